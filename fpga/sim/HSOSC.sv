@@ -0,0 +1,32 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Behavioral model of the iCE40 UltraPlus HSOSC oscillator (simulation only)
+- 48 MHz divided by 2^CLKHF_DIV
+- Under Verilator the clock comes from top_sim.sim_clk so the C++ driver owns time
+*/
+
+module HSOSC #(
+    parameter CLKHF_DIV = "0b00"
+) (
+    input  logic CLKHFPU,
+    input  logic CLKHFEN,
+    output logic CLKHF
+);
+
+`ifdef VERILATOR
+    assign CLKHF = $root.top_sim.sim_clk & CLKHFPU & CLKHFEN;
+`else
+    timeunit 1ns;
+    timeprecision 1ps;
+
+    localparam real HALF_PERIOD_NS = (CLKHF_DIV == "0b00") ? 10.4167 :
+                                     (CLKHF_DIV == "0b01") ? 20.8333 :
+                                     (CLKHF_DIV == "0b10") ? 41.6667 : 83.3333;
+    logic clk = 1'b0;
+    always #(HALF_PERIOD_NS) clk = ~clk;
+    assign CLKHF = clk & CLKHFPU & CLKHFEN;
+`endif
+
+endmodule
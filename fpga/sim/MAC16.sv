@@ -0,0 +1,102 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Behavioral model of the iCE40 UltraPlus MAC16 DSP primitive (simulation only)
+- Cycle-accurate for the configuration MAC16_wrapper_accum uses:
+  registered signed A/B, 16x16 multiply, 32-bit accumulate, unregistered adder output
+- O = Q + A_reg * B_reg, where Q is the accumulator register, loaded with O on CE
+- IRSTTOP/IRSTBOT clear the A/B input registers, ORSTTOP/ORSTBOT clear Q
+- Any other parameter setting stops elaboration instead of silently mis-modelling
+- Port list matches the vendor primitive so the RTL instantiates it unchanged
+*/
+
+module MAC16 #(
+    parameter NEG_TRIGGER              = "0b0",
+    parameter A_REG                    = "0b0",
+    parameter B_REG                    = "0b0",
+    parameter C_REG                    = "0b0",
+    parameter D_REG                    = "0b0",
+    parameter TOP_8x8_MULT_REG         = "0b0",
+    parameter BOT_8x8_MULT_REG         = "0b0",
+    parameter PIPELINE_16x16_MULT_REG1 = "0b0",
+    parameter PIPELINE_16x16_MULT_REG2 = "0b0",
+    parameter TOPOUTPUT_SELECT         = "0b00",
+    parameter TOPADDSUB_LOWERINPUT     = "0b00",
+    parameter TOPADDSUB_UPPERINPUT     = "0b0",
+    parameter TOPADDSUB_CARRYSELECT    = "0b00",
+    parameter BOTOUTPUT_SELECT         = "0b00",
+    parameter BOTADDSUB_LOWERINPUT     = "0b00",
+    parameter BOTADDSUB_UPPERINPUT     = "0b0",
+    parameter BOTADDSUB_CARRYSELECT    = "0b00",
+    parameter MODE_8x8                 = "0b0",
+    parameter A_SIGNED                 = "0b0",
+    parameter B_SIGNED                 = "0b0"
+) (
+    input  logic CLK, CE,
+    input  logic A15, A14, A13, A12, A11, A10, A9, A8, A7, A6, A5, A4, A3, A2, A1, A0,
+    input  logic B15, B14, B13, B12, B11, B10, B9, B8, B7, B6, B5, B4, B3, B2, B1, B0,
+    input  logic C15, C14, C13, C12, C11, C10, C9, C8, C7, C6, C5, C4, C3, C2, C1, C0,
+    input  logic D15, D14, D13, D12, D11, D10, D9, D8, D7, D6, D5, D4, D3, D2, D1, D0,
+    input  logic AHOLD, BHOLD, CHOLD, DHOLD,
+    input  logic IRSTTOP, IRSTBOT, ORSTTOP, ORSTBOT,
+    input  logic OLOADTOP, OLOADBOT, ADDSUBTOP, ADDSUBBOT, OHOLDTOP, OHOLDBOT,
+    input  logic CI, ACCUMCI, SIGNEXTIN,
+    output logic O31, O30, O29, O28, O27, O26, O25, O24, O23, O22, O21, O20, O19, O18, O17, O16,
+    output logic O15, O14, O13, O12, O11, O10, O9, O8, O7, O6, O5, O4, O3, O2, O1, O0,
+    output logic CO, ACCUMCO, SIGNEXTOUT
+);
+
+    // Only the MAC16_wrapper_accum configuration is modelled
+    initial begin
+        if (A_REG != "0b1" || B_REG != "0b1" || MODE_8x8 != "0b0" ||
+            A_SIGNED != "0b1" || B_SIGNED != "0b1" ||
+            PIPELINE_16x16_MULT_REG1 != "0b0" || PIPELINE_16x16_MULT_REG2 != "0b0" ||
+            TOPOUTPUT_SELECT != "0b00" || BOTOUTPUT_SELECT != "0b00" ||
+            TOPADDSUB_LOWERINPUT != "0b10" || BOTADDSUB_LOWERINPUT != "0b10" ||
+            TOPADDSUB_UPPERINPUT != "0b0" || BOTADDSUB_UPPERINPUT != "0b0" ||
+            TOPADDSUB_CARRYSELECT != "0b10" || BOTADDSUB_CARRYSELECT != "0b00" ||
+            NEG_TRIGGER != "0b0")
+            $fatal(1, "MAC16 model: unsupported configuration");
+    end
+
+    logic signed [15:0] a, b, a_reg, b_reg;
+    logic        [31:0] q, o;
+
+    assign a = {A15, A14, A13, A12, A11, A10, A9, A8, A7, A6, A5, A4, A3, A2, A1, A0};
+    assign b = {B15, B14, B13, B12, B11, B10, B9, B8, B7, B6, B5, B4, B3, B2, B1, B0};
+
+    // Input registers (A_REG/B_REG = 1)
+    always_ff @(posedge CLK or posedge IRSTTOP) begin
+        if (IRSTTOP)            a_reg <= 16'sd0;
+        else if (CE && !AHOLD)  a_reg <= a;
+    end
+
+    always_ff @(posedge CLK or posedge IRSTBOT) begin
+        if (IRSTBOT)            b_reg <= 16'sd0;
+        else if (CE && !BHOLD)  b_reg <= b;
+    end
+
+    // Upper input = accumulator, lower input = 32-bit product, carry chained
+    // from the bottom adder, so the two 16-bit adders form one 32-bit adder
+    logic signed [31:0] product;
+    assign product = a_reg * b_reg;
+    assign o = q + product;
+
+    always_ff @(posedge CLK or posedge ORSTTOP) begin
+        if (ORSTTOP)               q[31:16] <= 16'd0;
+        else if (CE && !OHOLDTOP)  q[31:16] <= o[31:16];
+    end
+
+    always_ff @(posedge CLK or posedge ORSTBOT) begin
+        if (ORSTBOT)               q[15:0] <= 16'd0;
+        else if (CE && !OHOLDBOT)  q[15:0] <= o[15:0];
+    end
+
+    assign {O31, O30, O29, O28, O27, O26, O25, O24, O23, O22, O21, O20, O19, O18, O17, O16,
+            O15, O14, O13, O12, O11, O10, O9, O8, O7, O6, O5, O4, O3, O2, O1, O0} = o;
+    assign CO = 1'b0;
+    assign ACCUMCO = 1'b0;
+    assign SIGNEXTOUT = a_reg[15];
+
+endmodule
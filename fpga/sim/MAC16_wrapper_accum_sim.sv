@@ -0,0 +1,29 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Simulation build of MAC16_wrapper_accum for MAC16_wrapper_accum_sim_tb
+- Same ports and behavior; compile with fpga/sim/MAC16.sv in place of the vendor primitive
+*/
+
+module MAC16_wrapper_accum_sim (
+    input  logic               clk,
+    input  logic               reset,
+    input  logic               mac_rst,
+    input  logic               ce,
+    input  logic signed [15:0] a_in,
+    input  logic signed [15:0] b_in,
+    output logic signed [31:0] result
+);
+
+    MAC16_wrapper_accum mac (
+        .clk(clk),
+        .reset(reset),
+        .mac_rst(mac_rst),
+        .ce(ce),
+        .a_in(a_in),
+        .b_in(b_in),
+        .result(result)
+    );
+
+endmodule
@@ -2,32 +2,98 @@
 Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
-Module Function: I2S data latching wrapper
+Module Function: I2S data latching and stereo framing wrapper
 - Latches incoming 32-bit ADC data when valid
-- Extracts 16-bit audio sample from bits [23:8]
+- Passes on the full 24-bit audio sample, bits [23:0]
+- Tags each word with its channel (WS low = left, WS high = right)
+- Latches one DAC word per channel at each transmitter request
 */
-module I2S_package(
+module I2S_package #(
+    parameter int HALF_CLKS = 192           // clk per WS half: conf_res 24 x conf_ratio 4 x 2
+)(
     input  logic        clk,
     input  logic        reset_n,
+    input  logic        ws,                 // I2S word select
     input  logic [31:0] adc_data,
     input  logic        adc_valid,
-    output logic [15:0] audio_in
+    output logic [23:0] audio_in,
+    output logic        audio_ch,           // Channel of audio_in: 0 left, 1 right
+    input  logic signed [23:0] audio_out_l,
+    input  logic signed [23:0] audio_out_r,
+    input  logic        dac_request,        // Transmitter fetches its next word
+    output logic [31:0] dac_data
 );
 
+    // ======================
+    // WORD SELECT TRACKING
+    // A word's LSB is clocked in the first SCK of the next WS half (I2S),
+    // so a word that completes near a WS change can fall on either side of
+    // it. Attribute it to the half that holds most of the word instead.
+    // ======================
+    logic       ws_d, ws_prev;
+    logic [7:0] since_ws;
+    logic       word_ws;            // Level of the half the current word belongs to
+
+    always_ff @(posedge clk) begin
+        if (reset_n == 0) begin
+            ws_d     <= 1'b0;
+            ws_prev  <= 1'b1;
+            since_ws <= 8'd0;
+        end
+        else begin
+            ws_d <= ws;
+            if (ws != ws_d) begin
+                ws_prev  <= ws_d;
+                since_ws <= 8'd0;
+            end
+            else if (since_ws != 8'hFF) begin
+                since_ws <= since_ws + 8'd1;
+            end
+        end
+    end
+
+    assign word_ws = (since_ws < HALF_CLKS / 2) ? ws_prev : ws_d;
+
+    // ======================
+    // ADC
+    // ======================
     logic [31:0] latch_data;
-    
+    logic        latch_ch;
+
     always_ff @(posedge clk) begin
         if (reset_n == 0) begin
             latch_data <= 32'd0;
-        end 
-        else begin 
-            if (adc_valid) begin 
+            latch_ch   <= 1'b0;
+        end
+        else begin
+            if (adc_valid) begin
                 latch_data <= adc_data;
+                latch_ch   <= word_ws;
             end
-        end 
+        end
+    end
+
+    // The 24-bit audio data sits in bits [23:0]
+    assign audio_in = latch_data[23:0];
+    assign audio_ch = latch_ch;
+
+    // ======================
+    // DAC
+    // The request comes at a word boundary, so the word it fetches is for the
+    // half that is starting. Latching it keeps the whole word from one sample
+    // even if the filter publishes mid-word.
+    // ======================
+    logic signed [23:0] dac_word;
+
+    always_ff @(posedge clk) begin
+        if (reset_n == 0) begin
+            dac_word <= 24'sd0;
+        end
+        else if (dac_request) begin
+            dac_word <= word_ws ? audio_out_l : audio_out_r;
+        end
     end
-    
-    // Extract the 16-bit audio data from bits [23:8]
-    assign audio_in = latch_data[23:8];
 
-endmodule
\ No newline at end of file
+    assign dac_data = {8'b0, dac_word};
+
+endmodule
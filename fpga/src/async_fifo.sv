@@ -0,0 +1,97 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Small dual-clock FIFO for clock domain crossing
+- Gray-coded read and write pointers, each crossing through a two-stage
+  synchronizer; the memory itself never crosses until its pointer says so
+- First-word fall-through: rdata shows the head entry whenever !empty
+- Async active-low resets, so both sides clear together even when the
+  write clock (sck) is not running
+- 2^DEPTH_LOG2 entries of WIDTH bits
+*/
+
+module async_fifo #(
+    parameter int WIDTH      = 20,
+    parameter int DEPTH_LOG2 = 2
+)(
+    // Write side
+    input  logic             wclk,
+    input  logic             wrst_n,
+    input  logic             wr,
+    input  logic [WIDTH-1:0] wdata,
+    output logic             full,
+
+    // Read side
+    input  logic             rclk,
+    input  logic             rrst_n,
+    input  logic             rd,
+    output logic [WIDTH-1:0] rdata,
+    output logic             empty
+);
+
+    if (DEPTH_LOG2 < 2) begin : g_depth
+        $error("async_fifo: DEPTH_LOG2 must be at least 2, not %0d", DEPTH_LOG2);
+    end
+
+    localparam int DEPTH = 1 << DEPTH_LOG2;
+    localparam int PW    = DEPTH_LOG2 + 1;     // One extra bit tells full from empty
+
+    logic [WIDTH-1:0] mem [0:DEPTH-1];
+
+    logic [PW-1:0] wbin, wgray, rbin, rgray;
+    logic [PW-1:0] wgray_r1, wgray_r2;          // wgray in the read domain
+    logic [PW-1:0] rgray_w1, rgray_w2;          // rgray in the write domain
+    logic [PW-1:0] wbin_next, rbin_next;
+
+    function automatic logic [PW-1:0] to_gray(input logic [PW-1:0] b);
+        to_gray = b ^ (b >> 1);
+    endfunction
+
+    // ======================
+    // WRITE SIDE
+    // ======================
+    assign full      = wgray == {~rgray_w2[PW-1:PW-2], rgray_w2[PW-3:0]};
+    assign wbin_next = wbin + PW'(wr && !full);
+
+    always_ff @(posedge wclk, negedge wrst_n) begin
+        if (!wrst_n) begin
+            wbin     <= '0;
+            wgray    <= '0;
+            rgray_w1 <= '0;
+            rgray_w2 <= '0;
+        end else begin
+            wbin     <= wbin_next;
+            wgray    <= to_gray(wbin_next);
+            rgray_w1 <= rgray;
+            rgray_w2 <= rgray_w1;
+        end
+    end
+
+    always_ff @(posedge wclk) begin
+        if (wr && !full)
+            mem[wbin[DEPTH_LOG2-1:0]] <= wdata;
+    end
+
+    // ======================
+    // READ SIDE
+    // ======================
+    assign empty     = rgray == wgray_r2;
+    assign rdata     = mem[rbin[DEPTH_LOG2-1:0]];
+    assign rbin_next = rbin + PW'(rd && !empty);
+
+    always_ff @(posedge rclk, negedge rrst_n) begin
+        if (!rrst_n) begin
+            rbin     <= '0;
+            rgray    <= '0;
+            wgray_r1 <= '0;
+            wgray_r2 <= '0;
+        end else begin
+            rbin     <= rbin_next;
+            rgray    <= to_gray(rbin_next);
+            wgray_r1 <= wgray;
+            wgray_r2 <= wgray_r1;
+        end
+    end
+
+endmodule
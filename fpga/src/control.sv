@@ -3,66 +3,316 @@ Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
 Module Function: Filter coefficient management with safe frame-boundary updates
-- Stages incoming SPI coefficient data
+- One coefficient bank per channel. SPI frames arrive as addressed byte
+  writes (aes_spi, through spi_top's FIFO) straight into the staging bank of
+  each channel they name; the other bands keep their staged words
+- A frame is all or nothing: its END_OK write keeps the bands it wrote, an
+  END_BAD write or a cut-short frame (frame_abort) copies them back from the
+  active bank, and nothing commits while a frame is open. Frames that check
+  out before a commit merge in the stage; if a rolled-back frame wrote a band
+  one of them had, that band reverts too, and the commit keeps the old
+  sequence number so the MCU sees its frame never landed and resends
+- Gain-index frames stage the bands from the coefficient ROM (gain_rom.sv),
+  5 words per band, one clk per word, once the frame checks out; the ROM holds
+  the low/mid/high designs, so only bands 0-2 take gain indices
+- N_BANDS bands per bank; each bank is 80 x N_BANDS flops, active and staged
+- Bypass flags per channel (v5 frames: band 15, offsets 10-11 carry the flag
+  word, bit b = band b, bit 15 = every band) are staged, rolled back and
+  committed with the coefficients; iir_cascade_accum crossfades around them
 - Commits coefficients only at safe sample boundaries (output_ready)
+- Reports the sequence number of the last committed frame, a busy flag and a
+  pulse per rolled-back frame for the MISO status word (spi_top.sv)
 - Prevents audio artifacts from mid-frame coefficient changes
+- With RAMP set, a commit makes the staged bands the target bank and the
+  active words walk toward it instead of jumping: after each sample boundary
+  one word per clk of the bank the cascade is not reading (pass_ch) moves
+  (target - active) >> ramp_shift, at least one LSB, so a coefficient settles
+  with a time constant of about 2^ramp_shift samples. Every step is a convex
+  mix of the old and new designs, which keeps (a1, a2) inside the stability
+  triangle. ramp_shift = 0 jumps at the commit as without RAMP; the target
+  bank costs another 80 x N_BANDS flops per channel
 */
 
-module control(
+module control #(
+    parameter int N_BANDS = 3,
+    parameter bit RAMP    = 1'b0      // Walk active toward committed words (target bank)
+)(
     input  logic              clk,
     input  logic              reset,          // active low
     input  logic              output_ready,   // safe to update, 1 cycle pulse
-    input  logic              update_en,      // SPI update pulse
-    input  logic [335:0]      data,
 
-    // Low-pass (LPF)
-    output logic signed [15:0] low_b0, low_b1, low_b2, low_a1, low_a2,
+    // One write per clk from the SPI FIFO (entry layout in aes_spi)
+    input  logic              wr_en,
+    input  logic [1:0]        wr_kind,        // WR_COEFF, WR_INDEX, WR_END_OK, WR_END_BAD
+    input  logic [1:0]        wr_channels,    // Banks the write is for: {right, left}
+    input  logic [3:0]        wr_band,
+    input  logic [3:0]        wr_offset,      // Byte of the band: 0 = b0 high ... 9 = a2 low
+    input  logic [7:0]        wr_byte,
+    input  logic              frame_abort,    // CS rose with a frame still open
 
-    // Mid-pass (BPF)
-    output logic signed [15:0] mid_b0, mid_b1, mid_b2, mid_a1, mid_a2,
+    // Coefficient ramping (RAMP builds only)
+    input  logic [3:0]        ramp_shift,     // Step = distance >> ramp_shift; 0 = jump
+    input  logic              pass_ch,        // Channel the cascade is filtering
 
-    // High-pass (HPF)
-    output logic signed [15:0] high_b0, high_b1, high_b2, high_a1, high_a2
+    // Active coefficients: [channel][band: low, mid, high, ...][b0 b1 b2 a1 a2]
+    output logic [1:0][N_BANDS-1:0][4:0][15:0] coeffs,
+    output logic [1:0][N_BANDS-1:0]        bypass,         // [channel][band]
+
+    // Status for the MCU
+    output logic [7:0]        committed_seq,  // Last frame made active (FF after reset)
+    output logic              busy,           // A frame open or staged bands not yet active
+    output logic              rejected,       // One clk pulse per rolled-back frame
+    output logic              commit          // One clk pulse per commit to the active bank
 );
 
+    localparam int ROM_BANDS = 3;   // Bands gain_rom has designs for
+
+    // Write kinds (same codes in aes_spi)
+    localparam logic [1:0] WR_COEFF   = 2'd0;
+    localparam logic [1:0] WR_INDEX   = 2'd1;
+    localparam logic [1:0] WR_END_OK  = 2'd2;
+    localparam logic [1:0] WR_END_BAD = 2'd3;
+
     // ======================
     // ACTIVE COEFFICIENTS
     // (used by the filters)
     // ======================
-    logic signed [15:0] low_b0_r, low_b1_r, low_b2_r, low_a1_r, low_a2_r;
-    logic signed [15:0] mid_b0_r, mid_b1_r, mid_b2_r, mid_a1_r, mid_a2_r;
-    logic signed [15:0] high_b0_r, high_b1_r, high_b2_r, high_a1_r, high_a2_r;
+    logic signed [15:0] active [0:1][0:N_BANDS-1][0:4];
 
     // OUTPUT ASSIGNMENTS
-    assign low_b0  = low_b0_r;
-    assign low_b1  = low_b1_r;
-    assign low_b2  = low_b2_r;
-    assign low_a1  = low_a1_r;
-    assign low_a2  = low_a2_r;
-
-    assign mid_b0  = mid_b0_r;
-    assign mid_b1  = mid_b1_r;
-    assign mid_b2  = mid_b2_r;
-    assign mid_a1  = mid_a1_r;
-    assign mid_a2  = mid_a2_r;
-
-    assign high_b0 = high_b0_r;
-    assign high_b1 = high_b1_r;
-    assign high_b2 = high_b2_r;
-    assign high_a1 = high_a1_r;
-    assign high_a2 = high_a2_r;
+    always_comb begin
+        for (int c = 0; c < 2; c++)
+            for (int b = 0; b < N_BANDS; b++)
+                for (int k = 0; k < 5; k++)
+                    coeffs[c][b][k] = active[c][b][k];
+    end
 
     // ======================
     // STAGING REGISTERS
     // (store coefficients from SPI, waiting to commit)
     // ======================
-    logic signed [15:0] low_b0_stage, low_b1_stage, low_b2_stage, low_a1_stage, low_a2_stage;
-    logic signed [15:0] mid_b0_stage, mid_b1_stage, mid_b2_stage, mid_a1_stage, mid_a2_stage;
-    logic signed [15:0] high_b0_stage, high_b1_stage, high_b2_stage, high_a1_stage, high_a2_stage;
+    logic signed [15:0] stage [0:1][0:N_BANDS-1][0:4];
+
+    // ======================
+    // BYPASS FLAGS
+    // (bit b = band b, bit 15 = all bands; staged and committed like the
+    //  coefficients, never ramped)
+    // ======================
+    logic [15:0] stage_bypass  [0:1];
+    logic [15:0] active_bypass [0:1];
+
+    always_comb begin
+        for (int c = 0; c < 2; c++)
+            for (int b = 0; b < N_BANDS; b++)
+                bypass[c][b] = active_bypass[c][b] || active_bypass[c][15];
+    end
+
+    // ======================
+    // RAMP TARGETS
+    // (committed words the active bank walks toward; with RAMP off they
+    //  are never written and synthesis drops them)
+    // ======================
+    logic signed [15:0] target [0:1][0:N_BANDS-1][0:4];
+    logic               ramp_run;   // Walking ramp_bank this sample
+    logic               ramp_bank;
+    logic [3:0]         ramp_band;
+    logic [2:0]         ramp_k;
+    logic signed [15:0] ramp_a, ramp_t;
+    logic signed [16:0] ramp_d, ramp_step;
 
-    // One-update-per-frame lock
+    // Distance >>> ramp_shift, rounded away from zero so every word lands exactly
+    assign ramp_a = active[ramp_bank][ramp_band][ramp_k];
+    assign ramp_t = target[ramp_bank][ramp_band][ramp_k];
+    assign ramp_d = 17'(ramp_t) - 17'(ramp_a);
+
+    always_comb begin
+        ramp_step = ramp_d >>> ramp_shift;
+        if (ramp_step == 17'sd0 && ramp_d != 17'sd0)
+            ramp_step = ramp_d[16] ? -17'sd1 : 17'sd1;
+    end
+
+    // Staged bands waiting for a sample boundary
     logic update_pending;
-    logic busy;
+    logic [7:0] staged_seq;     // Last frame that checked out
+    logic       staged_lost;    // A rollback reverted bands of a checked-out frame
+
+    // ======================
+    // FRAME TRACKING
+    // ======================
+    logic                 frame_open;   // A frame has written since its last END
+    logic [2*N_BANDS-1:0] dirty;        // Bands (c * N_BANDS + b) the open frame wrote
+    logic [2*N_BANDS-1:0] byte_hits;    // Bands a coefficient byte lands in this cycle
+    logic [1:0]           bypass_dirty; // Channels whose flags the open frame wrote
+    logic [1:0]           bypass_hits;  // Channels a flag byte lands in this cycle
+    logic [2*N_BANDS-1:0] pending;      // Bands checked-out frames wrote since the last commit
+    logic [1:0]           pending_bypass;
+    logic                 end_ok, end_bad, rollback;
+
+    assign end_ok   = wr_en && (wr_kind == WR_END_OK);
+    assign end_bad  = wr_en && (wr_kind == WR_END_BAD);
+    assign rollback = end_bad || (frame_abort && frame_open);
+
+    always_comb begin
+        for (int c = 0; c < 2; c++)
+            for (int b = 0; b < N_BANDS; b++)
+                byte_hits[c*N_BANDS + b] = wr_en && (wr_kind == WR_COEFF) && (wr_offset < 4'd10) &&
+                                           wr_channels[c] && (wr_band == 4'(b));
+        for (int c = 0; c < 2; c++)
+            bypass_hits[c] = wr_en && (wr_kind == WR_COEFF) && (wr_offset >= 4'd10) &&
+                             wr_channels[c] && (wr_band == 4'hF);
+    end
+
+    // ======================
+    // GAIN-INDEX LOOKUP
+    // (an index frame names one ROM entry per band; once it checks out
+    //  the sequencer reads each entry's 5 words into the staging
+    //  registers. Entry e = channel * 3 + band, bands 0-2.)
+    // ======================
+    logic [5:0]  lk_index [0:5];    // Latest gain index per entry
+    logic [5:0]  lk_new   [0:5];    // Indices of the open frame
+    logic [5:0]  lk_named;          // Entries the open frame named
+    logic [5:0]  lk_todo;           // Entries still to be read
+    logic [5:0]  lk_live;           // Entries whose stage holds (or will hold) an uncommitted lookup
+    logic        lk_busy;           // Reading lk_entry
+    logic [2:0]  lk_entry;
+    logic [5:0]  lk_cur;            // Index being read for lk_entry
+    logic [2:0]  lk_k;              // Word being addressed (b0 b1 b2 a1 a2)
+    logic        lk_drop;           // A coefficient frame replaced lk_entry mid-read
+    logic        rd_valid, rd_drop; // ROM output stage
+    logic [2:0]  rd_entry;
+    logic [2:0]  rd_k;
+    logic [15:0] rom_q;
+    logic [9:0]  rom_addr;
+    logic [7:0]  rom_entry;
+    logic [1:0]  lk_band;
+    logic [5:0]  lk_dirty;          // dirty, per lookup entry
+    logic [5:0]  lk_hits;           // Entries a good coefficient frame replaced
+    logic [5:0]  lk_ready;
+    logic [2:0]  lk_next;
+    logic        lookup_active;
+
+    // Indices past the table clamp to the top entry (0 dB)
+    function automatic logic [5:0] clamp_index(input logic [7:0] i);
+        clamp_index = (i > 8'd63) ? 6'd63 : i[5:0];
+    endfunction
+
+    // Lowest entry in m (6 = none)
+    function automatic logic [2:0] first_entry(input logic [5:0] m);
+        first_entry = 3'd6;
+        for (int e = 5; e >= 0; e--)
+            if (m[e]) first_entry = 3'(e);
+    endfunction
+
+    // Banks share the ROM: word (band * 64 + index) * 5 + k
+    assign lk_band   = (lk_entry >= 3'd3) ? 2'(lk_entry - 3'd3) : lk_entry[1:0];
+    assign rom_entry = {lk_band, lk_cur};
+    assign rom_addr  = {rom_entry, 2'b00} + {2'b00, rom_entry} + {7'd0, lk_k};
+
+    gain_rom rom_inst (
+        .clk(clk),
+        .addr(rom_addr),
+        .q(rom_q)
+    );
+
+    always_comb begin
+        for (int c = 0; c < 2; c++)
+            for (int b = 0; b < ROM_BANDS; b++)
+                lk_dirty[c*ROM_BANDS + b] = dirty[c*N_BANDS + b] || byte_hits[c*N_BANDS + b];
+    end
+
+    // A good coefficient frame wins over lookups still pending for its bands;
+    // a ROM word for a band the open frame is writing is dropped
+    assign lk_hits       = end_ok ? lk_dirty : 6'b000000;
+    assign lk_ready      = frame_open ? 6'b000000 : (lk_todo & ~lk_hits);
+    assign lk_next       = first_entry(lk_ready);
+    assign lookup_active = lk_busy || rd_valid || (lk_todo != 6'b000000);
+
+    assign busy     = update_pending || lookup_active || frame_open;
+    assign rejected = rollback;
+    assign commit   = output_ready && update_pending && !lookup_active && !frame_open;
+
+    always_ff @(posedge clk) begin
+        if (!reset) begin
+            for (int e = 0; e < 6; e++) begin
+                lk_index[e] <= 6'd63;
+                lk_new[e]   <= 6'd63;
+            end
+            lk_named <= 6'b000000;
+            lk_todo  <= 6'b000000;
+            lk_live  <= 6'b000000;
+            lk_busy  <= 1'b0;
+            lk_entry <= 3'd0;
+            lk_cur   <= 6'd0;
+            lk_k     <= 3'd0;
+            lk_drop  <= 1'b0;
+            rd_valid <= 1'b0;
+            rd_drop  <= 1'b0;
+            rd_entry <= 3'd0;
+            rd_k     <= 3'd0;
+        end
+        else begin
+            // The ROM answers the address issued in the previous cycle
+            rd_valid <= lk_busy;
+            rd_drop  <= lk_drop || lk_hits[lk_entry] || lk_dirty[lk_entry];
+            rd_entry <= lk_entry;
+            rd_k     <= lk_k;
+
+            if (lk_busy) begin
+                if (lk_hits[lk_entry])
+                    lk_drop <= 1'b1;
+                if (lk_k == 3'd4)
+                    lk_busy <= 1'b0;
+                else
+                    lk_k <= lk_k + 3'd1;
+            end
+            else if (lk_ready != 6'b000000) begin
+                lk_entry          <= lk_next;
+                lk_cur            <= lk_index[lk_next];
+                lk_k              <= 3'd0;
+                lk_drop           <= 1'b0;
+                lk_busy           <= 1'b1;
+                lk_todo[lk_next]  <= 1'b0;
+            end
+
+            // Indices wait for the frame's END; the last index for an entry wins
+            if (wr_en && wr_kind == WR_INDEX) begin
+                for (int c = 0; c < 2; c++) begin
+                    for (int b = 0; b < ROM_BANDS; b++) begin
+                        if (wr_channels[c] && wr_band == 4'(b)) begin
+                            lk_new[c*3 + b]   <= clamp_index(wr_byte);
+                            lk_named[c*3 + b] <= 1'b1;
+                        end
+                    end
+                end
+            end
+
+            if (end_ok) begin
+                for (int e = 0; e < 6; e++) begin
+                    if (lk_named[e]) begin
+                        lk_index[e] <= lk_new[e];
+                        lk_todo[e]  <= 1'b1;
+                        lk_live[e]  <= 1'b1;
+                    end
+                    else if (lk_hits[e]) begin
+                        lk_todo[e]  <= 1'b0;
+                        lk_live[e]  <= 1'b0;
+                    end
+                end
+                lk_named <= 6'b000000;
+            end
+            else if (rollback) begin
+                // The bands go back to the active words, so lookups they
+                // still owed are read again
+                for (int e = 0; e < 6; e++)
+                    if (lk_dirty[e] && lk_live[e])
+                        lk_todo[e] <= 1'b1;
+                lk_named <= 6'b000000;
+            end
+            else if (commit) begin
+                lk_live  <= 6'b000000;  // Committed below
+            end
+        end
+    end
 
     // ======================
     // MAIN LOGIC
@@ -70,102 +320,164 @@ module control(
 
     always_ff @(posedge clk) begin
         if (!reset) begin
-            // Reset active coefficients
-            low_b0_r  <= 16'sh4000;
-            low_b1_r  <= 16'sh0000;
-            low_b2_r  <= 16'sh0000;
-            low_a1_r  <= 16'sh0000;
-            low_a2_r  <= 16'sh0000;
-
-            mid_b0_r  <= 16'sh4000;
-            mid_b1_r  <= 16'sh0000;
-            mid_b2_r  <= 16'sh0000;
-            mid_a1_r  <= 16'sh0000;
-            mid_a2_r  <= 16'sh0000;
-
-            high_b0_r <= 16'sh4000;
-            high_b1_r <= 16'sh0000;
-            high_b2_r <= 16'sh0000;
-            high_a1_r <= 16'sh0000;
-            high_a2_r <= 16'sh0000;
-
-            // Reset staged
-            low_b0_stage  <= 16'sh4000;
-            low_b1_stage  <= 16'sh0000;
-            low_b2_stage  <= 16'sh0000;
-            low_a1_stage  <= 16'sh0000;
-            low_a2_stage  <= 16'sh0000;
-
-            mid_b0_stage  <= 16'sh4000;
-            mid_b1_stage  <= 16'sh0000;
-            mid_b2_stage  <= 16'sh0000;
-            mid_a1_stage  <= 16'sh0000;
-            mid_a2_stage  <= 16'sh0000;
-
-            high_b0_stage <= 16'sh4000;
-            high_b1_stage <= 16'sh0000;
-            high_b2_stage <= 16'sh0000;
-            high_a1_stage <= 16'sh0000;
-            high_a2_stage <= 16'sh0000;
+            // Reset active and staged coefficients to passthrough
+            for (int c = 0; c < 2; c++) begin
+                for (int b = 0; b < N_BANDS; b++) begin
+                    for (int k = 0; k < 5; k++) begin
+                        active[c][b][k] <= (k == 0) ? 16'sh4000 : 16'sh0000;
+                        stage[c][b][k]  <= (k == 0) ? 16'sh4000 : 16'sh0000;
+                        target[c][b][k] <= (k == 0) ? 16'sh4000 : 16'sh0000;
+                    end
+                end
+                stage_bypass[c]  <= 16'h0000;
+                active_bypass[c] <= 16'h0000;
+            end
 
             update_pending <= 1'b0;
-            busy <= 1'b0;
-        end 
+            frame_open     <= 1'b0;
+            dirty          <= '0;
+            bypass_dirty   <= '0;
+            pending        <= '0;
+            pending_bypass <= '0;
+            staged_lost    <= 1'b0;
+            staged_seq     <= 8'hFF;
+            committed_seq  <= 8'hFF;
+            ramp_run       <= 1'b0;
+            ramp_bank      <= 1'b0;
+            ramp_band      <= 4'd0;
+            ramp_k         <= 3'd0;
+        end
         else begin
 
             // ==================================================
-            // 1) CAPTURE SPI UPDATE IMMEDIATELY (but only once)
+            // 1) STAGE GAIN-INDEX LOOKUP RESULTS
+            // ==================================================
+            if (rd_valid && !rd_drop) begin
+                if (rd_entry >= 3'd3)
+                    stage[1][rd_entry - 3'd3][rd_k] <= rom_q;
+                else
+                    stage[0][rd_entry][rd_k] <= rom_q;
+            end
+
+            // ==================================================
+            // 2) WRITE SPI BYTES STRAIGHT INTO THE STAGE
+            // Only the bands in the frame are touched; a second
+            // frame before the commit merges into the stage (and a
+            // rollback of it reverts the first one's bands too).
             // ==================================================
-            if (update_en && !busy) begin
-                // Stage new coefficients
-                low_b0_stage <= data[239:224];
-                low_b1_stage <= data[223:208];
-                low_b2_stage <= data[207:192];
-                low_a1_stage <= data[191:176];
-                low_a2_stage <= data[175:160];
-
-                mid_b0_stage <= data[159:144];
-                mid_b1_stage <= data[143:128];
-                mid_b2_stage <= data[127:112];
-                mid_a1_stage <= data[111:96];
-                mid_a2_stage <= data[95:80];
-
-                high_b0_stage <= data[79:64];
-                high_b1_stage <= data[63:48];
-                high_b2_stage <= data[47:32];
-                high_a1_stage <= data[31:16];
-                high_a2_stage <= data[15:0];
+            for (int c = 0; c < 2; c++)
+                for (int b = 0; b < N_BANDS; b++)
+                    if (byte_hits[c*N_BANDS + b])
+                        for (int k = 0; k < 5; k++)
+                            if (wr_offset[3:1] == 3'(k)) begin
+                                if (wr_offset[0])
+                                    stage[c][b][k][7:0]  <= wr_byte;
+                                else
+                                    stage[c][b][k][15:8] <= wr_byte;
+                            end
 
-                update_pending <= 1'b1;
-                busy <= 1'b1;   // lock until commit
+            for (int c = 0; c < 2; c++)
+                if (bypass_hits[c]) begin
+                    if (wr_offset == 4'd10)
+                        stage_bypass[c][15:8] <= wr_byte;
+                    else
+                        stage_bypass[c][7:0]  <= wr_byte;
+                end
+
+            if (wr_en && (wr_kind == WR_COEFF || wr_kind == WR_INDEX))
+                frame_open <= 1'b1;
+            dirty        <= dirty | byte_hits;
+            bypass_dirty <= bypass_dirty | bypass_hits;
+
+            // ==================================================
+            // 3) CLOSE THE FRAME
+            // A bad or cut-short frame puts back the active words
+            // of every band it wrote (the committed ones when
+            // ramping: active may still be on its way there).
+            // Any of them a checked-out frame wrote is lost with
+            // it, so that frame must not be reported committed.
+            // ==================================================
+            if (end_ok || rollback) begin
+                frame_open   <= 1'b0;
+                dirty        <= '0;
+                bypass_dirty <= '0;
+            end
+            if (rollback) begin
+                for (int c = 0; c < 2; c++)
+                    for (int b = 0; b < N_BANDS; b++)
+                        if (dirty[c*N_BANDS + b])
+                            for (int k = 0; k < 5; k++)
+                                stage[c][b][k] <= RAMP ? target[c][b][k] : active[c][b][k];
+                for (int c = 0; c < 2; c++)
+                    if (bypass_dirty[c])
+                        stage_bypass[c] <= active_bypass[c];
+                if ((dirty & pending) != '0 || (bypass_dirty & pending_bypass) != 2'b00)
+                    staged_lost <= 1'b1;
             end
 
             // ==================================================
-            // 2) COMMIT AT A SAFE SAMPLE BOUNDARY
+            // 4) COMMIT AT A SAFE SAMPLE BOUNDARY
+            // Never with a band half read from the ROM or half
+            // written by an open frame: either holds the commit to
+            // the next boundary (6 clks per band and bank, well
+            // inside one sample).
             // ==================================================
-            if (output_ready && update_pending) begin
-                // Commit to ACTIVE coefficients
-                low_b0_r  <= low_b0_stage;
-                low_b1_r  <= low_b1_stage;
-                low_b2_r  <= low_b2_stage;
-                low_a1_r  <= low_a1_stage;
-                low_a2_r  <= low_a2_stage;
-
-                mid_b0_r  <= mid_b0_stage;
-                mid_b1_r  <= mid_b1_stage;
-                mid_b2_r  <= mid_b2_stage;
-                mid_a1_r  <= mid_a1_stage;
-                mid_a2_r  <= mid_a2_stage;
-
-                high_b0_r <= high_b0_stage;
-                high_b1_r <= high_b1_stage;
-                high_b2_r <= high_b2_stage;
-                high_a1_r <= high_a1_stage;
-                high_a2_r <= high_a2_stage;
+            if (commit) begin
+                // Commit to ACTIVE coefficients, or to the ramp targets
+                for (int c = 0; c < 2; c++)
+                    for (int b = 0; b < N_BANDS; b++)
+                        for (int k = 0; k < 5; k++) begin
+                            if (RAMP)
+                                target[c][b][k] <= stage[c][b][k];
+                            if (!RAMP || ramp_shift == 4'd0)
+                                active[c][b][k] <= stage[c][b][k];
+                        end
+                for (int c = 0; c < 2; c++)
+                    active_bypass[c] <= stage_bypass[c];
+                if (!staged_lost)
+                    committed_seq <= staged_seq;
+                pending        <= '0;
+                pending_bypass <= '0;
+                staged_lost    <= 1'b0;
+            end
 
-                update_pending <= 1'b0;
-                busy <= 1'b0;  // ready for next SPI frame
+            // ==================================================
+            // 5) RAMP ACTIVE TOWARD THE TARGETS
+            // One word per clk, 5 * N_BANDS clks after each sample
+            // boundary, in the bank of the channel the pass is not
+            // filtering (it only reads coeffs[pass_ch]). Commits
+            // happen at the boundary too, so the two never collide.
+            // ==================================================
+            if (RAMP) begin
+                if (output_ready) begin
+                    ramp_run  <= 1'b1;
+                    ramp_bank <= !pass_ch;
+                    ramp_band <= 4'd0;
+                    ramp_k    <= 3'd0;
+                end
+                else if (ramp_run) begin
+                    active[ramp_bank][ramp_band][ramp_k] <= 16'(ramp_a + ramp_step);
+                    if (ramp_k == 3'd4) begin
+                        ramp_k <= 3'd0;
+                        if (ramp_band == 4'(N_BANDS - 1))
+                            ramp_run <= 1'b0;
+                        else
+                            ramp_band <= ramp_band + 4'd1;
+                    end
+                    else
+                        ramp_k <= ramp_k + 3'd1;
+                end
             end
+
+            // A frame that checks out in the commit cycle waits for the next boundary
+            if (end_ok) begin
+                update_pending <= 1'b1;
+                staged_seq     <= wr_byte;
+                pending        <= (commit ? '0 : pending) | dirty;
+                pending_bypass <= (commit ? 2'b00 : pending_bypass) | bypass_dirty;
+            end
+            else if (output_ready && !lookup_active && !frame_open)
+                update_pending <= 1'b0;
         end
     end
 
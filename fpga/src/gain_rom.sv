@@ -0,0 +1,29 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Coefficient ROM for gain-index frames
+- 3 bands x 64 gain indices x 5 words (b0 b1 b2 a1 a2), Q2.14
+- Word (band * 64 + index) * 5 + k, as mcu/tools/gen_gain_rom.c writes gain_rom.mem
+- Synchronous read so it maps onto EBR (960 x 16 = 4 blocks); q is valid one clk after addr
+*/
+
+`ifndef GAIN_ROM_FILE
+`define GAIN_ROM_FILE "gain_rom.mem"
+`endif
+
+module gain_rom(
+    input  logic        clk,
+    input  logic [9:0]  addr,
+    output logic [15:0] q
+);
+
+    logic [15:0] rom [0:959];
+
+    initial $readmemh(`GAIN_ROM_FILE, rom);
+
+    always_ff @(posedge clk) begin
+        q <= rom[addr];
+    end
+
+endmodule
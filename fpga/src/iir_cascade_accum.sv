@@ -0,0 +1,315 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Stereo N-section biquad cascade on one time-multiplexed MAC16
+- Every l_r_clk edge brings one sample, tagged with its channel; the pass runs
+  section 0 -> 1 -> ... -> N_SECTIONS - 1 back to back on that channel's own
+  x/y history and coefficient bank, so left and right never share filter state
+- 24-bit samples on a 16x16 MAC: each section runs the b0 b1 b2 a1 a2 sequence
+  twice (7 clks each), once on the low bytes x[7:0] (zero extended) and once
+  on the high words x[23:8]; the sums combine as hi * 2^8 + lo, exact while
+  the high sum fits the 32-bit accumulator (about 12 dB over full scale)
+- The Q2.14 result is rounded and saturated to 24 bits; with NOISE_SHAPING the
+  rounding error of each section is fed back into its next result (first-order
+  error feedback), moving the requantization noise away from DC where the
+  low shelf's poles would amplify it
+- One pass of 14 x N_SECTIONS + 1 clks per edge must fit in CLKS_PER_EDGE
+  (192 at the 12 MHz HSOSC): up to 13 sections, the three bands in 43
+- Publishes both channels on the next edge: one sample of latency per channel
+- mac_busy and clip feed the performance counters in three_band_eq
+- Only coeffs[pass_channel] is read between two edges; control.sv ramps the
+  other bank meanwhile
+- bypass[c][s] routes channel c around section s: the section's result is
+  crossfaded toward its input over 2^FADE_LOG2 of the channel's samples,
+  y + (x - y) * f / 2^FADE_LOG2, and once fully faded the section skips its
+  MAC sequences (2 clks instead of 14) and passes x through bit for bit.
+  Clearing the flag fades back the same way. The mix lands in the section's
+  own y history, which is the same as blending its coefficients toward
+  passthrough: (a1, a2) scale by 1 - f, so the section stays stable all the
+  way through the fade
+*/
+
+module iir_cascade_accum #(
+    parameter int N_SECTIONS    = 3,
+    parameter int CLKS_PER_EDGE = 192,      // clk per l_r_clk half: conf_res 24 x conf_ratio 4 x 2
+    parameter bit NOISE_SHAPING = 1'b1,     // Feed each section's rounding error back
+    parameter int FADE_LOG2     = 6         // Bypass crossfade: 2^FADE_LOG2 samples (2 ms)
+)(
+    input  logic               clk,         // High speed system clock
+    input  logic               l_r_clk,     // Left right select (new sample on every edge)
+    input  logic               reset,
+    input  logic signed [23:0] latest_sample,           // x[n]
+    input  logic               latest_channel,          // Channel of x[n]: 0 left, 1 right
+    input  logic [1:0][N_SECTIONS-1:0][4:0][15:0] coeffs,   // [channel][section][b0 b1 b2 a1 a2]
+    input  logic [1:0][N_SECTIONS-1:0] bypass,              // [channel][section]: route around it
+    output logic [1:0][N_SECTIONS-1:0][23:0] section_output, // Each section's output per channel, published per edge
+    output logic [1:0][23:0]   filtered_output,         // Last section per channel (= section_output[c][N_SECTIONS-1])
+    output logic               output_ready,            // 1 clk pulse after each edge
+    output logic               mac_busy,                // A pass is in flight (MAC cycles used)
+    output logic               pass_channel,            // Channel of the pass since the last edge
+    output logic               clip                     // A section result saturated this clk
+);
+
+    // Edge detection takes 3 clks before the pass starts
+    if (14 * N_SECTIONS + 4 > CLKS_PER_EDGE) begin : g_budget
+        $error("iir_cascade_accum: %0d sections do not fit in %0d clks per edge",
+               N_SECTIONS, CLKS_PER_EDGE);
+    end
+
+    localparam int SW = $clog2(N_SECTIONS + 1);     // Wide enough for node index section + 1
+    localparam int FW = FADE_LOG2 + 1;              // Fade position 0 .. 2^FADE_LOG2
+    localparam logic [FW-1:0] FADE_FULL = FW'(1 << FADE_LOG2);
+
+    // FSM States
+    typedef enum logic [2:0] {
+        IDLE      = 3'd0,
+        CLEAR     = 3'd1,
+        MULT_B0   = 3'd2,
+        MULT_B1   = 3'd3,
+        MULT_B2   = 3'd4,
+        MULT_A1   = 3'd5,
+        MULT_A2   = 3'd6,
+        DONE      = 3'd7
+    } state_t;
+
+    state_t state;
+    logic [SW-1:0] section; // Section being computed
+    logic       channel;    // Channel of the pass in flight
+    logic       high;       // Second MAC sequence of the section: high words
+    logic       skipping;   // Section fully bypassed: no MAC sequences this pass
+
+    // ======================
+    // EDGE DETECTION
+    // ======================
+    logic l_r_clk_d1, l_r_clk_d2;
+    logic l_r_edge;
+
+    always_ff @(posedge clk) begin
+        if (!reset) begin
+            l_r_clk_d1 <= 1'b0;
+            l_r_clk_d2 <= 1'b0;
+            l_r_edge   <= 1'b0;
+        end else begin
+            l_r_clk_d1 <= l_r_clk;
+            l_r_clk_d2 <= l_r_clk_d1;
+            l_r_edge   <= l_r_clk_d1 ^ l_r_clk_d2;
+        end
+    end
+
+    // ======================
+    // SIGNAL HISTORY
+    // Per channel, node 0 is the input, node s + 1 the output of section s.
+    // Registers: 2 x (N_SECTIONS + 1) x 3 words of 24 bits.
+    // Section s reads x[n..n-2] from node s and y[n-1..n-2] from node s + 1,
+    // so each section's output history doubles as the next section's input history.
+    // ======================
+    logic signed [23:0] hist [0:1][0:N_SECTIONS][0:2];
+    logic signed [31:0] mac_result;
+    logic signed [31:0] low_sum;            // Low-byte sequence of the section in flight
+
+    // ======================
+    // OUTPUT STAGE
+    // acc = hi * 2^8 + lo has 14 fraction bits. v = acc - e[n-1] is rounded
+    // half up to 24 bits; e[n] = y * 2^14 - v lies in [-2^13, 2^13], and is
+    // cleared when y saturates so a clipped section cannot wind it up.
+    // ======================
+    logic signed [15:0] err [0:1][0:N_SECTIONS-1];     // e[n-1] per channel and section
+    logic signed [41:0] acc, shaped, rounded;
+    logic signed [23:0] section_y;
+    logic signed [15:0] section_e;
+    logic               clipped;
+
+    always_comb begin
+        acc     = 42'(mac_result) * 42'sd256 + 42'(low_sum);
+        shaped  = NOISE_SHAPING ? acc - 42'(err[channel][section]) : acc;
+        rounded = (shaped + 42'sd8192) >>> 14;
+        clipped = 1'b1;
+        if (rounded > 42'sd8388607)
+            section_y = 24'sh7FFFFF;
+        else if (rounded < -42'sd8388608)
+            section_y = 24'sh800000;
+        else begin
+            section_y = rounded[23:0];
+            clipped   = 1'b0;
+        end
+        section_e = clipped ? 16'sd0 : 16'((rounded <<< 14) - shaped);
+    end
+
+    assign clip = (state == DONE) && high && clipped && !skipping;
+
+    // ======================
+    // BYPASS CROSSFADE
+    // fade counts the section's passes toward FADE_FULL while it is
+    // bypassed and back toward 0 after; the endpoints give y and x exactly
+    // ======================
+    logic [FW-1:0]       fade [0:1][0:N_SECTIONS-1];
+    logic                skip;
+    logic signed [24:0]  mix_d;
+    logic signed [25+FW:0] mix_p;
+    logic signed [23:0]  mixed;
+
+    assign skip = bypass[channel][section] && (fade[channel][section] == FADE_FULL);
+
+    always_comb begin
+        mix_d = 25'(hist[channel][section][0]) - 25'(section_y);
+        mix_p = (26+FW)'(mix_d) * (26+FW)'($signed({1'b0, fade[channel][section]}));
+        mixed = 24'((26+FW)'(section_y) + (mix_p >>> FADE_LOG2));
+    end
+
+    always_ff @(posedge clk) begin
+        if (!reset) begin
+            for (int c = 0; c < 2; c++)
+                for (int k = 0; k <= N_SECTIONS; k++)
+                    for (int t = 0; t < 3; t++)
+                        hist[c][k][t] <= 24'sd0;
+            for (int c = 0; c < 2; c++)
+                for (int k = 0; k < N_SECTIONS; k++) begin
+                    err[c][k]  <= 16'sd0;
+                    fade[c][k] <= '0;
+                end
+            low_sum         <= 32'sd0;
+            section_output  <= '0;
+            filtered_output <= '0;
+            output_ready    <= 1'b0;
+            channel         <= 1'b0;
+        end else begin
+            output_ready <= l_r_edge;
+
+            if (l_r_edge) begin
+                // Publish both channels' latest passes, then shift the new
+                // sample into its own channel
+                for (int c = 0; c < 2; c++) begin
+                    for (int s = 0; s < N_SECTIONS; s++)
+                        section_output[c][s] <= hist[c][s + 1][0];
+                    filtered_output[c] <= hist[c][N_SECTIONS][0];
+                end
+
+                channel <= latest_channel;
+                hist[latest_channel][0][0] <= latest_sample;
+                hist[latest_channel][0][1] <= hist[latest_channel][0][0];
+                hist[latest_channel][0][2] <= hist[latest_channel][0][1];
+            end
+
+            // Low-byte sum waits for the high-word sequence
+            if (state == DONE && !high)
+                low_sum <= mac_result;
+
+            // Section result: becomes y[n-1] for this section and x[n] for the next
+            if (state == DONE && high) begin
+                hist[channel][section + 1][0] <= mixed;
+                hist[channel][section + 1][1] <= hist[channel][section + 1][0];
+                hist[channel][section + 1][2] <= hist[channel][section + 1][1];
+                err[channel][section]         <= skipping ? 16'sd0 : section_e;
+
+                if (bypass[channel][section] && fade[channel][section] != FADE_FULL)
+                    fade[channel][section] <= fade[channel][section] + 1'b1;
+                else if (!bypass[channel][section] && fade[channel][section] != '0)
+                    fade[channel][section] <= fade[channel][section] - 1'b1;
+            end
+        end
+    end
+
+    // ======================
+    // FSM
+    // ======================
+    assign mac_busy     = state != IDLE;
+    assign pass_channel = channel;
+
+    always_ff @(posedge clk) begin
+        if (!reset) begin
+            state    <= IDLE;
+            section  <= '0;
+            high     <= 1'b0;
+            skipping <= 1'b0;
+        end else begin
+            case (state)
+                IDLE: begin
+                    section <= '0;
+                    high    <= 1'b0;
+                    if (l_r_edge)
+                        state <= CLEAR;
+                end
+                CLEAR: begin
+                    // A fully bypassed section goes straight to its result
+                    skipping <= skip && !high;
+                    if (skip && !high) begin
+                        high  <= 1'b1;
+                        state <= DONE;
+                    end else begin
+                        state <= MULT_B0;
+                    end
+                end
+                DONE: begin
+                    high <= !high;
+                    if (!high) begin
+                        state <= CLEAR;
+                    end else if (section == SW'(N_SECTIONS - 1)) begin
+                        state <= IDLE;
+                    end else begin
+                        section <= section + 1'b1;
+                        state   <= CLEAR;
+                    end
+                end
+                default: state <= state_t'(state + 3'd1);
+            endcase
+        end
+    end
+
+    // ======================
+    // SHARED MAC
+    // ======================
+    logic signed [15:0] mac_a, mac_b;
+    logic mac_rst, mac_ce;
+
+    // MAC operand from a 24-bit history word: high word, or low byte zero extended
+    function automatic logic signed [15:0] part(input logic signed [23:0] v, input logic hi);
+        part = hi ? v[23:8] : {8'd0, v[7:0]};
+    endfunction
+
+    // Accumulator cleared before every sequence; coefficients committed by
+    // control at output_ready (the first CLEAR) are in place by MULT_B0
+    assign mac_rst = reset && (state != CLEAR);
+    assign mac_ce  = (state == MULT_B0) || (state == MULT_B1) || (state == MULT_B2) ||
+                     (state == MULT_A1) || (state == MULT_A2);
+
+    always_comb begin
+        case (state)
+            MULT_B0: begin
+                mac_a = coeffs[channel][section][0];
+                mac_b = part(hist[channel][section][0], high);
+            end
+            MULT_B1: begin
+                mac_a = coeffs[channel][section][1];
+                mac_b = part(hist[channel][section][1], high);
+            end
+            MULT_B2: begin
+                mac_a = coeffs[channel][section][2];
+                mac_b = part(hist[channel][section][2], high);
+            end
+            MULT_A1: begin
+                mac_a = -coeffs[channel][section][3];  // Negative for IIR feedback
+                mac_b = part(hist[channel][section + 1][0], high);
+            end
+            MULT_A2: begin
+                mac_a = -coeffs[channel][section][4];  // Negative for IIR feedback
+                mac_b = part(hist[channel][section + 1][1], high);
+            end
+            default: begin
+                mac_a = 16'd0;
+                mac_b = 16'd0;
+            end
+        endcase
+    end
+
+    MAC16_wrapper_accum mac_inst(
+        .clk(clk),
+        .reset(reset),
+        .mac_rst(mac_rst),
+        .ce(mac_ce),
+        .a_in(mac_a),
+        .b_in(mac_b),
+        .result(mac_result)
+    );
+
+endmodule
@@ -2,54 +2,268 @@
 Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
-Module Function: SPI receiver for 336-bit coefficient frames
-- Shifts in filter coefficients serially
-- Asserts valid pulse when complete frame received
-- Provides stable output buffer for clock domain crossing
+Module Function: SPI receiver for v2/v3/v4/v5 coefficient frames (mcu/src/coeff_frame.h)
+- Frame: header {version, band mask[2:0], kind}, sequence byte, for version 3
+  a channel mask byte (version 2 frames go to both channels), per band in the
+  mask 10 bytes (b0 b1 b2 a1 a2) for kind 0 or one gain index for kind 1,
+  CRC-16/CCITT-FALSE
+- Version 4 (wide) frames reach all N_BANDS bands: header {4, 000, 0}, sequence,
+  channel byte, 16-bit band mask (big-endian, bit b = band b), 10 bytes per band,
+  CRC. Coefficients only; bands at or past N_BANDS reject the frame
+- Version 5 (bypass) frames: header {5, 000, 0}, sequence, channel byte, 16-bit
+  bypass flags (big-endian, bit b = band b, bit 15 = every band), CRC. The flag
+  bytes leave as writes to band 15, offsets 10 and 11; flags for bands the
+  build does not have are ignored
+- No frame buffer: every payload byte leaves as one addressed write
+  {kind, channels, band, offset, byte} (wr/entry, into async_fifo) as soon as
+  it is shifted in, and control.sv writes it straight into its staging bank
+- Runs the CRC bit-serially over the whole frame; a good frame leaves 0. The
+  frame closes with an END_OK or END_BAD write (bad header, CRC, or a write
+  lost to a full FIFO) carrying the sequence number; control keeps or rolls
+  back the bands the frame wrote
+- CS high resets the framing; a short frame gets no END, spi_top sees CS and
+  has control roll it back
+- Shifts spi_top's 32-bit status word out on sdo, MSB first, from the start of
+  every transaction (mode 0: each bit is held from one falling sck edge to the
+  next). A header byte of 0x00 is a status poll: no END. Its second byte names
+  a register of spi_top's readback bank (rd_req/reg_index), shifted out as bytes
+  4-7; the rest of the poll is ignored
+- A header byte of 0x01 is a config write {0x01, register, value, ~value}:
+  cfg_req rises with the fourth byte if it is the complement of the third, and
+  spi_top writes cfg_value to reg_index. No END; a mangled write is dropped
+- sdo reads status and readback, clk_in registers, combinationally; spi_top
+  stops updating status two clk_in cycles after CS falls and loads readback
+  within three of rd_req, both long before the sck edges that read them
 */
 
-module aes_spi(
+module aes_spi #(
+    parameter int N_BANDS = 3               // 3 to 16; v2/v3 frames reach bands 0-2
+)(
     input  logic sck,
     input  logic reset_n,
     input  logic sdi,
     input  logic cs,
-    output logic [335:0] data,     // safe, stable output
-    output logic valid
+    output logic         wr,            // entry is valid this sck edge
+    output logic [19:0]  entry,         // {kind[1:0], channels[1:0], band[3:0], offset[3:0], byte[7:0]}
+    input  logic         full,          // The FIFO cannot take entry
+    input  logic [31:0]  status,        // Held while CS is low
+    output logic         rd_req,        // reg_index is valid, until CS rises
+    output logic         cfg_req,       // reg_index and cfg_value are valid, until CS rises
+    output logic [7:0]   reg_index,
+    output logic [7:0]   cfg_value,
+    input  logic [31:0]  readback,      // Register reg_index, from three clk_in after rd_req
+    output logic         sdo
 );
 
-    logic [335:0] sreg;
-    logic [8:0]   bit_count;
-	logic [335:0] next_sreg;
-    // NEW: stable, cross-domain-safe data buffer
-    logic [335:0] data_stable;
-
-always_ff @(posedge sck) begin
-    if (!reset_n) begin
-        bit_count   <= 0;
-        sreg        <= 0;
-        data_stable <= 0;
-        valid       <= 0;
-    end else if (cs) begin
-        bit_count   <= 0;
-        sreg        <= 0;
-        valid       <= 0;
-    end else begin
-        // shift in new bit
-        sreg <= {sreg[334:0], sdi};
-
-        if (bit_count == 335) begin
-            data_stable <= {sreg[334:0], sdi};  // latch full frame
-            valid       <= 1;
-            bit_count   <= 0;                     // ready for next frame
-            sreg        <= 0;                     // clear shift register
-        end else begin
+    // Entry kinds (same codes in control.sv)
+    localparam logic [1:0] WR_COEFF   = 2'd0;   // Coefficient byte: offset 0-9 = b0 high ... a2 low
+    localparam logic [1:0] WR_INDEX   = 2'd1;   // Gain index for the band
+    localparam logic [1:0] WR_END_OK  = 2'd2;   // Frame checked out; byte = sequence number
+    localparam logic [1:0] WR_END_BAD = 2'd3;   // Frame rejected; byte = sequence number
+
+    if (N_BANDS < 3 || N_BANDS > 16) begin : g_bands
+        $error("aes_spi: N_BANDS must be 3 to 16, not %0d", N_BANDS);
+    end
+
+    localparam int MAX_BYTES = 7 + 10 * N_BANDS;             // Longest v4 frame
+    localparam int CW        = $clog2(MAX_BYTES + 1);
+    localparam int BW        = $clog2(N_BANDS + 1);          // Band index, N_BANDS = none
+
+    // ======================
+    // FRAMING STATE (reset by CS high)
+    // ======================
+    logic [2:0]    bit_count;
+    logic [CW-1:0] byte_count;
+    logic [6:0]    sreg;
+    logic [15:0]   crc;
+    logic [N_BANDS-1:0] hdr_mask;
+    logic          hdr_ok;
+    logic          hdr_index;
+    logic          hdr_v3;      // Channel byte follows the sequence byte
+    logic          hdr_v4;      // ... and then the two band mask bytes
+    logic          hdr_bypass;  // v5: the two bytes after the channel byte are flags
+    logic [7:0]    mask_hi;     // v4 band mask, first byte
+    logic [1:0]    chan_stage;
+    logic [CW-1:0] frame_bytes;
+    logic [7:0]    seq_stage;
+    logic [BW-1:0] slot;        // Band being received
+    logic [3:0]    offset;      // Byte within the band
+    logic          done;
+    logic          lost;        // A payload write found the FIFO full
+    logic          hdr_poll;    // 0x00 header: a register index follows
+    logic          hdr_cfg;     // 0x01 header: register, value, ~value follow
+
+    logic [7:0]  rx_byte;
+    logic [15:0] crc_next;
+    logic        byte_done;
+    logic [15:0] wide_mask;
+
+    assign rx_byte   = {sreg, sdi};
+    assign crc_next  = {crc[14:0], 1'b0} ^ ({16{crc[15] ^ sdi}} & 16'h1021);
+    assign byte_done = (bit_count == 3'd7) && !done;
+    assign wide_mask = {mask_hi, rx_byte};
+
+    // First band in the mask at or after slot `from` (N_BANDS = none left)
+    function automatic logic [BW-1:0] next_band(input logic [N_BANDS-1:0] m, input int from);
+        next_band = BW'(N_BANDS);
+        for (int b = N_BANDS - 1; b >= 0; b--)
+            if (b >= from && m[b]) next_band = BW'(b);
+    endfunction
+
+    // Header bytes (2, 3 for v3, 5 for v4) + 10 (or 1 for gain indices) per band + 2 CRC bytes
+    function automatic logic [CW-1:0] length_for(input logic [N_BANDS-1:0] m, input logic index,
+                                                 input int hdr);
+        int bands;
+        bands = 0;
+        for (int b = 0; b < N_BANDS; b++)
+            bands += m[b];
+        length_for = CW'(hdr + 2 + (index ? bands : 10 * bands));
+    endfunction
+
+    always_ff @(posedge sck, posedge cs) begin
+        if (cs) begin
+            bit_count   <= 0;
+            byte_count  <= 0;
+            sreg        <= 0;
+            crc         <= 16'hFFFF;
+            hdr_mask    <= 0;
+            hdr_ok      <= 0;
+            hdr_index   <= 0;
+            hdr_v3      <= 0;
+            hdr_v4      <= 0;
+            hdr_bypass  <= 0;
+            mask_hi     <= 0;
+            chan_stage  <= 0;
+            frame_bytes <= 0;
+            seq_stage   <= 0;
+            slot        <= 0;
+            offset      <= 0;
+            done        <= 0;
+            lost        <= 0;
+            hdr_poll    <= 0;
+            hdr_cfg     <= 0;
+            rd_req      <= 0;
+            cfg_req     <= 0;
+            reg_index   <= 0;
+            cfg_value   <= 0;
+        end else if (!reset_n) begin
+            bit_count   <= 0;
+            byte_count  <= 0;
+            crc         <= 16'hFFFF;
+            done        <= 1;        // Ignore the rest of a frame interrupted by reset
+        end else if (!done) begin
+            sreg      <= rx_byte[6:0];
+            crc       <= crc_next;
             bit_count <= bit_count + 1;
-            valid     <= 0;
+
+            if (byte_done) begin
+                byte_count <= byte_count + 1;
+
+                if (byte_count == 0 && rx_byte == 8'h00) begin
+                    hdr_poll <= 1;  // Status poll: nothing to write
+                end else if (byte_count == 0 && rx_byte == 8'h01) begin
+                    hdr_cfg <= 1;   // Config write: nothing to write to the FIFO
+                end else if (byte_count == 1 && hdr_poll) begin
+                    reg_index <= rx_byte;
+                    rd_req    <= 1;
+                    done      <= 1;
+                end else if (hdr_cfg) begin
+                    if (byte_count == 1)
+                        reg_index <= rx_byte;
+                    else if (byte_count == 2)
+                        cfg_value <= rx_byte;
+                    else begin
+                        cfg_req <= (rx_byte == ~cfg_value);
+                        done    <= 1;
+                    end
+                end else if (byte_count == 0) begin
+                    hdr_mask    <= N_BANDS'(rx_byte[3:1]);
+                    hdr_ok      <= (rx_byte[7:4] == 4'h2) || (rx_byte[7:4] == 4'h3) ||
+                                   (rx_byte[7:4] == 4'h4 && rx_byte[3:0] == 4'h0) ||
+                                   (rx_byte[7:4] == 4'h5 && rx_byte[3:0] == 4'h0);
+                    hdr_index   <= rx_byte[0];
+                    hdr_v3      <= (rx_byte[7:4] == 4'h3) || (rx_byte[7:4] == 4'h4) ||
+                                   (rx_byte[7:4] == 4'h5);
+                    hdr_v4      <= (rx_byte[7:4] == 4'h4);
+                    hdr_bypass  <= (rx_byte[7:4] == 4'h5);
+                    chan_stage  <= 2'b11;
+                    // A v4 length is known after its mask bytes; until then the
+                    // empty-mask length keeps frame_end away from the header.
+                    // A v5 frame is always 7 bytes, its flags the payload
+                    frame_bytes <= (rx_byte[7:4] == 4'h4 || rx_byte[7:4] == 4'h5) ? CW'(7) :
+                                   length_for(N_BANDS'(rx_byte[3:1]), rx_byte[0],
+                                              (rx_byte[7:4] == 4'h3) ? 3 : 2);
+                    slot        <= next_band(N_BANDS'(rx_byte[3:1]), 0);
+                    offset      <= 0;
+                end else if (byte_count == 1) begin
+                    seq_stage <= rx_byte;
+                end else if (byte_count == 2 && hdr_v3) begin
+                    chan_stage <= rx_byte[1:0];
+                    if (rx_byte[7:2] != 0 || rx_byte[1:0] == 0)
+                        hdr_ok <= 0;    // Unknown bits or no channel at all
+                end else if (byte_count == 3 && hdr_v4) begin
+                    mask_hi <= rx_byte;
+                end else if (byte_count == 4 && hdr_v4) begin
+                    hdr_mask    <= N_BANDS'(wide_mask);
+                    frame_bytes <= length_for(N_BANDS'(wide_mask), 1'b0, 5);
+                    slot        <= next_band(N_BANDS'(wide_mask), 0);
+                    if ((wide_mask >> N_BANDS) != 0)
+                        hdr_ok <= 0;    // Names a band this build does not have
+                end else if (byte_count < frame_bytes - CW'(2)) begin
+                    if (hdr_ok && full)
+                        lost <= 1;
+                    if (hdr_index || offset == 4'd9) begin
+                        offset <= 0;
+                        slot   <= next_band(hdr_mask, int'(slot) + 1);
+                    end else begin
+                        offset <= offset + 1;
+                    end
+                end else if (byte_count == frame_bytes - CW'(1)) begin
+                    done <= 1;      // Bytes after the CRC are ignored until CS rises
+                end
+            end
         end
     end
-end
 
-assign data = data_stable;
+    // ======================
+    // STATUS AND READBACK OUT
+    // ======================
+    logic [6:0] out_count;      // Bits already shifted out, stops at 64
+
+    always_ff @(negedge sck, posedge cs) begin
+        if (cs)
+            out_count <= 0;
+        else if (!out_count[6])
+            out_count <= out_count + 1;
+    end
+
+    always_comb begin
+        if (out_count[6])
+            sdo = 1'b0;
+        else if (out_count[5])
+            sdo = readback[5'd31 - out_count[4:0]];
+        else
+            sdo = status[5'd31 - out_count[4:0]];
+    end
+
+    // ======================
+    // WRITES
+    // Payload bytes of a frame whose header checked out, then its END.
+    // ======================
+    logic frame_end, payload;
+    logic frame_good;
+    assign frame_end  = byte_done && (byte_count != 0) && (byte_count == frame_bytes - CW'(1));
+    assign payload    = byte_done && hdr_ok && (byte_count > CW'(hdr_v4 ? 4 : hdr_v3 ? 2 : 1)) &&
+                        (byte_count < frame_bytes - CW'(2));
+    assign frame_good = hdr_ok && !lost && (crc_next == 16'h0000);
 
+    always_comb begin
+        wr    = reset_n && (payload || frame_end);
+        entry = {hdr_index ? WR_INDEX : WR_COEFF, chan_stage, 4'(slot), offset, rx_byte};
+        if (hdr_bypass)
+            entry = {WR_COEFF, chan_stage, 4'hF, (byte_count == CW'(3)) ? 4'd10 : 4'd11, rx_byte};
+        if (frame_end)
+            entry = {frame_good ? WR_END_OK : WR_END_BAD, chan_stage, 8'd0, seq_stage};
+    end
 
 endmodule
@@ -3,84 +3,242 @@ Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
 Module Function: SPI top-level integration module
-- Clock domain crossing from SPI to system clock
-- Synchronizes valid signal and coefficient data
-- Interfaces with control module for safe coefficient updates
+- Clock domain crossing from SPI to system clock: aes_spi's addressed byte
+  writes cross in a 4-entry async FIFO (async_fifo.sv), one write per clk_in
+- control writes them straight into its coefficient staging banks; a frame's
+  END write keeps or rolls back the bands it wrote
+- CS is synchronized too: CS high with the FIFO drained and a frame still
+  open means the frame was cut short, and control rolls it back
+- Gain-index frames are looked up in control's coefficient ROM (gain_rom.sv)
+- v3 frames address the left or right coefficient bank; v2 frames both
+- v4 frames reach bands past the first three in N_BANDS builds
+- v5 frames set the bypass flags, committed with the coefficients
+- Every transaction shifts a status word out on sdo (MISO), MSB first:
+    byte 0  {4'h5, 3'b000, busy}: busy while a frame is open or staged bands
+            wait for a commit
+    byte 1  sequence number of the last frame made active (FF after reset)
+    byte 2  transactions ended (CS rises), mod 256, counted once their last
+            write has been handled
+    byte 3  frames rejected (bad header or CRC, lost write, cut short), mod 256
+  The word is sampled each clk_in while CS is high and held while it is low.
+  A transaction whose first byte is 0x00 only reads the status
+- The second byte of such a poll selects a 32-bit register, shifted out as
+  bytes 4-7 (mcu/src/fpga_perf.h decodes them):
+    0  {16'hE155, N_BANDS, PERF_VERSION}   4  {longest edge, latest stereo frame} clks
+    1  samples filtered                    5  frames accepted
+    2  section results saturated           6  frames rejected
+    3  {most, latest} MAC-busy clks/pass   7  commits to the active bank
+    8  ramp_shift (config register 0)
+  Counters run free and wrap; unused indices read 0
+- Config writes (0x01 header, see spi.sv) set control registers:
+    0  ramp_shift: committed coefficients walk in with a time constant of
+       about 2^ramp_shift samples; 0 (reset) makes them jump at the commit.
+       Low 4 bits; only RAMP builds ramp
+  Unknown registers are ignored
 */
 
-module spi_top(
+module spi_top #(
+    parameter int N_BANDS = 3,
+    parameter bit RAMP    = 1'b0     // Coefficient ramping in control
+)(
     input  logic clk_in,
     input  logic rst_in,
 	input logic output_ready,
     input  logic sck,
     input  logic sdi,
     input  logic cs,
-    // Low-pass filter coefficients
-    output logic signed [15:0] low_b0, low_b1, low_b2, low_a1, low_a2,
-    // Mid-pass filter coefficients
-    output logic signed [15:0] mid_b0, mid_b1, mid_b2, mid_a1, mid_a2,
-    // High-pass filter coefficients
-    output logic signed [15:0] high_b0, high_b1, high_b2, high_a1, high_a2,
-	output logic spi_valid
+    output logic sdo,
+    // Filter coefficients: [channel][band: low, mid, high, ...][b0 b1 b2 a1 a2]
+    output logic [1:0][N_BANDS-1:0][4:0][15:0] coeffs,
+    output logic [1:0][N_BANDS-1:0]        bypass,         // Bands to crossfade around, per channel
+    // Datapath counters for the readback bank (three_band_eq)
+    input  logic [31:0] perf_samples,
+    input  logic [31:0] perf_clips,
+    input  logic [31:0] perf_mac,
+    input  logic [31:0] perf_rate,
+    input  logic        pass_ch,           // Bank the cascade reads this sample
+	output logic spi_valid,        // One clk_in pulse per good frame
+	output logic spi_error         // One clk_in pulse per rejected frame
 );
 
-    logic [335:0] spi_data;
-    logic spi_valid_sync;
-    logic [335:0] data_latched;
+    localparam logic [1:0] WR_END_OK  = 2'd2;   // Entry kinds, see aes_spi
+    localparam logic [1:0] WR_END_BAD = 2'd3;
+
+    localparam logic [7:0] PERF_VERSION = 8'd1;   // Readback bank layout
+
+    logic        spi_wr, fifo_full, fifo_empty;
+    logic [19:0] spi_entry, fifo_entry;
+    logic [31:0] status, readback;
+    logic [7:0]  committed_seq;
+    logic        ctrl_busy, ctrl_rejected, ctrl_commit;
+    logic        rd_req, cfg_req;
+    logic [7:0]  reg_index, cfg_value;
+    logic [3:0]  ramp_shift;
 
     // SPI module (runs on sck domain)
-    aes_spi spi_inst (
+    aes_spi #(.N_BANDS(N_BANDS)) spi_inst (
         .sck(sck),
 		.reset_n(rst_in),
         .sdi(sdi),
         .cs(cs),
-        .data(spi_data),
-        .valid(spi_valid)
+        .wr(spi_wr),
+        .entry(spi_entry),
+        .full(fifo_full),
+        .status(status),
+        .rd_req(rd_req),
+        .cfg_req(cfg_req),
+        .reg_index(reg_index),
+        .cfg_value(cfg_value),
+        .readback(readback),
+        .sdo(sdo)
+    );
+
+    // sck -> clk_in. A write lands at most every 8 sck and is read the clk
+    // after it crosses, so the FIFO only fills if sck outruns clk_in.
+    async_fifo #(.WIDTH(20), .DEPTH_LOG2(2)) fifo_inst (
+        .wclk(sck),
+        .wrst_n(rst_in),
+        .wr(spi_wr),
+        .wdata(spi_entry),
+        .full(fifo_full),
+        .rclk(clk_in),
+        .rrst_n(rst_in),
+        .rd(!fifo_empty),
+        .rdata(fifo_entry),
+        .empty(fifo_empty)
     );
 
-    // Synchronize valid signal
-    synchronizer sync_valid (
+    assign spi_valid = !fifo_empty && (fifo_entry[19:18] == WR_END_OK);
+    assign spi_error = !fifo_empty && (fifo_entry[19:18] == WR_END_BAD);
+
+    // CS takes two clks more than the FIFO pointers to cross, so the last
+    // write of a frame is always read before CS high is seen
+    logic cs_sync, cs_d1, cs_late;
+
+    synchronizer #(.NUM_BITS(1)) sync_cs (
         .clk(clk_in),
         .reset(rst_in),
 
-        .async_input(spi_valid),
-        .sync_output(spi_valid_sync)
+        .async_input(cs),
+        .sync_output(cs_sync)
     );
 
-logic [335:0] spi_data_sync1, spi_data_sync2;
+    always_ff @(posedge clk_in) begin
+        if (!rst_in) begin
+            cs_d1   <= 1'b1;
+            cs_late <= 1'b1;
+        end else begin
+            cs_d1   <= cs_sync;
+            cs_late <= cs_d1;
+        end
+    end
 
-always_ff @(posedge clk_in) begin
-    spi_data_sync1 <= spi_data;
-    spi_data_sync2 <= spi_data_sync1;
-end
-
-always_ff @(posedge clk_in) begin
-    if (spi_valid_sync)
-        data_latched <= spi_data_sync2;
-end
-
-    // Controller instance to unpack the data
-    control ctrl_inst (
+    // Controller instance: stages the writes, commits at sample boundaries
+    control #(.N_BANDS(N_BANDS), .RAMP(RAMP)) ctrl_inst (
 		.clk(clk_in),
 		.reset(rst_in),
 		.output_ready(output_ready),
-        .data(data_latched),
-		.update_en(spi_valid_sync),
-        .low_b0(low_b0),
-        .low_b1(low_b1),
-        .low_b2(low_b2),
-        .low_a1(low_a1),
-        .low_a2(low_a2),
-        .mid_b0(mid_b0),
-        .mid_b1(mid_b1),
-        .mid_b2(mid_b2),
-        .mid_a1(mid_a1),
-        .mid_a2(mid_a2),
-        .high_b0(high_b0),
-        .high_b1(high_b1),
-        .high_b2(high_b2),
-        .high_a1(high_a1),
-        .high_a2(high_a2)
+        .wr_en(!fifo_empty),
+        .wr_kind(fifo_entry[19:18]),
+        .wr_channels(fifo_entry[17:16]),
+        .wr_band(fifo_entry[15:12]),
+        .wr_offset(fifo_entry[11:8]),
+        .wr_byte(fifo_entry[7:0]),
+        .frame_abort(cs_late && fifo_empty),
+        .ramp_shift(ramp_shift),
+        .pass_ch(pass_ch),
+        .coeffs(coeffs),
+        .bypass(bypass),
+        .committed_seq(committed_seq),
+        .busy(ctrl_busy),
+        .rejected(ctrl_rejected),
+        .commit(ctrl_commit)
+    );
+
+    // ======================
+    // STATUS WORD
+    // cs_late rises after the transaction's END has been handled, so a poll
+    // that counts the previous transaction as ended also sees its outcome.
+    // A cut-short frame rolls back the clk after the count moves; until then
+    // it is still open and the word says busy.
+    // ======================
+    logic [7:0]  trans_count;
+    logic [31:0] frames_ok, frames_rejected, commits;
+
+    always_ff @(posedge clk_in) begin
+        if (!rst_in) begin
+            trans_count     <= 8'd0;
+            frames_ok       <= 32'd0;
+            frames_rejected <= 32'd0;
+            commits         <= 32'd0;
+            status          <= 32'h0;
+        end else begin
+            if (cs_d1 && !cs_late)
+                trans_count <= trans_count + 8'd1;
+            if (spi_valid)
+                frames_ok <= frames_ok + 1;
+            if (ctrl_rejected)
+                frames_rejected <= frames_rejected + 1;
+            if (ctrl_commit)
+                commits <= commits + 1;
+            if (cs_sync)
+                status <= {4'h5, 3'b000, ctrl_busy, committed_seq, trans_count, frames_rejected[7:0]};
+        end
+    end
+
+    // ======================
+    // READBACK BANK AND CONFIG REGISTERS
+    // reg_index and cfg_value are held from before rd_req or cfg_req
+    // rises until CS does, so they cross as is once the request has
+    // come through its synchronizer
+    // ======================
+    logic rd_req_sync, rd_req_d;
+    logic cfg_req_sync, cfg_req_d;
+
+    synchronizer #(.NUM_BITS(1)) sync_rd (
+        .clk(clk_in),
+        .reset(rst_in),
+
+        .async_input(rd_req),
+        .sync_output(rd_req_sync)
     );
 
+    synchronizer #(.NUM_BITS(1)) sync_cfg (
+        .clk(clk_in),
+        .reset(rst_in),
+
+        .async_input(cfg_req),
+        .sync_output(cfg_req_sync)
+    );
+
+    always_ff @(posedge clk_in) begin
+        if (!rst_in) begin
+            rd_req_d   <= 1'b0;
+            cfg_req_d  <= 1'b0;
+            readback   <= 32'h0;
+            ramp_shift <= 4'd0;
+        end else begin
+            rd_req_d  <= rd_req_sync;
+            cfg_req_d <= cfg_req_sync;
+            if (cfg_req_sync && !cfg_req_d) begin
+                if (reg_index == 8'd0)
+                    ramp_shift <= cfg_value[3:0];
+            end
+            if (rd_req_sync && !rd_req_d) begin
+                case (reg_index)
+                    8'd0:    readback <= {16'hE155, 8'(N_BANDS), PERF_VERSION};
+                    8'd1:    readback <= perf_samples;
+                    8'd2:    readback <= perf_clips;
+                    8'd3:    readback <= perf_mac;
+                    8'd4:    readback <= perf_rate;
+                    8'd5:    readback <= frames_ok;
+                    8'd6:    readback <= frames_rejected;
+                    8'd7:    readback <= commits;
+                    8'd8:    readback <= {28'd0, ramp_shift};
+                    default: readback <= 32'h0;
+                endcase
+            end
+        end
+    end
+
 endmodule
\ No newline at end of file
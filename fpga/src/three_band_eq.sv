@@ -2,94 +2,135 @@
 Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
-Module Function: 3-band equalizer using cascaded biquad IIR filters
-- Processes audio through three sequential filter stages
+Module Function: Stereo 3-band equalizer using cascaded biquad IIR filters
+- Processes audio through three sequential filter stages on one shared MAC16
+  (iir_cascade_accum), all within the sample period: one sample of latency
+- Left and right keep separate filter state and coefficient banks
+- N_BANDS sections per channel (3: low, mid, high); the cascade has cycles for
+  up to 13, see iir_cascade_accum
 - Coefficients in Q2.14 fixed-point format
-- 16-bit signed audio samples
+- Bypassed bands are crossfaded out of the cascade and then passed through
+  bit for bit, without their MAC cycles (iir_cascade_accum)
+- 24-bit signed audio samples, rounded and saturated after every section
+- Performance counters for the SPI readback bank (spi_top.sv): samples
+  filtered, saturated section results, MAC-busy clks per pass against the
+  clks between edges (utilization), and the measured sample period
 */
 
-module three_band_eq(
+module three_band_eq #(
+    parameter int N_BANDS       = 3,
+    parameter bit NOISE_SHAPING = 1'b1
+)(
     input  logic               clk,
     input  logic               l_r_clk,
     input  logic               reset,
-    input  logic signed [15:0] audio_in,
-    
-    // Low-pass filter coefficients
-    input  logic signed [15:0] low_b0,
-    input  logic signed [15:0] low_b1,
-    input  logic signed [15:0] low_b2,
-    input  logic signed [15:0] low_a1,
-    input  logic signed [15:0] low_a2,
-    
-    // Mid-pass filter coefficients
-    input  logic signed [15:0] mid_b0,
-    input  logic signed [15:0] mid_b1,
-    input  logic signed [15:0] mid_b2,
-    input  logic signed [15:0] mid_a1,
-    input  logic signed [15:0] mid_a2,
-    
-    // High-pass filter coefficients
-    input  logic signed [15:0] high_b0,
-    input  logic signed [15:0] high_b1,
-    input  logic signed [15:0] high_b2,
-    input  logic signed [15:0] high_a1,
-    input  logic signed [15:0] high_a2,
-    
-    output logic signed [15:0] audio_out,
-    output logic               mac_a
+    input  logic signed [23:0] audio_in,
+    input  logic               audio_ch,    // Channel audio_in was captured from: 0 left, 1 right
+
+    // Filter coefficients: [channel][band: low, mid, high, ...][b0 b1 b2 a1 a2]
+    input  logic [1:0][N_BANDS-1:0][4:0][15:0] coeffs,
+    input  logic [1:0][N_BANDS-1:0]            bypass,      // [channel][band]: crossfade around it
+
+    output logic signed [23:0] audio_out_l,
+    output logic signed [23:0] audio_out_r,
+    output logic               mac_a,
+    output logic               pass_ch,     // Bank the cascade reads until the next edge
+
+    // Performance counters (free running, wrap)
+    output logic [31:0]        perf_samples,    // Samples filtered, both channels
+    output logic [31:0]        perf_clips,      // Section results saturated
+    output logic [31:0]        perf_mac,        // {most, latest} MAC-busy clks of one pass
+    output logic [31:0]        perf_rate        // {longest edge, latest stereo frame} in clks
 );
 
-    // Outputs from each cascaded filter stage
-    logic signed [15:0] low_band_out;
-    logic signed [15:0] mid_band_out;
-    logic signed [15:0] high_band_out;
+    // Outputs from each cascaded filter stage, per channel
+    logic [1:0][N_BANDS-1:0][23:0] band_out;
+    logic [1:0][23:0]      channel_out;
+
+    logic mac_busy, clip;
+
+    // Left channel's first three stages, for the testbenches
+    logic signed [23:0] low_band_out;
+    logic signed [23:0] mid_band_out;
+    logic signed [23:0] high_band_out;
 
-    // First stage: Low-pass filter
-    iir_time_mux_accum low_band_filter (
+    // All stages of both channels on one MAC16: low -> mid -> high within each sample
+    iir_cascade_accum #(.N_SECTIONS(N_BANDS), .NOISE_SHAPING(NOISE_SHAPING)) cascade (
         .clk(clk),
         .l_r_clk(l_r_clk),
         .reset(reset),
         .latest_sample(audio_in),
-        .b0(low_b0),
-        .b1(low_b1),
-        .b2(low_b2),
-        .a1(low_a1),
-        .a2(low_a2),
-        .filtered_output(low_band_out),
-        .test(mac_a)
+        .latest_channel(audio_ch),
+        .coeffs(coeffs),
+        .bypass(bypass),
+        .section_output(band_out),
+        .filtered_output(channel_out),
+        .output_ready(mac_a),
+        .mac_busy(mac_busy),
+        .pass_channel(pass_ch),
+        .clip(clip)
     );
-    
-    // Second stage: Mid-pass filter (cascaded from low-pass output)
-    iir_time_mux_accum mid_band_filter (
-        .clk(clk),
-        .l_r_clk(l_r_clk),
-        .reset(reset),
-        .latest_sample(low_band_out),
-        .b0(mid_b0),
-        .b1(mid_b1),
-        .b2(mid_b2),
-        .a1(mid_a1),
-        .a2(mid_a2),
-        .filtered_output(mid_band_out),
-        .test(mac_a)
-    );
-    
-    // Third stage: High-pass filter (cascaded from mid-pass output)
-    iir_time_mux_accum high_band_filter (
-        .clk(clk),
-        .l_r_clk(l_r_clk),
-        .reset(reset),
-        .latest_sample(mid_band_out),
-        .b0(high_b0),
-        .b1(high_b1),
-        .b2(high_b2),
-        .a1(high_a1),
-        .a2(high_a2),
-        .filtered_output(high_band_out),
-        .test(mac_a)
-    );
-    
+
+    assign low_band_out  = band_out[0][0];
+    assign mid_band_out  = band_out[0][1];
+    assign high_band_out = band_out[0][2];
+
     // Output is the final cascaded result
-    assign audio_out = high_band_out;
+    assign audio_out_l = channel_out[0];
+    assign audio_out_r = channel_out[1];
+
+    // ======================
+    // PERFORMANCE COUNTERS
+    // mac_a comes once per edge, the clk after the pass starts: the MAC-busy
+    // count between two of them is one whole pass, and the clks between them
+    // one edge period (192 at 12 MHz and 31.25 kHz, 384 per stereo frame)
+    // ======================
+    logic [15:0] busy_count, busy_last, busy_max;
+    logic [15:0] edge_count, edge_last, edge_max, frame_last;
+    logic [1:0]  edges_seen;     // The first count after reset starts mid-edge
+
+    assign perf_mac  = {busy_max, busy_last};
+    assign perf_rate = {edge_max, frame_last};
+
+    always_ff @(posedge clk) begin
+        if (!reset) begin
+            perf_samples <= '0;
+            perf_clips   <= '0;
+            busy_count   <= '0;
+            busy_last    <= '0;
+            busy_max     <= '0;
+            edge_count   <= '0;
+            edge_last    <= '0;
+            edge_max     <= '0;
+            frame_last   <= '0;
+            edges_seen   <= '0;
+        end else begin
+            if (clip)
+                perf_clips <= perf_clips + 1;
+
+            if (mac_a) begin
+                perf_samples <= perf_samples + 1;
+                busy_count   <= 16'(mac_busy);
+                edge_count   <= 16'd1;
+                if (edges_seen != 2'd3)
+                    edges_seen <= edges_seen + 1;
+                if (edges_seen != 2'd0) begin
+                    busy_last <= busy_count;
+                    edge_last <= edge_count;
+                    if (busy_count > busy_max)
+                        busy_max <= busy_count;
+                    if (edge_count > edge_max)
+                        edge_max <= edge_count;
+                end
+                if (edges_seen >= 2'd2)
+                    frame_last <= edge_count + edge_last;
+            end else begin
+                if (mac_busy && busy_count != 16'hFFFF)
+                    busy_count <= busy_count + 1;
+                if (edge_count != 16'hFFFF)
+                    edge_count <= edge_count + 1;
+            end
+        end
+    end
 
-endmodule
\ No newline at end of file
+endmodule
@@ -3,14 +3,20 @@ Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
 Module Function: Top-level three-band audio equalizer system
-- I2S audio input/output with 24-bit codec
-- SPI interface for real-time coefficient updates
-- Three cascaded biquad IIR filters with dynamic coefficients
+- I2S stereo audio input/output with 24-bit codec, 24 bits through the filters
+- SPI interface for real-time coefficient updates, linked or per channel;
+  a status word goes back on sdo (spi_top.sv) so the MCU can confirm each frame,
+  and the datapath's performance counters can be read back the same way
+- Three cascaded biquad IIR filters per channel with dynamic coefficients
+  (N_BANDS; more bands take v4 SPI frames, see spi.sv); coefficient changes
+  walk in over a time constant the MCU sets (control.sv), and flat bands can
+  be bypassed with a crossfade (v5 frames, iir_cascade_accum.sv)
 
 CREDIT: We are using lscc_i2s_codec.sv from Lattice Semiconductor as an I2S controller for our ADC & DAC. We also instantiate the MAC16 primitive for our iCE40 FPGA.
 */
 
 module top(input logic sck, sdi, cs,
+			output logic sdo,
 			input  logic reset_n_i, 
 			input  logic i2s_sd_i,
 			output logic lmmi_clk_i,    
@@ -25,7 +31,7 @@ module top(input logic sck, sdi, cs,
     logic [31:0] dac_data;
     logic        adc_valid;         
     logic        dac_request;
-    logic signed [15:0] audio_in;
+    logic signed [23:0] audio_in;
 
     HSOSC #(.CLKHF_DIV ("0b10")) hf_osc (
         .CLKHFPU(1'b1),
@@ -35,50 +41,56 @@ module top(input logic sck, sdi, cs,
 
     assign adc_test = adc_valid;
 
-    logic signed [15:0] audio_out;
-    assign dac_data = {8'b0, audio_out, 8'b0};
+    logic signed [23:0] audio_out_l, audio_out_r;
+    logic               audio_ch;
 
-    // I2S Package - handles ADC data latching
+    // I2S Package - handles ADC data latching and stereo DAC framing
     I2S_package i2s_pkg (
         .clk(lmmi_clk_i),
         .reset_n(reset_n_i),
+        .ws(i2s_ws_o),
         .adc_data(adc_data),
         .adc_valid(adc_valid),
-        .audio_in(audio_in)
+        .audio_in(audio_in),
+        .audio_ch(audio_ch),
+        .audio_out_l(audio_out_l),
+        .audio_out_r(audio_out_r),
+        .dac_request(dac_request),
+        .dac_data(dac_data)
     );
 
-    logic signed [15:0] low_b0, low_b1, low_b2, low_a1, low_a2, mid_b0, mid_b1, mid_b2, mid_a1, mid_a2, high_b0, high_b1, high_b2, high_a1, high_a2;
+    // Cascaded sections per channel. The MAC has cycles for 13, but each band
+    // costs about 660 flops (active and staged banks, SPI staging, history)
+    // plus 160 for the ramp targets, so past 5 or so the banks have to move
+    // to EBR to fit the UP5K.
+    localparam int N_BANDS = 3;
+    localparam bit RAMP    = 1'b1;     // Walk coefficient changes in (control.sv)
+
+    // [channel][band: low, mid, high][b0 b1 b2 a1 a2]
+    logic [1:0][N_BANDS-1:0][4:0][15:0] coeffs;
+    logic [1:0][N_BANDS-1:0]            bypass;     // Bands routed around the cascade
+
+    // Datapath counters, read back over SPI
+    logic [31:0] perf_samples, perf_clips, perf_mac, perf_rate;
+    logic        pass_ch;
 
-    // Three-band equalizer
-    three_band_eq filter(
+    // Three-band equalizer, both channels
+    three_band_eq #(.N_BANDS(N_BANDS)) filter(
         .clk(lmmi_clk_i),
         .l_r_clk(i2s_ws_o),
         .reset(reset_n_i),
         .audio_in(audio_in),
-        
-        // Low-pass filter coefficients
-        .low_b0(low_b0),
-        .low_b1(low_b1),
-        .low_b2(low_b2),
-        .low_a1(low_a1),
-        .low_a2(low_a2),
-        
-        // Mid-pass filter coefficients
-        .mid_b0(mid_b0),
-        .mid_b1(mid_b1),
-        .mid_b2(mid_b2),
-        .mid_a1(mid_a1),
-        .mid_a2(mid_a2),
-        
-        // High-pass filter coefficients
-        .high_b0(high_b0),
-        .high_b1(high_b1),
-        .high_b2(high_b2),
-        .high_a1(high_a1),
-        .high_a2(high_a2),
-        
-        .audio_out(audio_out),
-        .mac_a(output_ready)
+        .audio_ch(audio_ch),
+        .coeffs(coeffs),
+        .bypass(bypass),
+        .audio_out_l(audio_out_l),
+        .audio_out_r(audio_out_r),
+        .mac_a(output_ready),
+        .pass_ch(pass_ch),
+        .perf_samples(perf_samples),
+        .perf_clips(perf_clips),
+        .perf_mac(perf_mac),
+        .perf_rate(perf_rate)
     );
 
     // I2S Receiver
@@ -122,36 +134,23 @@ module top(input logic sck, sdi, cs,
     );
 
     // SPI interface for filter coefficient updates
-    spi_top dutspitop(
+    spi_top #(.N_BANDS(N_BANDS), .RAMP(RAMP)) dutspitop(
         .sck(sck),
         .sdi(sdi),
         .cs(cs),
+        .sdo(sdo),
         .clk_in(lmmi_clk_i),
         .rst_in(reset_n_i),
         .output_ready(output_ready),
-        
-        // Low-pass filter coefficients
-        .low_b0(low_b0),
-        .low_b1(low_b1),
-        .low_b2(low_b2),
-        .low_a1(low_a1),
-        .low_a2(low_a2),
-        
-        // Mid-pass filter coefficients
-        .mid_b0(mid_b0),
-        .mid_b1(mid_b1),
-        .mid_b2(mid_b2),
-        .mid_a1(mid_a1),
-        .mid_a2(mid_a2),
-        
-        // High-pass filter coefficients
-        .high_b0(high_b0),
-        .high_b1(high_b1),
-        .high_b2(high_b2),
-        .high_a1(high_a1),
-        .high_a2(high_a2),
-        
-        .spi_valid()
+        .coeffs(coeffs),
+        .bypass(bypass),
+        .perf_samples(perf_samples),
+        .perf_clips(perf_clips),
+        .perf_mac(perf_mac),
+        .perf_rate(perf_rate),
+        .pass_ch(pass_ch),
+        .spi_valid(),
+        .spi_error()
     );
 
 endmodule
\ No newline at end of file
@@ -146,8 +146,59 @@ module iir_time_mux_accum_tb;
         end
     endtask
     
+    // Timeout watchdog deadline: 100 ms, moved out by golden runs to fit their vectors
+    realtime watchdog_end = 100_000_000;
+
+    // Golden vectors from host/tools/golden_vectors.cpp (run with +golden=<prefix>)
+    localparam int GOLDEN_MAX = 65536;
+    logic [15:0] golden_coeff [0:4];
+    logic [15:0] golden_in    [0:GOLDEN_MAX-1];
+    logic [15:0] golden_out   [0:GOLDEN_MAX-1];
+
+    task run_golden_vectors(input string prefix);
+        integer i, n, errors;
+        begin
+            $readmemh({prefix, "_coeff.hex"}, golden_coeff);
+            $readmemh({prefix, "_in.hex"}, golden_in);
+            $readmemh({prefix, "_out.hex"}, golden_out);
+            n = 0;
+            while (n < GOLDEN_MAX && !$isunknown(golden_in[n])) n++;
+            $display("\n=== Golden vectors: %s (%0d samples) ===", prefix, n);
+
+            // One edge per sample, plus the reset and a margin
+            watchdog_end = $realtime + (n + 16) * (L_R_PERIOD / 2.0) + 1_000_000;
+
+            {b0, b1, b2, a1, a2} = {golden_coeff[0], golden_coeff[1], golden_coeff[2],
+                                    golden_coeff[3], golden_coeff[4]};
+            audio_in = 16'd0;
+
+            // Reset while l_r_clk is low so the first detected edge is sample 0
+            @(negedge l_r_clk);
+            reset = 0;
+            repeat(4) @(posedge clk);
+            reset = 1;
+
+            // One sample per l_r_clk edge; audio_out before edge i is the result of edge i-1
+            errors = 0;
+            for (i = 0; i <= n; i++) begin
+                @(l_r_clk);
+                if (i > 0 && audio_out !== golden_out[i-1]) begin
+                    if (errors < 10)
+                        $display("MISMATCH edge %0d: got %h expected %h", i-1, audio_out, golden_out[i-1]);
+                    errors++;
+                end
+                if (i < n) audio_in = golden_in[i];
+            end
+            $display("Golden vectors: %0d mismatches in %0d samples", errors, n);
+            if (errors != 0)
+                $fatal(1, "Golden vectors: %0d mismatches against %s", errors, prefix);
+        end
+    endtask
+
     // Main test sequence
     initial begin
+        string golden_prefix;
+
         $display("=== IIR Time-Multiplexed Filter Hardware Verification ===");
         $display("System Clock: %0.1f MHz", 1000.0/CLK_PERIOD);
         $display("Sample Rate: %0.1f kHz", SAMPLE_RATE/1000.0);
@@ -169,6 +220,11 @@ module iir_time_mux_accum_tb;
         
         // Wait for L/R clock to settle
         repeat(10) @(posedge l_r_clk);
+
+        if ($value$plusargs("golden=%s", golden_prefix)) begin
+            run_golden_vectors(golden_prefix);
+            $finish;
+        end
         
         //========================================
         // TEST 1: Unity Gain Passthrough
@@ -251,9 +307,9 @@ module iir_time_mux_accum_tb;
     
     // Timeout watchdog
     initial begin
-        #100_000_000;  // 100 ms timeout
-        $display("ERROR: Test timeout!");
-        $finish;
+        while ($realtime < watchdog_end)
+            #(watchdog_end - $realtime);
+        $fatal(1, "ERROR: Test timeout!");
     end
     
     // Optional: Dump waveforms
@@ -8,8 +8,8 @@ module three_band_eq_tb;
     logic reset;
     
     // Audio signals
-    logic signed [15:0] audio_in;
-    logic signed [15:0] audio_out;
+    logic signed [23:0] audio_in;
+    logic signed [23:0] audio_out;
     
     // Test parameters
     localparam real CLK_PERIOD = 10.0;  // 100 MHz system clock
@@ -28,29 +28,52 @@ module three_band_eq_tb;
         forever #(L_R_PERIOD/2) l_r_clk = ~l_r_clk;
     end
     
+    // Coefficients: {b0, b1, b2, a1, a2} for low, mid, high (passthrough unless loaded),
+    // the same set for both channels
+    logic signed [15:0] coeff [0:14];
+    logic [1:0][2:0][4:0][15:0] coeff_bus;
+
+    always_comb begin
+        for (int c = 0; c < 2; c++)
+            for (int b = 0; b < 3; b++)
+                for (int k = 0; k < 5; k++)
+                    coeff_bus[c][b][k] = coeff[5*b + k];
+    end
+
+    // The sample set at posedge l_r_clk is filtered as left and again, half a
+    // period later, as right; golden runs tag every edge themselves
+    logic golden_mode, golden_ch;
+    logic audio_ch;
+    assign audio_ch = golden_mode ? golden_ch : ~l_r_clk;
+
     // DUT instantiation
     three_band_eq dut (
         .clk(clk),
         .l_r_clk(l_r_clk),
         .reset(reset),
         .audio_in(audio_in),
-        .audio_out(audio_out)
+        .audio_ch(audio_ch),
+        .coeffs(coeff_bus),
+        .bypass('0),
+        .audio_out_l(audio_out),
+        .audio_out_r(),
+        .mac_a()
     );
     
-    // Function to convert real to Q2.14 fixed point
-    function signed [15:0] real_to_q2_14(real value);
+    // Function to convert real to a Q2.22 audio sample (24 bits, same scale as Q2.14 coefficients)
+    function signed [23:0] real_to_q2_22(real value);
         real scaled;
         integer temp;
-        scaled = value * (2.0 ** 14.0);
-        if (scaled > 32767.0) scaled = 32767.0;
-        if (scaled < -32768.0) scaled = -32768.0;
+        scaled = value * (2.0 ** 22.0);
+        if (scaled > 8388607.0) scaled = 8388607.0;
+        if (scaled < -8388608.0) scaled = -8388608.0;
         temp = integer'(scaled);
-        return temp[15:0];
+        return temp[23:0];
     endfunction
     
-    // Function to convert Q2.14 to real
-    function real q2_14_to_real(logic signed [15:0] value);
-        return real'(value) / (2.0 ** 14.0);
+    // Function to convert a Q2.22 audio sample to real
+    function real q2_22_to_real(logic signed [23:0] value);
+        return real'(value) / (2.0 ** 22.0);
     endfunction
     
     // Task to send a sine wave at given frequency
@@ -65,27 +88,27 @@ module three_band_eq_tb;
                 @(posedge l_r_clk);
                 time_sec = real'(i) / SAMPLE_RATE;
                 sample_value = amp * $sin(2.0 * 3.14159265359 * freq * time_sec);
-                audio_in = real_to_q2_14(sample_value);
+                audio_in = real_to_q2_22(sample_value);
                 
                 // Show output every 50 samples
                 if (i % 50 == 0) begin
                     $display("Sample %4d: In=%0.4f, Out=%0.4f, Low=%0.4f, Mid=%0.4f, High=%0.4f", 
                              i, 
-                             q2_14_to_real(audio_in), 
-                             q2_14_to_real(audio_out),
-                             q2_14_to_real(dut.low_band_out),
-                             q2_14_to_real(dut.mid_band_out),
-                             q2_14_to_real(dut.high_band_out));
+                             q2_22_to_real(audio_in), 
+                             q2_22_to_real(audio_out),
+                             q2_22_to_real(dut.low_band_out),
+                             q2_22_to_real(dut.mid_band_out),
+                             q2_22_to_real(dut.high_band_out));
                 end
             end
             
             // Show final values
             $display("Final: In=%0.4f, Out=%0.4f, Low=%0.4f, Mid=%0.4f, High=%0.4f", 
-                     q2_14_to_real(audio_in), 
-                     q2_14_to_real(audio_out),
-                     q2_14_to_real(dut.low_band_out),
-                     q2_14_to_real(dut.mid_band_out),
-                     q2_14_to_real(dut.high_band_out));
+                     q2_22_to_real(audio_in), 
+                     q2_22_to_real(audio_out),
+                     q2_22_to_real(dut.low_band_out),
+                     q2_22_to_real(dut.mid_band_out),
+                     q2_22_to_real(dut.high_band_out));
         end
     endtask
     
@@ -99,18 +122,18 @@ module three_band_eq_tb;
             for (i = 0; i < num_samples; i++) begin
                 @(posedge l_r_clk);
                 if (i == 0)
-                    audio_in = real_to_q2_14(amp);
+                    audio_in = real_to_q2_22(amp);
                 else
-                    audio_in = 16'd0;
+                    audio_in = 24'd0;
                 
                 if (i < 30 || i % 50 == 0) begin
                     $display("Sample %4d: In=%0.4f, Out=%0.4f, Low=%0.4f, Mid=%0.4f, High=%0.4f", 
                              i,
-                             q2_14_to_real(audio_in), 
-                             q2_14_to_real(audio_out),
-                             q2_14_to_real(dut.low_band_out),
-                             q2_14_to_real(dut.mid_band_out),
-                             q2_14_to_real(dut.high_band_out));
+                             q2_22_to_real(audio_in), 
+                             q2_22_to_real(audio_out),
+                             q2_22_to_real(dut.low_band_out),
+                             q2_22_to_real(dut.mid_band_out),
+                             q2_22_to_real(dut.high_band_out));
                 end
             end
         end
@@ -125,23 +148,79 @@ module three_band_eq_tb;
             
             for (i = 0; i < num_samples; i++) begin
                 @(posedge l_r_clk);
-                audio_in = real_to_q2_14(dc_value);
+                audio_in = real_to_q2_22(dc_value);
                 
                 if (i % 50 == 0) begin
                     $display("Sample %4d: In=%0.4f, Out=%0.4f, Low=%0.4f, Mid=%0.4f, High=%0.4f", 
                              i,
-                             q2_14_to_real(audio_in), 
-                             q2_14_to_real(audio_out),
-                             q2_14_to_real(dut.low_band_out),
-                             q2_14_to_real(dut.mid_band_out),
-                             q2_14_to_real(dut.high_band_out));
+                             q2_22_to_real(audio_in), 
+                             q2_22_to_real(audio_out),
+                             q2_22_to_real(dut.low_band_out),
+                             q2_22_to_real(dut.mid_band_out),
+                             q2_22_to_real(dut.high_band_out));
                 end
             end
         end
     endtask
     
+    // Timeout watchdog deadline: 200 ms, moved out by golden runs to fit their vectors
+    realtime watchdog_end = 200_000_000;
+
+    // Golden vectors from host/tools/golden_vectors.cpp --stages 3 (run with +golden=<prefix>)
+    localparam int GOLDEN_MAX = 65536;
+    logic [23:0] golden_in  [0:GOLDEN_MAX-1];   // Left, right, left, ...
+    logic [47:0] golden_out [0:GOLDEN_MAX-1];   // {audio_out_l, audio_out_r}
+
+    task run_golden_vectors(input string prefix);
+        integer i, n, errors;
+        logic [47:0] got;
+        begin
+            $readmemh({prefix, "_coeff.hex"}, coeff);
+            $readmemh({prefix, "_in.hex"}, golden_in);
+            $readmemh({prefix, "_out.hex"}, golden_out);
+            n = 0;
+            while (n < GOLDEN_MAX && !$isunknown(golden_in[n])) n++;
+            $display("\n=== Golden vectors: %s (%0d samples) ===", prefix, n);
+
+            // One edge per sample, plus the reset and a margin
+            watchdog_end = $realtime + (n + 16) * (L_R_PERIOD / 2.0) + 1_000_000;
+
+            audio_in    = 24'd0;
+            golden_ch   = 1'b0;
+            golden_mode = 1'b1;
+
+            // Reset while l_r_clk is low so the first detected edge is sample 0
+            @(negedge l_r_clk);
+            reset = 0;
+            repeat(4) @(posedge clk);
+            reset = 1;
+
+            // One sample per l_r_clk edge, channels alternating; outputs before edge i
+            // are what edge i-1 published
+            errors = 0;
+            for (i = 0; i <= n; i++) begin
+                @(l_r_clk);
+                got = {dut.audio_out_l, dut.audio_out_r};
+                if (i > 0 && got !== golden_out[i-1]) begin
+                    if (errors < 10)
+                        $display("MISMATCH edge %0d: got %h expected %h", i-1, got, golden_out[i-1]);
+                    errors++;
+                end
+                if (i < n) begin
+                    audio_in  = golden_in[i];
+                    golden_ch = i[0];
+                end
+            end
+            $display("Golden vectors: %0d mismatches in %0d samples", errors, n);
+            if (errors != 0)
+                $fatal(1, "Golden vectors: %0d mismatches against %s", errors, prefix);
+        end
+    endtask
+
     // Main test sequence
     initial begin
+        string golden_prefix;
+
         $display("=== Three-Band Equalizer Testbench ===");
         $display("System Clock: %0.1f MHz", 1000.0/CLK_PERIOD);
         $display("Sample Rate: %0.1f kHz", SAMPLE_RATE/1000.0);
@@ -152,7 +231,10 @@ module three_band_eq_tb;
         
         // Initialize
         reset = 0;
-        audio_in = 16'd0;
+        audio_in = 24'd0;
+        golden_mode = 1'b0;
+        golden_ch = 1'b0;
+        foreach (coeff[i]) coeff[i] = (i % 5 == 0) ? 16'sh4000 : 16'sh0000;
         
         // Reset pulse
         #100;
@@ -161,6 +243,11 @@ module three_band_eq_tb;
         
         // Wait for L/R clock to settle
         repeat(20) @(posedge l_r_clk);
+
+        if ($value$plusargs("golden=%s", golden_prefix)) begin
+            run_golden_vectors(golden_prefix);
+            $finish;
+        end
         
         // Test 1: Impulse response
         send_impulse(1.0, 200);
@@ -196,16 +283,16 @@ module three_band_eq_tb;
             sample_value = 0.2 * $sin(2.0 * 3.14159265359 * 100.0 * time_sec) +
                           0.2 * $sin(2.0 * 3.14159265359 * 1000.0 * time_sec) +
                           0.2 * $sin(2.0 * 3.14159265359 * 10000.0 * time_sec);
-            audio_in = real_to_q2_14(sample_value);
+            audio_in = real_to_q2_22(sample_value);
             
             if (i % 100 == 0) begin
                 $display("Sample %4d: In=%0.4f, Out=%0.4f, Low=%0.4f, Mid=%0.4f, High=%0.4f", 
                          i,
-                         q2_14_to_real(audio_in), 
-                         q2_14_to_real(audio_out),
-                         q2_14_to_real(dut.low_band_out),
-                         q2_14_to_real(dut.mid_band_out),
-                         q2_14_to_real(dut.high_band_out));
+                         q2_22_to_real(audio_in), 
+                         q2_22_to_real(audio_out),
+                         q2_22_to_real(dut.low_band_out),
+                         q2_22_to_real(dut.mid_band_out),
+                         q2_22_to_real(dut.high_band_out));
             end
         end
         
@@ -224,9 +311,9 @@ module three_band_eq_tb;
     
     // Timeout watchdog
     initial begin
-        #200_000_000;  // 200 ms timeout
-        $display("ERROR: Test timeout!");
-        $finish;
+        while ($realtime < watchdog_end)
+            #(watchdog_end - $realtime);
+        $fatal(1, "ERROR: Test timeout!");
     end
     
     // Optional: Dump waveforms
@@ -3,8 +3,20 @@ Authors: Eoin O'Connell (eoconnell@hmc.edu)
          Drake Gonzales (drgonzales@g.hmc.edu)
 Date: Dec. 4, 2025
 Module Function: Testbench for top-level equalizer system
-- Tests SPI coefficient transmission
-- Verifies unity and half-gain configurations
+- Tests SPI coefficient transmission with v2 (both channels) and v3 (one channel) frames
+- Verifies unity and half-gain configurations, a one-band delta, a
+  gain-index frame looked up in gain_rom (run with gain_rom.mem in the sim directory)
+  and a right-channel-only frame that leaves the left bank alone
+- Sends a v4 (wide) frame, and one naming a band past N_BANDS that must be dropped
+- Checks that a frame with a bad CRC and one cut short by CS leave nothing
+  behind: the next good delta frame must not commit their bytes
+- Polls the MISO status word: last committed sequence number, idle, and the
+  transaction and rejected-frame counts of the frames above
+- Reads back the performance counter bank: ID, frame counts and the sample period
+- Sets a ramp time constant with a config write and checks that the next
+  commit walks the coefficient in rather than jumping to it
+- Bypasses every band with a v5 frame: once the crossfade is done the MAC
+  skips the sections, and clearing the flags brings them back
 - Provides basic I2S input stimulus
 */
 
@@ -13,7 +25,8 @@ Module Function: Testbench for top-level equalizer system
 module top_tb();
 
     // Signals
-    logic sck, sdi, cs;
+    logic sck, sdi, cs, sdo;
+    logic [31:0] status, value;
     logic reset_n_i;
     logic i2s_sd_i;
     logic lmmi_clk_i;
@@ -21,14 +34,14 @@ module top_tb();
     logic i2s_sck_o;
     logic i2s_ws_o;
     logic adc_test;
-    logic conf_en_i;
-    logic mac_a;
+    logic output_ready;
     
     // DUT
     top dut (
         .sck(sck),
         .sdi(sdi),
         .cs(cs),
+        .sdo(sdo),
         .reset_n_i(reset_n_i),
         .i2s_sd_i(i2s_sd_i),
         .lmmi_clk_i(lmmi_clk_i),
@@ -36,8 +49,7 @@ module top_tb();
         .i2s_sck_o(i2s_sck_o),
         .i2s_ws_o(i2s_ws_o),
         .adc_test(adc_test),
-        .conf_en_i(conf_en_i),
-        .mac_a(mac_a)
+        .output_ready(output_ready)
     );
     
     // SPI clock - 1 MHz
@@ -52,21 +64,129 @@ module top_tb();
         forever #1000 i2s_sd_i = ~i2s_sd_i;
     end
     
-    // Task to send SPI data
-    task send_spi(input logic [335:0] data);
+    // CRC-16/CCITT-FALSE, one byte MSB first (mcu/src/crc16.c)
+    function automatic logic [15:0] crc16_byte(input logic [15:0] crc, input logic [7:0] b);
+        for (int i = 7; i >= 0; i--)
+            crc = {crc[14:0], 1'b0} ^ ((crc[15] ^ b[i]) ? 16'h1021 : 16'h0000);
+        return crc;
+    endfunction
+
+    // Task to send one frame (mcu/src/coeff_frame.h): header, seq, masked bands, CRC.
+    // With index set, each masked band sends only the top byte of its slot (a gain index).
+    // channels other than both ({right, left} = 2'b11) send a v3 frame with the channel byte.
+    // wide sends a v4 frame: channel byte and the full 16-bit mask (bands past 2 carry no data here).
+    // bad_crc flips the last CRC bit; cut > 0 raises CS after that many bytes.
+    task send_spi(input logic [15:0] mask, input logic [7:0] seq, input logic [239:0] coeffs,
+                  input logic index = 1'b0, input logic [1:0] channels = 2'b11,
+                  input logic wide = 1'b0, input logic bad_crc = 1'b0, input int cut = 0);
+        logic [7:0]  bytes[$];
+        logic [15:0] crc;
         begin
+            bytes = {};
+            if (wide) begin
+                bytes.push_back(8'h40);
+                bytes.push_back(seq);
+                bytes.push_back({6'd0, channels});
+                bytes.push_back(mask[15:8]);
+                bytes.push_back(mask[7:0]);
+            end else begin
+                bytes.push_back({(channels == 2'b11) ? 4'h2 : 4'h3, mask[2:0], index});
+                bytes.push_back(seq);
+                if (channels != 2'b11)
+                    bytes.push_back({6'd0, channels});
+            end
+            for (int b = 0; b < 3; b++)
+                if (mask[b])
+                    for (int k = 0; k < (index ? 1 : 10); k++)
+                        bytes.push_back(coeffs[239 - 80*b - 8*k -: 8]);
+            crc = 16'hFFFF;
+            foreach (bytes[i]) crc = crc16_byte(crc, bytes[i]);
+            bytes.push_back(crc[15:8]);
+            bytes.push_back(crc[7:0] ^ {7'd0, bad_crc});
+            if (cut > 0)
+                bytes = bytes[0:cut-1];
+
             cs = 0;
             #1000;
-            for (int i = 335; i >= 0; i--) begin
-                @(negedge sck);
-                sdi = data[i];
+            foreach (bytes[i]) begin
+                for (int j = 7; j >= 0; j--) begin
+                    @(negedge sck);
+                    sdi = bytes[i][j];
+                end
             end
             @(posedge sck);
             #1000;
             cs = 1;
         end
     endtask
+
+    // Task to poll the status word and one readback register: a 0x00 header and
+    // the register index, 64 bits read on rising sck. CS falls while sck is low,
+    // so the first edge is a rising one, as in mode 0.
+    task read_register(input logic [7:0] index, output logic [31:0] word, output logic [31:0] reg_value);
+        logic [63:0] bits;
+        logic [15:0] out;
+        begin
+            out = {8'h00, index};
+            @(negedge sck);
+            #100;
+            sdi = out[15];
+            cs = 0;
+            for (int i = 63; i >= 0; i--) begin
+                @(posedge sck);
+                bits[i] = sdo;
+                @(negedge sck);
+                sdi = (i > 48) ? out[i - 49] : 1'b0;
+            end
+            #1000;
+            cs = 1;
+            word = bits[63:32];
+            reg_value = bits[31:0];
+        end
+    endtask
     
+    // Task to write a config register: {0x01, register, value, ~value}
+    task write_config(input logic [7:0] index, input logic [7:0] v);
+        logic [31:0] out;
+        begin
+            out = {8'h01, index, v, ~v};
+            cs = 0;
+            #1000;
+            for (int i = 31; i >= 0; i--) begin
+                @(negedge sck);
+                sdi = out[i];
+            end
+            @(posedge sck);
+            #1000;
+            cs = 1;
+        end
+    endtask
+
+    // Task to send a v5 frame to both channels: bypass flags, bit b = band b, bit 15 = all
+    task send_bypass(input logic [7:0] seq, input logic [15:0] flags);
+        logic [7:0]  bytes[$];
+        logic [15:0] crc;
+        begin
+            bytes = {8'h50, seq, 8'h03, flags[15:8], flags[7:0]};
+            crc = 16'hFFFF;
+            foreach (bytes[i]) crc = crc16_byte(crc, bytes[i]);
+            bytes.push_back(crc[15:8]);
+            bytes.push_back(crc[7:0]);
+
+            cs = 0;
+            #1000;
+            foreach (bytes[i]) begin
+                for (int j = 7; j >= 0; j--) begin
+                    @(negedge sck);
+                    sdi = bytes[i][j];
+                end
+            end
+            @(posedge sck);
+            #1000;
+            cs = 1;
+        end
+    endtask
+
     // Main test
     initial begin
         // Initialize
@@ -82,8 +202,7 @@ module top_tb();
         
         // Test 1: Send unity gain coefficients
         $display("Test 1: Unity gain");
-        send_spi({
-            96'h0,
+        send_spi(3'b111, 8'd0, {
             16'h4000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // low
             16'h4000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // mid
             16'h4000, 16'h0000, 16'h0000, 16'h0000, 16'h0000   // high
@@ -92,14 +211,175 @@ module top_tb();
         
         // Test 2: Send half gain coefficients
         $display("Test 2: Half gain");
-        send_spi({
-            96'h0,
+        send_spi(3'b111, 8'd1, {
             16'h2000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // low
             16'h2000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // mid
             16'h2000, 16'h0000, 16'h0000, 16'h0000, 16'h0000   // high
         });
         #200000;
-        
+
+        // Test 3: Delta frame with only the mid band back at unity (14 bytes)
+        $display("Test 3: Mid band delta");
+        send_spi(3'b010, 8'd2, {
+            80'h0,
+            16'h4000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // mid
+            80'h0
+        });
+        #200000;
+        if (dut.coeffs[0][1][0] !== 16'sh4000 || dut.coeffs[0][0][0] !== 16'sh2000 ||
+            dut.coeffs[0][2][0] !== 16'sh2000 || dut.coeffs[1][1][0] !== 16'sh4000)
+            $display("FAIL: delta frame should change only the mid band, in both channels");
+
+        // Test 4: Gain-index frame, low band at the top index (0 dB = unity, 5 bytes)
+        $display("Test 4: Low band gain index");
+        send_spi(3'b001, 8'd3, {8'd63, 232'h0}, 1'b1);
+        #200000;
+        if (dut.coeffs[0][0][0] !== 16'sh4000 || dut.coeffs[0][0][3] !== 16'sh0000 ||
+            dut.coeffs[1][0][0] !== 16'sh4000 || dut.coeffs[0][2][0] !== 16'sh2000)
+            $display("FAIL: gain index 63 should set only the low band to unity");
+
+        // Test 5: Independent channels, right high band at quarter gain (15 bytes)
+        $display("Test 5: Right channel only");
+        send_spi(3'b100, 8'd4, {
+            160'h0,
+            16'h1000, 16'h0000, 16'h0000, 16'h0000, 16'h0000   // high
+        }, 1'b0, 2'b10);
+        #200000;
+        if (dut.coeffs[1][2][0] !== 16'sh1000 || dut.coeffs[0][2][0] !== 16'sh2000)
+            $display("FAIL: a right-channel frame should leave the left bank alone");
+
+        // Test 6: v4 frame, both channels' mid band at quarter gain (17 bytes)
+        $display("Test 6: Wide frame");
+        send_spi(16'h0002, 8'd5, {
+            80'h0,
+            16'h1000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // mid
+            80'h0
+        }, 1'b0, 2'b11, 1'b1);
+        #200000;
+        if (dut.coeffs[0][1][0] !== 16'sh1000 || dut.coeffs[1][1][0] !== 16'sh1000 ||
+            dut.coeffs[0][0][0] !== 16'sh4000)
+            $display("FAIL: a wide frame should set the mid band in both channels");
+
+        // Test 7: v4 frame naming band 3, which this three-band build does not have
+        $display("Test 7: Wide frame past N_BANDS");
+        send_spi(16'h0009, 8'd6, {
+            16'h2000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // low
+            160'h0
+        }, 1'b0, 2'b11, 1'b1);
+        #200000;
+        if (dut.coeffs[0][0][0] !== 16'sh4000)
+            $display("FAIL: a frame naming a missing band should be dropped");
+
+        // Test 8: all bands written, then a bad CRC: every byte must be rolled back
+        $display("Test 8: Bad CRC");
+        send_spi(3'b111, 8'd7, {
+            16'h0800, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // low
+            16'h0800, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // mid
+            16'h0800, 16'h0000, 16'h0000, 16'h0000, 16'h0000   // high
+        }, 1'b0, 2'b11, 1'b0, 1'b1);
+        #200000;
+
+        // Test 9: low band half sent when CS rises
+        $display("Test 9: Frame cut short");
+        send_spi(3'b001, 8'd8, {
+            16'h0400, 16'h0400, 16'h0400, 16'h0400, 16'h0400,  // low
+            160'h0
+        }, 1'b0, 2'b11, 1'b0, 1'b0, 7);
+        #200000;
+        if (dut.coeffs[0][0][0] !== 16'sh4000 || dut.coeffs[0][1][0] !== 16'sh1000 ||
+            dut.coeffs[1][2][0] !== 16'sh1000)
+            $display("FAIL: a rejected or cut-short frame should change nothing");
+
+        // Test 10: a good mid delta commits the stage; only the mid band may change
+        $display("Test 10: Delta after rejected frames");
+        send_spi(3'b010, 8'd9, {
+            80'h0,
+            16'h3000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // mid
+            80'h0
+        });
+        #200000;
+        if (dut.coeffs[0][1][0] !== 16'sh3000 || dut.coeffs[0][0][0] !== 16'sh4000 ||
+            dut.coeffs[0][0][1] !== 16'sh0000 || dut.coeffs[0][2][0] !== 16'sh2000 ||
+            dut.coeffs[1][2][0] !== 16'sh1000)
+            $display("FAIL: bytes of a rejected frame were left in the stage");
+
+        // Test 11: status after 10 transactions, 3 of them rejected (tests 7-9), seq 9 live
+        $display("Test 11: Status word");
+        read_register(8'd0, status, value);
+        if (status !== 32'h5009_0A03)
+            $display("FAIL: status %h, expected 50090a03", status);
+        if (value !== 32'hE155_0301)
+            $display("FAIL: ID register %h, expected e1550301", value);
+        #10000;
+        read_register(8'd5, status, value);
+        if (status !== 32'h5009_0B03)
+            $display("FAIL: a status poll should count as a transaction and nothing else (%h)", status);
+        if (value !== 32'd7)
+            $display("FAIL: %0d frames accepted, expected 7 (tests 1-6 and 10)", value);
+
+        // Test 12: commits, saturation and the measured sample period
+        $display("Test 12: Performance counters");
+        read_register(8'd7, status, value);
+        if (value !== 32'd7)
+            $display("FAIL: %0d commits, expected one per accepted frame", value);
+        read_register(8'd4, status, value);
+        if (value[15:0] !== 16'd384)
+            $display("FAIL: %0d clks per stereo frame, expected 384", value[15:0]);
+        read_register(8'd3, status, value);
+        if (value[15:0] == 16'd0 || value[31:16] > 16'd192)
+            $display("FAIL: MAC busy %0d (max %0d) clks per pass, expected 1 to 192",
+                     value[15:0], value[31:16]);
+        read_register(8'd1, status, value);
+        $display("  %0d samples filtered", value);
+
+        // Test 13: with ramp_shift 4 the low band walks from 0x4000 to 0x2000
+        // over about 16 samples a step; the commit itself is still confirmed at once
+        $display("Test 13: Coefficient ramp");
+        write_config(8'd0, 8'd4);
+        #10000;
+        read_register(8'd8, status, value);
+        if (value !== 32'd4)
+            $display("FAIL: ramp_shift reads %0d, expected 4", value);
+        send_spi(3'b001, 8'd10, {
+            16'h2000, 16'h0000, 16'h0000, 16'h0000, 16'h0000,  // low
+            160'h0
+        });
+        #100000;
+        read_register(8'd0, status, value);
+        if (status[23:16] !== 8'd10)
+            $display("FAIL: seq 10 should be committed (status %h)", status);
+        if (dut.coeffs[0][0][0] === 16'sh2000 || dut.coeffs[0][0][0] === 16'sh4000)
+            $display("FAIL: low b0 is %h a few samples in, expected between 4000 and 2000",
+                     dut.coeffs[0][0][0]);
+        #5000000;
+        if (dut.coeffs[0][0][0] !== 16'sh2000 || dut.coeffs[1][0][0] !== 16'sh2000)
+            $display("FAIL: low b0 settled at %h/%h, expected 2000",
+                     dut.coeffs[0][0][0], dut.coeffs[1][0][0]);
+        write_config(8'd0, 8'd0);
+
+        // Test 14: bypass every band; after the 64-sample fade a pass is only
+        // CLEAR + DONE per section, and the cascade output is its input
+        $display("Test 14: Bypass");
+        send_bypass(8'd11, 16'h8000);
+        #100000;
+        if (dut.bypass !== '1)
+            $display("FAIL: bypass flags %b, expected all set", dut.bypass);
+        #3000000;
+        read_register(8'd3, status, value);
+        if (status[23:16] !== 8'd11 || value[15:0] > 16'd8)
+            $display("FAIL: seq %0d, MAC busy %0d clks per pass with every band bypassed",
+                     status[23:16], value[15:0]);
+        @(posedge dut.filter.mac_a);
+        repeat (20) @(posedge lmmi_clk_i);
+        for (int c = 0; c < 2; c++)
+            if (dut.filter.cascade.hist[c][3][0] !== dut.filter.cascade.hist[c][0][0])
+                $display("FAIL: bypassed cascade changed a channel %0d sample", c);
+        send_bypass(8'd12, 16'h0000);
+        #3000000;
+        read_register(8'd3, status, value);
+        if (dut.bypass !== '0 || value[15:0] < 16'd40)
+            $display("FAIL: MAC busy %0d clks per pass after leaving bypass", value[15:0]);
+
         $display("Done");
         $finish;
     end
@@ -0,0 +1,160 @@
+// harness.h
+// Shared option parsing, stimulus and reporting for the Verilator drivers
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "hw_model.h"
+#include "wav_file.h"
+
+extern "C" {
+#include "calc_coefficient.h"
+}
+
+struct HarnessOptions {
+    std::string wav_in;          // stimulus file (all channels, interleaved, one per edge;
+                                 // a mono file alternates between left and right)
+    std::string wav_out;         // optional RTL output, stereo, top 16 of the 24 bits
+    size_t      samples = 48000; // noise samples when no file is given
+    size_t      limit = 0;       // cap on edges from the file (0 = whole file)
+    ThreeBandCoeffs coeffs = simpleTestFilters(0);
+    bool        quiet = false;
+};
+
+static inline void harness_usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [--wav in.wav] [--out out.wav] [--samples N] [--limit N]\n"
+            "          [--pots L,M,H | --test N | --coeffs w0,...,w14] [--quiet]\n", prog);
+    exit(2);
+}
+
+static inline HarnessOptions harness_parse(int argc, char **argv)
+{
+    HarnessOptions o;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (!strcmp(arg, "--quiet")) {
+            o.quiet = true;
+            continue;
+        }
+        if (arg[0] == '+') {
+            continue;   // leave Verilator plusargs alone
+        }
+        if (i + 1 >= argc) {
+            harness_usage(argv[0]);
+        }
+        const char *val = argv[++i];
+        if      (!strcmp(arg, "--wav"))     o.wav_in = val;
+        else if (!strcmp(arg, "--out"))     o.wav_out = val;
+        else if (!strcmp(arg, "--samples")) o.samples = strtoul(val, nullptr, 0);
+        else if (!strcmp(arg, "--limit"))   o.limit = strtoul(val, nullptr, 0);
+        else if (!strcmp(arg, "--test"))    o.coeffs = simpleTestFilters((uint8_t)atoi(val));
+        else if (!strcmp(arg, "--pots") || !strcmp(arg, "--coeffs")) {
+            std::vector<long> v;
+            for (char *s = (char *)val, *end; *s; s = (*end == ',') ? end + 1 : end) {
+                v.push_back(strtol(s, &end, 0));
+                if (end == s) harness_usage(argv[0]);
+            }
+            if (!strcmp(arg, "--pots") && v.size() == 3) {
+                calcCoeffInit();
+                o.coeffs = calcCoeffUpdate((uint16_t)v[0], (uint16_t)v[1], (uint16_t)v[2]);
+            } else if (!strcmp(arg, "--coeffs") && v.size() == 15) {
+                int16_t *w = &o.coeffs.low.b0;
+                for (int k = 0; k < 15; k++) w[k] = (int16_t)v[k];
+            } else {
+                harness_usage(argv[0]);
+            }
+        } else {
+            harness_usage(argv[0]);
+        }
+    }
+    return o;
+}
+
+/** @brief Sign-extends a 24-bit output port */
+static inline int32_t harness_s24(uint32_t v)
+{
+    return (int32_t)(v << 8) >> 8;
+}
+
+/**
+ * @brief One 24-bit sample per l_r_clk edge: the WAV file's samples whole (16-bit
+ * ones in the top bits, as a 16-bit source reaches the ADC word), or full 24-bit
+ * white noise
+ */
+static inline std::vector<int32_t> harness_stimulus(const HarnessOptions &o)
+{
+    std::vector<int32_t> v;
+    if (!o.wav_in.empty()) {
+        MappedWav w;
+        std::string err;
+        if (!w.openRead(o.wav_in, &err)) {
+            fprintf(stderr, "%s\n", err.c_str());
+            exit(1);
+        }
+        uint64_t frames = w.frames();
+        if (o.limit && frames * w.channels() > o.limit) {
+            frames = o.limit / w.channels();
+        }
+        v.resize((size_t)frames * w.channels());
+        w.readFrames(0, (size_t)frames, v.data());
+    } else {
+        uint32_t s = 0x1234567u;
+        v.resize(o.samples);
+        for (int32_t &x : v) {
+            s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+            x = (int32_t)s >> 10;   // about -12 dBFS so the shelves have headroom
+        }
+    }
+    return v;
+}
+
+static inline HwCoeffs harness_stage(const ThreeBandCoeffs &c, int stage)
+{
+    const BiquadQ14 &q = stage == 0 ? c.low : stage == 1 ? c.mid : c.high;
+    return { q.b0, q.b1, q.b2, q.a1, q.a2 };
+}
+
+/** @brief Write interleaved 24-bit RTL output (channels per frame) as 24-bit PCM when --out was given */
+static inline void harness_write(const HarnessOptions &o, const std::vector<int32_t> &out,
+                                 int channels, uint32_t rate)
+{
+    if (o.wav_out.empty()) {
+        return;
+    }
+    MappedWav w;
+    std::string err;
+    size_t frames = out.size() / channels;
+    if (!w.create(o.wav_out, (uint16_t)channels, rate, frames, &err, 24)) {
+        fprintf(stderr, "%s\n", err.c_str());
+        return;
+    }
+    w.writeFrames(0, frames, out.data());
+}
+
+/** @brief Print the throughput line and return the process exit code */
+static inline int harness_report(const char *what, size_t edges, uint64_t clocks,
+                                 double secs, size_t mismatches)
+{
+    // The board sees one l_r_clk edge every 192 clocks of the 12 MHz HSOSC
+    double edge_rate = edges / secs;
+    printf("%s: %zu edges, %llu clocks in %.2f s -> %.0f edges/s, %.2f Mclk/s (%.2fx real time)\n",
+           what, edges, (unsigned long long)clocks, secs, edge_rate, clocks / secs / 1e6,
+           edge_rate / 62500.0);
+    printf("%s: %zu mismatches against the golden model\n", what, mismatches);
+    return mismatches ? 1 : 0;
+}
+
+static inline double harness_now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif
@@ -0,0 +1,119 @@
+// sim_eq.cpp
+// Verilator driver: streams audio through three_band_eq.sv and diffs it against StereoEq
+//
+// Build and run from fpga/:
+//   gcc -c -O2 -I../mcu/src ../mcu/src/calc_coefficient.c ../mcu/src/coeff_table.c ../mcu/src/coeff_table_data.c
+//   verilator --cc --exe --build -O3 -Wno-fatal --top-module three_band_eq -Mdir obj_eq \
+//       -CFLAGS "-O2 -std=c++17 -I../../host/src -I../../mcu/src" \
+//       src/three_band_eq.sv src/iir_cascade_accum.sv src/MAC16_wrapper_accum.sv sim/MAC16.sv \
+//       verilator/sim_eq.cpp ../host/src/hw_model.cpp ../host/src/wav_file.cpp \
+//       $PWD/calc_coefficient.o $PWD/coeff_table.o $PWD/coeff_table_data.o
+//   obj_eq/Vthree_band_eq --wav song.wav --pots 1000,4095,2500
+//
+// The driver owns the clock: it toggles l_r_clk every CLOCKS_PER_EDGE system
+// clocks, presents one sample per edge on audio_in (left on even edges, right
+// on odd ones, tagged on audio_ch), and reads both outputs just before the
+// next edge, exactly as the +golden mode of three_band_eq_tb does.
+
+#include <memory>
+#include "verilated.h"
+#include "Vthree_band_eq.h"
+#include "harness.h"
+
+// 12 MHz / 62.5 kHz edges on the board; anything above the cascade's 46-cycle pass works
+#ifndef CLOCKS_PER_EDGE
+#define CLOCKS_PER_EDGE 192
+#endif
+
+// Both banks get the same set; coeffs[c][b][k] sits at bit 16 * ((c * 3 + b) * 5 + k)
+static void load_coeffs(Vthree_band_eq *m, const ThreeBandCoeffs &c)
+{
+    const int16_t *w = &c.low.b0;
+    for (int ch = 0; ch < StereoEq::kNumChannels; ch++) {
+        for (int k = 0; k < 15; k++) {
+            int bit = 16 * (ch * 15 + k);
+            uint32_t &word = m->coeffs[bit / 32];
+            word = (word & ~(0xFFFFu << (bit % 32))) | ((uint32_t)(uint16_t)w[k] << (bit % 32));
+        }
+    }
+}
+
+static void tick(Vthree_band_eq *m)
+{
+    m->clk = 1;
+    m->eval();
+    m->clk = 0;
+    m->eval();
+}
+
+int main(int argc, char **argv)
+{
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    HarnessOptions opt = harness_parse(argc, argv);
+    std::vector<int32_t> in = harness_stimulus(opt);
+    std::vector<int32_t> rtl_out;   // {L, R} after each right-channel edge
+    rtl_out.reserve(in.size() + 1);
+
+    auto m = std::make_unique<Vthree_band_eq>(ctx.get());
+    StereoEq ref;
+    ref.reset();
+    for (int c = 0; c < StereoEq::kNumChannels; c++) {
+        for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+            ref.setCoeffs(c, s, harness_stage(opt.coeffs, s));
+        }
+    }
+    load_coeffs(m.get(), opt.coeffs);
+
+    // Synchronous active-low reset with l_r_clk low, so edge 0 is the first toggle
+    m->l_r_clk = 0;
+    m->audio_in = 0;
+    m->audio_ch = 0;
+    m->reset = 0;
+    m->clk = 0;
+    for (int i = 0; i < 4; i++) tick(m.get());
+    m->reset = 1;
+    for (int i = 0; i < 4; i++) tick(m.get());
+
+    size_t mismatches = 0;
+    uint64_t clocks = 8;
+    double t0 = harness_now();
+    for (size_t i = 0; i <= in.size(); i++) {
+        if (i > 0) {
+            int32_t got[2] = { harness_s24(m->audio_out_l), harness_s24(m->audio_out_r) };
+            ref.edge(in[i - 1], (int)((i - 1) % 2));
+            for (int c = 0; c < StereoEq::kNumChannels; c++) {
+                if (got[c] != ref.output(c)) {
+                    if (mismatches < 10) {
+                        printf("MISMATCH edge %zu %s: rtl %d model %d\n", i - 1, c ? "right" : "left",
+                               got[c], ref.output(c));
+                    }
+                    mismatches++;
+                }
+            }
+            if ((i - 1) % 2 == 1) {
+                rtl_out.push_back(got[0]);
+                rtl_out.push_back(got[1]);
+            }
+        }
+        if (i == in.size()) {
+            break;
+        }
+        m->l_r_clk = !m->l_r_clk;
+        m->audio_in = (uint32_t)in[i] & 0xFFFFFF;
+        m->audio_ch = i % 2;
+        for (int c = 0; c < CLOCKS_PER_EDGE; c++) {
+            tick(m.get());
+        }
+        clocks += CLOCKS_PER_EDGE;
+        if (!opt.quiet && (i + 1) % 1000000 == 0) {
+            printf("  %zu edges\n", i + 1);
+        }
+    }
+    double secs = harness_now() - t0;
+    m->final();
+
+    // Two edges per stereo frame
+    harness_write(opt, rtl_out, 2, 31250);
+    return harness_report("three_band_eq", in.size(), clocks, secs, mismatches);
+}
@@ -0,0 +1,291 @@
+// sim_top.cpp
+// Verilator driver: full top-level run with an I2S ADC, the MCU's SPI frame and a datapath diff
+//
+// Build and run from fpga/:
+//   gcc -c -O2 -I../mcu/src ../mcu/src/calc_coefficient.c ../mcu/src/coeff_table.c ../mcu/src/coeff_table_data.c \
+//       ../mcu/src/coeff_frame.c ../mcu/src/crc16.c
+//   verilator --cc --exe --build -O3 -Wno-fatal --top-module top_sim -Mdir obj_top \
+//       -CFLAGS "-O2 -std=c++17 -I../../host/src -I../../mcu/src" \
+//       verilator/top_sim.sv src/top.sv src/I2S_package.sv src/lscc_i2s_codec.sv src/three_band_eq.sv \
+//       src/iir_cascade_accum.sv src/MAC16_wrapper_accum.sv src/spi_top.sv src/spi.sv \
+//       src/async_fifo.sv src/control.sv src/gain_rom.sv src/synchronizer.sv sim/MAC16.sv sim/HSOSC.sv \
+//       +define+GAIN_ROM_FILE=\"src/gain_rom.mem\" \
+//       verilator/sim_top.cpp ../host/src/hw_model.cpp ../host/src/wav_file.cpp \
+//       $PWD/calc_coefficient.o $PWD/coeff_table.o $PWD/coeff_table_data.o $PWD/coeff_frame.o $PWD/crc16.o
+//   obj_top/Vtop_sim --wav song.wav --pots 1000,4095,2500
+//
+// The driver plays the board around the FPGA:
+//   - ADC: shifts one 24-bit word per I2S_WS half onto i2s_sd_i, MSB first,
+//     one SCK after WS changes, as the PCM1808 does. The stimulus is interleaved:
+//     WS-low (left) halves send the even samples, WS-high (right) halves the odd ones
+//   - MCU: sends coefficient frames packed by coeffFramePack() over SPI: a full
+//     frame with a junk set, a frame with one bit flipped (must be dropped), then
+//     the wanted set as a full frame and as a one-band delta, then the high band as
+//     a gain-index frame that the FPGA looks up in gain_rom, all linked (v2). Last,
+//     a v3 frame gives the right channel alone a different low band
+//   - Checker: on every l_r_clk edge inside three_band_eq it steps StereoEq
+//     with the sample, channel and coefficients the RTL actually used, then
+//     compares both outputs. The I2S input path is checked separately by aligning
+//     each channel's captured audio_in stream with its half of the stimulus.
+
+#include <cstring>
+#include <memory>
+#include "verilated.h"
+#include "Vtop_sim.h"
+#include "harness.h"
+
+extern "C" {
+#include "coeff_frame.h"
+}
+
+#define SPI_HALF_CLOCKS  4    // sck half period in system clocks
+#define RESET_CLOCKS     16
+#define CHECK_DELAY      4    // clocks after an edge before the MULT states read coefficients
+#define MAX_ALIGN        16   // I2S input latency search window, in edges
+#define GAP_BITS         4    // CS high between frames, in bit times
+#define CS_GAP           2    // Marks a CS-high bit time in SpiMaster::bits
+#define HIGH_GAIN_INDEX  40   // Gain index sent for the high band (-3.65 dB)
+#define RIGHT_LOW_TEST   3    // simpleTestFilters() set whose low band goes to the right channel only
+
+struct SpiMaster {
+    std::vector<uint8_t> bits;
+    size_t pos = 0;
+    int phase = 0;
+
+    // Queues one coefficient frame; CS rises for a gap of GAP_BITS bit times after it
+    void load(uint8_t mask, uint8_t seq, const ThreeBandCoeffs &c, int flip_bit = -1)
+    {
+        uint8_t frame[COEFF_FRAME_MAX_BYTES];
+        push(frame, coeffFramePack(frame, mask, seq, &c), flip_bit);
+    }
+
+    // Queues one coefficient frame for the given channels only
+    void load_channels(uint8_t channels, uint8_t mask, uint8_t seq, const ThreeBandCoeffs &c)
+    {
+        uint8_t frame[COEFF_FRAME_MAX_BYTES];
+        push(frame, coeffFramePackChannels(frame, channels, COEFF_FRAME_COEFFS, mask, seq, &c, NULL), -1);
+    }
+
+    // Queues one gain-index frame
+    void load_indices(uint8_t mask, uint8_t seq, const uint8_t index[COEFF_NUM_BANDS])
+    {
+        uint8_t frame[COEFF_FRAME_MAX_BYTES];
+        push(frame, coeffFramePackIndices(frame, mask, seq, index), -1);
+    }
+
+    void push(uint8_t *frame, uint32_t n, int flip_bit)
+    {
+        if (flip_bit >= 0) {
+            frame[flip_bit / 8] ^= (uint8_t)(0x80 >> (flip_bit % 8));
+        }
+        for (uint32_t k = 0; k < n; k++) {
+            for (int i = 7; i >= 0; i--) {
+                bits.push_back((frame[k] >> i) & 1);
+            }
+        }
+        for (int i = 0; i < GAP_BITS; i++) {
+            bits.push_back(CS_GAP);
+        }
+    }
+
+    // SPI mode 0 (initSPI(7, 0, 0)): data set while sck is low, sampled on the rising edge
+    void step(Vtop_sim *m)
+    {
+        if (pos >= bits.size()) {
+            m->cs = 1;
+            m->sck = 0;
+            return;
+        }
+        bool gap = bits[pos] == CS_GAP;
+        m->cs = gap;
+        m->sdi = gap ? 0 : bits[pos];
+        m->sck = !gap && phase >= SPI_HALF_CLOCKS;
+        if (++phase == 2 * SPI_HALF_CLOCKS) {
+            phase = 0;
+            pos++;
+        }
+    }
+};
+
+struct I2sAdc {
+    const std::vector<int32_t> *stim;
+    size_t frame = 0;                   // Stereo frames started
+    bool last_sck = false, last_ws = false;
+    uint32_t shift = 0;
+    int bits_left = 0;
+
+    // Changes i2s_sd_i on falling SCK edges of the FPGA's I2S master clock
+    void step(Vtop_sim *m)
+    {
+        bool sck = m->i2s_sck_o, ws = m->i2s_ws_o;
+        if (last_sck && !sck) {
+            if (ws != last_ws) {
+                size_t next = 2 * frame + ws;   // Left (WS low) on even samples
+                int32_t s = next < stim->size() ? (*stim)[next] : 0;
+                frame += ws;
+                shift = (uint32_t)s & 0xFFFFFF;       // 24-bit word
+                bits_left = 24;
+                last_ws = ws;
+                m->i2s_sd_i = 0;
+            } else if (bits_left > 0) {
+                m->i2s_sd_i = (shift >> 23) & 1;
+                shift <<= 1;
+                bits_left--;
+            } else {
+                m->i2s_sd_i = 0;
+            }
+        }
+        last_sck = sck;
+    }
+};
+
+static HwCoeffs probed_coeffs(const Vtop_sim *m, int channel, int stage)
+{
+    int16_t w[5];
+    for (int k = 0; k < 5; k++) {
+        int idx = (channel * ThreeBandEq::kNumStages + stage) * 5 + k;
+        w[k] = (int16_t)(m->probe_coeffs[idx / 2] >> (16 * (idx % 2)));
+    }
+    return { w[0], w[1], w[2], w[3], w[4] };
+}
+
+int main(int argc, char **argv)
+{
+    auto ctx = std::make_unique<VerilatedContext>();
+    ctx->commandArgs(argc, argv);
+    HarnessOptions opt = harness_parse(argc, argv);
+    std::vector<int32_t> in = harness_stimulus(opt);
+
+    auto m = std::make_unique<Vtop_sim>(ctx.get());
+    StereoEq ref;
+    ref.reset();
+
+    SpiMaster spi;
+    I2sAdc adc;
+    adc.stim = &in;
+
+    // aes_spi resets on sck edges, so keep sck running through reset with cs high
+    m->reset_n = 0;
+    m->cs = 1;
+    m->i2s_sd_i = 0;
+    for (int i = 0; i < RESET_CLOCKS; i++) {
+        m->sck = i & 1;
+        m->sim_clk = 1;
+        m->eval();
+        m->sim_clk = 0;
+        m->eval();
+    }
+    m->sck = 0;
+    m->reset_n = 1;
+
+    // Junk first, so the checks below prove the later frames landed
+    ThreeBandCoeffs junk = simpleTestFilters(1), delta_base = opt.coeffs;
+    delta_base.mid = simpleTestFilters(4).mid;
+    spi.load(COEFF_BANDS_ALL, 0, junk);
+    spi.load(COEFF_BANDS_ALL, 1, opt.coeffs, 8 * 7 + 3);                 // Corrupt: dropped
+    spi.load(COEFF_BANDS_ALL, 2, delta_base);                            // Mid band still wrong
+    spi.load(COEFF_BAND_MASK(COEFF_BAND_MID), 3, opt.coeffs);            // One-band delta fixes it
+
+    // High band by gain index: the ROM must hold what the MCU's design code gives
+    ThreeBandCoeffs want = opt.coeffs;
+    uint8_t index[COEFF_NUM_BANDS] = { 0, 0, HIGH_GAIN_INDEX };
+    want.high = calcCoeffGainIndexDesign(COEFF_BAND_HIGH, HIGH_GAIN_INDEX);
+    spi.load_indices(COEFF_BAND_MASK(COEFF_BAND_HIGH), 4, index);
+
+    // Right channel alone: the left bank must keep the linked set
+    ThreeBandCoeffs want_right = want;
+    want_right.low = simpleTestFilters(RIGHT_LOW_TEST).low;
+    spi.load_channels(COEFF_CHANNEL_RIGHT, COEFF_BAND_MASK(COEFF_BAND_LOW), 5, want_right);
+    const ThreeBandCoeffs *want_bank[StereoEq::kNumChannels] = { &want, &want_right };
+
+    std::vector<int32_t> captured_in[StereoEq::kNumChannels], rtl_out;   // rtl_out: {L, R} per frame
+    size_t mismatches = 0, edges = 0;
+    int check_in = -1;
+    int32_t edge_sample = 0;
+    int edge_ch = 0;
+    uint64_t clocks = RESET_CLOCKS;
+    size_t edges_wanted = in.size() + MAX_ALIGN;
+
+    double t0 = harness_now();
+    while (edges < edges_wanted) {
+        spi.step(m.get());
+        adc.step(m.get());
+
+        // Sampled before the posedge: this is the clock the edge registers on
+        bool edge = m->probe_l_r_edge;
+        if (edge) {
+            edge_sample = harness_s24(m->probe_audio_in);
+            edge_ch = m->probe_audio_ch;
+            check_in = CHECK_DELAY;
+        }
+
+        m->sim_clk = 1;
+        m->eval();
+        m->sim_clk = 0;
+        m->eval();
+        clocks++;
+
+        if (check_in >= 0 && check_in-- == 0) {
+            for (int c = 0; c < StereoEq::kNumChannels; c++) {
+                for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+                    ref.setCoeffs(c, s, probed_coeffs(m.get(), c, s));
+                }
+            }
+            ref.edge(edge_sample, edge_ch);
+            int32_t got[2] = { harness_s24(m->probe_audio_out_l), harness_s24(m->probe_audio_out_r) };
+            for (int c = 0; c < StereoEq::kNumChannels; c++) {
+                if (got[c] != ref.output(c)) {
+                    if (mismatches < 10) {
+                        printf("MISMATCH edge %zu %s: rtl %d model %d\n", edges, c ? "right" : "left",
+                               got[c], ref.output(c));
+                    }
+                    mismatches++;
+                }
+            }
+            captured_in[edge_ch].push_back(edge_sample);
+            if (edge_ch == 1) {
+                rtl_out.push_back(got[0]);
+                rtl_out.push_back(got[1]);
+            }
+            edges++;
+            if (!opt.quiet && edges % 100000 == 0) {
+                printf("  %zu edges\n", edges);
+            }
+        }
+    }
+    double secs = harness_now() - t0;
+
+    // The frames must have landed: the live coefficients are the ones sent
+    for (int c = 0; c < StereoEq::kNumChannels; c++) {
+        for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+            HwCoeffs got = probed_coeffs(m.get(), c, s), want_stage = harness_stage(*want_bank[c], s);
+            if (memcmp(&got, &want_stage, sizeof got) != 0) {
+                printf("MISMATCH %s stage %d coefficients after the SPI frames\n", c ? "right" : "left", s);
+                mismatches++;
+            }
+        }
+    }
+
+    // I2S input path: per channel, find the frame latency that lines captured audio_in
+    // up with that channel's half of the stimulus
+    for (int c = 0; c < StereoEq::kNumChannels; c++) {
+        const std::vector<int32_t> &cap = captured_in[c];
+        size_t best = 0, best_lag = 0, total = (in.size() + 1 - c) / 2;
+        for (size_t lag = 0; lag < MAX_ALIGN / 2; lag++) {
+            size_t hits = 0;
+            for (size_t i = 0; 2 * i + c < in.size() && i + lag < cap.size(); i++) {
+                hits += cap[i + lag] == in[2 * i + c];
+            }
+            if (hits > best) {
+                best = hits;
+                best_lag = lag;
+            }
+        }
+        printf("I2S input path, %s: %zu/%zu samples delivered intact at %zu frames latency\n",
+               c ? "right" : "left", best, total, best_lag);
+    }
+    m->final();
+
+    harness_write(opt, rtl_out, 2, 31250);
+    return harness_report("top", edges, clocks, secs, mismatches);
+}
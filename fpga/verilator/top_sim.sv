@@ -0,0 +1,48 @@
+/*
+Authors: Eoin O'Connell (eoconnell@hmc.edu)
+         Drake Gonzales (drgonzales@g.hmc.edu)
+Date: Dec. 4, 2025
+Module Function: Verilator wrapper around top (simulation only)
+- sim_clk feeds the HSOSC model in fpga/sim/HSOSC.sv
+- Probes expose the filter's input and its channel, both outputs, the edge
+  strobe and both live coefficient banks so sim_top.cpp can diff the datapath
+  against the host golden model
+*/
+
+module top_sim(
+    input  logic sim_clk,
+    input  logic reset_n,
+    input  logic sck, sdi, cs,
+    output logic sdo,
+    input  logic i2s_sd_i,
+    output logic i2s_sd_o, i2s_sck_o, i2s_ws_o,
+    output logic               probe_l_r_edge,
+    output logic signed [23:0] probe_audio_in,
+    output logic               probe_audio_ch,
+    output logic signed [23:0] probe_audio_out_l,
+    output logic signed [23:0] probe_audio_out_r,
+    output logic [479:0]       probe_coeffs       // [channel][band][k] at 16 * ((channel * 3 + band) * 5 + k)
+);
+
+    logic lmmi_clk, adc_test, output_ready;
+
+    top dut(
+        .sck(sck), .sdi(sdi), .cs(cs), .sdo(sdo),
+        .reset_n_i(reset_n),
+        .i2s_sd_i(i2s_sd_i),
+        .lmmi_clk_i(lmmi_clk),
+        .i2s_sd_o(i2s_sd_o),
+        .i2s_sck_o(i2s_sck_o),
+        .i2s_ws_o(i2s_ws_o),
+        .adc_test(adc_test),
+        .output_ready(output_ready)
+    );
+
+    assign probe_l_r_edge    = dut.filter.cascade.l_r_edge;
+    assign probe_audio_in    = dut.audio_in;
+    assign probe_audio_ch    = dut.audio_ch;
+    assign probe_audio_out_l = dut.audio_out_l;
+    assign probe_audio_out_r = dut.audio_out_r;
+    assign probe_coeffs      = dut.coeffs;
+
+endmodule
@@ -0,0 +1,107 @@
+// hw_model.cpp
+// Bit-accurate host model of iir_time_mux_accum.sv and the stereo three_band_eq.sv (iir_cascade_accum.sv)
+
+#include "hw_model.h"
+
+// -----------------------------
+// Single Biquad Stage
+// -----------------------------
+
+void IirTimeMuxAccum::reset()
+{
+    // Coefficients are module inputs, not state, so they survive a reset
+    x0_ = x1_ = x2_ = 0;
+    y1_ = y2_ = 0;
+    acc_ = 0;
+    out_ = 0;
+}
+
+void IirTimeMuxAccum::setCoeffs(const HwCoeffs &c)
+{
+    coeffs_ = c;
+    neg_a1_ = (int16_t)(uint16_t)(0u - (uint16_t)c.a1);
+    neg_a2_ = (int16_t)(uint16_t)(0u - (uint16_t)c.a2);
+}
+
+void IirTimeMuxAccum::process(const int16_t *in, int16_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = edge(in[i]);
+    }
+}
+
+// -----------------------------
+// Three-band Cascade
+// -----------------------------
+
+void ThreeBandEq::reset()
+{
+    for (IirTimeMuxAccum &s : stages_) {
+        s.reset();
+    }
+}
+
+void ThreeBandEq::process(const int16_t *in, int16_t *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = edge(in[i]);
+    }
+}
+
+// -----------------------------
+// 24-bit Section
+// -----------------------------
+
+void CascadeSection::reset()
+{
+    x0_ = x1_ = x2_ = 0;
+    y1_ = y2_ = 0;
+    y_ = 0;
+    err_ = 0;
+    out_ = 0;
+    fade_ = 0;
+}
+
+void CascadeSection::setCoeffs(const HwCoeffs &c)
+{
+    coeffs_ = c;
+    neg_a1_ = (int16_t)(uint16_t)(0u - (uint16_t)c.a1);
+    neg_a2_ = (int16_t)(uint16_t)(0u - (uint16_t)c.a2);
+}
+
+// -----------------------------
+// N-section Cascade
+// -----------------------------
+
+void CascadeEq::reset()
+{
+    for (CascadeSection &s : stages_) {
+        s.reset();
+    }
+}
+
+void CascadeEq::setNoiseShaping(bool on)
+{
+    for (CascadeSection &s : stages_) {
+        s.setNoiseShaping(on);
+    }
+}
+
+// -----------------------------
+// Stereo Datapath
+// -----------------------------
+
+void StereoEq::reset()
+{
+    for (CascadeEq &c : channels_) {
+        c.reset();
+    }
+    out_[0] = out_[1] = 0;
+}
+
+void StereoEq::setNoiseShaping(bool on)
+{
+    for (CascadeEq &c : channels_) {
+        c.setNoiseShaping(on);
+    }
+}
@@ -0,0 +1,337 @@
+// hw_model.h
+// Bit-accurate host model of iir_time_mux_accum.sv and the stereo three_band_eq.sv (iir_cascade_accum.sv)
+
+#ifndef HW_MODEL_H
+#define HW_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// -----------------------------
+// Coefficients
+// -----------------------------
+
+// Same layout as BiquadQ14 in mcu/src/calc_coefficient.h (Q2.14, a0 = 1 implied)
+struct HwCoeffs {
+    int16_t b0;
+    int16_t b1;
+    int16_t b2;
+    int16_t a1;
+    int16_t a2;
+};
+
+// b0 = 1.0, everything else zero
+constexpr HwCoeffs kHwPassthrough = { 0x4000, 0, 0, 0, 0 };
+
+// -----------------------------
+// Single Biquad Stage
+// -----------------------------
+
+/**
+ * @brief One iir_time_mux_accum instance, stepped once per l_r_clk edge
+ *
+ * The RTL spends ~9 system clocks per edge, so as long as edges are further
+ * apart than that the whole FSM collapses to one update per edge:
+ *
+ *   - filtered_output takes mac_result_latched[29:14] from the previous pass
+ *   - x history shifts in latest_sample, y history shifts in filtered_output
+ *   - MAC16 sums b0*x[n] + b1*x[n-1] + b2*x[n-2] + (-a1)*y[n-1] + (-a2)*y[n-2]
+ *
+ * All products are 16x16 -> 32 signed and the sum wraps at 32 bits like the
+ * DSP accumulator. -a1/-a2 are negated in 16 bits, so -(-32768) stays -32768.
+ * The output slice drops bits 31:30 without saturating.
+ */
+class IirTimeMuxAccum {
+public:
+    IirTimeMuxAccum() { reset(); }
+
+    /** @brief Clear all state, as the active-low reset does */
+    void reset();
+
+    /** @brief Load new coefficients; they take effect at the next edge */
+    void setCoeffs(const HwCoeffs &c);
+    const HwCoeffs &coeffs() const { return coeffs_; }
+
+    /** @brief Current filtered_output register */
+    int16_t output() const { return out_; }
+
+    /** @brief Result of the pass started by the last edge, published at the next one */
+    int16_t pending() const { return (int16_t)(uint16_t)(acc_ >> 14); }
+
+    /**
+     * @brief Advance one l_r_clk edge
+     * @param latest_sample Value on latest_sample when the edge is detected
+     * @return filtered_output after the edge
+     */
+    int16_t edge(int16_t latest_sample)
+    {
+        out_ = (int16_t)(uint16_t)(acc_ >> 14);
+        x2_ = x1_;
+        x1_ = x0_;
+        x0_ = latest_sample;
+        y2_ = y1_;
+        y1_ = out_;
+        acc_ = mac(coeffs_.b0, x0_) + mac(coeffs_.b1, x1_) + mac(coeffs_.b2, x2_)
+             + mac(neg_a1_, y1_) + mac(neg_a2_, y2_);
+        return out_;
+    }
+
+    /** @brief Run edge() over a block; in and out may alias */
+    void process(const int16_t *in, int16_t *out, size_t n);
+
+    /** @brief One MAC16 product as it lands in the 32-bit accumulator */
+    static uint32_t mac(int16_t a, int16_t b)
+    {
+        return (uint32_t)((int32_t)a * (int32_t)b);
+    }
+
+private:
+    HwCoeffs coeffs_ = { 0, 0, 0, 0, 0 };
+    int16_t  neg_a1_ = 0, neg_a2_ = 0;
+    int16_t  x0_, x1_, x2_;
+    int16_t  y1_, y2_;
+    uint32_t acc_;             // mac_result_latched
+    int16_t  out_;             // filtered_output
+};
+
+// -----------------------------
+// Three-band Cascade
+// -----------------------------
+
+/**
+ * @brief Three IirTimeMuxAccum sections in a one-MAC cascade: the 16-bit datapath
+ *
+ * The sections run back to back after each edge, and each downstream section
+ * takes the result its upstream section computed in the same pass, so per
+ * section this is one IirTimeMuxAccum fed the upstream pending() value. All
+ * section outputs are published together at the next edge: an input sample
+ * reaches audio_out after kLatencyEdges edges. three_band_eq ran this before
+ * its 24-bit path (CascadeEq).
+ */
+class ThreeBandEq {
+public:
+    static constexpr int kNumStages = 3;
+    static constexpr int kLatencyEdges = 1;
+
+    void reset();
+    void setCoeffs(int stage, const HwCoeffs &c) { stages_[stage].setCoeffs(c); }
+    const IirTimeMuxAccum &stage(int i) const { return stages_[i]; }
+
+    /** @brief audio_out register */
+    int16_t output() const { return stages_[kNumStages - 1].output(); }
+
+    /** @brief Result of the pass started by the last edge, published at the next one */
+    int16_t pending() const { return stages_[kNumStages - 1].pending(); }
+
+    /**
+     * @brief Advance one l_r_clk edge
+     * @param audio_in Value on audio_in when the edge is detected
+     * @return audio_out after the edge
+     */
+    int16_t edge(int16_t audio_in)
+    {
+        stages_[0].edge(audio_in);
+        stages_[1].edge(stages_[0].pending());
+        return stages_[2].edge(stages_[1].pending());
+    }
+
+    /** @brief Run edge() over a block; in and out may alias */
+    void process(const int16_t *in, int16_t *out, size_t n);
+
+private:
+    IirTimeMuxAccum stages_[kNumStages];
+};
+
+// -----------------------------
+// 24-bit Section
+// -----------------------------
+
+/**
+ * @brief One section of iir_cascade_accum: 24-bit samples on the 16x16 MAC
+ *
+ * Same timing as IirTimeMuxAccum. The MAC runs the five products twice, on the
+ * low bytes of the history words (zero extended) and on their high words, and
+ * the result is
+ *
+ *   acc = hi * 2^8 + lo          hi wraps at 32 bits like the accumulator
+ *   v   = acc - e[n-1]           e = 0 without noise shaping
+ *   y   = sat24((v + 2^13) >> 14)
+ *   e[n] = y * 2^14 - v, or 0 when y saturated
+ *
+ * Bypassed, the result is crossfaded toward the section input over
+ * kFadeSamples passes, y + ((x - y) * f >> kFadeLog2), and once f reaches
+ * kFadeSamples the section passes x through and clears e.
+ */
+class CascadeSection {
+public:
+    static constexpr int32_t kMax = (1 << 23) - 1;
+    static constexpr int32_t kMin = -(1 << 23);
+    static constexpr int     kFadeLog2 = 6;                 // FADE_LOG2
+    static constexpr int     kFadeSamples = 1 << kFadeLog2;
+
+    CascadeSection() { reset(); }
+
+    void reset();
+    void setCoeffs(const HwCoeffs &c);
+    const HwCoeffs &coeffs() const { return coeffs_; }
+    void setNoiseShaping(bool on) { shape_ = on; }
+
+    /** @brief bypass[c][s]: takes effect at the next edge, crossfaded */
+    void setBypass(bool on) { bypass_ = on; }
+    bool bypass() const { return bypass_; }
+
+    /** @brief Crossfade position: 0 filtering, kFadeSamples passing x through */
+    int fade() const { return fade_; }
+
+    /** @brief Output published at the last edge */
+    int32_t output() const { return out_; }
+
+    /** @brief Result of the pass started by the last edge, published at the next one */
+    int32_t pending() const { return y_; }
+
+    /** @brief Advance one l_r_clk edge; returns output() after it */
+    int32_t edge(int32_t latest_sample)
+    {
+        out_ = y_;
+        x2_ = x1_;
+        x1_ = x0_;
+        x0_ = latest_sample;
+        y2_ = y1_;
+        y1_ = out_;
+
+        const int16_t k[5] = { coeffs_.b0, coeffs_.b1, coeffs_.b2, neg_a1_, neg_a2_ };
+        const int32_t h[5] = { x0_, x1_, x2_, y1_, y2_ };
+        uint32_t lo = 0, hi = 0;
+        for (int i = 0; i < 5; i++) {
+            lo += IirTimeMuxAccum::mac(k[i], (int16_t)(h[i] & 0xFF));
+            hi += IirTimeMuxAccum::mac(k[i], (int16_t)(h[i] >> 8));
+        }
+        int64_t v = (int64_t)(int32_t)hi * 256 + (int32_t)lo - (shape_ ? err_ : 0);
+        int64_t r = (v + 8192) >> 14;
+        int32_t y;
+        if (r > kMax || r < kMin) {
+            y = r > kMax ? kMax : kMin;
+            err_ = 0;
+        } else {
+            y = (int32_t)r;
+            err_ = (int32_t)(r * 16384 - v);
+        }
+
+        y_ = y + (int32_t)(((int64_t)x0_ - y) * fade_ >> kFadeLog2);
+        if (bypass_ && fade_ == kFadeSamples) {
+            err_ = 0;       // Skipped: no MAC sequences ran
+        }
+        if (bypass_ && fade_ < kFadeSamples) {
+            fade_++;
+        } else if (!bypass_ && fade_ > 0) {
+            fade_--;
+        }
+        return out_;
+    }
+
+private:
+    HwCoeffs coeffs_ = { 0, 0, 0, 0, 0 };
+    int16_t  neg_a1_ = 0, neg_a2_ = 0;
+    bool     shape_ = true;     // NOISE_SHAPING
+    bool     bypass_ = false;
+    int      fade_;
+    int32_t  x0_, x1_, x2_;
+    int32_t  y1_, y2_;
+    int32_t  y_;                // Section result (hist node s + 1, word 0)
+    int32_t  err_;              // e[n-1]
+    int32_t  out_;              // section_output
+};
+
+// -----------------------------
+// N-section Cascade
+// -----------------------------
+
+/**
+ * @brief One channel of iir_cascade_accum #(N_SECTIONS): 24-bit sections, any count
+ *
+ * Chained like ThreeBandEq, with the same one-edge latency; the count is
+ * fixed at construction.
+ */
+class CascadeEq {
+public:
+    static constexpr int kMaxStages = 16;   // What a v4 coefficient frame can address
+
+    explicit CascadeEq(int stages = ThreeBandEq::kNumStages) : n_(stages) {}
+
+    int numStages() const { return n_; }
+    void reset();
+    void setCoeffs(int stage, const HwCoeffs &c) { stages_[stage].setCoeffs(c); }
+    void setBypass(int stage, bool on) { stages_[stage].setBypass(on); }
+    const CascadeSection &stage(int i) const { return stages_[i]; }
+
+    /** @brief NOISE_SHAPING of the build (on by default) */
+    void setNoiseShaping(bool on);
+
+    /** @brief audio_out register */
+    int32_t output() const { return stages_[n_ - 1].output(); }
+
+    /** @brief Result of the pass started by the last edge, published at the next one */
+    int32_t pending() const { return stages_[n_ - 1].pending(); }
+
+    /** @brief Advance one l_r_clk edge; returns audio_out after it */
+    int32_t edge(int32_t audio_in)
+    {
+        stages_[0].edge(audio_in);
+        for (int s = 1; s < n_; s++) {
+            stages_[s].edge(stages_[s - 1].pending());
+        }
+        return stages_[n_ - 1].output();
+    }
+
+private:
+    int            n_;
+    CascadeSection stages_[kMaxStages];
+};
+
+// -----------------------------
+// Stereo Datapath
+// -----------------------------
+
+/**
+ * @brief three_band_eq as built: one CascadeEq of filter state and coefficients per channel
+ *
+ * Each edge brings one sample tagged with its channel (I2S_package) and runs
+ * one pass on that channel only. Both channels are published at every edge, so
+ * a channel's output changes at the edge after its pass: kLatencyEdges of that
+ * channel's own samples, as in the mono cascade.
+ */
+class StereoEq {
+public:
+    static constexpr int kNumChannels = 2;
+
+    /** @param stages N_BANDS of the build */
+    explicit StereoEq(int stages = ThreeBandEq::kNumStages) : channels_{ CascadeEq(stages), CascadeEq(stages) } {}
+
+    void reset();
+    void setCoeffs(int channel, int stage, const HwCoeffs &c) { channels_[channel].setCoeffs(stage, c); }
+    void setBypass(int channel, int stage, bool on) { channels_[channel].setBypass(stage, on); }
+    const CascadeEq &channel(int c) const { return channels_[c]; }
+    void setNoiseShaping(bool on);
+
+    /** @brief audio_out_l (0) / audio_out_r (1) registers, 24-bit */
+    int32_t output(int c) const { return out_[c]; }
+
+    /**
+     * @brief Advance one l_r_clk edge
+     * @param audio_in Value on audio_in when the edge is detected, 24-bit
+     * @param channel  Value on audio_ch: 0 left, 1 right
+     */
+    void edge(int32_t audio_in, int channel)
+    {
+        for (int c = 0; c < kNumChannels; c++) {
+            out_[c] = channels_[c].pending();
+        }
+        channels_[channel].edge(audio_in);
+    }
+
+private:
+    CascadeEq   channels_[kNumChannels];
+    int32_t     out_[kNumChannels] = {};
+};
+
+#endif
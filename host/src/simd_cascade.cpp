@@ -0,0 +1,402 @@
+// simd_cascade.cpp
+// Batched three-band biquad cascade: one SIMD lane per independent stream
+
+#include "simd_cascade.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// Bytes of input rows per pass over the stream groups. Each group walks the
+// block row by row at a stride of streams * 4 bytes, so the block has to stay
+// resident in L1 or the strided reads miss on every row.
+#ifndef BLOCK_BYTES
+#define BLOCK_BYTES (16 * 1024)
+#endif
+#define BLOCK_MIN_FRAMES 16
+
+// -----------------------------
+// Lane Types
+// -----------------------------
+
+// Each lane type exposes the handful of operations the kernels need on W
+// adjacent streams. Scalar versions handle the tail and non-SIMD builds.
+
+struct FixScalar {
+    typedef int32_t T;
+    static const int W = 1;
+    static T load(const int32_t *p) { return *p; }
+    static void store(int32_t *p, T v) { *p = v; }
+    static T set(int32_t v) { return v; }
+    static T mul(T a, T b) { return (int32_t)((uint32_t)a * (uint32_t)b); }
+    static T add(T a, T b) { return (int32_t)((uint32_t)a + (uint32_t)b); }
+    static T sub(T a, T b) { return (int32_t)((uint32_t)a - (uint32_t)b); }
+    static T band(T a, T b) { return a & b; }
+    template <int N> static T shl(T v) { return (int32_t)((uint32_t)v << N); }
+    template <int N> static T sar(T v) { return v >> N; }
+    static T min(T a, T b) { return a < b ? a : b; }
+    static T max(T a, T b) { return a > b ? a : b; }
+    static T eq(T a, T b) { return a == b ? -1 : 0; }
+};
+
+struct FltScalar {
+    typedef float T;
+    static const int W = 1;
+    static T load(const float *p) { return *p; }
+    static void store(float *p, T v) { *p = v; }
+    static T loadSamples(const int32_t *p) { return (float)*p; }
+    static void storeSamples(int32_t *p, T v)
+    {
+        float r = std::nearbyint(v);
+        *p = (int32_t)std::min(std::max(r, (float)CascadeSection::kMin), (float)CascadeSection::kMax);
+    }
+    static T loadSamples(const float *p) { return *p; }
+    static void storeSamples(float *p, T v) { *p = v; }
+    static T mul(T a, T b) { return a * b; }
+    static T add(T a, T b) { return a + b; }
+    static T sub(T a, T b) { return a - b; }
+};
+
+#if defined(__AVX2__)
+
+struct FixVec {
+    typedef __m256i T;
+    static const int W = 8;
+    static T load(const int32_t *p) { return _mm256_loadu_si256((const __m256i *)p); }
+    static void store(int32_t *p, T v) { _mm256_storeu_si256((__m256i *)p, v); }
+    static T set(int32_t v) { return _mm256_set1_epi32(v); }
+    static T mul(T a, T b) { return _mm256_mullo_epi32(a, b); }
+    static T add(T a, T b) { return _mm256_add_epi32(a, b); }
+    static T sub(T a, T b) { return _mm256_sub_epi32(a, b); }
+    static T band(T a, T b) { return _mm256_and_si256(a, b); }
+    template <int N> static T shl(T v) { return _mm256_slli_epi32(v, N); }
+    template <int N> static T sar(T v) { return _mm256_srai_epi32(v, N); }
+    static T min(T a, T b) { return _mm256_min_epi32(a, b); }
+    static T max(T a, T b) { return _mm256_max_epi32(a, b); }
+    static T eq(T a, T b) { return _mm256_cmpeq_epi32(a, b); }
+};
+
+struct FltVec {
+    typedef __m256 T;
+    static const int W = 8;
+    static T load(const float *p) { return _mm256_loadu_ps(p); }
+    static void store(float *p, T v) { _mm256_storeu_ps(p, v); }
+    static T loadSamples(const int32_t *p) { return _mm256_cvtepi32_ps(FixVec::load(p)); }
+    static void storeSamples(int32_t *p, T v)
+    {
+        v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps((float)CascadeSection::kMin)),
+                          _mm256_set1_ps((float)CascadeSection::kMax));
+        FixVec::store(p, _mm256_cvtps_epi32(v));
+    }
+    static T loadSamples(const float *p) { return _mm256_loadu_ps(p); }
+    static void storeSamples(float *p, T v) { _mm256_storeu_ps(p, v); }
+    static T mul(T a, T b) { return _mm256_mul_ps(a, b); }
+    static T add(T a, T b) { return _mm256_add_ps(a, b); }
+    static T sub(T a, T b) { return _mm256_sub_ps(a, b); }
+};
+
+#elif defined(__SSE4_1__)
+
+struct FixVec {
+    typedef __m128i T;
+    static const int W = 4;
+    static T load(const int32_t *p) { return _mm_loadu_si128((const __m128i *)p); }
+    static void store(int32_t *p, T v) { _mm_storeu_si128((__m128i *)p, v); }
+    static T set(int32_t v) { return _mm_set1_epi32(v); }
+    static T mul(T a, T b) { return _mm_mullo_epi32(a, b); }
+    static T add(T a, T b) { return _mm_add_epi32(a, b); }
+    static T sub(T a, T b) { return _mm_sub_epi32(a, b); }
+    static T band(T a, T b) { return _mm_and_si128(a, b); }
+    template <int N> static T shl(T v) { return _mm_slli_epi32(v, N); }
+    template <int N> static T sar(T v) { return _mm_srai_epi32(v, N); }
+    static T min(T a, T b) { return _mm_min_epi32(a, b); }
+    static T max(T a, T b) { return _mm_max_epi32(a, b); }
+    static T eq(T a, T b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+struct FltVec {
+    typedef __m128 T;
+    static const int W = 4;
+    static T load(const float *p) { return _mm_loadu_ps(p); }
+    static void store(float *p, T v) { _mm_storeu_ps(p, v); }
+    static T loadSamples(const int32_t *p) { return _mm_cvtepi32_ps(FixVec::load(p)); }
+    static void storeSamples(int32_t *p, T v)
+    {
+        v = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps((float)CascadeSection::kMin)),
+                       _mm_set1_ps((float)CascadeSection::kMax));
+        FixVec::store(p, _mm_cvtps_epi32(v));
+    }
+    static T loadSamples(const float *p) { return _mm_loadu_ps(p); }
+    static void storeSamples(float *p, T v) { _mm_storeu_ps(p, v); }
+    static T mul(T a, T b) { return _mm_mul_ps(a, b); }
+    static T add(T a, T b) { return _mm_add_ps(a, b); }
+    static T sub(T a, T b) { return _mm_sub_ps(a, b); }
+};
+
+#else
+
+typedef FixScalar FixVec;
+typedef FltScalar FltVec;
+
+#endif
+
+
+// -----------------------------
+// Kernels
+// -----------------------------
+
+/**
+ * @brief Fixed-point cascade for streams [lane, lane + V::W) over frames [0, n)
+ *
+ * Same per-edge update as CascadeSection::edge(), with each downstream stage
+ * fed the result the upstream stage computed on this edge (CascadeEq::edge).
+ * The model forms v = hi * 2^8 + lo - e in 64 bits; here hi is split into
+ * 64 * (hi >> 6) + (hi & 63), so
+ *
+ *   (v + 2^13) >> 14 = (hi >> 6) + (((hi & 63) << 8) + lo - e + 2^13) >> 14
+ *
+ * and every term fits a 32-bit lane. e[n] = y * 2^14 - v is small, so it
+ * comes out exact from wrapping 32-bit arithmetic.
+ */
+template <class V>
+static void fixed_kernel(int32_t *state, size_t stride, size_t lane, bool shape,
+                         const int32_t *in, int32_t *out, size_t n, size_t streams)
+{
+    typedef typename V::T T;
+    const int S = SimdCascade::kNumStages;
+    T x0[S], x1[S], x2[S], y1[S], y2[S], y[S], err[S];
+    T b0[S], b1[S], b2[S], na1[S], na2[S];
+    const T bytes = V::set(0xFF), rem = V::set(63), half = V::set(1 << 13);
+    const T hi_lim = V::set(CascadeSection::kMax), lo_lim = V::set(CascadeSection::kMin);
+    const T shape_mask = V::set(shape ? -1 : 0);
+
+    for (int s = 0; s < S; s++) {
+        int32_t *p = state + (size_t)s * SimdCascade::FX_SLOTS * stride + lane;
+        x0[s]  = V::load(p + SimdCascade::FX_X0 * stride);
+        x1[s]  = V::load(p + SimdCascade::FX_X1 * stride);
+        x2[s]  = V::load(p + SimdCascade::FX_X2 * stride);
+        y1[s]  = V::load(p + SimdCascade::FX_Y1 * stride);
+        y2[s]  = V::load(p + SimdCascade::FX_Y2 * stride);
+        y[s]   = V::load(p + SimdCascade::FX_Y * stride);
+        err[s] = V::load(p + SimdCascade::FX_ERR * stride);
+        b0[s]  = V::load(p + SimdCascade::FX_B0 * stride);
+        b1[s]  = V::load(p + SimdCascade::FX_B1 * stride);
+        b2[s]  = V::load(p + SimdCascade::FX_B2 * stride);
+        na1[s] = V::load(p + SimdCascade::FX_NA1 * stride);
+        na2[s] = V::load(p + SimdCascade::FX_NA2 * stride);
+    }
+
+    for (size_t t = 0; t < n; t++) {
+        // audio_in is 24 bits wide
+        T sample = V::template sar<8>(V::template shl<8>(V::load(in + t * streams + lane)));
+        for (int s = 0; s < S; s++) {
+            x2[s] = x1[s];
+            x1[s] = x0[s];
+            x0[s] = sample;
+            y2[s] = y1[s];
+            y1[s] = y[s];
+
+            // Pass 1: low bytes, zero extended. Pass 2: high words.
+            T lo = V::add(V::add(V::add(V::mul(b0[s], V::band(x0[s], bytes)),
+                                        V::mul(b1[s], V::band(x1[s], bytes))),
+                                 V::add(V::mul(b2[s], V::band(x2[s], bytes)),
+                                        V::mul(na1[s], V::band(y1[s], bytes)))),
+                          V::mul(na2[s], V::band(y2[s], bytes)));
+            T hi = V::add(V::add(V::add(V::mul(b0[s], V::template sar<8>(x0[s])),
+                                        V::mul(b1[s], V::template sar<8>(x1[s]))),
+                                 V::add(V::mul(b2[s], V::template sar<8>(x2[s])),
+                                        V::mul(na1[s], V::template sar<8>(y1[s])))),
+                          V::mul(na2[s], V::template sar<8>(y2[s])));
+
+            T lo_v = V::sub(lo, V::band(err[s], shape_mask));
+            T r = V::add(V::template sar<6>(hi),
+                         V::template sar<14>(V::add(V::add(V::template shl<8>(V::band(hi, rem)), lo_v), half)));
+            y[s] = V::min(V::max(r, lo_lim), hi_lim);
+
+            // e[n] = y * 2^14 - v, cleared when y saturated
+            T e = V::sub(V::sub(V::template shl<14>(y[s]), V::template shl<8>(hi)), lo_v);
+            err[s] = V::band(e, V::eq(y[s], r));
+
+            sample = y[s];   // pending(): the next stage's input this edge
+        }
+        V::store(out + t * streams + lane, y1[S - 1]);
+    }
+
+    for (int s = 0; s < S; s++) {
+        int32_t *p = state + (size_t)s * SimdCascade::FX_SLOTS * stride + lane;
+        V::store(p + SimdCascade::FX_X0 * stride, x0[s]);
+        V::store(p + SimdCascade::FX_X1 * stride, x1[s]);
+        V::store(p + SimdCascade::FX_X2 * stride, x2[s]);
+        V::store(p + SimdCascade::FX_Y1 * stride, y1[s]);
+        V::store(p + SimdCascade::FX_Y2 * stride, y2[s]);
+        V::store(p + SimdCascade::FX_Y * stride, y[s]);
+        V::store(p + SimdCascade::FX_ERR * stride, err[s]);
+    }
+}
+
+/**
+ * @brief Float cascade (direct form I per stage) for streams [lane, lane + V::W)
+ */
+template <class V, class Sample>
+static void float_kernel(float *state, size_t stride, size_t lane,
+                         const Sample *in, Sample *out, size_t n, size_t streams)
+{
+    typedef typename V::T T;
+    const int S = SimdCascade::kNumStages;
+    T x1[S], x2[S], y1[S], y2[S];
+    T b0[S], b1[S], b2[S], a1[S], a2[S];
+
+    for (int s = 0; s < S; s++) {
+        float *p = state + (size_t)s * SimdCascade::FL_SLOTS * stride + lane;
+        x1[s] = V::load(p + SimdCascade::FL_X1 * stride);
+        x2[s] = V::load(p + SimdCascade::FL_X2 * stride);
+        y1[s] = V::load(p + SimdCascade::FL_Y1 * stride);
+        y2[s] = V::load(p + SimdCascade::FL_Y2 * stride);
+        b0[s] = V::load(p + SimdCascade::FL_B0 * stride);
+        b1[s] = V::load(p + SimdCascade::FL_B1 * stride);
+        b2[s] = V::load(p + SimdCascade::FL_B2 * stride);
+        a1[s] = V::load(p + SimdCascade::FL_A1 * stride);
+        a2[s] = V::load(p + SimdCascade::FL_A2 * stride);
+    }
+
+    for (size_t t = 0; t < n; t++) {
+        T x = V::loadSamples(in + t * streams + lane);
+        for (int s = 0; s < S; s++) {
+            T y = V::sub(V::add(V::add(V::mul(b0[s], x), V::mul(b1[s], x1[s])), V::mul(b2[s], x2[s])),
+                         V::add(V::mul(a1[s], y1[s]), V::mul(a2[s], y2[s])));
+            x2[s] = x1[s];
+            x1[s] = x;
+            y2[s] = y1[s];
+            y1[s] = y;
+            x = y;
+        }
+        V::storeSamples(out + t * streams + lane, x);
+    }
+
+    for (int s = 0; s < S; s++) {
+        float *p = state + (size_t)s * SimdCascade::FL_SLOTS * stride + lane;
+        V::store(p + SimdCascade::FL_X1 * stride, x1[s]);
+        V::store(p + SimdCascade::FL_X2 * stride, x2[s]);
+        V::store(p + SimdCascade::FL_Y1 * stride, y1[s]);
+        V::store(p + SimdCascade::FL_Y2 * stride, y2[s]);
+    }
+}
+
+// -----------------------------
+// Engine
+// -----------------------------
+
+static size_t block_frames(size_t row_bytes)
+{
+    size_t n = BLOCK_BYTES / row_bytes;
+    return n < BLOCK_MIN_FRAMES ? BLOCK_MIN_FRAMES : n;
+}
+
+SimdCascade::SimdCascade(size_t streams, CascadeMode mode)
+    : streams_(streams), mode_(mode)
+{
+    if (mode_ == CascadeMode::Fixed) {
+        fixed_.assign((size_t)kNumStages * FX_SLOTS * streams_, 0);
+    } else {
+        float_.assign((size_t)kNumStages * FL_SLOTS * streams_, 0.0f);
+    }
+}
+
+int SimdCascade::laneWidth()
+{
+    return FixVec::W;
+}
+
+void SimdCascade::reset()
+{
+    for (int s = 0; s < kNumStages; s++) {
+        if (mode_ == CascadeMode::Fixed) {
+            int32_t *p = &fixed_[(size_t)s * FX_SLOTS * streams_];
+            std::fill(p, p + (size_t)(FX_ERR + 1) * streams_, 0);
+        } else {
+            float *p = &float_[(size_t)s * FL_SLOTS * streams_];
+            std::fill(p, p + (size_t)(FL_Y2 + 1) * streams_, 0.0f);
+        }
+    }
+}
+
+void SimdCascade::setCoeffs(int stage, const HwCoeffs &c)
+{
+    for (size_t i = 0; i < streams_; i++) {
+        setCoeffs(i, stage, c);
+    }
+}
+
+void SimdCascade::setCoeffs(size_t stream, int stage, const HwCoeffs &c)
+{
+    if (mode_ == CascadeMode::Fixed) {
+        // Same 16-bit negation as the RTL's -a1 / -a2
+        int32_t *p = &fixed_[(size_t)stage * FX_SLOTS * streams_ + stream];
+        p[FX_B0 * streams_]  = c.b0;
+        p[FX_B1 * streams_]  = c.b1;
+        p[FX_B2 * streams_]  = c.b2;
+        p[FX_NA1 * streams_] = (int16_t)(uint16_t)(0u - (uint16_t)c.a1);
+        p[FX_NA2 * streams_] = (int16_t)(uint16_t)(0u - (uint16_t)c.a2);
+    } else {
+        float *p = &float_[(size_t)stage * FL_SLOTS * streams_ + stream];
+        p[FL_B0 * streams_] = c.b0 / 16384.0f;
+        p[FL_B1 * streams_] = c.b1 / 16384.0f;
+        p[FL_B2 * streams_] = c.b2 / 16384.0f;
+        p[FL_A1 * streams_] = c.a1 / 16384.0f;
+        p[FL_A2 * streams_] = c.a2 / 16384.0f;
+    }
+}
+
+void SimdCascade::process(const int32_t *in, int32_t *out, size_t frames)
+{
+    size_t full = streams_ - streams_ % FixVec::W;
+    size_t block = block_frames(streams_ * sizeof(int32_t));
+
+    for (size_t t0 = 0; t0 < frames; t0 += block) {
+        size_t n = (frames - t0 < block) ? frames - t0 : block;
+        const int32_t *bin = in + t0 * streams_;
+        int32_t *bout = out + t0 * streams_;
+
+        if (mode_ == CascadeMode::Fixed) {
+            for (size_t lane = 0; lane < full; lane += FixVec::W) {
+                fixed_kernel<FixVec>(fixed_.data(), streams_, lane, shape_, bin, bout, n, streams_);
+            }
+            for (size_t lane = full; lane < streams_; lane++) {
+                fixed_kernel<FixScalar>(fixed_.data(), streams_, lane, shape_, bin, bout, n, streams_);
+            }
+        } else {
+            for (size_t lane = 0; lane < full; lane += FltVec::W) {
+                float_kernel<FltVec>(float_.data(), streams_, lane, bin, bout, n, streams_);
+            }
+            for (size_t lane = full; lane < streams_; lane++) {
+                float_kernel<FltScalar>(float_.data(), streams_, lane, bin, bout, n, streams_);
+            }
+        }
+    }
+}
+
+void SimdCascade::processFloat(const float *in, float *out, size_t frames)
+{
+    if (mode_ != CascadeMode::Float) {
+        throw std::logic_error("SimdCascade::processFloat needs CascadeMode::Float");
+    }
+    size_t full = streams_ - streams_ % FltVec::W;
+    size_t block = block_frames(streams_ * sizeof(float));
+
+    for (size_t t0 = 0; t0 < frames; t0 += block) {
+        size_t n = (frames - t0 < block) ? frames - t0 : block;
+        const float *bin = in + t0 * streams_;
+        float *bout = out + t0 * streams_;
+
+        for (size_t lane = 0; lane < full; lane += FltVec::W) {
+            float_kernel<FltVec>(float_.data(), streams_, lane, bin, bout, n, streams_);
+        }
+        for (size_t lane = full; lane < streams_; lane++) {
+            float_kernel<FltScalar>(float_.data(), streams_, lane, bin, bout, n, streams_);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+// simd_cascade.h
+// Batched three-band biquad cascade: one SIMD lane per independent stream
+
+#ifndef SIMD_CASCADE_H
+#define SIMD_CASCADE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "hw_model.h"
+
+// -----------------------------
+// Modes
+// -----------------------------
+
+enum class CascadeMode {
+    Fixed,   // bit-exact with CascadeEq, one channel of the 24-bit datapath
+    Float    // single-precision direct form I, no inter-stage registers
+};
+
+// -----------------------------
+// Engine
+// -----------------------------
+
+/**
+ * @brief Runs the three-band cascade over many streams at once
+ *
+ * Samples are frame-interleaved: in[frame * streams + stream]. State and
+ * coefficients are stored struct-of-arrays so that one vector load picks up
+ * the same term for W adjacent streams (W = 8 with AVX2, 4 with SSE4.1).
+ * Streams past the last full vector run through the same kernel one lane at
+ * a time.
+ *
+ * Fixed mode reproduces one channel of the 24-bit three_band_eq exactly
+ * (CascadeEq with no bypassed sections): two-pass MAC, rounding, saturation,
+ * noise shaping and the ThreeBandEq::kLatencyEdges delay. Each stream keeps
+ * its own state, so the two channels of a StereoEq are two streams. Float mode
+ * is the ideal filter built from the same Q2.14 words (coefficient / 16384)
+ * with no added delay, for previews and for measuring what the fixed-point
+ * datapath costs.
+ */
+class SimdCascade {
+public:
+    static constexpr int kNumStages = ThreeBandEq::kNumStages;
+
+    SimdCascade(size_t streams, CascadeMode mode);
+
+    size_t streams() const { return streams_; }
+    CascadeMode mode() const { return mode_; }
+
+    /** @brief Lanes per vector in this build (1 when compiled without SSE4.1) */
+    static int laneWidth();
+
+    /** @brief Clear filter state on every stream; coefficients are kept */
+    void reset();
+
+    /** @brief Fixed mode: NOISE_SHAPING of the build (on by default) */
+    void setNoiseShaping(bool on) { shape_ = on; }
+
+    /** @brief Load one stage's coefficients on every stream */
+    void setCoeffs(int stage, const HwCoeffs &c);
+
+    /** @brief Load one stage's coefficients on one stream */
+    void setCoeffs(size_t stream, int stage, const HwCoeffs &c);
+
+    /**
+     * @brief Filter frame-interleaved 24-bit samples, either mode
+     * @param in     frames * streams() samples; bits above 23 are ignored,
+     *               as audio_in is 24 bits wide
+     * @param out    Same size as in; may alias it
+     * @param frames Number of frames
+     *
+     * Float mode rounds to nearest and saturates to 24 bits on the way out.
+     */
+    void process(const int32_t *in, int32_t *out, size_t frames);
+
+    /** @brief Float-mode only: filter frame-interleaved float samples */
+    void processFloat(const float *in, float *out, size_t frames);
+
+    // SoA slot indices, public so the kernels in the .cpp can share them
+    enum { FX_X0, FX_X1, FX_X2, FX_Y1, FX_Y2, FX_Y, FX_ERR, FX_B0, FX_B1, FX_B2, FX_NA1, FX_NA2, FX_SLOTS };
+    enum { FL_X1, FL_X2, FL_Y1, FL_Y2, FL_B0, FL_B1, FL_B2, FL_A1, FL_A2, FL_SLOTS };
+
+private:
+    size_t streams_;
+    CascadeMode mode_;
+    bool shape_ = true;
+    std::vector<int32_t> fixed_;   // [stage][slot][stream]
+    std::vector<float>   float_;   // [stage][slot][stream]
+};
+
+#endif
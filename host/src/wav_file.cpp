@@ -0,0 +1,293 @@
+// wav_file.cpp
+// Memory-mapped PCM WAV reader/writer for the offline renderer
+
+#include "wav_file.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define WAV_HEADER_BYTES 44
+#define WAVE_FORMAT_PCM        0x0001
+#define WAVE_FORMAT_EXTENSIBLE 0xFFFE
+
+// -----------------------------
+// Little-endian Helpers
+// -----------------------------
+
+static uint16_t rd16(const uint8_t *p) { return (uint16_t)(p[0] | p[1] << 8); }
+static uint32_t rd32(const uint8_t *p) { return (uint32_t)rd16(p) | (uint32_t)rd16(p + 2) << 16; }
+static int32_t  rd24(const uint8_t *p) { return (int32_t)((uint32_t)(p[0] | p[1] << 8 | p[2] << 16) << 8) >> 8; }
+
+static void wr16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void wr32(uint8_t *p, uint32_t v)
+{
+    wr16(p, (uint16_t)v);
+    wr16(p + 2, (uint16_t)(v >> 16));
+}
+
+static void wr24(uint8_t *p, int32_t v)
+{
+    wr16(p, (uint16_t)v);
+    p[2] = (uint8_t)(v >> 16);
+}
+
+static bool fail(std::string *err, const std::string &msg)
+{
+    if (err) {
+        *err = msg;
+    }
+    return false;
+}
+
+// -----------------------------
+// Open / Create
+// -----------------------------
+
+MappedWav::~MappedWav()
+{
+    close();
+}
+
+void MappedWav::close()
+{
+    if (map_) {
+        munmap(map_, map_len_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    data_ = nullptr;
+    frames_ = 0;
+}
+
+bool MappedWav::openRead(const std::string &path, std::string *err)
+{
+    close();
+    fd_ = open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        return fail(err, path + ": " + strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || st.st_size < 12) {
+        return fail(err, path + ": not a WAV file");
+    }
+    map_len_ = (size_t)st.st_size;
+    void *m = mmap(nullptr, map_len_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (m == MAP_FAILED) {
+        return fail(err, path + ": mmap: " + strerror(errno));
+    }
+    map_ = (uint8_t *)m;
+    writable_ = false;
+
+    if (memcmp(map_, "RIFF", 4) != 0 || memcmp(map_ + 8, "WAVE", 4) != 0) {
+        return fail(err, path + ": not a RIFF/WAVE file");
+    }
+
+    // Walk the chunk list; chunks are padded to an even length
+    bool have_fmt = false;
+    size_t pos = 12;
+    while (pos + 8 <= map_len_) {
+        const uint8_t *ck = map_ + pos;
+        uint64_t len = rd32(ck + 4);
+        const uint8_t *body = ck + 8;
+        uint64_t avail = map_len_ - (pos + 8);
+
+        if (memcmp(ck, "fmt ", 4) == 0 && len >= 16) {
+            if (len > avail) {
+                return fail(err, path + ": fmt chunk runs past the end of the file");
+            }
+            uint16_t tag = rd16(body);
+            if (tag == WAVE_FORMAT_EXTENSIBLE && len >= 26) {
+                tag = rd16(body + 24);   // first two bytes of the SubFormat GUID
+            }
+            channels_    = rd16(body + 2);
+            sample_rate_ = rd32(body + 4);
+            block_align_ = rd16(body + 12);
+            bits_        = rd16(body + 14);
+            if (tag != WAVE_FORMAT_PCM || (bits_ != 16 && bits_ != 24) || channels_ == 0 ||
+                block_align_ != channels_ * (bits_ / 8)) {
+                return fail(err, path + ": only 16- or 24-bit integer PCM is supported");
+            }
+            have_fmt = true;
+        } else if (memcmp(ck, "data", 4) == 0) {
+            if (!have_fmt) {
+                return fail(err, path + ": data chunk before fmt chunk");
+            }
+            // Streaming writers leave the length at 0 or 0xFFFFFFFF: take what is there
+            if (len == 0 || len > avail) {
+                len = avail;
+            }
+            data_ = (uint8_t *)body;
+            frames_ = len / block_align_;
+            madvise(map_, map_len_, MADV_SEQUENTIAL);
+            return true;
+        }
+        pos += 8 + len + (len & 1);
+    }
+    return fail(err, path + ": no data chunk");
+}
+
+bool MappedWav::create(const std::string &path, uint16_t channels, uint32_t sample_rate,
+                       uint64_t frames, std::string *err, uint16_t bits)
+{
+    close();
+    if (bits != 16 && bits != 24) {
+        return fail(err, path + ": only 16- or 24-bit files can be written");
+    }
+    channels_ = channels;
+    sample_rate_ = sample_rate;
+    bits_ = bits;
+    block_align_ = (uint16_t)(channels * (bits / 8));
+    frames_ = frames;
+
+    uint64_t data_bytes = frames * block_align_;
+    if (data_bytes > 0xFFFFFFFFull - WAV_HEADER_BYTES) {
+        return fail(err, path + ": too long for a RIFF file");
+    }
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        return fail(err, path + ": " + strerror(errno));
+    }
+    map_len_ = WAV_HEADER_BYTES + (size_t)data_bytes;
+    if (ftruncate(fd_, (off_t)map_len_) != 0) {
+        return fail(err, path + ": " + strerror(errno));
+    }
+    void *m = mmap(nullptr, map_len_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (m == MAP_FAILED) {
+        return fail(err, path + ": mmap: " + strerror(errno));
+    }
+    map_ = (uint8_t *)m;
+    writable_ = true;
+
+    uint8_t *h = map_;
+    memcpy(h, "RIFF", 4);
+    wr32(h + 4, (uint32_t)(map_len_ - 8));
+    memcpy(h + 8, "WAVEfmt ", 8);
+    wr32(h + 16, 16);
+    wr16(h + 20, WAVE_FORMAT_PCM);
+    wr16(h + 22, channels);
+    wr32(h + 24, sample_rate);
+    wr32(h + 28, sample_rate * block_align_);
+    wr16(h + 32, block_align_);
+    wr16(h + 34, bits);
+    memcpy(h + 36, "data", 4);
+    wr32(h + 40, (uint32_t)data_bytes);
+    data_ = h + WAV_HEADER_BYTES;
+    return true;
+}
+
+// -----------------------------
+// Sample Access
+// -----------------------------
+
+void MappedWav::readChannel(int ch, uint64_t frame0, size_t n, int16_t *dst) const
+{
+    const uint8_t *p = frameAddr(frame0);
+    if (bits_ == 16) {
+        p += ch * 2;
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            dst[i] = (int16_t)rd16(p);
+        }
+    } else {
+        // Bits [23:8] of the 24-bit word: its top 16 bits
+        p += ch * 3 + 1;
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            dst[i] = (int16_t)rd16(p);
+        }
+    }
+}
+
+void MappedWav::writeChannel(int ch, uint64_t frame0, size_t n, const int16_t *src)
+{
+    uint8_t *p = (uint8_t *)frameAddr(frame0) + ch * 2;
+    for (size_t i = 0; i < n; i++, p += block_align_) {
+        wr16(p, (uint16_t)src[i]);
+    }
+}
+
+void MappedWav::readFrames(uint64_t frame0, size_t n, int16_t *dst) const
+{
+    for (int ch = 0; ch < channels_; ch++) {
+        const uint8_t *p = frameAddr(frame0) + ch * (bits_ / 8) + (bits_ == 24 ? 1 : 0);
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            dst[i * channels_ + ch] = (int16_t)rd16(p);
+        }
+    }
+}
+
+void MappedWav::writeFrames(uint64_t frame0, size_t n, const int16_t *src)
+{
+    for (int ch = 0; ch < channels_; ch++) {
+        uint8_t *p = (uint8_t *)frameAddr(frame0) + ch * 2;
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            wr16(p, (uint16_t)src[i * channels_ + ch]);
+        }
+    }
+}
+
+void MappedWav::readChannel(int ch, uint64_t frame0, size_t n, int32_t *dst) const
+{
+    const uint8_t *p = frameAddr(frame0) + ch * (bits_ / 8);
+    if (bits_ == 16) {
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            dst[i] = (int32_t)(int16_t)rd16(p) * 256;
+        }
+    } else {
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            dst[i] = rd24(p);
+        }
+    }
+}
+
+void MappedWav::writeChannel(int ch, uint64_t frame0, size_t n, const int32_t *src)
+{
+    uint8_t *p = (uint8_t *)frameAddr(frame0) + ch * 3;
+    for (size_t i = 0; i < n; i++, p += block_align_) {
+        wr24(p, src[i]);
+    }
+}
+
+void MappedWav::readFrames(uint64_t frame0, size_t n, int32_t *dst) const
+{
+    for (int ch = 0; ch < channels_; ch++) {
+        const uint8_t *p = frameAddr(frame0) + ch * (bits_ / 8);
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            dst[i * channels_ + ch] = (bits_ == 16) ? (int32_t)(int16_t)rd16(p) * 256 : rd24(p);
+        }
+    }
+}
+
+void MappedWav::writeFrames(uint64_t frame0, size_t n, const int32_t *src)
+{
+    for (int ch = 0; ch < channels_; ch++) {
+        uint8_t *p = (uint8_t *)frameAddr(frame0) + ch * 3;
+        for (size_t i = 0; i < n; i++, p += block_align_) {
+            wr24(p, src[i * channels_ + ch]);
+        }
+    }
+}
+
+void MappedWav::release(uint64_t frame0, uint64_t n) const
+{
+    // Round inward to whole pages; the partial pages at the edges stay resident
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t lo = ((uintptr_t)frameAddr(frame0) + page - 1) & ~(page - 1);
+    uintptr_t hi = (uintptr_t)frameAddr(frame0 + n) & ~(page - 1);
+    if (hi > lo) {
+        if (writable_) {
+            msync((void *)lo, hi - lo, MS_ASYNC);
+        }
+        madvise((void *)lo, hi - lo, MADV_DONTNEED);
+    }
+}
@@ -0,0 +1,94 @@
+// wav_file.h
+// Memory-mapped PCM WAV reader/writer for the offline renderer
+
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief A PCM WAV file mapped into memory
+ *
+ * Reading accepts 16- and 24-bit integer PCM, plain or WAVE_FORMAT_EXTENSIBLE.
+ * The int32_t accessors carry whole 24-bit samples, as I2S_package.sv hands
+ * them to the filters; a 16-bit file reads as its samples * 2^8. The int16_t
+ * accessors narrow 24-bit samples to bits [23:8]. create() writes 16- or
+ * 24-bit files.
+ *
+ * Nothing is copied: pages fault in as channels are read, and release() lets
+ * a caller that has finished a region hand its pages back, so files larger
+ * than RAM stream through.
+ */
+class MappedWav {
+public:
+    MappedWav() = default;
+    ~MappedWav();
+    MappedWav(const MappedWav &) = delete;
+    MappedWav &operator=(const MappedWav &) = delete;
+
+    /** @brief Map an existing file read-only; false with *err set on failure */
+    bool openRead(const std::string &path, std::string *err);
+
+    /** @brief Create a 16- or 24-bit file of the given size and map it read-write */
+    bool create(const std::string &path, uint16_t channels, uint32_t sample_rate,
+                uint64_t frames, std::string *err, uint16_t bits = 16);
+
+    /** @brief Unmap; written data reaches the file without an explicit flush */
+    void close();
+
+    uint16_t channels() const { return channels_; }
+    uint32_t sampleRate() const { return sample_rate_; }
+    uint16_t bitsPerSample() const { return bits_; }
+    uint64_t frames() const { return frames_; }
+
+    /**
+     * @brief Gather one channel into a contiguous 16-bit buffer
+     * @param ch     Channel index
+     * @param frame0 First frame
+     * @param n      Frame count
+     * @param dst    n samples
+     */
+    void readChannel(int ch, uint64_t frame0, size_t n, int16_t *dst) const;
+
+    /** @brief Scatter one channel from a contiguous buffer (16-bit files only) */
+    void writeChannel(int ch, uint64_t frame0, size_t n, const int16_t *src);
+
+    /** @brief Read n interleaved frames as 16-bit samples */
+    void readFrames(uint64_t frame0, size_t n, int16_t *dst) const;
+
+    /** @brief Write n interleaved frames (16-bit files only) */
+    void writeFrames(uint64_t frame0, size_t n, const int16_t *src);
+
+    /** @brief Gather one channel as 24-bit samples (sign extended) */
+    void readChannel(int ch, uint64_t frame0, size_t n, int32_t *dst) const;
+
+    /** @brief Scatter one channel of 24-bit samples (24-bit files only) */
+    void writeChannel(int ch, uint64_t frame0, size_t n, const int32_t *src);
+
+    /** @brief Read n interleaved frames as 24-bit samples */
+    void readFrames(uint64_t frame0, size_t n, int32_t *dst) const;
+
+    /** @brief Write n interleaved frames of 24-bit samples (24-bit files only) */
+    void writeFrames(uint64_t frame0, size_t n, const int32_t *src);
+
+    /** @brief Drop the pages behind [frame0, frame0 + n); a hint only */
+    void release(uint64_t frame0, uint64_t n) const;
+
+private:
+    const uint8_t *frameAddr(uint64_t frame) const { return data_ + frame * block_align_; }
+
+    int      fd_ = -1;
+    uint8_t *map_ = nullptr;
+    size_t   map_len_ = 0;
+    bool     writable_ = false;
+    uint8_t *data_ = nullptr;     // start of the data chunk payload
+    uint16_t channels_ = 0;
+    uint32_t sample_rate_ = 0;
+    uint16_t bits_ = 0;
+    uint16_t block_align_ = 0;
+    uint64_t frames_ = 0;
+};
+
+#endif
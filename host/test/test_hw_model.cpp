@@ -0,0 +1,521 @@
+// test_hw_model.cpp
+// Host test: edge-level golden model vs. clock-by-clock replays of the RTL, plus throughput
+//
+// Build and run from host/:
+//   g++ -O2 -std=c++17 -Isrc test/test_hw_model.cpp src/hw_model.cpp -o test_hw_model
+//   ./test_hw_model
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "hw_model.h"
+
+// System clocks per l_r_clk half period (12 MHz / 62.5 kHz edges)
+#define CLOCKS_PER_EDGE 192
+#define BENCH_SAMPLES   (10 * 1000 * 1000)
+
+// -----------------------------
+// Clock-level RTL Replay
+// -----------------------------
+
+// Register-for-register copy of iir_time_mux_accum.sv + MAC16_wrapper_accum.sv,
+// evaluated with nonblocking semantics. Deliberately naive: it is the reference.
+struct RtlStage {
+    enum { IDLE, WAIT1, WAIT2, MULT_B0, MULT_B1, MULT_B2, MULT_A1, MULT_A2, DONE };
+
+    HwCoeffs c = { 0, 0, 0, 0, 0 };
+    int      state = IDLE;
+    bool     lr_d1 = false, lr_d2 = false, lr_edge = false, ready = false;
+    int16_t  x_n = 0, x_n1 = 0, x_n2 = 0, y_n1 = 0, y_n2 = 0, filtered = 0;
+    int16_t  a_reg = 0, b_reg = 0;
+    uint32_t q = 0, latched = 0;
+
+    uint32_t published() const { return (uint16_t)filtered; }
+
+    void clock(bool l_r_clk, int16_t latest_sample, int /*channel: mono*/)
+    {
+        bool mac_rst = (state == WAIT1 || state == WAIT2);
+        bool ce = (state >= MULT_B0 && state <= MULT_A2);
+        int16_t mac_a = 0, mac_b = 0;
+        switch (state) {
+        case MULT_B0: mac_a = c.b0; mac_b = x_n;  break;
+        case MULT_B1: mac_a = c.b1; mac_b = x_n1; break;
+        case MULT_B2: mac_a = c.b2; mac_b = x_n2; break;
+        case MULT_A1: mac_a = (int16_t)-c.a1; mac_b = y_n1; break;
+        case MULT_A2: mac_a = (int16_t)-c.a2; mac_b = y_n2; break;
+        }
+        uint32_t mac_result = q + IirTimeMuxAccum::mac(a_reg, b_reg);
+
+        RtlStage n = *this;
+        n.lr_d1 = l_r_clk;
+        n.lr_d2 = lr_d1;
+        n.lr_edge = lr_d1 ^ lr_d2;
+        if (lr_edge) {
+            n.x_n = latest_sample;
+            n.x_n1 = x_n;
+            n.x_n2 = x_n1;
+            n.filtered = (int16_t)(uint16_t)(latched >> 14);
+        }
+        n.ready = lr_edge;
+        if (ready) {
+            n.y_n1 = filtered;
+            n.y_n2 = y_n1;
+        }
+        if (mac_rst) {
+            n.a_reg = n.b_reg = 0;
+            n.q = 0;
+        } else if (ce) {
+            n.a_reg = mac_a;
+            n.b_reg = mac_b;
+            n.q = mac_result;
+        }
+        if (state == DONE) {
+            n.latched = mac_result;
+        }
+        if (state == IDLE) {
+            n.state = lr_edge ? WAIT1 : IDLE;
+        } else {
+            n.state = (state == DONE) ? IDLE : state + 1;
+        }
+        *this = n;
+    }
+};
+
+// Register-for-register copy of iir_cascade_accum.sv (three_band_eq.sv) on one
+// MAC16_wrapper_accum: sections run back to back on the edge's channel, each
+// as a low-byte then a high-word MAC sequence, and each result shifts into the
+// history node the next section reads as its input
+struct RtlCascade {
+    enum { IDLE, CLEAR, MULT_B0, MULT_B1, MULT_B2, MULT_A1, MULT_A2, DONE };
+
+    int      sections = ThreeBandEq::kNumStages;    // N_SECTIONS
+    bool     noise_shaping = true;                  // NOISE_SHAPING
+    HwCoeffs c[2][CascadeEq::kMaxStages] = {};
+    int      state = IDLE, section = 0, channel = 0;
+    bool     high = false;
+    bool     lr_d1 = false, lr_d2 = false, lr_edge = false;
+    int32_t  hist[2][CascadeEq::kMaxStages + 1][3] = {}, filtered[2] = {};
+    int32_t  err[2][CascadeEq::kMaxStages] = {};
+    bool     bypass[2][CascadeEq::kMaxStages] = {};
+    int      fade[2][CascadeEq::kMaxStages] = {};
+    bool     skipping = false;
+    int16_t  a_reg = 0, b_reg = 0;
+    uint32_t q = 0, low_sum = 0;
+
+    // {audio_out_l, audio_out_r}, 24 bits each
+    uint64_t published() const
+    {
+        return (uint64_t)(filtered[0] & 0xFFFFFF) << 24 | (uint32_t)(filtered[1] & 0xFFFFFF);
+    }
+
+    static int16_t part(int32_t v, bool hi) { return hi ? (int16_t)(v >> 8) : (int16_t)(v & 0xFF); }
+
+    void clock(bool l_r_clk, int32_t latest_sample, int latest_channel)
+    {
+        bool mac_rst = state == CLEAR;
+        bool ce = (state >= MULT_B0 && state <= MULT_A2);
+        const HwCoeffs &k = c[channel][section];
+        int32_t (*h)[3] = hist[channel];
+        int16_t mac_a = 0, mac_b = 0;
+        switch (state) {
+        case MULT_B0: mac_a = k.b0; mac_b = part(h[section][0], high); break;
+        case MULT_B1: mac_a = k.b1; mac_b = part(h[section][1], high); break;
+        case MULT_B2: mac_a = k.b2; mac_b = part(h[section][2], high); break;
+        case MULT_A1: mac_a = (int16_t)-k.a1; mac_b = part(h[section + 1][0], high); break;
+        case MULT_A2: mac_a = (int16_t)-k.a2; mac_b = part(h[section + 1][1], high); break;
+        }
+        uint32_t mac_result = q + IirTimeMuxAccum::mac(a_reg, b_reg);
+
+        // Output stage, as wide as it needs to be
+        int64_t acc = (int64_t)(int32_t)mac_result * 256 + (int32_t)low_sum;
+        int64_t shaped = noise_shaping ? acc - err[channel][section] : acc;
+        int64_t rounded = (shaped + 8192) >> 14;
+        bool clipped = rounded > 8388607 || rounded < -8388608;
+        int32_t section_y = clipped ? (rounded > 0 ? 8388607 : -8388608) : (int32_t)rounded;
+        int32_t section_e = clipped ? 0 : (int32_t)(rounded * 16384 - shaped);
+
+        // Bypass crossfade
+        const int full = CascadeSection::kFadeSamples;
+        int f = fade[channel][section];
+        bool skip = bypass[channel][section] && f == full;
+        int64_t mix_p = ((int64_t)h[section][0] - section_y) * f;
+        int32_t mixed = (int32_t)(section_y + (mix_p >> CascadeSection::kFadeLog2));
+
+        RtlCascade n = *this;
+        n.lr_d1 = l_r_clk;
+        n.lr_d2 = lr_d1;
+        n.lr_edge = lr_d1 ^ lr_d2;
+        if (lr_edge) {
+            for (int ch = 0; ch < 2; ch++) {
+                n.filtered[ch] = hist[ch][sections][0];
+            }
+            n.channel = latest_channel;
+            int32_t *x = n.hist[latest_channel][0];
+            x[2] = hist[latest_channel][0][1];
+            x[1] = hist[latest_channel][0][0];
+            x[0] = latest_sample;
+        }
+        if (state == DONE && !high) {
+            n.low_sum = mac_result;
+        }
+        if (state == DONE && high) {
+            int32_t *y = n.hist[channel][section + 1];
+            y[2] = h[section + 1][1];
+            y[1] = h[section + 1][0];
+            y[0] = mixed;
+            n.err[channel][section] = skipping ? 0 : section_e;
+            if (bypass[channel][section] && f != full) {
+                n.fade[channel][section] = f + 1;
+            } else if (!bypass[channel][section] && f != 0) {
+                n.fade[channel][section] = f - 1;
+            }
+        }
+        if (mac_rst) {
+            n.a_reg = n.b_reg = 0;
+            n.q = 0;
+        } else if (ce) {
+            n.a_reg = mac_a;
+            n.b_reg = mac_b;
+            n.q = mac_result;
+        }
+        if (state == IDLE) {
+            n.section = 0;
+            n.high = false;
+            n.state = lr_edge ? CLEAR : IDLE;
+        } else if (state == CLEAR) {
+            n.skipping = skip && !high;
+            if (skip && !high) {
+                n.high = true;
+                n.state = DONE;
+            } else {
+                n.state = MULT_B0;
+            }
+        } else if (state == DONE) {
+            n.high = !high;
+            if (!high) {
+                n.state = CLEAR;
+            } else {
+                n.state = section == sections - 1 ? IDLE : CLEAR;
+                n.section = section == sections - 1 ? section : section + 1;
+            }
+        } else {
+            n.state = state + 1;
+        }
+        *this = n;
+    }
+};
+
+// Drives the RTL replay one system clock at a time and records what it
+// publishes just before each l_r_clk transition, exactly as a testbench would
+// see it. Sample i is tagged with channel i % 2, like an interleaved stream.
+template <class Rtl>
+static std::vector<uint64_t> rtl_run(Rtl &rtl, const std::vector<int32_t> &in)
+{
+    std::vector<uint64_t> out;
+    bool lr = false;
+    for (size_t i = 0; i <= in.size(); i++) {
+        if (i > 0) {
+            out.push_back(rtl.published());
+        }
+        if (i == in.size()) {
+            break;
+        }
+        lr = !lr;
+        for (int clk = 0; clk < CLOCKS_PER_EDGE; clk++) {
+            rtl.clock(lr, in[i], (int)(i % 2));
+        }
+    }
+    return out;
+}
+
+// -----------------------------
+// Checks
+// -----------------------------
+
+static uint32_t rng_state = 0x12345678u;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Coefficients biased toward the corners that exercise wraparound
+static int16_t random_word(void)
+{
+    static const int16_t corners[] = { -32768, -32767, -16384, -1, 0, 1, 16384, 32767 };
+    return (rng() & 3) == 0 ? corners[rng() & 7] : (int16_t)rng();
+}
+
+// 24-bit samples, biased toward full scale so the output stage saturates
+static int32_t random_sample(void)
+{
+    static const int32_t corners[] = { -8388608, -8388607, -4194304, -1, 0, 1, 4194304, 8388607 };
+    return (rng() & 3) == 0 ? corners[rng() & 7] : (int32_t)(rng() << 8) >> 8;
+}
+
+// One stage: IirTimeMuxAccum. More: StereoEq of that many sections, each channel
+// with its own coefficients so a channel mix-up in either side shows as a mismatch.
+static int check_against_rtl(int stages, int trials, int samples, bool noise_shaping = true)
+{
+    int failures = 0;
+    for (int t = 0; t < trials; t++) {
+        HwCoeffs coeffs[StereoEq::kNumChannels][CascadeEq::kMaxStages];
+        for (auto &ch : coeffs) {
+            for (HwCoeffs &c : ch) {
+                c = { random_word(), random_word(), random_word(), random_word(), random_word() };
+            }
+        }
+        std::vector<int32_t> in(samples);
+        for (int32_t &x : in) {
+            x = stages == 1 ? random_word() : random_sample();
+        }
+
+        std::vector<uint64_t> want;
+        std::vector<uint64_t> got(samples);
+        if (stages == 1) {
+            RtlStage rtl;
+            rtl.c = coeffs[0][0];
+            want = rtl_run(rtl, in);
+            IirTimeMuxAccum m;
+            m.setCoeffs(coeffs[0][0]);
+            for (int i = 0; i < samples; i++) {
+                got[i] = (uint16_t)m.edge((int16_t)in[i]);
+            }
+        } else {
+            RtlCascade rtl;
+            rtl.sections = stages;
+            rtl.noise_shaping = noise_shaping;
+            StereoEq m(stages);
+            m.reset();
+            m.setNoiseShaping(noise_shaping);
+            for (int ch = 0; ch < StereoEq::kNumChannels; ch++) {
+                for (int st = 0; st < stages; st++) {
+                    rtl.c[ch][st] = coeffs[ch][st];
+                    m.setCoeffs(ch, st, coeffs[ch][st]);
+                }
+            }
+            want = rtl_run(rtl, in);
+            for (int i = 0; i < samples; i++) {
+                m.edge(in[i], i % 2);
+                got[i] = (uint64_t)(m.output(0) & 0xFFFFFF) << 24 | (uint32_t)(m.output(1) & 0xFFFFFF);
+            }
+        }
+
+        for (int i = 0; i < samples; i++) {
+            if (got[i] != want[i]) {
+                if (failures < 10) {
+                    printf("FAIL %d-stage trial %d edge %d: model %012llx rtl %012llx\n",
+                           stages, t, i, (unsigned long long)got[i], (unsigned long long)want[i]);
+                }
+                failures++;
+                break;
+            }
+        }
+    }
+    printf("%d-stage model vs. clock-level RTL%s: %d/%d trials mismatched\n",
+           stages, noise_shaping ? "" : " (no noise shaping)", failures, trials);
+    return failures;
+}
+
+// Left and right keep separate state: the right channel of a stereo run must
+// equal a mono CascadeEq fed only the right samples, whatever the left does
+static int check_channel_isolation(void)
+{
+    StereoEq st;
+    CascadeEq mono;
+    st.reset();
+    mono.reset();
+    for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+        HwCoeffs c = { random_word(), random_word(), random_word(), random_word(), random_word() };
+        st.setCoeffs(1, s, c);
+        mono.setCoeffs(s, c);
+        st.setCoeffs(0, s, { random_word(), random_word(), random_word(), random_word(), random_word() });
+    }
+    int bad = 0;
+    for (int i = 0; i < 2000; i++) {
+        int32_t left = random_sample(), right = random_sample();
+        st.edge(left, 0);
+        st.edge(right, 1);
+        bad += st.output(1) != mono.pending();
+        mono.edge(right);
+    }
+    printf("right channel vs. mono cascade on the right samples alone: %d mismatches\n", bad);
+    return bad != 0;
+}
+
+static int check_latency(void)
+{
+    CascadeEq eq;
+    eq.reset();
+    for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+        eq.setCoeffs(s, kHwPassthrough);
+    }
+    int arrival = -1;
+    for (int i = 0; i < 16; i++) {
+        if (eq.edge(i == 0 ? 1234567 : 0) == 1234567) {
+            arrival = i;
+        }
+    }
+    printf("passthrough cascade: impulse arrives after %d edges (expect %d)\n",
+           arrival, ThreeBandEq::kLatencyEdges);
+    return arrival != ThreeBandEq::kLatencyEdges;
+}
+
+// A hot signal through +6 dB must clip at the 24-bit rails, never wrap
+static int check_saturation(void)
+{
+    CascadeSection sec;
+    sec.setCoeffs({ 0x7FFF, 0, 0, 0, 0 });     // b0 just under 2.0
+    int bad = 0;
+    for (int i = 0; i < 1000; i++) {
+        int32_t x = (int32_t)(0.75 * CascadeSection::kMax * std::sin(i * 0.05));
+        sec.edge(x);
+        double want = std::round(x * 32767.0 / 16384.0);
+        want = std::fmin(std::fmax(want, CascadeSection::kMin), CascadeSection::kMax);
+        bad += std::fabs(sec.pending() - want) > 1.0;
+    }
+    printf("+6 dB section on a -2.5 dBFS sine: %d samples off the clipped ideal\n", bad);
+    return bad != 0;
+}
+
+// Error feedback against plain rounding on a 60 Hz +6 dB peak, whose poles sit
+// close to z = 1: the error against a double-precision run of the same
+// quantized coefficients must come out well below the unshaped error
+static int check_noise_shaping(void)
+{
+    const double fs = 31250.0, f0 = 60.0, q = 1.0, gain = std::pow(10.0, 6.0 / 40.0);
+    double w = 2.0 * M_PI * f0 / fs, alpha = std::sin(w) / (2.0 * q), a0 = 1.0 + alpha / gain;
+    double d[5] = { (1.0 + alpha * gain) / a0, -2.0 * std::cos(w) / a0, (1.0 - alpha * gain) / a0,
+                    -2.0 * std::cos(w) / a0, (1.0 - alpha / gain) / a0 };
+    int16_t k[5];
+    for (int i = 0; i < 5; i++) {
+        k[i] = (int16_t)std::lround(d[i] * 16384.0);
+    }
+    HwCoeffs c = { k[0], k[1], k[2], k[3], k[4] };
+
+    CascadeSection plain, shaped;
+    plain.setCoeffs(c);
+    shaped.setCoeffs(c);
+    plain.setNoiseShaping(false);
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0, e_plain = 0, e_shaped = 0;
+    for (int i = 0; i < 200000; i++) {
+        int32_t x = (int32_t)(rng() << 8) >> 14;    // About -36 dBFS
+        plain.edge(x);
+        shaped.edge(x);
+        double y = (k[0] * (double)x + k[1] * x1 + k[2] * x2 - k[3] * y1 - k[4] * y2) / 16384.0;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+        e_plain += (plain.pending() - y) * (plain.pending() - y);
+        e_shaped += (shaped.pending() - y) * (shaped.pending() - y);
+    }
+    double db = 10.0 * std::log10(e_shaped / e_plain);
+    printf("60 Hz peak: error feedback moves the requantization error by %.1f dB\n", db);
+    return db > -10.0;
+}
+
+// Bypass flags toggled at random edges on both sides: the crossfade and the
+// skipped passes must match the RTL, and a fully bypassed cascade must hand
+// every sample through untouched, one edge later
+static int check_bypass(int stages, int trials, int samples)
+{
+    int failures = 0, opaque = 0;
+    for (int t = 0; t < trials; t++) {
+        RtlCascade rtl;
+        rtl.sections = stages;
+        StereoEq m(stages);
+        m.reset();
+        for (int ch = 0; ch < StereoEq::kNumChannels; ch++) {
+            for (int st = 0; st < stages; st++) {
+                HwCoeffs c = { random_word(), random_word(), random_word(), random_word(), random_word() };
+                rtl.c[ch][st] = c;
+                m.setCoeffs(ch, st, c);
+            }
+        }
+
+        bool lr = false;
+        int mismatch = -1;
+        for (int i = 0; i < samples; i++) {
+            // The last stretch bypasses everything for long enough to fade all the way
+            bool all = i >= samples - 4 * CascadeSection::kFadeSamples;
+            if (all || rng() % 32 == 0) {
+                int ch = rng() % 2, st = rng() % stages;
+                bool on = all || (rng() & 1);
+                for (int c = 0; c < StereoEq::kNumChannels; c++) {
+                    for (int s = 0; s < stages; s++) {
+                        bool b = all ? true : (c == ch && s == st) ? on : rtl.bypass[c][s];
+                        rtl.bypass[c][s] = b;
+                        m.setBypass(c, s, b);
+                    }
+                }
+            }
+            int32_t x = random_sample();
+            lr = !lr;
+            for (int clk = 0; clk < CLOCKS_PER_EDGE; clk++) {
+                rtl.clock(lr, x, i % 2);
+            }
+            m.edge(x, i % 2);
+            uint64_t got = (uint64_t)(m.output(0) & 0xFFFFFF) << 24 | (uint32_t)(m.output(1) & 0xFFFFFF);
+            if (mismatch < 0 && got != rtl.published()) {
+                mismatch = i;
+            }
+            if (i >= samples - CascadeSection::kFadeSamples && m.channel(i % 2).pending() != x) {
+                opaque++;
+            }
+        }
+        if (mismatch >= 0) {
+            if (failures < 10) {
+                printf("FAIL bypass %d-stage trial %d edge %d\n", stages, t, mismatch);
+            }
+            failures++;
+        }
+    }
+    printf("%d-stage bypass crossfade vs. clock-level RTL: %d/%d trials mismatched, "
+           "%d samples not passed through\n", stages, failures, trials, opaque);
+    return failures + opaque;
+}
+
+static void bench(void)
+{
+    ThreeBandEq eq;
+    eq.reset();
+    eq.setCoeffs(0, { 16220, -32166, 15950, -32166, 15787 });
+    eq.setCoeffs(1, { 16621, -31632, 15027, -31632, 15265 });
+    eq.setCoeffs(2, { 15106, -27384, 12619, -29116, 13008 });
+
+    std::vector<int16_t> buf(BENCH_SAMPLES);
+    for (int16_t &x : buf) {
+        x = (int16_t)(rng() >> 20);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    eq.process(buf.data(), buf.data(), buf.size());
+    auto t1 = std::chrono::steady_clock::now();
+    double s = std::chrono::duration<double>(t1 - t0).count();
+    printf("three-band model: %.1f Msamples/s (%.0fx real time at 62.5 kHz edges)\n",
+           BENCH_SAMPLES / s / 1e6, BENCH_SAMPLES / s / 62500.0);
+}
+
+int main(void)
+{
+    int failures = check_latency()
+                 + check_channel_isolation()
+                 + check_saturation()
+                 + check_noise_shaping()
+                 + check_against_rtl(1, 200, 400)
+                 + check_against_rtl(3, 200, 400)
+                 + check_against_rtl(3, 100, 400, false)
+                 + check_against_rtl(10, 50, 400)
+                 + check_bypass(3, 50, 1000);
+    bench();
+
+    if (failures) {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
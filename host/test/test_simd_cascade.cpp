@@ -0,0 +1,198 @@
+// test_simd_cascade.cpp
+// Host test: batched engine vs. the scalar 24-bit model (StereoEq), plus streams-per-core throughput
+//
+// Build and run from host/:
+//   g++ -O3 -march=native -std=c++17 -Isrc test/test_simd_cascade.cpp src/simd_cascade.cpp src/hw_model.cpp -o test_simd_cascade
+//   ./test_simd_cascade
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "hw_model.h"
+#include "simd_cascade.h"
+
+#define BENCH_STREAMS 1024
+#define BENCH_FRAMES  16384
+
+// Shelf / peak / shelf designs from the MCU at mid-travel pots
+static const HwCoeffs kBands[ThreeBandEq::kNumStages] = {
+    { 16220, -32166, 15950, -32166, 15787 },
+    { 16621, -31632, 15027, -31632, 15265 },
+    { 15106, -27384, 12619, -29116, 13008 },
+};
+
+static uint32_t rng_state = 0x2545F491u;
+
+static uint32_t rng(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static int16_t random_word(void)
+{
+    static const int16_t corners[] = { -32768, -32767, -16384, -1, 0, 1, 16384, 32767 };
+    return (rng() & 3) == 0 ? corners[rng() & 7] : (int16_t)rng();
+}
+
+static int32_t random_sample(void)
+{
+    static const int32_t corners[] = { CascadeSection::kMin, CascadeSection::kMin + 1, -256, -1,
+                                       0, 255, 256, CascadeSection::kMax };
+    return (rng() & 3) == 0 ? corners[rng() & 7] : (int32_t)(rng() << 8) >> 8;
+}
+
+// Streams 2k and 2k + 1 are the left and right channels of StereoEq k, each
+// with its own random coefficients; every output must match bit for bit.
+// 37 streams leaves a scalar tail after the vector groups. Random words
+// saturate often; every fourth stream runs the real designs instead, so the
+// rounding and noise shaping of in-range results get exercised too.
+static int check_fixed(bool shaping)
+{
+    const size_t streams = 37, frames = 1000;
+    SimdCascade engine(streams, CascadeMode::Fixed);
+    std::vector<StereoEq> ref((streams + 1) / 2);
+
+    engine.setNoiseShaping(shaping);
+    for (StereoEq &eq : ref) {
+        eq.reset();
+        eq.setNoiseShaping(shaping);
+    }
+    for (size_t i = 0; i < streams; i++) {
+        for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+            HwCoeffs c = { random_word(), random_word(), random_word(), random_word(), random_word() };
+            if (i % 4 == 3) {
+                c = kBands[s];
+            }
+            engine.setCoeffs(i, s, c);
+            ref[i / 2].setCoeffs((int)(i % 2), s, c);
+        }
+    }
+    std::vector<int32_t> buf(streams * frames);
+    for (int32_t &x : buf) {
+        x = random_sample();
+    }
+    std::vector<int32_t> in = buf;
+
+    // Uneven chunks so state carries across calls and block boundaries
+    size_t done = 0, chunk = 1;
+    while (done < frames) {
+        size_t n = std::min(chunk, frames - done);
+        engine.process(&buf[done * streams], &buf[done * streams], n);
+        done += n;
+        chunk = chunk * 3 + 1;
+    }
+
+    // One edge per channel, left then right, as I2S_package tags them
+    std::vector<bool> bad(streams, false);
+    for (size_t t = 0; t < frames; t++) {
+        for (size_t i = 0; i < streams; i++) {
+            int c = (int)(i % 2);
+            ref[i / 2].edge(in[t * streams + i], c);
+            int32_t want = ref[i / 2].output(c);
+            if (!bad[i] && buf[t * streams + i] != want) {
+                printf("FAIL fixed stream %zu frame %zu: %d vs %d\n", i, t, buf[t * streams + i], want);
+                bad[i] = true;
+            }
+        }
+    }
+    int failures = (int)std::count(bad.begin(), bad.end(), true);
+    printf("fixed mode (%d lanes, noise shaping %s): %d/%zu streams differ from StereoEq\n",
+           SimdCascade::laneWidth(), shaping ? "on" : "off", failures, streams);
+    return failures;
+}
+
+// Float mode against a double-precision cascade of the same Q2.14 designs
+static int check_float(void)
+{
+    const size_t streams = 11, frames = 4000;
+    SimdCascade engine(streams, CascadeMode::Float);
+    for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+        engine.setCoeffs(s, kBands[s]);
+    }
+    std::vector<float> buf(streams * frames);
+    for (float &x : buf) {
+        x = (float)(int16_t)(rng() >> 18);
+    }
+    std::vector<float> in = buf;
+    engine.processFloat(buf.data(), buf.data(), frames);
+
+    double worst = 0.0;
+    for (size_t i = 0; i < streams; i++) {
+        double st[ThreeBandEq::kNumStages][4] = {};
+        for (size_t t = 0; t < frames; t++) {
+            double x = in[t * streams + i];
+            for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+                const HwCoeffs &c = kBands[s];
+                double *z = st[s];
+                double y = (c.b0 * x + c.b1 * z[0] + c.b2 * z[1] - c.a1 * z[2] - c.a2 * z[3]) / 16384.0;
+                z[1] = z[0]; z[0] = x; z[3] = z[2]; z[2] = y;
+                x = y;
+            }
+            worst = std::max(worst, std::fabs(x - buf[t * streams + i]));
+        }
+    }
+    printf("float mode: worst deviation from double %.4f LSB\n", worst);
+    return worst > 2.0;
+}
+
+template <class F>
+static double seconds(F f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void bench(void)
+{
+    std::vector<int32_t> in((size_t)BENCH_STREAMS * BENCH_FRAMES), out(in.size());
+    for (int32_t &x : in) {
+        x = (int32_t)(rng() << 8) >> 10;
+    }
+    double samples = (double)in.size();
+    double bytes = samples * 2.0 * sizeof(int32_t);
+
+    for (int m = 0; m < 2; m++) {
+        CascadeMode mode = m ? CascadeMode::Float : CascadeMode::Fixed;
+        SimdCascade engine(BENCH_STREAMS, mode);
+        for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+            engine.setCoeffs(s, kBands[s]);
+        }
+        double t = seconds([&] { engine.process(in.data(), out.data(), BENCH_FRAMES); });
+        printf("%-5s engine: %7.1f Msamples/s, %5.2f GB/s\n", m ? "float" : "fixed",
+               samples / t / 1e6, bytes / t / 1e9);
+    }
+
+    std::vector<CascadeEq> ref(BENCH_STREAMS);
+    for (CascadeEq &eq : ref) {
+        eq.reset();
+        for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+            eq.setCoeffs(s, kBands[s]);
+        }
+    }
+    double t = seconds([&] {
+        for (size_t f = 0; f < BENCH_FRAMES; f++) {
+            for (size_t i = 0; i < BENCH_STREAMS; i++) {
+                out[f * BENCH_STREAMS + i] = ref[i].edge(in[f * BENCH_STREAMS + i]);
+            }
+        }
+    });
+    printf("scalar CascadeEq: %7.1f Msamples/s\n", samples / t / 1e6);
+}
+
+int main(void)
+{
+    int failures = check_fixed(true) + check_fixed(false) + check_float();
+    bench();
+
+    if (failures) {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
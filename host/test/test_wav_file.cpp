@@ -0,0 +1,190 @@
+// test_wav_file.cpp
+// Host test: mapped WAV round trips, 24-bit narrowing, chunk walking and truncated headers
+//
+// Build and run from host/:
+//   g++ -O2 -std=c++17 -Isrc test/test_wav_file.cpp src/wav_file.cpp -o test_wav_file
+//   ./test_wav_file
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "wav_file.h"
+
+static int check_round_trip(const std::string &path)
+{
+    const uint16_t channels = 3;
+    const uint64_t frames = 100000;   // spans many pages, exercises release()
+    std::string err;
+    int failures = 0;
+
+    MappedWav w;
+    if (!w.create(path, channels, 44100, frames, &err)) {
+        printf("FAIL create: %s\n", err.c_str());
+        return 1;
+    }
+    std::vector<int16_t> col(frames);
+    for (int ch = 0; ch < channels; ch++) {
+        for (uint64_t i = 0; i < frames; i++) {
+            col[i] = (int16_t)(i * 7919 + ch * 31);
+        }
+        w.writeChannel(ch, 0, frames, col.data());
+    }
+    w.release(0, frames);
+    w.close();
+
+    MappedWav r;
+    if (!r.openRead(path, &err)) {
+        printf("FAIL reopen: %s\n", err.c_str());
+        return 1;
+    }
+    if (r.channels() != channels || r.sampleRate() != 44100 || r.bitsPerSample() != 16 ||
+        r.frames() != frames) {
+        printf("FAIL header fields\n");
+        failures++;
+    }
+    std::vector<int16_t> inter(frames * channels);
+    r.readFrames(0, frames, inter.data());
+    for (uint64_t i = 0; i < frames && !failures; i++) {
+        for (int ch = 0; ch < channels; ch++) {
+            if (inter[i * channels + ch] != (int16_t)(i * 7919 + ch * 31)) {
+                printf("FAIL sample %llu ch %d\n", (unsigned long long)i, ch);
+                failures++;
+                break;
+            }
+        }
+    }
+    printf("16-bit round trip: %d failures\n", failures);
+    return failures;
+}
+
+// Extensible 24-bit header with an odd-length LIST chunk ahead of the data
+static int check_extensible_24(const std::string &path)
+{
+    static const uint8_t samples[] = {
+        0x00, 0x34, 0x12,   0xFF, 0xFF, 0x80,   // frame 0: 0x123400, 0x80FFFF
+        0xAB, 0xCD, 0x7F,   0x00, 0x00, 0x00,   // frame 1: 0x7FCDAB, 0
+    };
+    std::vector<uint8_t> f;
+    auto put = [&](const void *p, size_t n) { f.insert(f.end(), (const uint8_t *)p, (const uint8_t *)p + n); };
+    auto put16 = [&](uint16_t v) { put(&v, 2); };
+    auto put32 = [&](uint32_t v) { put(&v, 4); };
+
+    put("RIFF", 4); put32(0); put("WAVE", 4);
+    put("fmt ", 4); put32(40);
+    put16(0xFFFE); put16(2); put32(48000); put32(48000 * 6); put16(6); put16(24);
+    put16(22); put16(24); put32(3);
+    put16(0x0001); put("\x00\x00\x00\x00\x10\x00\x80\x00\x00\xAA\x00\x38\x9B\x71", 14);
+    put("LIST", 4); put32(3); put("abc", 3); f.push_back(0);
+    put("data", 4); put32(sizeof samples); put(samples, sizeof samples);
+
+    FILE *fp = fopen(path.c_str(), "wb");
+    fwrite(f.data(), 1, f.size(), fp);
+    fclose(fp);
+
+    MappedWav r;
+    std::string err;
+    if (!r.openRead(path, &err)) {
+        printf("FAIL extensible: %s\n", err.c_str());
+        return 1;
+    }
+    int16_t got[4];
+    r.readFrames(0, 2, got);
+    int16_t right[2];
+    r.readChannel(1, 0, 2, right);
+    int failures = !(r.frames() == 2 && r.bitsPerSample() == 24 &&
+                     got[0] == 0x1234 && got[1] == (int16_t)0x80FF &&
+                     got[2] == 0x7FCD && got[3] == 0 &&
+                     right[0] == got[1] && right[1] == got[3]);
+    int32_t whole[4];
+    r.readFrames(0, 2, whole);
+    int32_t left[2];
+    r.readChannel(0, 0, 2, left);
+    failures += !(whole[0] == 0x123400 && whole[1] == (int32_t)0xFF80FFFF &&
+                  whole[2] == 0x7FCDAB && whole[3] == 0 &&
+                  left[0] == whole[0] && left[1] == whole[2]);
+    printf("24-bit extensible narrowing: %d failures\n", failures);
+    return failures;
+}
+
+// 24-bit file written and read back whole; the same samples read from a 16-bit file scale by 2^8
+static int check_round_trip_24(const std::string &path)
+{
+    const int32_t src[6] = { 0x7FFFFF, -0x800000, 0x123456, -1, 0, -0x123456 };
+    std::string err;
+    int failures = 0;
+
+    MappedWav w;
+    if (!w.create(path, 2, 48000, 3, &err, 24)) {
+        printf("FAIL create 24: %s\n", err.c_str());
+        return 1;
+    }
+    w.writeFrames(0, 3, src);
+    w.close();
+
+    MappedWav r;
+    int32_t got[6], right[3];
+    if (!r.openRead(path, &err) || r.bitsPerSample() != 24 || r.frames() != 3) {
+        printf("FAIL reopen 24: %s\n", err.c_str());
+        return 1;
+    }
+    r.readFrames(0, 3, got);
+    r.readChannel(1, 0, 3, right);
+    failures += memcmp(got, src, sizeof src) != 0;
+    failures += !(right[0] == src[1] && right[1] == src[3] && right[2] == src[5]);
+    r.close();
+
+    const int16_t narrow[2] = { -32768, 0x1234 };
+    if (!w.create(path, 1, 48000, 2, &err)) {
+        printf("FAIL create 16: %s\n", err.c_str());
+        return 1;
+    }
+    w.writeChannel(0, 0, 2, narrow);
+    w.close();
+    r.openRead(path, &err);
+    r.readChannel(0, 0, 2, got);
+    failures += !(got[0] == -0x800000 && got[1] == 0x123400);
+    printf("24-bit round trip: %d failures\n", failures);
+    return failures;
+}
+
+// fmt chunk cut off by the end of the file: rejected, nothing read past the map
+static int check_truncated(const std::string &path)
+{
+    static const uint8_t head[] = {
+        'R', 'I', 'F', 'F', 0x20, 0, 0, 0, 'W', 'A', 'V', 'E',
+        'f', 'm', 't', ' ', 40, 0, 0, 0,    // 40 bytes promised
+        0xFE, 0xFF, 2, 0,                   // ... 4 delivered
+    };
+    int failures = 0;
+    std::string err;
+    MappedWav r;
+    for (size_t len = 12; len <= sizeof head; len++) {
+        FILE *fp = fopen(path.c_str(), "wb");
+        fwrite(head, 1, len, fp);
+        fclose(fp);
+        bool opened = r.openRead(path, &err);
+        if (opened || (len >= 20 && err.find("fmt chunk") == std::string::npos)) {
+            printf("FAIL truncated file of %zu bytes: %s\n", len, opened ? "opened" : err.c_str());
+            failures++;
+        }
+    }
+    printf("truncated fmt chunk: %d failures\n", failures);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = check_round_trip("test_wav_file_16.wav") +
+                   check_extensible_24("test_wav_file_24.wav") +
+                   check_round_trip_24("test_wav_file_24.wav") +
+                   check_truncated("test_wav_file_24.wav");
+    remove("test_wav_file_16.wav");
+    remove("test_wav_file_24.wav");
+
+    if (failures) {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,321 @@
+// eq_render.cpp
+// Host tool: renders WAV files through the FPGA filter arithmetic with MCU-designed coefficients
+//
+// Build and run from host/:
+//   gcc -c -O2 -I../mcu/src ../mcu/src/calc_coefficient.c ../mcu/src/coeff_table.c ../mcu/src/coeff_table_data.c
+//   g++ -O3 -march=native -std=c++17 -pthread -Isrc -I../mcu/src tools/eq_render.cpp src/wav_file.cpp src/simd_cascade.cpp src/hw_model.cpp calc_coefficient.o coeff_table.o coeff_table_data.o -o eq_render
+//   ./eq_render --pots 1000,4095,2500 -o rendered/ song1.wav song2.wav
+//
+// Coefficients come from calcCoeffUpdate (the engine the firmware is built
+// with), simpleTestFilters, or 15 raw Q2.14 words in low/mid/high b0 b1 b2
+// a1 a2 order. Each (file, channel) pair is a job on the thread pool; every
+// job streams its channel through the mapped files in CHUNK_FRAMES pieces.
+//
+// Per-channel jobs match the bitstream: three_band_eq.sv keeps separate
+// filter state for left and right. --shared-state reproduces the older mono
+// datapath, which ran every l_r_clk edge through one set of filter state, so
+// stereo files are filtered as a single interleaved stream.
+//
+// The fixed-point path is the bitstream's 24-bit datapath (SimdCascade's fixed
+// mode, bit-exact with StereoEq): samples are read whole (16-bit files as
+// their samples * 2^8) and renders are written as 24-bit files, bit for bit
+// what audio_out_l/r carry. --float renders the ideal filter at the same
+// scale, rounded and saturated to 24 bits.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include "hw_model.h"
+#include "simd_cascade.h"
+#include "wav_file.h"
+
+extern "C" {
+#include "calc_coefficient.h"
+#include "calc_coefficient_config.h"
+}
+
+#define CHUNK_FRAMES 65536
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: eq_render [--pots L,M,H | --test N | --coeffs w0,...,w14]\n"
+            "                 [--float] [--shared-state] [--threads N] -o OUTDIR in.wav...\n");
+    exit(2);
+}
+
+static std::vector<long> parse_list(const char *s)
+{
+    std::vector<long> v;
+    char *end;
+    while (*s) {
+        v.push_back(strtol(s, &end, 0));
+        if (end == s) {
+            usage();
+        }
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return v;
+}
+
+static HwCoeffs to_hw(BiquadQ14 q)
+{
+    return { q.b0, q.b1, q.b2, q.a1, q.a2 };
+}
+
+// -----------------------------
+// Output Paths
+// -----------------------------
+
+// Device and inode of an existing file: every path that reaches it compares equal
+struct FileId {
+    dev_t dev = 0;
+    ino_t ino = 0;
+    bool operator==(const FileId &o) const { return dev == o.dev && ino == o.ino; }
+};
+
+static bool file_id(const std::string &path, FileId *id)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    *id = { st.st_dev, st.st_ino };
+    return true;
+}
+
+static std::string base_name(const std::string &path)
+{
+    size_t slash = path.find_last_of('/');
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+// Creating an output truncates it, so an output that is also an input (or an
+// earlier output) would wipe data other jobs are still reading or writing.
+// Inputs whose output clashes get an empty path and are skipped.
+static std::vector<std::string> output_paths(const std::vector<std::string> &inputs,
+                                             const std::string &outdir)
+{
+    std::string dir_real = outdir;
+    if (char *rp = realpath(outdir.c_str(), nullptr)) {
+        dir_real = rp;
+        free(rp);
+    }
+    std::vector<FileId> in_ids;
+    for (const std::string &path : inputs) {
+        FileId id;
+        if (file_id(path, &id)) {
+            in_ids.push_back(id);
+        }
+    }
+
+    std::vector<std::string> out(inputs.size()), canon(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        std::string name = base_name(inputs[i]);
+        std::string path = outdir + "/" + name;
+        FileId id;
+        bool exists = file_id(path, &id);
+        canon[i] = dir_real + "/" + name;
+        if (exists && std::find(in_ids.begin(), in_ids.end(), id) != in_ids.end()) {
+            fprintf(stderr, "skipping %s: output %s is an input\n", inputs[i].c_str(), path.c_str());
+            continue;
+        }
+        size_t j = 0;
+        for (; j < i; j++) {
+            FileId other;
+            if (!out[j].empty() &&
+                (canon[j] == canon[i] || (exists && file_id(out[j], &other) && other == id))) {
+                break;
+            }
+        }
+        if (j < i) {
+            fprintf(stderr, "skipping %s: output %s is also the output of %s\n",
+                    inputs[i].c_str(), path.c_str(), inputs[j].c_str());
+            continue;
+        }
+        out[i] = path;
+    }
+    return out;
+}
+
+// -----------------------------
+// Jobs
+// -----------------------------
+
+struct FileJob {
+    std::string in_path, out_path;
+    MappedWav in, out;
+    bool ok = false;
+};
+
+struct Job {
+    FileJob *file;
+    int channel;    // -1: all channels as one interleaved stream
+};
+
+struct RenderConfig {
+    HwCoeffs coeffs[ThreeBandEq::kNumStages];
+    CascadeMode mode = CascadeMode::Fixed;
+};
+
+static void run_job(const Job &job, const RenderConfig &cfg)
+{
+    const MappedWav &in = job.file->in;
+    MappedWav &out = job.file->out;
+    size_t width = (job.channel < 0) ? in.channels() : 1;
+    size_t samples = CHUNK_FRAMES * width;
+
+    // One filter stream per job: a channel's own bank, or (shared state) every
+    // sample through the left bank's state. Either way a stream only sees its
+    // own edges, and its output is published at its next edge.
+    SimdCascade eq(1, cfg.mode);
+    for (int s = 0; s < ThreeBandEq::kNumStages; s++) {
+        eq.setCoeffs(s, cfg.coeffs[s]);
+    }
+
+    std::vector<int32_t> buf(samples);
+    for (uint64_t f = 0; f < in.frames(); f += CHUNK_FRAMES) {
+        size_t n = (size_t)std::min<uint64_t>(CHUNK_FRAMES, in.frames() - f);
+        size_t m = n * width;
+        if (job.channel < 0) {
+            in.readFrames(f, n, buf.data());
+        } else {
+            in.readChannel(job.channel, f, n, buf.data());
+        }
+        eq.process(buf.data(), buf.data(), m);
+        if (job.channel < 0) {
+            out.writeFrames(f, n, buf.data());
+        } else {
+            out.writeChannel(job.channel, f, n, buf.data());
+        }
+        // Hand finished pages back. Another channel's job may still fault them
+        // in again, which costs a re-read but never changes the result.
+        in.release(f, n);
+        out.release(f, n);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    RenderConfig cfg;
+    std::vector<long> pots, words;
+    int test = -1;
+    bool shared = false;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string outdir;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if      (!strcmp(arg, "--float"))        { cfg.mode = CascadeMode::Float; continue; }
+        else if (!strcmp(arg, "--shared-state")) { shared = true; continue; }
+        else if (arg[0] != '-')                  { inputs.push_back(arg); continue; }
+        if (!val) {
+            usage();
+        }
+        if      (!strcmp(arg, "--pots"))    pots = parse_list(val);
+        else if (!strcmp(arg, "--coeffs"))  words = parse_list(val);
+        else if (!strcmp(arg, "--test"))    test = atoi(val);
+        else if (!strcmp(arg, "--threads")) threads = (unsigned)std::max(1, atoi(val));
+        else if (!strcmp(arg, "-o"))        outdir = val;
+        else usage();
+        i++;
+    }
+    if (outdir.empty() || inputs.empty()) {
+        usage();
+    }
+
+    // Coefficients, exactly as the firmware would produce and send them
+    ThreeBandCoeffs c = simpleTestFilters(0);
+    if (!words.empty()) {
+        if (words.size() != 15) {
+            fprintf(stderr, "--coeffs needs 15 words\n");
+            return 2;
+        }
+        int16_t *w = &c.low.b0;
+        for (int i = 0; i < 15; i++) {
+            w[i] = (int16_t)words[i];
+        }
+    } else if (!pots.empty()) {
+        if (pots.size() != 3) {
+            fprintf(stderr, "--pots needs 3 ADC codes\n");
+            return 2;
+        }
+        calcCoeffInit();
+        c = calcCoeffUpdate((uint16_t)pots[0], (uint16_t)pots[1], (uint16_t)pots[2]);
+    } else if (test >= 0) {
+        c = simpleTestFilters((uint8_t)test);
+    }
+    cfg.coeffs[0] = to_hw(c.low);
+    cfg.coeffs[1] = to_hw(c.mid);
+    cfg.coeffs[2] = to_hw(c.high);
+
+    // Map every file up front so errors surface before any work starts; output
+    // clashes are settled before anything is mapped
+    std::vector<std::string> out_paths = output_paths(inputs, outdir);
+    std::vector<std::unique_ptr<FileJob>> files;
+    std::vector<Job> jobs;
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const std::string &path = inputs[i];
+        if (out_paths[i].empty()) {
+            continue;
+        }
+        std::unique_ptr<FileJob> fj(new FileJob);
+        std::string err;
+        fj->in_path = path;
+        fj->out_path = out_paths[i];
+        if (!fj->in.openRead(path, &err) ||
+            !fj->out.create(fj->out_path, fj->in.channels(), fj->in.sampleRate(), fj->in.frames(), &err, 24)) {
+            fprintf(stderr, "skipping %s\n", err.c_str());
+            continue;
+        }
+        if (fj->in.sampleRate() * (shared ? fj->in.channels() : 1) != (uint32_t)FS) {
+            fprintf(stderr, "note: %s runs at %u Hz per filter stream; coefficients assume %.0f Hz\n",
+                    path.c_str(), fj->in.sampleRate() * (shared ? fj->in.channels() : 1), (double)FS);
+        }
+        fj->ok = true;
+        if (shared) {
+            jobs.push_back({ fj.get(), -1 });
+        } else {
+            for (int ch = 0; ch < fj->in.channels(); ch++) {
+                jobs.push_back({ fj.get(), ch });
+            }
+        }
+        files.push_back(std::move(fj));
+    }
+
+    // Thread pool: workers pull (file, channel) jobs until none are left
+    auto t0 = std::chrono::steady_clock::now();
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < std::min<size_t>(threads, jobs.size()); t++) {
+        pool.emplace_back([&] {
+            for (size_t j; (j = next.fetch_add(1)) < jobs.size();) {
+                run_job(jobs[j], cfg);
+            }
+        });
+    }
+    for (std::thread &th : pool) {
+        th.join();
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    uint64_t samples = 0;
+    for (const std::unique_ptr<FileJob> &fj : files) {
+        samples += fj->in.frames() * fj->in.channels();
+        fj->out.close();
+        printf("%s -> %s\n", fj->in_path.c_str(), fj->out_path.c_str());
+    }
+    printf("%zu file(s), %llu samples in %.2f s (%.1f Msamples/s, %zu threads)\n", files.size(),
+           (unsigned long long)samples, secs, samples / secs / 1e6, pool.size());
+    return files.size() == inputs.size() ? 0 : 1;
+}
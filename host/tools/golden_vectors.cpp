@@ -0,0 +1,223 @@
+// golden_vectors.cpp
+// Host tool: runs a stimulus through the golden model and writes $readmemh vectors
+// for fpga/testbenches/iir_time_mux_accum_tb.sv and three_band_eq_tb.sv
+//
+// Build and run from host/:
+//   gcc -c -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT ../mcu/src/calc_coefficient.c -o calc_coefficient.o
+//   g++ -O2 -std=c++17 -Isrc -I../mcu/src -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT tools/golden_vectors.cpp src/hw_model.cpp calc_coefficient.o -o golden_vectors
+//   ./golden_vectors --stages 3 --pots 1000,4095,2500 --stim sine:1000 --samples 4096 --out eq3
+//
+// Writes <out>_coeff.hex (5 words per stage, b0 b1 b2 a1 a2), <out>_in.hex
+// (one sample per l_r_clk edge) and <out>_out.hex (filtered_output after each
+// edge). Three-stage runs model the stereo three_band_eq: 24-bit samples,
+// --samples frames of left then right, the right carrying the negated stimulus
+// so a channel swap shows, both channels on the same coefficients, and
+// {audio_out_l, audio_out_r} packed into one 48-bit word per edge.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "hw_model.h"
+
+extern "C" {
+#include "calc_coefficient.h"
+}
+
+#define EDGE_FS         62500.0   // l_r_clk edge rate on the board (one stage, mono)
+#define FRAME_FS        31250.0   // Per-channel rate of the stereo cascade
+#define DEFAULT_SAMPLES 4096
+#define DEFAULT_AMP     0.5
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: golden_vectors [--stages 1|3] [--pots L,M,H | --coeffs w0,w1,...]\n"
+            "                      [--stim impulse|step|sine:HZ|sweep|noise] [--amp A]\n"
+            "                      [--samples N] [--fs HZ] [--seed S] --out PREFIX\n");
+    exit(2);
+}
+
+static std::vector<long> parse_list(const char *s)
+{
+    std::vector<long> v;
+    char *end;
+    while (*s) {
+        v.push_back(strtol(s, &end, 0));
+        if (end == s) {
+            usage();
+        }
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return v;
+}
+
+// Signal sample with two integer bits: Q2.14 for the 16-bit stage, Q2.22 for
+// the 24-bit cascade, the same scaling the testbenches use
+static int32_t to_fixed(double x, int bits)
+{
+    double one = std::ldexp(1.0, bits - 2), max = 2.0 * one - 1.0;
+    double scaled = std::round(x * one);
+    if (scaled > max) scaled = max;
+    if (scaled < -max - 1.0) scaled = -max - 1.0;
+    return (int32_t)scaled;
+}
+
+static std::vector<int32_t> make_stimulus(const std::string &stim, double amp, int samples,
+                                          double fs, uint32_t seed, int bits)
+{
+    std::vector<int32_t> v(samples);
+    for (int i = 0; i < samples; i++) {
+        double t = i / fs;
+        double x = 0.0;
+        if (stim == "impulse") {
+            x = (i == 0) ? amp : 0.0;
+        } else if (stim == "step") {
+            x = amp;
+        } else if (stim.rfind("sine:", 0) == 0) {
+            x = amp * std::sin(2.0 * M_PI * std::atof(stim.c_str() + 5) * t);
+        } else if (stim == "sweep") {
+            // Log sweep 20 Hz -> fs/2 over the whole run
+            double f0 = 20.0, f1 = fs / 2.0, T = samples / fs;
+            double k = std::log(f1 / f0);
+            x = amp * std::sin(2.0 * M_PI * f0 * T / k * (std::exp(t / T * k) - 1.0));
+        } else if (stim == "noise") {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            x = amp * ((double)seed / 2147483648.0 - 1.0);
+        } else {
+            usage();
+        }
+        v[i] = to_fixed(x, bits);
+    }
+    return v;
+}
+
+static FILE *open_hex(const std::string &path, const char *what)
+{
+    FILE *f = fopen(path.c_str(), "w");
+    if (!f) {
+        perror(path.c_str());
+        exit(1);
+    }
+    fprintf(f, "// %s - generated by host/tools/golden_vectors.cpp\n", what);
+    return f;
+}
+
+int main(int argc, char **argv)
+{
+    int stages = 3;
+    int samples = DEFAULT_SAMPLES;
+    double amp = DEFAULT_AMP;
+    double fs = 0.0;
+    uint32_t seed = 1;
+    std::string stim = "impulse";
+    std::string out;
+    std::vector<long> pots, words;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) {
+            usage();
+        }
+        if      (!strcmp(arg, "--stages"))  stages = atoi(val);
+        else if (!strcmp(arg, "--pots"))    pots = parse_list(val);
+        else if (!strcmp(arg, "--coeffs"))  words = parse_list(val);
+        else if (!strcmp(arg, "--stim"))    stim = val;
+        else if (!strcmp(arg, "--amp"))     amp = atof(val);
+        else if (!strcmp(arg, "--samples")) samples = atoi(val);
+        else if (!strcmp(arg, "--fs"))      fs = atof(val);
+        else if (!strcmp(arg, "--seed"))    seed = (uint32_t)strtoul(val, nullptr, 0);
+        else if (!strcmp(arg, "--out"))     out = val;
+        else usage();
+        i++;
+    }
+    if (out.empty() || (stages != 1 && stages != ThreeBandEq::kNumStages) || samples <= 0) {
+        usage();
+    }
+    if (fs <= 0.0) {
+        fs = stages == 1 ? EDGE_FS : FRAME_FS;
+    }
+
+    // Coefficients: explicit words, MCU design from pot codes, or passthrough
+    std::vector<HwCoeffs> coeffs(stages, kHwPassthrough);
+    if (!words.empty()) {
+        if ((int)words.size() != 5 * stages) {
+            fprintf(stderr, "--coeffs needs %d words\n", 5 * stages);
+            return 2;
+        }
+        for (int s = 0; s < stages; s++) {
+            const long *w = &words[5 * s];
+            coeffs[s] = { (int16_t)w[0], (int16_t)w[1], (int16_t)w[2],
+                          (int16_t)w[3], (int16_t)w[4] };
+        }
+    } else if (!pots.empty()) {
+        if ((int)pots.size() != stages) {
+            fprintf(stderr, "--pots needs %d ADC codes\n", stages);
+            return 2;
+        }
+        for (int s = 0; s < stages; s++) {
+            // A single stage uses the band the one pot is given for: the low shelf
+            BiquadQ14 q = calcCoeffBandFloat((CoeffBand)s, (uint16_t)pots[s]);
+            coeffs[s] = { q.b0, q.b1, q.b2, q.a1, q.a2 };
+        }
+    }
+
+    int bits = stages == 1 ? 16 : 24;
+    std::vector<int32_t> in = make_stimulus(stim, amp, samples, fs, seed, bits);
+    if (stages != 1) {
+        std::vector<int32_t> frames = in;
+        in.clear();
+        for (int32_t x : frames) {
+            in.push_back(x);
+            in.push_back(x == CascadeSection::kMin ? CascadeSection::kMax : -x);
+        }
+    }
+
+    FILE *f = open_hex(out + "_coeff.hex", "b0 b1 b2 a1 a2 per stage");
+    for (const HwCoeffs &c : coeffs) {
+        fprintf(f, "%04x\n%04x\n%04x\n%04x\n%04x\n", (uint16_t)c.b0, (uint16_t)c.b1,
+                (uint16_t)c.b2, (uint16_t)c.a1, (uint16_t)c.a2);
+    }
+    fclose(f);
+
+    f = open_hex(out + "_in.hex", "latest_sample per l_r_clk edge");
+    for (int32_t x : in) {
+        if (bits == 16) {
+            fprintf(f, "%04x\n", (uint16_t)x);
+        } else {
+            fprintf(f, "%06x\n", (uint32_t)x & 0xFFFFFF);
+        }
+    }
+    fclose(f);
+
+    f = open_hex(out + "_out.hex", stages == 1 ? "filtered_output after each edge"
+                                               : "{audio_out_l, audio_out_r} after each edge");
+    if (stages == 1) {
+        IirTimeMuxAccum m;
+        m.setCoeffs(coeffs[0]);
+        for (int32_t x : in) {
+            fprintf(f, "%04x\n", (uint16_t)m.edge((int16_t)x));
+        }
+    } else {
+        StereoEq m;
+        m.reset();
+        for (int ch = 0; ch < StereoEq::kNumChannels; ch++) {
+            for (int s = 0; s < stages; s++) {
+                m.setCoeffs(ch, s, coeffs[s]);
+            }
+        }
+        for (size_t i = 0; i < in.size(); i++) {
+            m.edge(in[i], (int)(i % 2));
+            fprintf(f, "%06x%06x\n", (uint32_t)m.output(0) & 0xFFFFFF, (uint32_t)m.output(1) & 0xFFFFFF);
+        }
+    }
+    fclose(f);
+
+    printf("%zu edges, %d stage(s) -> %s_{coeff,in,out}.hex\n", in.size(), stages, out.c_str());
+    return 0;
+}
@@ -23,4 +23,15 @@ void delay_millis(TIM_TypeDef * TIMx, uint32_t ms){
   TIMx->CNT = 0;      // Reset count
 
   while(!(TIMx->SR & 1)); // Wait for UIF to go high
-}
\ No newline at end of file
+}
+
+void initTIMPeriodic(TIM_TypeDef * TIMx, uint32_t hz){
+  // 1 MHz count, update (and update interrupt) every 1/hz seconds
+  TIMx->CR1 &= ~1;  // Stop while reprogramming
+  TIMx->PSC = (uint32_t) (SystemCoreClock/1e6) - 1;
+  TIMx->ARR = (1000000 / hz) - 1;
+  TIMx->EGR |= 1;     // Load PSC/ARR
+  TIMx->SR &= ~(0x1); // Clear the UIF the forced update just set
+  TIMx->DIER |= 1;    // UIE
+  TIMx->CR1 |= 1;     // Set CEN = 1
+}
@@ -15,5 +15,6 @@
 
 void initTIM(TIM_TypeDef * TIMx);
 void delay_millis(TIM_TypeDef * TIMx, uint32_t ms);
+void initTIMPeriodic(TIM_TypeDef * TIMx, uint32_t hz);  // Update interrupt at hz (>= 16 Hz)
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+// adc_scan.h
+// Timer-triggered, DMA-backed circular scan of the five pot channels
+
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include <stdint.h>
+
+// -----------------------------
+// Scan Geometry
+// -----------------------------
+
+#define ADC_SCAN_CHANNELS  5                        // Same order as values[] in STM32L432KC_ADC.c
+#define ADC_SCAN_DMA_LEN   (2 * ADC_SCAN_CHANNELS)  // Two scans: DMA half/full transfer each finish one
+#define ADC_SCAN_RATE_HZ   1000                     // Default trigger rate (one full scan per tick)
+
+// Called from the DMA interrupt after each new snapshot is published
+typedef void (*AdcScanCallback)(const uint16_t *snapshot, uint32_t seq);
+
+// -----------------------------
+// Register Layer (adc_scan_stm32.c on target, mocked in test/test_adc_scan.c)
+// -----------------------------
+
+/**
+ * @brief Start the timer-triggered scan with circular DMA into dma_buf
+ * @param dma_buf Buffer of ADC_SCAN_DMA_LEN words, owned by the DMA until adcScanHwStop
+ * @param rate_hz Scan trigger rate
+ */
+void adcScanHwStart(volatile uint16_t *dma_buf, uint32_t rate_hz);
+
+/**
+ * @brief Stop the trigger timer and the DMA channel
+ */
+void adcScanHwStop(void);
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Reset the snapshots and start scanning (configureADC() must have run on target)
+ * @param rate_hz Scan trigger rate, ADC_SCAN_RATE_HZ for the default
+ */
+void adcScanInit(uint32_t rate_hz);
+
+/**
+ * @brief Stop scanning; the last snapshot stays readable
+ */
+void adcScanStop(void);
+
+/**
+ * @brief Copy the latest complete scan without waiting for a conversion
+ * @param out Destination for ADC_SCAN_CHANNELS codes (all from the same scan)
+ * @return Sequence number of the copied scan, 0 if no scan has finished yet
+ */
+uint32_t adcScanRead(uint16_t out[ADC_SCAN_CHANNELS]);
+
+/**
+ * @brief Number of scans published so far
+ */
+uint32_t adcScanSequence(void);
+
+/**
+ * @brief Install (or clear with NULL) the per-snapshot callback; it runs in interrupt context
+ */
+void adcScanSetCallback(AdcScanCallback cb);
+
+/**
+ * @brief DMA half-transfer event: the first scan slot of the DMA buffer is complete
+ */
+void adcScanOnDmaHalf(void);
+
+/**
+ * @brief DMA transfer-complete event: the second scan slot of the DMA buffer is complete
+ */
+void adcScanOnDmaFull(void);
+
+#endif // ADC_SCAN_H
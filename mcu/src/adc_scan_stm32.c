@@ -0,0 +1,76 @@
+// adc_scan_stm32.c
+// Register layer for adc_scan.c: TIM6 TRGO triggers ADC1 scans, DMA1 channel 1 moves them
+
+#include "STM32L432KC.h"
+#include "adc_scan.h"
+
+#define ADC_EXTSEL_TIM6_TRGO 13     // RM0394 ADC external trigger EXT13
+#define ADC_EXTEN_RISING     1
+#define TIM6_TICK_HZ         1000000
+
+void adcScanHwStart(volatile uint16_t *dma_buf, uint32_t rate_hz)
+{
+    RCC->AHB1ENR  |= RCC_AHB1ENR_DMA1EN;
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM6EN;
+
+    // ADC config bits below are only writable with no conversion running
+    if (ADC1->CR & ADC_CR_ADSTART) {
+        ADC1->CR |= ADC_CR_ADSTP;
+        while (ADC1->CR & ADC_CR_ADSTP);
+    }
+
+    // DMA1 channel 1, request 0 (ADC1): DR -> dma_buf, 16-bit, circular, half/full interrupts
+    DMA1_Channel1->CCR &= ~DMA_CCR_EN;
+    DMA1_CSELR->CSELR &= ~DMA_CSELR_C1S;
+    DMA1_Channel1->CPAR  = (uint32_t)&ADC1->DR;
+    DMA1_Channel1->CMAR  = (uint32_t)dma_buf;
+    DMA1_Channel1->CNDTR = ADC_SCAN_DMA_LEN;
+    DMA1_Channel1->CCR   = _VAL2FLD(DMA_CCR_MSIZE, 1) |
+                           _VAL2FLD(DMA_CCR_PSIZE, 1) |
+                           DMA_CCR_MINC | DMA_CCR_CIRC |
+                           DMA_CCR_HTIE | DMA_CCR_TCIE;
+    DMA1->IFCR = DMA_IFCR_CGIF1;
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+    DMA1_Channel1->CCR |= DMA_CCR_EN;
+
+    // One hardware-triggered pass over the SQR1/SQR2 sequence per TIM6 update
+    ADC1->CFGR &= ~(ADC_CFGR_CONT | ADC_CFGR_EXTEN | ADC_CFGR_EXTSEL);
+    ADC1->CFGR |= ADC_CFGR_DMAEN | ADC_CFGR_DMACFG | ADC_CFGR_OVRMOD |
+                  _VAL2FLD(ADC_CFGR_EXTEN, ADC_EXTEN_RISING) |
+                  _VAL2FLD(ADC_CFGR_EXTSEL, ADC_EXTSEL_TIM6_TRGO);
+    ADC1->ISR = ADC_ISR_OVR | ADC_ISR_EOS | ADC_ISR_EOC;
+    ADC1->CR |= ADC_CR_ADSTART;  // Arms the trigger; nothing converts until TIM6 fires
+
+    // TIM6 update -> TRGO at rate_hz
+    TIM6->CR1 = 0;
+    TIM6->PSC = (SystemCoreClock / TIM6_TICK_HZ) - 1;
+    TIM6->ARR = (TIM6_TICK_HZ / rate_hz) - 1;
+    TIM6->CR2 = _VAL2FLD(TIM_CR2_MMS, 2);  // MMS = update
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->CR1 |= TIM_CR1_CEN;
+}
+
+void adcScanHwStop(void)
+{
+    TIM6->CR1 &= ~TIM_CR1_CEN;
+    if (ADC1->CR & ADC_CR_ADSTART) {
+        ADC1->CR |= ADC_CR_ADSTP;
+        while (ADC1->CR & ADC_CR_ADSTP);
+    }
+    NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+    DMA1_Channel1->CCR &= ~DMA_CCR_EN;
+}
+
+void DMA1_Channel1_IRQHandler(void)
+{
+    uint32_t isr = DMA1->ISR;
+
+    if (isr & DMA_ISR_HTIF1) {
+        DMA1->IFCR = DMA_IFCR_CHTIF1;
+        adcScanOnDmaHalf();
+    }
+    if (isr & DMA_ISR_TCIF1) {
+        DMA1->IFCR = DMA_IFCR_CTCIF1;
+        adcScanOnDmaFull();
+    }
+}
@@ -3,29 +3,24 @@
 // CORRECTED VERSION
 
 #include "calc_coefficient.h"
+#include "calc_coefficient_config.h"
 #include <math.h>
 
+#if COEFF_ENGINE == COEFF_ENGINE_TABLE
+#include "coeff_table.h"
+#elif COEFF_ENGINE == COEFF_ENGINE_FIXED
+#include "coeff_fixed.h"
+#endif
+
 // -----------------------------
 // Configuration
 // -----------------------------
 
-#define FS 63000.0f  // Fixed: actual sample rate is 63 kHz (was 48 kHz)
-#define Q  0.5f   // Sharper cutoff
-
-#define MAX_CUT_DB 10.0f 
-
 #define Q14_SHIFT 14
 #define Q14_SCALE (1 << Q14_SHIFT)
 
 #define M_PI 3.14159265358979323846f
 
-// ADC configuration
-#define ADC_MAX 4095.0f
-#define ADC_THRESHOLD 3850.0f  // Values above this are treated as max (1.0)
-
-// Unity gain detection threshold (0.1 dB = essentially flat)
-#define UNITY_GAIN_THRESHOLD_DB 0.1f
-
 // Moving average filter
 #define MA_SIZE 5
 
@@ -44,11 +39,32 @@ static MovingAverage ma_low;
 static MovingAverage ma_mid;
 static MovingAverage ma_high;
 
+// Latest moving-average outputs, consumed by calcCoeffDesignChanged
+static uint16_t filtered[COEFF_NUM_BANDS];
+static uint8_t  filtered_valid;
+
 // Current smoothed pot values
 static float pot_low_smooth  = 0.5f;
 static float pot_mid_smooth  = 0.5f;
 static float pot_high_smooth = 0.5f;
 
+// -----------------------------
+// Change Tracking State
+// -----------------------------
+
+typedef struct {
+    uint16_t applied;   // Smoothed ADC value the cached coefficients were designed for
+    uint8_t  valid;     // Cleared by calcCoeffInit so the first update designs every band
+} BandTracker;
+
+static BandTracker     trackers[COEFF_NUM_BANDS];
+static ThreeBandCoeffs coeffs_cache;
+static CoeffStats      stats;
+
+// Gain-index path: same hysteresis, separate trackers
+static BandTracker     index_trackers[COEFF_NUM_BANDS];
+static uint8_t         index_cache[COEFF_NUM_BANDS];
+
 // -----------------------------
 // Moving Average Functions
 // -----------------------------
@@ -163,17 +179,10 @@ static inline BiquadQ14 unity_gain_biquad(void)
 // Low Band: Low-Shelf Filter at 400 Hz (Q2.14 Output)
 // -----------------------------
 
-static BiquadQ14 low_shelf_coeffs_q14(float pot)
+static BiquadQ14 low_shelf_design_q14(float gainDB)
 {
-    float gainDB = pot_to_gain_db(pot);
-    
-    // If near unity gain, return bypass filter
-    if (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) {
-        return unity_gain_biquad();
-    }
-    
     float A = db_to_amplitude(gainDB);  // Use db/40 for shelving (RBJ standard)
-    float w0 = 2.0f * M_PI * 400.0f / FS;  // Higher = tighter bass control
+    float w0 = 2.0f * M_PI * LOW_SHELF_FREQ / FS;  // Higher = tighter bass control
   // 400 Hz transition
     float alpha = sinf(w0) / (2.0f * Q);
     float cosw0 = cosf(w0);
@@ -196,11 +205,7 @@ static BiquadQ14 low_shelf_coeffs_q14(float pot)
     return biquad_float_to_q14(b0, b1, b2, a1, a2);
 }
 
-// -----------------------------
-// Mid-Peaking (Q2.14 Output)
-// -----------------------------
-
-static BiquadQ14 mid_peaking_coeffs_q14(float pot)
+static BiquadQ14 low_shelf_coeffs_q14(float pot)
 {
     float gainDB = pot_to_gain_db(pot);
     
@@ -209,8 +214,17 @@ static BiquadQ14 mid_peaking_coeffs_q14(float pot)
         return unity_gain_biquad();
     }
     
+    return low_shelf_design_q14(gainDB);
+}
+
+// -----------------------------
+// Mid-Peaking (Q2.14 Output)
+// -----------------------------
+
+static BiquadQ14 mid_peaking_design_q14(float gainDB)
+{
     float A = db_to_amplitude(gainDB);  // Use db/40 for peaking (RBJ standard)
-    float w0 = 2.0f * M_PI * 1000.0f / FS;
+    float w0 = 2.0f * M_PI * MID_PEAK_FREQ / FS;
     float alpha = sinf(w0) / (2.0f * Q);
     float cosw0 = cosf(w0);
 
@@ -233,11 +247,7 @@ static BiquadQ14 mid_peaking_coeffs_q14(float pot)
     return biquad_float_to_q14(b0, b1, b2, a1, a2);
 }
 
-// -----------------------------
-// High-Shelf (Q2.14 Output)
-// -----------------------------
-
-static BiquadQ14 high_shelf_coeffs_q14(float pot)
+static BiquadQ14 mid_peaking_coeffs_q14(float pot)
 {
     float gainDB = pot_to_gain_db(pot);
     
@@ -246,8 +256,17 @@ static BiquadQ14 high_shelf_coeffs_q14(float pot)
         return unity_gain_biquad();
     }
     
+    return mid_peaking_design_q14(gainDB);
+}
+
+// -----------------------------
+// High-Shelf (Q2.14 Output)
+// -----------------------------
+
+static BiquadQ14 high_shelf_design_q14(float gainDB)
+{
     float A = db_to_amplitude(gainDB);  // Use db/40 for shelving (RBJ standard)
-    float w0 = 2.0f * M_PI * 2000.0f / FS;
+    float w0 = 2.0f * M_PI * HIGH_SHELF_FREQ / FS;
     float alpha = sinf(w0) / (2.0f * Q);
     float cosw0 = cosf(w0);
 
@@ -270,6 +289,54 @@ static BiquadQ14 high_shelf_coeffs_q14(float pot)
     return biquad_float_to_q14(b0, b1, b2, a1, a2);
 }
 
+static BiquadQ14 high_shelf_coeffs_q14(float pot)
+{
+    float gainDB = pot_to_gain_db(pot);
+    
+    // If near unity gain, return bypass filter
+    if (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) {
+        return unity_gain_biquad();
+    }
+    
+    return high_shelf_design_q14(gainDB);
+}
+
+// -----------------------------
+// Engine Dispatch
+// -----------------------------
+
+static BiquadQ14 design_band(CoeffBand band, uint16_t filtered)
+{
+#if COEFF_ENGINE == COEFF_ENGINE_TABLE
+    // Interpolated flash tables indexed by the smoothed ADC code (no libm)
+    return coeffTableLookup(band, filtered);
+#elif COEFF_ENGINE == COEFF_ENGINE_FIXED
+    // Integer-only RBJ design (no libm, no FPU)
+    return coeffFixedDesign(band, filtered);
+#else
+    return calcCoeffBandFloat(band, filtered);
+#endif
+}
+
+// Redesign one band only if its smoothed value left the hysteresis window
+static uint8_t track_band(CoeffBand band, uint16_t filtered, BiquadQ14 *slot)
+{
+    BandTracker *t = &trackers[band];
+    int32_t moved = (int32_t)filtered - (int32_t)t->applied;
+
+    if (t->valid && moved <= COEFF_HYSTERESIS && moved >= -COEFF_HYSTERESIS) {
+        stats.band_skips++;
+        return 0;
+    }
+
+    t->applied = filtered;
+    t->valid   = 1;
+    *slot = design_band(band, filtered);
+    stats.band_recomputes++;
+
+    return COEFF_BAND_MASK(band);
+}
+
 // -----------------------------
 // Public Functions
 // -----------------------------
@@ -279,10 +346,25 @@ void calcCoeffInit(void)
     ma_init(&ma_low);
     ma_init(&ma_mid);
     ma_init(&ma_high);
+    filtered_valid = 0;
     
     pot_low_smooth  = 0.5f;
     pot_mid_smooth  = 0.5f;
     pot_high_smooth = 0.5f;
+
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        trackers[band].applied = 0;
+        trackers[band].valid   = 0;
+        index_trackers[band].applied = 0;
+        index_trackers[band].valid   = 0;
+        index_cache[band] = COEFF_GAIN_STEPS - 1;
+    }
+    coeffs_cache = simpleTestFilters(0);
+
+    stats.updates         = 0;
+    stats.unchanged       = 0;
+    stats.band_recomputes = 0;
+    stats.band_skips      = 0;
 }
 
 ThreeBandCoeffs calcCoeffUpdate(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high)
@@ -300,13 +382,62 @@ ThreeBandCoeffs calcCoeffUpdate(uint16_t adc_low, uint16_t adc_mid, uint16_t adc
     pot_high_smooth = adc_to_pot(high_filtered);
     
     // Generate coefficients for each band
-    coeffs.low  = low_shelf_coeffs_q14(pot_low_smooth);   // CHANGED: Low-shelf at 400 Hz
-    coeffs.mid  = mid_peaking_coeffs_q14(pot_mid_smooth);
-    coeffs.high = high_shelf_coeffs_q14(pot_high_smooth);
+    coeffs.low  = design_band(COEFF_BAND_LOW,  low_filtered);   // CHANGED: Low-shelf at 400 Hz
+    coeffs.mid  = design_band(COEFF_BAND_MID,  mid_filtered);
+    coeffs.high = design_band(COEFF_BAND_HIGH, high_filtered);
     
     return coeffs;
 }
 
+void calcCoeffSmooth(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high)
+{
+    // Apply moving average filter to each ADC input
+    filtered[COEFF_BAND_LOW]  = ma_update(&ma_low,  adc_low);
+    filtered[COEFF_BAND_MID]  = ma_update(&ma_mid,  adc_mid);
+    filtered[COEFF_BAND_HIGH] = ma_update(&ma_high, adc_high);
+    filtered_valid = 1;
+
+    pot_low_smooth  = adc_to_pot(filtered[COEFF_BAND_LOW]);
+    pot_mid_smooth  = adc_to_pot(filtered[COEFF_BAND_MID]);
+    pot_high_smooth = adc_to_pot(filtered[COEFF_BAND_HIGH]);
+}
+
+uint8_t calcCoeffDesignChanged(ThreeBandCoeffs *coeffs)
+{
+    uint8_t changed = 0;
+
+    // Only bands whose knob actually moved are redesigned
+    if (filtered_valid) {
+        changed |= track_band(COEFF_BAND_LOW,  filtered[COEFF_BAND_LOW],  &coeffs_cache.low);
+        changed |= track_band(COEFF_BAND_MID,  filtered[COEFF_BAND_MID],  &coeffs_cache.mid);
+        changed |= track_band(COEFF_BAND_HIGH, filtered[COEFF_BAND_HIGH], &coeffs_cache.high);
+    }
+
+    stats.updates++;
+    if (!changed) {
+        stats.unchanged++;
+    }
+
+    if (coeffs) {
+        *coeffs = coeffs_cache;
+    }
+    return changed;
+}
+
+uint8_t calcCoeffUpdateChanged(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high,
+                               ThreeBandCoeffs *coeffs)
+{
+    calcCoeffSmooth(adc_low, adc_mid, adc_high);
+    return calcCoeffDesignChanged(coeffs);
+}
+
+void calcCoeffGetStats(CoeffStats *out)
+{
+    if (out) {
+        *out = stats;
+    }
+}
+
 void calcCoeffGetPotValues(float *pot_low, float *pot_mid, float *pot_high)
 {
     if (pot_low)  *pot_low  = pot_low_smooth;
@@ -314,6 +445,89 @@ void calcCoeffGetPotValues(float *pot_low, float *pot_mid, float *pot_high)
     if (pot_high) *pot_high = pot_high_smooth;
 }
 
+float calcCoeffAdcToGainDb(uint16_t adc)
+{
+    return pot_to_gain_db(adc_to_pot(adc));
+}
+
+BiquadQ14 calcCoeffDesign(CoeffBand band, float gain_db)
+{
+    switch (band) {
+        case COEFF_BAND_LOW:  return low_shelf_design_q14(gain_db);
+        case COEFF_BAND_MID:  return mid_peaking_design_q14(gain_db);
+        case COEFF_BAND_HIGH: return high_shelf_design_q14(gain_db);
+        default:              return unity_gain_biquad();
+    }
+}
+
+BiquadQ14 calcCoeffBandFloat(CoeffBand band, uint16_t adc)
+{
+    float pot = adc_to_pot(adc);
+
+    switch (band) {
+        case COEFF_BAND_LOW:  return low_shelf_coeffs_q14(pot);
+        case COEFF_BAND_MID:  return mid_peaking_coeffs_q14(pot);
+        case COEFF_BAND_HIGH: return high_shelf_coeffs_q14(pot);
+        default:              return unity_gain_biquad();
+    }
+}
+
+// -----------------------------
+// Gain Index
+// -----------------------------
+
+uint8_t calcCoeffGainIndex(uint16_t adc)
+{
+    const uint32_t threshold = (uint32_t)ADC_THRESHOLD;
+
+    if (adc >= threshold) {
+        return COEFF_GAIN_STEPS - 1;
+    }
+    return (uint8_t)((adc * (COEFF_GAIN_STEPS - 1) + threshold / 2) / threshold);
+}
+
+BiquadQ14 calcCoeffGainIndexDesign(CoeffBand band, uint8_t index)
+{
+    if (index > COEFF_GAIN_STEPS - 1) {
+        index = COEFF_GAIN_STEPS - 1;
+    }
+    float gainDB = pot_to_gain_db((float)index / (COEFF_GAIN_STEPS - 1));
+
+    if (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) {
+        return unity_gain_biquad();
+    }
+    return calcCoeffDesign(band, gainDB);
+}
+
+uint8_t calcCoeffGainIndexChanged(uint8_t index[COEFF_NUM_BANDS])
+{
+    uint8_t changed = 0;
+
+    if (filtered_valid) {
+        for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+            BandTracker *t = &index_trackers[band];
+            int32_t moved = (int32_t)filtered[band] - (int32_t)t->applied;
+
+            // The hysteresis keeps a pot resting on a step boundary from toggling the index
+            if (t->valid && moved <= COEFF_HYSTERESIS && moved >= -COEFF_HYSTERESIS) {
+                continue;
+            }
+            uint8_t idx = calcCoeffGainIndex(filtered[band]);
+            t->applied = filtered[band];
+            if (!t->valid || idx != index_cache[band]) {
+                index_cache[band] = idx;
+                changed |= COEFF_BAND_MASK(band);
+            }
+            t->valid = 1;
+        }
+    }
+
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        index[band] = index_cache[band];
+    }
+    return changed;
+}
+
 // -----------------------------
 // Simple Test Filters
 // -----------------------------
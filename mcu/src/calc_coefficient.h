@@ -7,6 +7,19 @@
 
 #include <stdint.h>
 
+// -----------------------------
+// Coefficient Engine Selection
+// -----------------------------
+
+// Engine used by calcCoeffUpdate (override with -DCOEFF_ENGINE=...)
+#define COEFF_ENGINE_FLOAT 0   // RBJ design in single-precision float every update
+#define COEFF_ENGINE_TABLE 1   // Interpolated lookup into flash tables (coeff_table.c)
+#define COEFF_ENGINE_FIXED 2   // Integer-only Q4.28 design, no libm or FPU (coeff_fixed.c)
+
+#ifndef COEFF_ENGINE
+#define COEFF_ENGINE COEFF_ENGINE_TABLE
+#endif
+
 // -----------------------------
 // Q2.14 Biquad Format
 // -----------------------------
@@ -29,6 +42,30 @@ typedef struct {
     BiquadQ14 high;
 } ThreeBandCoeffs;
 
+typedef enum {
+    COEFF_BAND_LOW = 0,   // Low-shelf at 400 Hz
+    COEFF_BAND_MID,       // Peaking at 1 kHz
+    COEFF_BAND_HIGH,      // High-shelf at 2 kHz
+    COEFF_NUM_BANDS
+} CoeffBand;
+
+#define COEFF_BAND_MASK(band) ((uint8_t)(1u << (band)))
+#define COEFF_BANDS_ALL       ((uint8_t)((1u << COEFF_NUM_BANDS) - 1))
+
+// -----------------------------
+// Change-Tracking Counters
+// -----------------------------
+
+// ADC codes a smoothed pot must move before its band is recomputed
+#define COEFF_HYSTERESIS 4
+
+typedef struct {
+    uint32_t updates;          // calcCoeffDesignChanged/UpdateChanged calls
+    uint32_t unchanged;        // ...that returned 0 (frame can be suppressed)
+    uint32_t band_recomputes;  // Band designs actually run
+    uint32_t band_skips;       // Band designs avoided by the hysteresis
+} CoeffStats;
+
 // -----------------------------
 // Public Functions
 // -----------------------------
@@ -47,6 +84,44 @@ void calcCoeffInit(void);
  */
 ThreeBandCoeffs calcCoeffUpdate(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high);
 
+/**
+ * @brief Update coefficients, redesigning only bands whose smoothed pot moved
+ *        by more than the hysteresis since their last design
+ * @param adc_low  ADC value for low band (0-4095)
+ * @param adc_mid  ADC value for mid band (0-4095)
+ * @param adc_high ADC value for high band (0-4095)
+ * @param coeffs   Pointer to store the current coefficients for all three bands
+ * @return Bitmask of redesigned bands (COEFF_BAND_MASK), 0 if nothing changed
+ *         and the SPI frame can be skipped
+ */
+uint8_t calcCoeffUpdateChanged(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high,
+                               ThreeBandCoeffs *coeffs);
+
+/**
+ * @brief Feed one ADC reading per band into the moving averages (no design work)
+ *
+ * Split from calcCoeffDesignChanged so a scheduler can smooth at the sampling
+ * rate and design at a lower one; calcCoeffUpdateChanged does both.
+ *
+ * @param adc_low  ADC value for low band (0-4095)
+ * @param adc_mid  ADC value for mid band (0-4095)
+ * @param adc_high ADC value for high band (0-4095)
+ */
+void calcCoeffSmooth(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high);
+
+/**
+ * @brief Redesign bands whose smoothed pot moved past the hysteresis since their last design
+ * @param coeffs Pointer to store the current coefficients for all three bands
+ * @return Bitmask of redesigned bands (COEFF_BAND_MASK), 0 before the first calcCoeffSmooth
+ */
+uint8_t calcCoeffDesignChanged(ThreeBandCoeffs *coeffs);
+
+/**
+ * @brief Get the change-tracking counters (reset by calcCoeffInit)
+ * @param stats Pointer to store the counters
+ */
+void calcCoeffGetStats(CoeffStats *stats);
+
 /**
  * @brief Get the current smoothed potentiometer values (0.0 to 1.0)
  * @param pot_low  Pointer to store smoothed low pot value
@@ -55,6 +130,65 @@ ThreeBandCoeffs calcCoeffUpdate(uint16_t adc_low, uint16_t adc_mid, uint16_t adc
  */
 void calcCoeffGetPotValues(float *pot_low, float *pot_mid, float *pot_high);
 
+// -----------------------------
+// Per-Band Design
+// -----------------------------
+
+/**
+ * @brief Map a smoothed ADC value to the band gain in dB
+ * @param adc Smoothed ADC value (0-4095)
+ * @return Gain in dB (-MAX_CUT_DB at 0, 0 dB at or above the ADC threshold)
+ */
+float calcCoeffAdcToGainDb(uint16_t adc);
+
+/**
+ * @brief Run the float RBJ design for one band at an arbitrary gain
+ * @param band    Band to design
+ * @param gain_db Gain in dB (no unity-gain shortcut is applied)
+ * @return BiquadQ14 with the quantized coefficients
+ */
+BiquadQ14 calcCoeffDesign(CoeffBand band, float gain_db);
+
+/**
+ * @brief Float coefficient path for one band, exactly as calcCoeffUpdate ran it
+ *        with COEFF_ENGINE_FLOAT (reference for the table engine)
+ * @param band Band to design
+ * @param adc  Smoothed ADC value (0-4095)
+ * @return BiquadQ14 with the quantized coefficients
+ */
+BiquadQ14 calcCoeffBandFloat(CoeffBand band, uint16_t adc);
+
+// -----------------------------
+// Gain Index (FPGA coefficient ROM, fpga/src/gain_rom.sv)
+// -----------------------------
+
+// Quantized band gains: index i is -MAX_CUT_DB * (1 - i / (COEFF_GAIN_STEPS - 1)) dB,
+// so the top index is 0 dB (unity). The FPGA looks the BiquadQ14 set up in a ROM
+// generated by mcu/tools/gen_gain_rom.c from calcCoeffGainIndexDesign.
+#define COEFF_GAIN_STEPS 64
+
+/**
+ * @brief Map a smoothed ADC value to the nearest gain index (integer only)
+ * @param adc Smoothed ADC value (0-4095)
+ * @return Index 0 to COEFF_GAIN_STEPS - 1
+ */
+uint8_t calcCoeffGainIndex(uint16_t adc);
+
+/**
+ * @brief Design one band at a gain index, with the same unity shortcut as the knob path
+ * @param band  Band to design
+ * @param index Gain index (clamped to COEFF_GAIN_STEPS - 1)
+ * @return BiquadQ14 the FPGA ROM holds for (band, index)
+ */
+BiquadQ14 calcCoeffGainIndexDesign(CoeffBand band, uint8_t index);
+
+/**
+ * @brief Gain-index counterpart of calcCoeffDesignChanged: no design work at all
+ * @param index Receives the current gain index of every band
+ * @return Bitmask of bands whose index changed, 0 before the first calcCoeffSmooth
+ */
+uint8_t calcCoeffGainIndexChanged(uint8_t index[COEFF_NUM_BANDS]);
+
 // -----------------------------
 // Simple Test Filters
 // -----------------------------
@@ -0,0 +1,28 @@
+// calc_coefficient_config.h
+// Filter design constants shared by the float, table and fixed-point coefficient engines
+
+#ifndef CALC_COEFFICIENT_CONFIG_H
+#define CALC_COEFFICIENT_CONFIG_H
+
+// -----------------------------
+// Configuration
+// -----------------------------
+
+#define FS 31250.0f  // Per channel: 12 MHz HSOSC / 384 clks per I2S frame (each channel filtered separately)
+#define Q  0.5f   // Sharper cutoff
+
+#define MAX_CUT_DB 10.0f 
+
+// Band center / corner frequencies
+#define LOW_SHELF_FREQ  400.0f   // Higher = tighter bass control
+#define MID_PEAK_FREQ   1000.0f
+#define HIGH_SHELF_FREQ 2000.0f
+
+// ADC configuration
+#define ADC_MAX 4095.0f
+#define ADC_THRESHOLD 3850.0f  // Values above this are treated as max (1.0)
+
+// Unity gain detection threshold (0.1 dB = essentially flat)
+#define UNITY_GAIN_THRESHOLD_DB 0.1f
+
+#endif // CALC_COEFFICIENT_CONFIG_H
@@ -0,0 +1,181 @@
+// cmd_proto.c
+// Command frame encoder, byte-at-a-time parser and payload packing
+
+#include <string.h>
+#include "cmd_proto.h"
+#include "crc16.h"
+
+// -----------------------------
+// Payloads
+// -----------------------------
+
+static uint8_t *put_le(uint8_t *p, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+static uint32_t get_le(const uint8_t *p, int bytes)
+{
+    uint32_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+void cmdPackCoeffs(const ThreeBandCoeffs *c, uint8_t out[CMD_COEFF_BYTES])
+{
+    const int16_t *w = &c->low.b0;
+    for (int k = 0; k < CMD_COEFF_BYTES / 2; k++) {
+        out = put_le(out, (uint16_t)w[k], 2);
+    }
+}
+
+void cmdUnpackCoeffs(const uint8_t in[CMD_COEFF_BYTES], ThreeBandCoeffs *c)
+{
+    int16_t *w = &c->low.b0;
+    for (int k = 0; k < CMD_COEFF_BYTES / 2; k++) {
+        w[k] = (int16_t)get_le(in + 2 * k, 2);
+    }
+}
+
+void cmdPackStatus(const CmdStatus *s, uint8_t out[CMD_STATUS_BYTES])
+{
+    uint8_t *p = out;
+    *p++ = s->mode;
+    *p++ = s->test_number;
+    *p++ = 0;
+    *p++ = 0;
+    p = put_le(p, s->tick, 4);
+    p = put_le(p, s->commands, 4);
+    p = put_le(p, s->crc_errors, 4);
+    p = put_le(p, s->rx_overruns, 4);
+    p = put_le(p, s->frames_sent, 4);
+    p = put_le(p, s->knob_latency_max, 4);
+    p = put_le(p, s->telem_dropped, 4);
+    for (int i = 0; i < 3; i++) {
+        p = put_le(p, s->pots[i], 2);
+    }
+    cmdPackCoeffs(&s->coeffs, p);
+}
+
+void cmdUnpackStatus(const uint8_t in[CMD_STATUS_BYTES], CmdStatus *s)
+{
+    const uint8_t *p = in;
+    s->mode        = p[0];
+    s->test_number = p[1];
+    s->reserved[0] = s->reserved[1] = 0;
+    p += 4;
+    s->tick             = get_le(p, 4); p += 4;
+    s->commands         = get_le(p, 4); p += 4;
+    s->crc_errors       = get_le(p, 4); p += 4;
+    s->rx_overruns      = get_le(p, 4); p += 4;
+    s->frames_sent      = get_le(p, 4); p += 4;
+    s->knob_latency_max = get_le(p, 4); p += 4;
+    s->telem_dropped    = get_le(p, 4); p += 4;
+    for (int i = 0; i < 3; i++) {
+        s->pots[i] = (uint16_t)get_le(p, 2);
+        p += 2;
+    }
+    cmdUnpackCoeffs(p, &s->coeffs);
+}
+
+// -----------------------------
+// Framing
+// -----------------------------
+
+enum {
+    ST_SOF,
+    ST_TYPE,
+    ST_LEN_LO,
+    ST_LEN_HI,
+    ST_PAYLOAD,
+    ST_CRC_LO,
+    ST_CRC_HI,
+};
+
+void cmdParserInit(CmdParser *p)
+{
+    p->state = ST_SOF;
+    p->crc_errors = 0;
+    p->length_errors = 0;
+}
+
+int cmdParserFeed(CmdParser *p, uint8_t byte)
+{
+    switch (p->state) {
+    case ST_SOF:
+        if (byte == CMD_SOF) {
+            p->crc = CRC16_INIT;
+            p->state = ST_TYPE;
+        }
+        return 0;
+
+    case ST_TYPE:
+        p->type = byte;
+        p->crc = crc16Update(p->crc, &byte, 1);
+        p->state = ST_LEN_LO;
+        return 0;
+
+    case ST_LEN_LO:
+        p->len = byte;
+        p->crc = crc16Update(p->crc, &byte, 1);
+        p->state = ST_LEN_HI;
+        return 0;
+
+    case ST_LEN_HI:
+        p->len |= (uint16_t)byte << 8;
+        p->crc = crc16Update(p->crc, &byte, 1);
+        if (p->len > CMD_MAX_PAYLOAD) {
+            p->length_errors++;
+            p->state = ST_SOF;
+            return 0;
+        }
+        p->pos = 0;
+        p->state = p->len ? ST_PAYLOAD : ST_CRC_LO;
+        return 0;
+
+    case ST_PAYLOAD:
+        p->payload[p->pos++] = byte;
+        p->crc = crc16Update(p->crc, &byte, 1);
+        if (p->pos == p->len) {
+            p->state = ST_CRC_LO;
+        }
+        return 0;
+
+    case ST_CRC_LO:
+        p->crc ^= byte;              // Low byte must cancel; checked with the high byte
+        p->state = ST_CRC_HI;
+        return 0;
+
+    case ST_CRC_HI:
+        p->state = ST_SOF;
+        if (p->crc != ((uint16_t)byte << 8)) {
+            p->crc_errors++;
+            return 0;
+        }
+        return 1;
+    }
+
+    p->state = ST_SOF;
+    return 0;
+}
+
+size_t cmdFrameEncode(uint8_t type, const uint8_t *payload, uint16_t len, uint8_t *out)
+{
+    out[0] = CMD_SOF;
+    out[1] = type;
+    out[2] = (uint8_t)len;
+    out[3] = (uint8_t)(len >> 8);
+    if (len) {
+        memcpy(out + CMD_HEADER_BYTES, payload, len);
+    }
+
+    uint16_t crc = crc16Update(CRC16_INIT, out + 1, CMD_HEADER_BYTES - 1 + len);
+    out[CMD_HEADER_BYTES + len]     = (uint8_t)crc;
+    out[CMD_HEADER_BYTES + len + 1] = (uint8_t)(crc >> 8);
+    return CMD_HEADER_BYTES + len + CMD_CRC_BYTES;
+}
@@ -0,0 +1,133 @@
+// cmd_proto.h
+// Host command protocol: framing and payload layouts (shared by the firmware and the host tools)
+
+#ifndef CMD_PROTO_H
+#define CMD_PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc_coefficient.h"
+
+// -----------------------------
+// Frame Format
+// -----------------------------
+
+// SOF, type, len(le16), payload[len], crc(le16). The CRC-16/CCITT covers type, len and payload.
+#define CMD_SOF          0xA5
+#define CMD_HEADER_BYTES 4
+#define CMD_CRC_BYTES    2
+#define CMD_MAX_PAYLOAD  1024      // Fits a full profDump() reply
+#define CMD_MAX_FRAME    (CMD_HEADER_BYTES + CMD_MAX_PAYLOAD + CMD_CRC_BYTES)
+
+// Requests; the reply to type T has type T | CMD_REPLY and starts with a CmdStatusCode byte
+typedef enum {
+    CMD_PING        = 0x01,   // -> protocol version
+    CMD_SET_COEFFS  = 0x02,   // 15 x le16: low/mid/high b0 b1 b2 a1 a2 (Q2.14); mode -> COEFFS
+    CMD_SET_POTS    = 0x03,   // 3 x le16: low/mid/high ADC codes (0-4095); mode -> POTS
+    CMD_SET_MODE    = 0x04,   // u8 mode (EqMode), u8 argument (test number for EQ_MODE_TEST)
+    CMD_GET_STATUS  = 0x05,   // -> CmdStatus
+    CMD_GET_PROFILE = 0x06,   // -> profDump() record (prof.h)
+} CmdType;
+
+#define CMD_REPLY         0x80
+#define CMD_PROTO_VERSION 1
+
+typedef enum {
+    CMD_OK          = 0,
+    CMD_ERR_LENGTH  = 1,
+    CMD_ERR_UNKNOWN = 2,
+    CMD_ERR_ARG     = 3,
+} CmdStatusCode;
+
+// -----------------------------
+// Payloads
+// -----------------------------
+
+// Where the coefficients come from
+typedef enum {
+    EQ_MODE_KNOBS  = 0,       // Pots through the smoothing and design path (power-on default)
+    EQ_MODE_POTS   = 1,       // Host-supplied ADC codes through the same path
+    EQ_MODE_COEFFS = 2,       // Host-supplied coefficients, sent as is
+    EQ_MODE_TEST   = 3,       // simpleTestFilters(test_number)
+    EQ_NUM_MODES
+} EqMode;
+
+#define CMD_TEST_FILTERS 6    // simpleTestFilters cases 0-5
+
+#define CMD_COEFF_BYTES  (2 * 5 * COEFF_NUM_BANDS)
+#define CMD_POTS_BYTES   6
+#define CMD_STATUS_BYTES (4 + 7 * 4 + CMD_POTS_BYTES + CMD_COEFF_BYTES)
+
+typedef struct {
+    uint8_t  mode;              // EqMode in effect
+    uint8_t  test_number;
+    uint8_t  reserved[2];
+    uint32_t tick;              // Scheduler ticks (ms)
+    uint32_t commands;          // Frames accepted
+    uint32_t crc_errors;
+    uint32_t rx_overruns;
+    uint32_t frames_sent;       // SPI coefficient frames
+    uint32_t knob_latency_max;  // Ticks
+    uint32_t telem_dropped;
+    uint16_t pots[3];           // ADC codes feeding the design (knobs or override)
+    ThreeBandCoeffs coeffs;     // Coefficients last sent to the FPGA
+} CmdStatus;
+
+/**
+ * @brief Serialize 15 coefficients, low/mid/high b0 b1 b2 a1 a2, little endian
+ */
+void cmdPackCoeffs(const ThreeBandCoeffs *c, uint8_t out[CMD_COEFF_BYTES]);
+
+/**
+ * @brief Inverse of cmdPackCoeffs
+ */
+void cmdUnpackCoeffs(const uint8_t in[CMD_COEFF_BYTES], ThreeBandCoeffs *c);
+
+/**
+ * @brief Serialize a status reply body (after the status code byte)
+ */
+void cmdPackStatus(const CmdStatus *s, uint8_t out[CMD_STATUS_BYTES]);
+
+/**
+ * @brief Inverse of cmdPackStatus
+ */
+void cmdUnpackStatus(const uint8_t in[CMD_STATUS_BYTES], CmdStatus *s);
+
+// -----------------------------
+// Parser
+// -----------------------------
+
+typedef struct {
+    uint8_t  state;
+    uint8_t  type;
+    uint16_t len;
+    uint16_t pos;
+    uint16_t crc;
+    uint32_t crc_errors;      // Complete frames rejected by the CRC
+    uint32_t length_errors;   // Headers announcing more than CMD_MAX_PAYLOAD
+    uint8_t  payload[CMD_MAX_PAYLOAD];
+} CmdParser;
+
+/**
+ * @brief Reset a parser to hunt for SOF (counters are cleared too)
+ */
+void cmdParserInit(CmdParser *p);
+
+/**
+ * @brief Feed one received byte
+ * @return 1 when a frame with a good CRC is complete: p->type, p->len, p->payload hold it
+ *         until the next call; 0 otherwise. Bad frames resync on the next SOF.
+ */
+int cmdParserFeed(CmdParser *p, uint8_t byte);
+
+/**
+ * @brief Build one frame
+ * @param type    Frame type
+ * @param payload Payload bytes (may be NULL when len is 0)
+ * @param len     Payload length, at most CMD_MAX_PAYLOAD
+ * @param out     Destination of CMD_HEADER_BYTES + len + CMD_CRC_BYTES bytes
+ * @return Frame length
+ */
+size_t cmdFrameEncode(uint8_t type, const uint8_t *payload, uint16_t len, uint8_t *out);
+
+#endif // CMD_PROTO_H
@@ -0,0 +1,170 @@
+// cmd_server.c
+// Command dispatch: every request is answered at once, control changes wait for the design tick
+
+#include <stddef.h>
+#include "cmd_server.h"
+#include "uart.h"
+#include "prof.h"
+
+#define RX_CHUNK 64
+
+// -----------------------------
+// State
+// -----------------------------
+
+static CmdParser   parser;
+static CmdStatusFn status_source;
+static CmdControl  staged;
+static uint8_t     staged_pending;
+static uint32_t    commands;
+static uint32_t    reply_drops;
+
+// Reply payload (status byte + body) and the encoded frame
+static uint8_t reply[CMD_MAX_PAYLOAD];
+static uint8_t frame[CMD_MAX_FRAME];
+
+// -----------------------------
+// Helper Functions
+// -----------------------------
+
+static void send_reply(uint8_t type, uint16_t len)
+{
+    size_t n = cmdFrameEncode(type | CMD_REPLY, reply, len, frame);
+    if (!uartWrite(frame, (uint32_t)n)) {
+        reply_drops++;   // Host stopped reading; never wait for it
+    }
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+// Returns the reply length (reply[0] is the status code)
+static uint16_t handle(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    reply[0] = CMD_OK;
+
+    switch (type) {
+    case CMD_PING:
+        reply[1] = CMD_PROTO_VERSION;
+        return 2;
+
+    case CMD_SET_COEFFS:
+        if (len != CMD_COEFF_BYTES) break;
+        cmdUnpackCoeffs(payload, &staged.coeffs);
+        staged.mode = EQ_MODE_COEFFS;
+        staged_pending = 1;
+        return 1;
+
+    case CMD_SET_POTS:
+        if (len != CMD_POTS_BYTES) break;
+        for (int i = 0; i < 3; i++) {
+            if (get16(payload + 2 * i) > 4095) {
+                reply[0] = CMD_ERR_ARG;
+                return 1;
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            staged.pots[i] = get16(payload + 2 * i);
+        }
+        staged.mode = EQ_MODE_POTS;
+        staged_pending = 1;
+        return 1;
+
+    case CMD_SET_MODE:
+        if (len != 2) break;
+        if (payload[0] >= EQ_NUM_MODES ||
+            (payload[0] == EQ_MODE_TEST && payload[1] >= CMD_TEST_FILTERS)) {
+            reply[0] = CMD_ERR_ARG;
+            return 1;
+        }
+        staged.mode = (EqMode)payload[0];
+        staged.test_number = payload[1];
+        staged_pending = 1;
+        return 1;
+
+    case CMD_GET_STATUS: {
+        if (len != 0) break;
+        CmdStatus s = { 0 };
+        if (status_source != NULL) {
+            status_source(&s);
+        }
+        s.commands    = commands;
+        s.crc_errors  = parser.crc_errors;
+        s.rx_overruns = uartRxOverruns();
+        cmdPackStatus(&s, reply + 1);
+        return 1 + CMD_STATUS_BYTES;
+    }
+
+    case CMD_GET_PROFILE: {
+        if (len != 0) break;
+        size_t n = profSerialize(reply + 1, sizeof reply - 1);
+        return (uint16_t)(1 + n);
+    }
+
+    default:
+        reply[0] = CMD_ERR_UNKNOWN;
+        return 1;
+    }
+
+    reply[0] = CMD_ERR_LENGTH;
+    return 1;
+}
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+void cmdServerInit(CmdStatusFn status_fn)
+{
+    cmdParserInit(&parser);
+    status_source = status_fn;
+    staged.mode = EQ_MODE_KNOBS;
+    staged.test_number = 0;
+    staged.coeffs = simpleTestFilters(0);
+    staged_pending = 0;
+    commands = 0;
+    reply_drops = 0;
+}
+
+void cmdServerPoll(void)
+{
+    uint8_t buf[RX_CHUNK];
+    uint32_t n;
+
+    while ((n = uartRead(buf, sizeof buf)) > 0) {
+        for (uint32_t i = 0; i < n; i++) {
+            if (cmdParserFeed(&parser, buf[i])) {
+                commands++;
+                uint16_t len = handle(parser.type, parser.payload, parser.len);
+                send_reply(parser.type, len);
+            }
+        }
+    }
+}
+
+int cmdServerTakeControl(CmdControl *out)
+{
+    if (!staged_pending) {
+        return 0;
+    }
+    *out = staged;
+    staged_pending = 0;
+    return 1;
+}
+
+uint32_t cmdServerCommands(void)
+{
+    return commands;
+}
+
+uint32_t cmdServerReplyDrops(void)
+{
+    return reply_drops;
+}
+
+uint32_t cmdServerCrcErrors(void)
+{
+    return parser.crc_errors;
+}
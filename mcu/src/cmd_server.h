@@ -0,0 +1,50 @@
+// cmd_server.h
+// Firmware side of the host command protocol: parses UART frames, stages control updates
+
+#ifndef CMD_SERVER_H
+#define CMD_SERVER_H
+
+#include <stdint.h>
+#include "cmd_proto.h"
+
+// Control state requested by the host; applied as a whole at the next design tick
+typedef struct {
+    EqMode          mode;
+    uint8_t         test_number;
+    uint16_t        pots[3];      // EQ_MODE_POTS: ADC codes low/mid/high
+    ThreeBandCoeffs coeffs;       // EQ_MODE_COEFFS
+} CmdControl;
+
+// Fills the live parts of a status reply (the server adds its own counters)
+typedef void (*CmdStatusFn)(CmdStatus *status);
+
+/**
+ * @brief Reset the parser and the staged control (mode EQ_MODE_KNOBS)
+ * @param status_fn Provider for CMD_GET_STATUS replies
+ */
+void cmdServerInit(CmdStatusFn status_fn);
+
+/**
+ * @brief Handle every complete frame received so far and queue the replies (never waits)
+ */
+void cmdServerPoll(void);
+
+/**
+ * @brief Take the control state if the host changed it since the last call
+ * @param out Receives the complete staged control
+ * @return 1 if out was updated, 0 if nothing changed
+ */
+int cmdServerTakeControl(CmdControl *out);
+
+/**
+ * @brief Frames accepted, and replies dropped because the TX ring was full
+ */
+uint32_t cmdServerCommands(void);
+uint32_t cmdServerReplyDrops(void);
+
+/**
+ * @brief Frames rejected by the CRC
+ */
+uint32_t cmdServerCrcErrors(void);
+
+#endif // CMD_SERVER_H
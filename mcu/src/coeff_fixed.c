@@ -0,0 +1,244 @@
+// coeff_fixed.c
+// Integer-only RBJ coefficient designer: same BiquadQ14 outputs as the float path,
+// built with CORDIC trig, a polynomial 10^(dB/40) and Q4.28 intermediates.
+// No libm, no FPU, no divides. Loops have fixed trip counts and the other
+// branches only pick between short alternatives (CORDIC direction, rounding
+// sign, saturation), but the unity-gain shortcut returns before any of it: a
+// call is a handful of instructions on that path and a full shelf or peak
+// design otherwise (about 30x apart on the host). test_coeff_fixed reports
+// the host best and worst case per band; on the board, main.c's "design" PROF
+// scope gives the DWT min/max per update.
+
+#include "coeff_fixed.h"
+#include "calc_coefficient_config.h"
+
+// -----------------------------
+// Compile-Time Constants
+// -----------------------------
+
+#define PI_D   3.14159265358979323846
+#define LN10_D 2.30258509299404568402
+
+#define TO_Q28(x) ((int32_t)((x) * (double)Q28_ONE + ((x) >= 0 ? 0.5 : -0.5)))
+
+// w0 = 2*pi*f/FS per band
+static const int32_t w0_q28[COEFF_NUM_BANDS] = {
+    TO_Q28(2.0 * PI_D * LOW_SHELF_FREQ  / FS),
+    TO_Q28(2.0 * PI_D * MID_PEAK_FREQ   / FS),
+    TO_Q28(2.0 * PI_D * HIGH_SHELF_FREQ / FS),
+};
+
+#define INV_2Q_Q28 TO_Q28(1.0 / (2.0 * Q))
+
+// ln(A) per ADC code below the threshold: x = -(ADC_THRESHOLD - adc) * K, K in Q12.40
+#define ADC_THRESHOLD_CODE ((int32_t)ADC_THRESHOLD)
+#define LN_A_PER_CODE_Q40  ((int64_t)(MAX_CUT_DB * LN10_D / (40.0 * ADC_THRESHOLD) \
+                                      * 1099511627776.0 + 0.5))
+
+// |gain| < UNITY_GAIN_THRESHOLD_DB  <=>  (ADC_THRESHOLD - adc) < UNITY_SPAN (Q24.8 codes)
+#define UNITY_SPAN_Q8 ((int32_t)(UNITY_GAIN_THRESHOLD_DB * ADC_THRESHOLD / MAX_CUT_DB * 256.0))
+
+// -----------------------------
+// Q4.28 Arithmetic
+// -----------------------------
+
+static inline int32_t mul_q28(int32_t a, int32_t b)
+{
+    return (int32_t)(((int64_t)a * b + (1 << (Q28_SHIFT - 1))) >> Q28_SHIFT);
+}
+
+// 1/x for x in [1/4, 8): normalize to [0.5, 1), three Newton-Raphson steps
+static int32_t recip_q28(int32_t x)
+{
+    int s = __builtin_clz((uint32_t)x) - 1;      // x << s lands in [2^30, 2^31)
+    int64_t v = (int64_t)((uint32_t)x << s);     // v in Q1.31, 0.5 <= v < 1
+
+    // Seed y = 48/17 - 32/17 v (Q2.30), max error 1/17
+    int64_t y = 3031741621LL - ((2021161080LL * v) >> 31);
+
+    for (int i = 0; i < 3; i++) {
+        int64_t e = (v * y) >> 31;                // v*y in Q2.30
+        y = (y * ((2LL << 30) - e)) >> 30;
+    }
+
+    // 1/x = (1/v) * 2^(s - 3); Q2.30 -> Q4.28 is a further >> 2
+    int shift = 5 - s;
+    return (int32_t)((y + (1LL << (shift - 1))) >> shift);
+}
+
+// Q4.28 -> Q2.14, round half away from zero like lroundf, then saturate
+static inline int16_t q28_to_q14(int32_t x)
+{
+    const int shift = Q28_SHIFT - 14;
+    int32_t q = (x >= 0) ?  ((x + (1 << (shift - 1))) >> shift)
+                         : -((-x + (1 << (shift - 1))) >> shift);
+
+    if (q >  32767) q =  32767;
+    if (q < -32768) q = -32768;
+
+    return (int16_t)q;
+}
+
+static inline BiquadQ14 biquad_q28_to_q14(int32_t b0, int32_t b1, int32_t b2,
+                                          int32_t a0, int32_t a1, int32_t a2)
+{
+    int32_t inv_a0 = recip_q28(a0);
+    BiquadQ14 q;
+
+    q.b0 = q28_to_q14(mul_q28(b0, inv_a0));
+    q.b1 = q28_to_q14(mul_q28(b1, inv_a0));
+    q.b2 = q28_to_q14(mul_q28(b2, inv_a0));
+    q.a1 = q28_to_q14(mul_q28(a1, inv_a0));
+    q.a2 = q28_to_q14(mul_q28(a2, inv_a0));
+
+    return q;
+}
+
+// -----------------------------
+// Exponential (Horner, Taylor to x^10)
+// -----------------------------
+
+static const int32_t exp_coeffs_q28[11] = {
+    268435456, 268435456, 134217728, 44739243, 11184811,
+    2236962, 372827, 53261, 6658, 740, 74
+};
+
+int32_t coeffFixedExpQ28(int32_t x_q28)
+{
+    int32_t p = exp_coeffs_q28[10];
+
+    for (int k = 9; k >= 0; k--) {
+        p = exp_coeffs_q28[k] + mul_q28(x_q28, p);
+    }
+    return p;
+}
+
+// -----------------------------
+// CORDIC Sine / Cosine
+// -----------------------------
+
+#define CORDIC_ITERATIONS 28
+#define CORDIC_GAIN_INV_Q28 163008219  // prod 1/sqrt(1 + 2^-2i)
+
+static const int32_t cordic_atan_q28[CORDIC_ITERATIONS] = {
+    210828714, 124459457, 65760959, 33381290, 16755422, 8385879, 4193963,
+    2097109, 1048571, 524287, 262144, 131072, 65536, 32768, 16384, 8192,
+    4096, 2048, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2
+};
+
+void coeffFixedSinCos(int32_t angle_q28, int32_t *sin_q28, int32_t *cos_q28)
+{
+    // CORDIC converges for |z| < ~1.74 rad; fold (pi/2, pi] onto [0, pi/2)
+    const int32_t half_pi = TO_Q28(PI_D / 2.0);
+    int flip = angle_q28 > half_pi;
+    int32_t z = flip ? TO_Q28(PI_D) - angle_q28 : angle_q28;
+
+    int32_t x = CORDIC_GAIN_INV_Q28;
+    int32_t y = 0;
+
+    for (int i = 0; i < CORDIC_ITERATIONS; i++) {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+
+        if (z >= 0) {
+            x -= dx;
+            y += dy;
+            z -= cordic_atan_q28[i];
+        } else {
+            x += dx;
+            y -= dy;
+            z += cordic_atan_q28[i];
+        }
+    }
+
+    if (sin_q28) *sin_q28 = y;
+    if (cos_q28) *cos_q28 = flip ? -x : x;
+}
+
+// -----------------------------
+// Band Designs (RBJ Audio EQ Cookbook)
+// -----------------------------
+
+static BiquadQ14 low_shelf_fixed(int32_t A, int32_t sqrtA, int32_t cosw0, int32_t alpha)
+{
+    int32_t t    = 2 * mul_q28(sqrtA, alpha);   // 2*sqrt(A)*alpha
+    int32_t Ap1  = A + Q28_ONE;
+    int32_t Am1  = A - Q28_ONE;
+    int32_t Am1c = mul_q28(Am1, cosw0);
+    int32_t Ap1c = mul_q28(Ap1, cosw0);
+
+    return biquad_q28_to_q14(
+             mul_q28(A, Ap1 - Am1c + t),
+         2 * mul_q28(A, Am1 - Ap1c),
+             mul_q28(A, Ap1 - Am1c - t),
+                        Ap1 + Am1c + t,
+                 -2 * (Am1 + Ap1c),
+                        Ap1 + Am1c - t);
+}
+
+static BiquadQ14 mid_peaking_fixed(int32_t A, int32_t cosw0, int32_t alpha)
+{
+    int32_t alpha_A     = mul_q28(alpha, A);
+    int32_t alpha_Ainv  = mul_q28(alpha, recip_q28(A));
+
+    return biquad_q28_to_q14(
+        Q28_ONE + alpha_A,
+        -2 * cosw0,
+        Q28_ONE - alpha_A,
+        Q28_ONE + alpha_Ainv,
+        -2 * cosw0,
+        Q28_ONE - alpha_Ainv);
+}
+
+static BiquadQ14 high_shelf_fixed(int32_t A, int32_t sqrtA, int32_t cosw0, int32_t alpha)
+{
+    int32_t t    = 2 * mul_q28(sqrtA, alpha);
+    int32_t Ap1  = A + Q28_ONE;
+    int32_t Am1  = A - Q28_ONE;
+    int32_t Am1c = mul_q28(Am1, cosw0);
+    int32_t Ap1c = mul_q28(Ap1, cosw0);
+
+    return biquad_q28_to_q14(
+              mul_q28(A, Ap1 + Am1c + t),
+         -2 * mul_q28(A, Am1 + Ap1c),
+              mul_q28(A, Ap1 + Am1c - t),
+                         Ap1 - Am1c + t,
+                   2 * (Am1 - Ap1c),
+                         Ap1 - Am1c - t);
+}
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+BiquadQ14 coeffFixedDesign(CoeffBand band, uint16_t adc)
+{
+    if (adc > 4095) {
+        adc = 4095;
+    }
+
+    int32_t span = ADC_THRESHOLD_CODE - (int32_t)adc;  // codes below full scale
+    if (span < 0) {
+        span = 0;
+    }
+
+    // Same unity-gain shortcut as the float path
+    if ((span << 8) < UNITY_SPAN_Q8 || band >= COEFF_NUM_BANDS) {
+        return simpleUnity();
+    }
+
+    // A = 10^(gain/40) = e^x and sqrt(A) = e^(x/2), x = gain * ln(10) / 40
+    int32_t x     = -(int32_t)((span * LN_A_PER_CODE_Q40 + (1 << 11)) >> 12);
+    int32_t A     = coeffFixedExpQ28(x);
+    int32_t sqrtA = coeffFixedExpQ28(x / 2);
+
+    int32_t sinw0, cosw0;
+    coeffFixedSinCos(w0_q28[band], &sinw0, &cosw0);
+    int32_t alpha = mul_q28(sinw0, INV_2Q_Q28);
+
+    switch (band) {
+        case COEFF_BAND_LOW:  return low_shelf_fixed(A, sqrtA, cosw0, alpha);
+        case COEFF_BAND_MID:  return mid_peaking_fixed(A, cosw0, alpha);
+        default:              return high_shelf_fixed(A, sqrtA, cosw0, alpha);
+    }
+}
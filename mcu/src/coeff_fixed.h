@@ -0,0 +1,47 @@
+// coeff_fixed.h
+// Integer-only RBJ coefficient designer (Q4.28 intermediates, no libm or FPU)
+
+#ifndef COEFF_FIXED_H
+#define COEFF_FIXED_H
+
+#include <stdint.h>
+#include "calc_coefficient.h"
+
+// -----------------------------
+// Q4.28 Format
+// -----------------------------
+
+#define Q28_SHIFT 28
+#define Q28_ONE   ((int32_t)1 << Q28_SHIFT)
+
+// Largest difference (in Q2.14 LSBs) from calcCoeffBandFloat over all ADC codes
+#define COEFF_FIXED_MAX_LSB_ERR 1
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Design one band's coefficients in pure integer arithmetic
+ * @param band Band to design
+ * @param adc  Smoothed ADC value (0-4095)
+ * @return BiquadQ14 within COEFF_FIXED_MAX_LSB_ERR of calcCoeffBandFloat(band, adc)
+ */
+BiquadQ14 coeffFixedDesign(CoeffBand band, uint16_t adc);
+
+/**
+ * @brief Fixed-point e^x (10^(dB/40) = e^(dB * ln(10) / 40))
+ * @param x_q28 Exponent in Q4.28 (-1.0 to +1.0)
+ * @return e^x in Q4.28
+ */
+int32_t coeffFixedExpQ28(int32_t x_q28);
+
+/**
+ * @brief CORDIC sine and cosine
+ * @param angle_q28 Angle in radians, Q4.28 (0 to pi)
+ * @param sin_q28   Pointer to store sin(angle) in Q4.28
+ * @param cos_q28   Pointer to store cos(angle) in Q4.28
+ */
+void coeffFixedSinCos(int32_t angle_q28, int32_t *sin_q28, int32_t *cos_q28);
+
+#endif // COEFF_FIXED_H
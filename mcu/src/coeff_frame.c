@@ -0,0 +1,567 @@
+// coeff_frame.c
+// v2/v3/v4/v5 coefficient frame packer/parser, double-buffered DMA send queue and frame confirmation
+
+#include <stddef.h>
+#include "coeff_frame.h"
+#include "crc16.h"
+
+// Keeps the compiler from moving buffer writes across the handoff flags.
+// The completion interrupt runs to the end before main resumes, so this is all the M4 needs.
+#define FRAME_BARRIER() __asm volatile("" ::: "memory")
+
+// Send queue kinds: the two wire kinds of v2 frames, plus v4
+#define SEND_SECTIONS 2
+
+// -----------------------------
+// State
+// -----------------------------
+
+// buffers[wire] belongs to the DMA while busy; main packs into the other one.
+// Only main sets pending and only the interrupt chains a pending frame while busy,
+// so neither side needs to mask interrupts.
+static uint8_t           buffers[2][COEFF_FRAME_WIDE_MAX_BYTES];   // The longest frame is a v4 one
+static uint32_t          lengths[2];
+static volatile uint8_t  wire;
+static volatile uint8_t  busy;
+static volatile uint8_t  pending;
+static volatile uint32_t started;
+static volatile uint32_t completed;
+
+// The frame left waiting by the last coeffFrameSend (main only)
+static uint8_t  queued;
+static uint8_t  queued_kind;
+static uint16_t queued_mask;
+static uint8_t  queued_seq;
+static uint32_t queued_at;       // started when it was queued
+static uint8_t  next_seq;
+static uint8_t  last_seq;
+static uint8_t  seqs[2];         // Sequence number packed in each buffer
+
+// MISO bytes of the transfer on the wire. The interrupt decodes the status word
+// before it chains the next transfer or clears busy; main reads it only while idle.
+static uint8_t           rx_buf[COEFF_FRAME_WIDE_MAX_BYTES];
+static const uint8_t     poll_buf[COEFF_FRAME_STATUS_BYTES];   // All 0x00: a status poll
+static uint8_t           read_buf[COEFF_FRAME_READ_BYTES];     // 0x00, register index, then 0x00
+static uint8_t           config_buf[COEFF_FRAME_CONFIG_BYTES];
+static uint8_t           status_tagged;
+static CoeffFrameStatus  status;
+static uint8_t           reading;  // The transfer on the wire is read_buf
+static uint8_t           read_done;  // The latest read completed with the status tag
+static uint32_t          read_value;
+static uint32_t          sent_at;  // Transfer (counting from 0) that carried the last frame
+static uint8_t           sent_seq;
+static uint8_t           sent_any;
+
+// Frame confirmation (main only)
+static uint32_t checked;         // completed when the status was last evaluated
+static uint8_t  ack;
+static uint8_t  synced;
+static uint8_t  count_offset;    // FPGA transaction count minus ours, mod 256
+static uint8_t  mismatches;
+static uint8_t  rejected_seen;   // status.rejected when the status was last evaluated
+static uint32_t losses;
+
+// -----------------------------
+// Packing
+// -----------------------------
+
+static uint8_t *put16(uint8_t *p, uint16_t w)
+{
+    *p++ = (uint8_t)(w >> 8);
+    *p++ = (uint8_t)w;
+    return p;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint8_t *put_section(uint8_t *p, const BiquadQ14 *q)
+{
+    p = put16(p, (uint16_t)q->b0);
+    p = put16(p, (uint16_t)q->b1);
+    p = put16(p, (uint16_t)q->b2);
+    p = put16(p, (uint16_t)q->a1);
+    return put16(p, (uint16_t)q->a2);
+}
+
+static void get_section(const uint8_t *p, BiquadQ14 *q)
+{
+    q->b0 = (int16_t)get16(p);
+    q->b1 = (int16_t)get16(p + 2);
+    q->b2 = (int16_t)get16(p + 4);
+    q->a1 = (int16_t)get16(p + 6);
+    q->a2 = (int16_t)get16(p + 8);
+}
+
+uint32_t coeffFrameBytes(uint8_t mask, CoeffFrameKind kind)
+{
+    uint32_t per_band = kind == COEFF_FRAME_INDICES ? 1 : COEFF_FRAME_BAND_BYTES;
+    uint32_t n = COEFF_FRAME_HEADER_BYTES + COEFF_FRAME_CRC_BYTES;
+    for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+        if (mask & COEFF_BAND_MASK(b)) n += per_band;
+    }
+    return n;
+}
+
+static uint32_t finish(uint8_t *buf, uint8_t *p)
+{
+    uint32_t n = (uint32_t)(p - buf);
+    put16(p, crc16Update(CRC16_INIT, buf, n));
+    return n + COEFF_FRAME_CRC_BYTES;
+}
+
+uint32_t coeffFramePackChannels(uint8_t *buf, uint8_t channels, CoeffFrameKind kind, uint8_t mask,
+                                uint8_t seq, const ThreeBandCoeffs *coeffs,
+                                const uint8_t index[COEFF_NUM_BANDS])
+{
+    uint8_t *p = buf;
+    uint8_t linked = (channels & COEFF_CHANNELS_BOTH) == COEFF_CHANNELS_BOTH;
+
+    *p++ = COEFF_FRAME_HEADER_FOR(linked ? COEFF_FRAME_VERSION : COEFF_FRAME_VERSION_CHANNELS, mask, kind);
+    *p++ = seq;
+    if (!linked) *p++ = channels & COEFF_CHANNELS_BOTH;
+
+    for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+        if (!(mask & COEFF_BAND_MASK(b))) continue;
+        if (kind == COEFF_FRAME_INDICES) {
+            *p++ = index[b];
+            continue;
+        }
+        p = put_section(p, b == 0 ? &coeffs->low : b == 1 ? &coeffs->mid : &coeffs->high);
+    }
+    return finish(buf, p);
+}
+
+uint32_t coeffFramePack(uint8_t *buf, uint8_t mask, uint8_t seq, const ThreeBandCoeffs *coeffs)
+{
+    return coeffFramePackChannels(buf, COEFF_CHANNELS_BOTH, COEFF_FRAME_COEFFS, mask, seq, coeffs, NULL);
+}
+
+uint32_t coeffFramePackIndices(uint8_t *buf, uint8_t mask, uint8_t seq,
+                               const uint8_t index[COEFF_NUM_BANDS])
+{
+    return coeffFramePackChannels(buf, COEFF_CHANNELS_BOTH, COEFF_FRAME_INDICES, mask, seq, NULL, index);
+}
+
+uint32_t coeffFrameWideBytes(uint16_t mask)
+{
+    uint32_t n = COEFF_FRAME_WIDE_HEADER_BYTES + COEFF_FRAME_CRC_BYTES;
+    for (int s = 0; s < COEFF_MAX_SECTIONS; s++) {
+        if (mask & (1u << s)) n += COEFF_FRAME_BAND_BYTES;
+    }
+    return n;
+}
+
+uint32_t coeffFramePackSections(uint8_t *buf, uint8_t channels, uint16_t mask, uint8_t seq,
+                                const BiquadQ14 *sections)
+{
+    uint8_t *p = buf;
+
+    *p++ = COEFF_FRAME_HEADER_FOR(COEFF_FRAME_VERSION_WIDE, 0, COEFF_FRAME_COEFFS);
+    *p++ = seq;
+    *p++ = channels & COEFF_CHANNELS_BOTH;
+    p = put16(p, mask);
+
+    for (int s = 0; s < COEFF_MAX_SECTIONS; s++) {
+        if (mask & (1u << s)) p = put_section(p, &sections[s]);
+    }
+    return finish(buf, p);
+}
+
+uint32_t coeffFramePackBypass(uint8_t *buf, uint8_t channels, uint16_t flags, uint8_t seq)
+{
+    uint8_t *p = buf;
+
+    *p++ = COEFF_FRAME_HEADER_FOR(COEFF_FRAME_VERSION_BYPASS, 0, COEFF_FRAME_COEFFS);
+    *p++ = seq;
+    *p++ = channels & COEFF_CHANNELS_BOTH;
+    p = put16(p, flags);
+    return finish(buf, p);
+}
+
+static int flat(const BiquadQ14 *q)
+{
+    return q->b0 == 0x4000 && q->b1 == 0 && q->b2 == 0 && q->a1 == 0 && q->a2 == 0;
+}
+
+uint16_t coeffFrameFlatBands(const ThreeBandCoeffs *coeffs)
+{
+    const BiquadQ14 *bands[COEFF_NUM_BANDS] = { &coeffs->low, &coeffs->mid, &coeffs->high };
+    uint16_t flags = 0;
+    for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+        if (flat(bands[b])) flags |= COEFF_BAND_MASK(b);
+    }
+    if (flags == COEFF_BANDS_ALL) flags |= COEFF_BYPASS_ALL;
+    return flags;
+}
+
+int coeffFrameParseSections(const uint8_t *buf, uint32_t len, uint16_t *mask, uint8_t *seq,
+                            uint8_t *channels, BiquadQ14 *sections, uint8_t num_sections)
+{
+    if (len < COEFF_FRAME_WIDE_HEADER_BYTES + COEFF_FRAME_CRC_BYTES) return -1;
+    if (buf[0] != COEFF_FRAME_HEADER_FOR(COEFF_FRAME_VERSION_WIDE, 0, COEFF_FRAME_COEFFS)) return -1;
+
+    uint8_t ch = buf[2];
+    if (ch == 0 || (ch & ~COEFF_CHANNELS_BOTH)) return -1;
+    uint16_t m = get16(buf + 3);
+    if (num_sections < COEFF_MAX_SECTIONS && (m >> num_sections) != 0) return -1;
+
+    uint32_t n = coeffFrameWideBytes(m);
+    if (len < n) return -1;
+    if (crc16Update(CRC16_INIT, buf, n) != 0) return -1;
+
+    const uint8_t *p = buf + COEFF_FRAME_WIDE_HEADER_BYTES;
+    for (int s = 0; s < num_sections; s++) {
+        if (!(m & (1u << s))) continue;
+        get_section(p, &sections[s]);
+        p += COEFF_FRAME_BAND_BYTES;
+    }
+    *mask = m;
+    *seq = buf[1];
+    if (channels != NULL) *channels = ch;
+    return COEFF_FRAME_COEFFS;
+}
+
+int coeffFrameParse(const uint8_t *buf, uint32_t len, uint8_t *mask, uint8_t *seq, uint8_t *channels,
+                    ThreeBandCoeffs *coeffs, uint8_t index[COEFF_NUM_BANDS])
+{
+    BiquadQ14 *bands[COEFF_NUM_BANDS] = { &coeffs->low, &coeffs->mid, &coeffs->high };
+
+    if (len < COEFF_FRAME_HEADER_BYTES + COEFF_FRAME_CRC_BYTES) return -1;
+    uint8_t version = buf[0] >> 4;
+    if (version != COEFF_FRAME_VERSION && version != COEFF_FRAME_VERSION_CHANNELS) return -1;
+
+    uint8_t m = (buf[0] >> 1) & COEFF_BANDS_ALL;
+    CoeffFrameKind kind = (CoeffFrameKind)(buf[0] & 1);
+    uint32_t hdr = COEFF_FRAME_HEADER_BYTES;
+    uint8_t ch = COEFF_CHANNELS_BOTH;
+    if (version == COEFF_FRAME_VERSION_CHANNELS) {
+        hdr += COEFF_FRAME_CHANNEL_BYTES;
+        if (len < hdr + COEFF_FRAME_CRC_BYTES) return -1;
+        ch = buf[COEFF_FRAME_HEADER_BYTES];
+        if (ch == 0 || (ch & ~COEFF_CHANNELS_BOTH)) return -1;
+    }
+    uint32_t n = coeffFrameBytes(m, kind) + (hdr - COEFF_FRAME_HEADER_BYTES);
+    if (len < n) return -1;
+
+    // Running the CRC over the frame including its big-endian CRC leaves 0, as aes_spi checks it
+    if (crc16Update(CRC16_INIT, buf, n) != 0) return -1;
+
+    const uint8_t *p = buf + hdr;
+    for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+        if (!(m & COEFF_BAND_MASK(b))) continue;
+        if (kind == COEFF_FRAME_INDICES) {
+            if (index != NULL) index[b] = *p;
+            p++;
+            continue;
+        }
+        get_section(p, bands[b]);
+        p += COEFF_FRAME_BAND_BYTES;
+    }
+    *mask = m;
+    *seq = buf[1];
+    if (channels != NULL) *channels = ch;
+    return kind;
+}
+
+// -----------------------------
+// Send Queue
+// -----------------------------
+
+static void start(uint8_t idx)
+{
+    pending = 0;
+    wire = idx;
+    busy = 1;
+    reading = 0;
+    sent_at = started;
+    sent_seq = seqs[idx];
+    sent_any = 1;
+    started++;
+    FRAME_BARRIER();
+    coeffFrameHwStart(buffers[idx], rx_buf, lengths[idx]);
+}
+
+void coeffFrameInit(void)
+{
+    wire = 0;
+    busy = 0;
+    pending = 0;
+    started = 0;
+    completed = 0;
+    queued = 0;
+    next_seq = 0;
+    last_seq = 0;
+    status_tagged = 0;
+    reading = 0;
+    read_done = 0;
+    sent_any = 0;
+    checked = 0;
+    ack = COEFF_ACK_IDLE;
+    synced = 0;
+    mismatches = 0;
+    losses = 0;
+    coeffFrameHwInit();
+}
+
+static int send(uint8_t kind, uint16_t mask, uint16_t all, const ThreeBandCoeffs *coeffs,
+                const uint8_t *index, const BiquadQ14 *sections)
+{
+    uint8_t seq;
+
+    // Withdraw any waiting frame first so the interrupt cannot start a half-packed buffer;
+    // after this the interrupt no longer changes wire
+    pending = 0;
+    FRAME_BARRIER();
+
+    // If nothing started since the last frame was queued, it never left: take over its
+    // bands and sequence number so the FPGA sees neither a lost band nor a gap.
+    // A frame of the other kind cannot be merged band by band, so send every band.
+    if (queued && started == queued_at) {
+        mask = queued_kind == kind ? (uint16_t)(mask | queued_mask) : all;
+        seq = queued_seq;
+    } else {
+        seq = next_seq++;
+    }
+    queued = 0;
+    last_seq = seq;
+
+    uint8_t idx = wire ^ 1;
+    if (kind == SEND_SECTIONS) {
+        lengths[idx] = coeffFramePackSections(buffers[idx], COEFF_CHANNELS_BOTH, mask, seq, sections);
+    } else {
+        lengths[idx] = coeffFramePackChannels(buffers[idx], COEFF_CHANNELS_BOTH, (CoeffFrameKind)kind,
+                                              (uint8_t)mask, seq, coeffs, index);
+    }
+    seqs[idx] = seq;
+    FRAME_BARRIER();
+
+    if (!busy) {
+        start(idx);
+        return 1;
+    }
+
+    // Still busy: the completion interrupt will see pending and chain the frame
+    queued = 1;
+    queued_kind = kind;
+    queued_mask = mask;
+    queued_seq = seq;
+    queued_at = started;
+    FRAME_BARRIER();
+    pending = 1;
+    FRAME_BARRIER();
+    if (busy) {
+        return 0;
+    }
+
+    // The transfer finished before pending was set, so no interrupt is coming
+    queued = 0;
+    start(idx);
+    return 1;
+}
+
+int coeffFrameSend(uint8_t mask, const ThreeBandCoeffs *coeffs)
+{
+    return send(COEFF_FRAME_COEFFS, mask, COEFF_BANDS_ALL, coeffs, NULL, NULL);
+}
+
+int coeffFrameSendIndices(uint8_t mask, const uint8_t index[COEFF_NUM_BANDS])
+{
+    return send(COEFF_FRAME_INDICES, mask, COEFF_BANDS_ALL, NULL, index, NULL);
+}
+
+int coeffFrameSendSections(uint16_t mask, const BiquadQ14 *sections, uint8_t num_sections)
+{
+    uint16_t all = (uint16_t)((1u << num_sections) - 1);
+    return send(SEND_SECTIONS, mask & all, all, NULL, NULL, sections);
+}
+
+int coeffFrameSendBypass(uint16_t flags)
+{
+    if (busy) {
+        return 0;
+    }
+    uint8_t idx = wire ^ 1;
+    uint8_t seq = next_seq++;
+    queued = 0;
+    last_seq = seq;
+    lengths[idx] = coeffFramePackBypass(buffers[idx], COEFF_CHANNELS_BOTH, flags, seq);
+    seqs[idx] = seq;
+    FRAME_BARRIER();
+    start(idx);
+    return 1;
+}
+
+void coeffFrameOnDmaComplete(void)
+{
+    status_tagged = (rx_buf[0] & 0xF0) == COEFF_FRAME_STATUS_TAG;
+    if (status_tagged) {
+        status.busy          = rx_buf[0] & COEFF_FRAME_STATUS_BUSY;
+        status.committed_seq = rx_buf[1];
+        status.transactions  = rx_buf[2];
+        status.rejected      = rx_buf[3];
+    }
+    if (reading) {
+        read_done = status_tagged;
+        read_value = ((uint32_t)rx_buf[4] << 24) | ((uint32_t)rx_buf[5] << 16) |
+                     ((uint32_t)rx_buf[6] << 8) | rx_buf[7];
+    }
+    completed++;
+    FRAME_BARRIER();
+    if (pending) {
+        start(wire ^ 1);
+    } else {
+        busy = 0;
+    }
+}
+
+uint8_t coeffFrameSequence(void)
+{
+    return last_seq;
+}
+
+int coeffFrameBusy(void)
+{
+    return busy;
+}
+
+uint32_t coeffFrameCompleted(void)
+{
+    return completed;
+}
+
+// -----------------------------
+// Frame Confirmation
+// -----------------------------
+
+int coeffFramePoll(void)
+{
+    if (busy) {
+        return 0;
+    }
+    busy = 1;
+    reading = 0;
+    started++;
+    FRAME_BARRIER();
+    coeffFrameHwStart(poll_buf, rx_buf, COEFF_FRAME_STATUS_BYTES);
+    return 1;
+}
+
+int coeffFrameRead(uint8_t reg)
+{
+    if (busy) {
+        return 0;
+    }
+    read_buf[1] = reg;
+    busy = 1;
+    reading = 1;
+    started++;
+    FRAME_BARRIER();
+    coeffFrameHwStart(read_buf, rx_buf, COEFF_FRAME_READ_BYTES);
+    return 1;
+}
+
+int coeffFrameReadResult(uint8_t *reg, uint32_t *value)
+{
+    if (busy || !read_done) {
+        return 0;
+    }
+    *reg = read_buf[1];
+    *value = read_value;
+    return 1;
+}
+
+int coeffFrameWriteConfig(uint8_t reg, uint8_t value)
+{
+    if (busy) {
+        return 0;
+    }
+    config_buf[0] = COEFF_FRAME_CONFIG_HEADER;
+    config_buf[1] = reg;
+    config_buf[2] = value;
+    config_buf[3] = (uint8_t)~value;
+    busy = 1;
+    reading = 0;
+    started++;
+    FRAME_BARRIER();
+    coeffFrameHwStart(config_buf, rx_buf, COEFF_FRAME_CONFIG_BYTES);
+    return 1;
+}
+
+// What the status word read back in transfer `at` says about the last frame
+static CoeffFrameAck evaluate(uint32_t at)
+{
+    if (!status_tagged) {
+        return COEFF_ACK_UNKNOWN;
+    }
+
+    // The word speaks for every earlier transfer only if the FPGA counted them all
+    if (!synced || status.transactions != (uint8_t)(at + count_offset)) {
+        if (synced && ++mismatches < COEFF_FRAME_RESYNC_POLLS) {
+            return COEFF_ACK_WAIT;
+        }
+        uint8_t resync = synced;
+        count_offset = (uint8_t)(status.transactions - (uint8_t)at);
+        rejected_seen = status.rejected;
+        synced = 1;
+        mismatches = 0;
+        if (resync) {
+            // Most likely reset: whatever it had is gone
+            return sent_any ? COEFF_ACK_LOST : COEFF_ACK_IDLE;
+        }
+    }
+    mismatches = 0;
+
+    // Any frame the FPGA dropped since the last word may have carried bands no
+    // later frame repeats, even if the newest one commits
+    uint8_t dropped = status.rejected != rejected_seen;
+    rejected_seen = status.rejected;
+
+    if (!sent_any) {
+        return COEFF_ACK_IDLE;
+    }
+    if (dropped) {
+        return COEFF_ACK_LOST;
+    }
+    if (at <= sent_at || status.busy) {
+        return COEFF_ACK_WAIT;  // Read before the frame ended, or before its commit
+    }
+    return status.committed_seq == sent_seq ? COEFF_ACK_IDLE : COEFF_ACK_LOST;
+}
+
+CoeffFrameAck coeffFrameCheck(void)
+{
+    if (busy) {
+        return COEFF_ACK_WAIT;
+    }
+    if (completed != checked) {
+        checked = completed;
+        ack = evaluate(completed - 1);
+    }
+    if (ack == COEFF_ACK_WAIT) {
+        coeffFramePoll();
+    }
+
+    CoeffFrameAck r = (CoeffFrameAck)ack;
+    if (ack == COEFF_ACK_LOST) {
+        losses++;
+        ack = COEFF_ACK_IDLE;   // The caller's resend is the next frame to confirm
+    }
+    return r;
+}
+
+int coeffFrameStatus(CoeffFrameStatus *s)
+{
+    if (!status_tagged) {
+        return 0;
+    }
+    *s = status;
+    return 1;
+}
+
+uint32_t coeffFrameLosses(void)
+{
+    return losses;
+}
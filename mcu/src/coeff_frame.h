@@ -0,0 +1,358 @@
+// coeff_frame.h
+// Packs v2/v3/v4/v5 coefficient frames for aes_spi, sends them by DMA and confirms them from the FPGA status
+
+#ifndef COEFF_FRAME_H
+#define COEFF_FRAME_H
+
+#include <stdint.h>
+#include "calc_coefficient.h"
+
+// -----------------------------
+// Frame Layout, v2/v3 (fpga/src/spi.sv, fpga/src/control.sv)
+// -----------------------------
+
+// Variable length, MSB first, CS low for the whole frame:
+//   byte 0   version (4 bits) | band mask (3 bits, bit b = COEFF_BAND_MASK(b)) | kind (1 bit)
+//   byte 1   sequence number, +1 per frame put on the wire
+//   byte 2   v3 only: channel mask (COEFF_CHANNEL_*, nonzero, upper bits 0)
+//   then     kind 0: b0 b1 b2 a1 a2 (big-endian) for each band in the mask, low first
+//            kind 1: one gain index (calc_coefficient.h) for each band in the mask,
+//                    looked up in the FPGA's coefficient ROM
+//   last 2   CRC-16/CCITT-FALSE (crc16.h) over everything before it, big-endian
+// aes_spi drops frames with the wrong version or CRC. One knob costs 14 bytes on the
+// bus as coefficients or 5 as a gain index; the v1 frame was a fixed 42.
+// The FPGA keeps a coefficient bank per channel. A v2 frame writes both (linked
+// stereo, what the firmware sends); a v3 frame writes only the banks in its mask.
+#define COEFF_FRAME_VERSION          2
+#define COEFF_FRAME_VERSION_CHANNELS 3
+#define COEFF_FRAME_HEADER_BYTES     2
+#define COEFF_FRAME_CHANNEL_BYTES    1
+#define COEFF_FRAME_BAND_BYTES   10
+#define COEFF_FRAME_CRC_BYTES    2
+#define COEFF_FRAME_COEFF_WORDS  (5 * COEFF_NUM_BANDS)
+#define COEFF_FRAME_MAX_BYTES    (COEFF_FRAME_HEADER_BYTES + COEFF_FRAME_CHANNEL_BYTES + \
+                                  COEFF_NUM_BANDS * COEFF_FRAME_BAND_BYTES + COEFF_FRAME_CRC_BYTES)
+
+#define COEFF_CHANNEL_LEFT  0x1
+#define COEFF_CHANNEL_RIGHT 0x2
+#define COEFF_CHANNELS_BOTH (COEFF_CHANNEL_LEFT | COEFF_CHANNEL_RIGHT)
+
+// -----------------------------
+// Frame Layout, v4 (N-band FPGA builds, N_BANDS in fpga/src/top.sv)
+// -----------------------------
+
+// Wide frames reach up to COEFF_MAX_SECTIONS cascaded sections per channel:
+//   byte 0     0x40: version 4, no 3-bit mask, kind 0 (coefficients only)
+//   byte 1     sequence number
+//   byte 2     channel mask (COEFF_CHANNEL_*)
+//   bytes 3-4  section mask, big-endian, bit s = section s
+//   then       b0 b1 b2 a1 a2 for each section in the mask, section 0 first
+//   last 2     CRC-16/CCITT-FALSE
+// aes_spi also drops a wide frame that names a section its build does not have.
+// Sections 0-2 are the low/mid/high bands, so a three-band build takes v4 too.
+#define COEFF_FRAME_VERSION_WIDE     4
+#define COEFF_MAX_SECTIONS           16
+#define COEFF_FRAME_WIDE_HEADER_BYTES 5
+#define COEFF_FRAME_WIDE_MAX_BYTES   (COEFF_FRAME_WIDE_HEADER_BYTES + \
+                                      COEFF_MAX_SECTIONS * COEFF_FRAME_BAND_BYTES + COEFF_FRAME_CRC_BYTES)
+
+// -----------------------------
+// Frame Layout, v5 (bypass flags)
+// -----------------------------
+
+// Fixed 7 bytes; the flags commit together with any coefficients staged before them:
+//   byte 0     0x50: version 5, kind 0
+//   byte 1     sequence number
+//   byte 2     channel mask (COEFF_CHANNEL_*)
+//   bytes 3-4  bypass flags, big-endian, bit s = section s, COEFF_BYPASS_ALL = every section
+//   last 2     CRC-16/CCITT-FALSE
+// A bypassed section is crossfaded out over 64 samples (2 ms), then skipped: the
+// sample goes past it bit for bit. Clearing its flag fades it back in the same way.
+#define COEFF_FRAME_VERSION_BYPASS 5
+#define COEFF_FRAME_BYPASS_BYTES   7
+#define COEFF_BYPASS_ALL           0x8000
+
+// -----------------------------
+// FPGA Status (MISO, fpga/src/spi_top.sv)
+// -----------------------------
+
+// The FPGA shifts a status word out during the first 4 bytes of every transaction:
+//   byte 0  0x50 | busy (a frame open, or staged bands not yet active)
+//   byte 1  sequence number of the last frame made active (0xFF after reset)
+//   byte 2  transactions that ended before this one, mod 256
+//   byte 3  frames rejected (bad header or CRC, cut short), mod 256
+// A transaction of COEFF_FRAME_STATUS_BYTES zero bytes only polls: aes_spi ignores
+// a 0x00 header. The FPGA merges every frame into its staging bank, so it can
+// always take the next one; busy only means the last one is not active yet.
+// A poll whose second byte is a register index (fpga_perf.h) reads that 32-bit
+// register back, big-endian, in bytes 4-7: COEFF_FRAME_READ_BYTES in all.
+#define COEFF_FRAME_STATUS_BYTES 4
+#define COEFF_FRAME_READ_BYTES   8
+#define COEFF_FRAME_STATUS_TAG   0x50
+#define COEFF_FRAME_STATUS_BUSY  0x01
+
+typedef struct {
+    uint8_t busy;
+    uint8_t committed_seq;
+    uint8_t transactions;
+    uint8_t rejected;
+} CoeffFrameStatus;
+
+typedef enum {
+    COEFF_ACK_IDLE    = 0,   // The last frame is active on the FPGA (or none was sent)
+    COEFF_ACK_WAIT    = 1,   // Not confirmed yet; a transfer or status poll is under way
+    COEFF_ACK_LOST    = 2,   // The FPGA dropped the last frame, or one before it
+    COEFF_ACK_UNKNOWN = 3,   // No status word on MISO, frames cannot be confirmed
+} CoeffFrameAck;
+
+// Status words whose transaction count disagrees before the count is relearned
+// (the FPGA was reset, or missed a CS edge) and everything is resent
+#define COEFF_FRAME_RESYNC_POLLS 4
+
+// A transaction {0x01, register, value, ~value} sets an FPGA config register
+// (spi_top.sv); aes_spi drops it unless the last byte is the complement.
+#define COEFF_FRAME_CONFIG_HEADER 0x01
+#define COEFF_FRAME_CONFIG_BYTES  4
+#define COEFF_CONFIG_RAMP_SHIFT   0     // Coefficients walk in over ~2^value samples; 0 jumps
+
+typedef enum {
+    COEFF_FRAME_COEFFS  = 0,
+    COEFF_FRAME_INDICES = 1,
+} CoeffFrameKind;
+
+#define COEFF_FRAME_HEADER_FOR(version, mask, kind) \
+    ((uint8_t)(((version) << 4) | (((mask) & COEFF_BANDS_ALL) << 1) | ((kind) & 1)))
+#define COEFF_FRAME_HEADER(mask, kind) COEFF_FRAME_HEADER_FOR(COEFF_FRAME_VERSION, mask, kind)
+
+// -----------------------------
+// Register Layer (coeff_frame_stm32.c on target, mocked in test/test_coeff_frame.c)
+// -----------------------------
+
+/**
+ * @brief Route the SPI1 DMA requests and enable the completion interrupt (after initSPI)
+ */
+void coeffFrameHwInit(void);
+
+/**
+ * @brief Drive CS low and start the DMA transfer of one frame
+ * @param buf Frame bytes, untouched by the caller until coeffFrameOnDmaComplete
+ * @param rx  Receives the len bytes clocked in on MISO
+ * @param len Number of bytes
+ */
+void coeffFrameHwStart(const uint8_t *buf, uint8_t *rx, uint32_t len);
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Reset the send queue and set up the register layer
+ */
+void coeffFrameInit(void);
+
+/**
+ * @brief Frame length for a band mask (v2; a v3 frame is COEFF_FRAME_CHANNEL_BYTES longer)
+ */
+uint32_t coeffFrameBytes(uint8_t mask, CoeffFrameKind kind);
+
+/**
+ * @brief Pack one coefficient frame
+ * @param buf    Destination of up to COEFF_FRAME_MAX_BYTES bytes
+ * @param mask   Bands to carry (COEFF_BAND_MASK bits)
+ * @param seq    Sequence number
+ * @param coeffs Coefficients; only the bands in mask are read
+ * @return Frame length, coeffFrameBytes(mask, COEFF_FRAME_COEFFS)
+ */
+uint32_t coeffFramePack(uint8_t *buf, uint8_t mask, uint8_t seq, const ThreeBandCoeffs *coeffs);
+
+/**
+ * @brief Pack one gain-index frame
+ * @param index Gain index per band (low, mid, high); only the bands in mask are read
+ * @return Frame length, coeffFrameBytes(mask, COEFF_FRAME_INDICES)
+ */
+uint32_t coeffFramePackIndices(uint8_t *buf, uint8_t mask, uint8_t seq,
+                               const uint8_t index[COEFF_NUM_BANDS]);
+
+/**
+ * @brief Pack one frame for some of the channels' coefficient banks
+ * @param channels COEFF_CHANNEL_* mask; COEFF_CHANNELS_BOTH packs the v2 frame,
+ *                 anything else a v3 frame with the channel byte
+ * @param coeffs   Coefficients for kind COEFF_FRAME_COEFFS, else unused (may be NULL)
+ * @param index    Gain indices for kind COEFF_FRAME_INDICES, else unused (may be NULL)
+ * @return Frame length
+ */
+uint32_t coeffFramePackChannels(uint8_t *buf, uint8_t channels, CoeffFrameKind kind, uint8_t mask,
+                                uint8_t seq, const ThreeBandCoeffs *coeffs,
+                                const uint8_t index[COEFF_NUM_BANDS]);
+
+/**
+ * @brief Frame length of a v4 frame for a section mask
+ */
+uint32_t coeffFrameWideBytes(uint16_t mask);
+
+/**
+ * @brief Pack one v4 frame
+ * @param buf      Destination of up to COEFF_FRAME_WIDE_MAX_BYTES bytes
+ * @param channels COEFF_CHANNEL_* mask
+ * @param mask     Sections to carry, bit s = section s
+ * @param seq      Sequence number
+ * @param sections Coefficients per section (e.g. EqDesign.sections); only the masked ones are read
+ * @return Frame length, coeffFrameWideBytes(mask)
+ */
+uint32_t coeffFramePackSections(uint8_t *buf, uint8_t channels, uint16_t mask, uint8_t seq,
+                                const BiquadQ14 *sections);
+
+/**
+ * @brief Pack one v5 frame
+ * @param buf      Destination of COEFF_FRAME_BYPASS_BYTES bytes
+ * @param channels COEFF_CHANNEL_* mask
+ * @param flags    Bypass flags, bit s = section s, COEFF_BYPASS_ALL = all of them
+ * @return Frame length, COEFF_FRAME_BYPASS_BYTES
+ */
+uint32_t coeffFramePackBypass(uint8_t *buf, uint8_t channels, uint16_t flags, uint8_t seq);
+
+/**
+ * @brief Bypass flags for a set of coefficients: every passthrough band, and
+ *        COEFF_BYPASS_ALL when all three are
+ */
+uint16_t coeffFrameFlatBands(const ThreeBandCoeffs *coeffs);
+
+/**
+ * @brief Check and unpack a v4 frame (golden model of aes_spi with N_BANDS = num_sections)
+ * @param mask         Receives the section mask
+ * @param seq          Receives the sequence number
+ * @param channels     Receives the channel mask (may be NULL)
+ * @param sections     Sections in the mask are overwritten, the others keep their values
+ * @param num_sections Sections the receiver has; a frame naming one past them is rejected
+ * @return COEFF_FRAME_COEFFS for an accepted frame; -1 if it is short, has the wrong
+ *         version, header, channel byte or mask, or fails the CRC
+ */
+int coeffFrameParseSections(const uint8_t *buf, uint32_t len, uint16_t *mask, uint8_t *seq,
+                            uint8_t *channels, BiquadQ14 *sections, uint8_t num_sections);
+
+/**
+ * @brief Check and unpack a frame the way aes_spi and control.sv do (golden model)
+ * @param buf      Bytes clocked in while CS was low
+ * @param len      Number of bytes; extra bytes after the CRC are ignored
+ * @param mask     Receives the band mask
+ * @param seq      Receives the sequence number
+ * @param channels Receives the channel mask, COEFF_CHANNELS_BOTH for v2 (may be NULL)
+ * @param coeffs   Coefficient frames overwrite the bands in the mask, the others keep their values
+ * @param index    Gain-index frames overwrite the bands in the mask (may be NULL)
+ * @return COEFF_FRAME_COEFFS or COEFF_FRAME_INDICES for an accepted frame;
+ *         -1 if it is short, has the wrong version or channel byte, or fails the CRC
+ */
+int coeffFrameParse(const uint8_t *buf, uint32_t len, uint8_t *mask, uint8_t *seq, uint8_t *channels,
+                    ThreeBandCoeffs *coeffs, uint8_t index[COEFF_NUM_BANDS]);
+
+/**
+ * @brief Pack a frame into the free buffer and send it
+ *
+ * If a frame is already on the wire the new one waits and goes out from the
+ * completion interrupt. A newer frame replaces a waiting one and takes over its
+ * bands and sequence number, so a band changed only in the replaced frame is
+ * still sent (all bands if the replaced frame was of the other kind).
+ *
+ * @param mask   Bands that changed since the last call (COEFF_BANDS_ALL for a refresh)
+ * @param coeffs Coefficients for all three bands
+ * @return 1 if the transfer started now, 0 if it was queued behind the current one
+ */
+int coeffFrameSend(uint8_t mask, const ThreeBandCoeffs *coeffs);
+
+/**
+ * @brief coeffFrameSend for a gain-index frame
+ * @param index Gain index for all three bands
+ */
+int coeffFrameSendIndices(uint8_t mask, const uint8_t index[COEFF_NUM_BANDS]);
+
+/**
+ * @brief coeffFrameSend for a v4 frame to both channels
+ * @param mask         Sections that changed since the last call
+ * @param sections     Coefficients for all num_sections sections
+ * @param num_sections Sections in the FPGA build (a merged refresh resends all of them)
+ *
+ * For N-band builds that send only v4 frames: a v2 frame that replaces a waiting
+ * v4 frame resends bands 0-2 only.
+ */
+int coeffFrameSendSections(uint16_t mask, const BiquadQ14 *sections, uint8_t num_sections);
+
+/**
+ * @brief Send a v5 frame to both channels if nothing is on the wire or waiting
+ *
+ * Confirmed like any other frame; coefficient frames sent after it queue behind it.
+ *
+ * @return 1 if the transfer started, 0 if the link was busy (try again later)
+ */
+int coeffFrameSendBypass(uint16_t flags);
+
+/**
+ * @brief Sequence number of the most recently packed frame
+ */
+uint8_t coeffFrameSequence(void);
+
+/**
+ * @brief Whether a frame is on the wire or waiting
+ */
+int coeffFrameBusy(void);
+
+/**
+ * @brief Frames whose transfer finished (CS already released)
+ */
+uint32_t coeffFrameCompleted(void);
+
+/**
+ * @brief Start a status poll if nothing is on the wire
+ * @return 1 if the poll started
+ */
+int coeffFramePoll(void);
+
+/**
+ * @brief Start a read of one FPGA readback register if nothing is on the wire
+ * @return 1 if the read started; coeffFrameReadResult has the value once it completes
+ */
+int coeffFrameRead(uint8_t reg);
+
+/**
+ * @brief Result of the latest register read, kept through the frames and polls after it
+ * @param reg   Receives the register index
+ * @param value Receives the register
+ * @return 1 if a read has completed and MISO carried the status tag, 0 if not or while busy
+ */
+int coeffFrameReadResult(uint8_t *reg, uint32_t *value);
+
+/**
+ * @brief Start a write of one FPGA config register if nothing is on the wire
+ * @return 1 if the write started
+ */
+int coeffFrameWriteConfig(uint8_t reg, uint8_t value);
+
+/**
+ * @brief Whether the last frame sent is active on the FPGA, from the latest status word
+ *
+ * Call from main while nothing else is being sent. Polls the status while the
+ * answer is COEFF_ACK_WAIT and the link is idle. COEFF_ACK_LOST is returned
+ * once per loss: the last frame did not commit, or the FPGA's rejected count
+ * moved (an earlier frame was dropped, whatever became of the later ones). The
+ * caller resends every band in a new frame. A
+ * transaction count that stays off for COEFF_FRAME_RESYNC_POLLS words (an FPGA
+ * reset) is relearned and also reported as COEFF_ACK_LOST.
+ */
+CoeffFrameAck coeffFrameCheck(void);
+
+/**
+ * @brief The latest status word read back
+ * @return 1 if it carried the status tag, 0 if MISO gave none (s untouched)
+ */
+int coeffFrameStatus(CoeffFrameStatus *s);
+
+/**
+ * @brief Frames coeffFrameCheck has reported lost
+ */
+uint32_t coeffFrameLosses(void);
+
+/**
+ * @brief Called by the register layer after the last byte has been clocked out and CS is high
+ */
+void coeffFrameOnDmaComplete(void);
+
+#endif // COEFF_FRAME_H
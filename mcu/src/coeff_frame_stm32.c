@@ -0,0 +1,59 @@
+// coeff_frame_stm32.c
+// Register layer for coeff_frame.c: SPI1 TX on DMA1 channel 3, RX on channel 2, CS on PA11
+
+#include "STM32L432KC.h"
+#include "coeff_frame.h"
+
+#define COEFF_FRAME_CS    PA11
+#define DMA_REQ_SPI1      1      // CSELR request number for SPI1_RX (ch2) and SPI1_TX (ch3)
+
+void coeffFrameHwInit(void)
+{
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+
+    DMA1_CSELR->CSELR &= ~(DMA_CSELR_C2S | DMA_CSELR_C3S);
+    DMA1_CSELR->CSELR |= _VAL2FLD(DMA_CSELR_C2S, DMA_REQ_SPI1) |
+                         _VAL2FLD(DMA_CSELR_C3S, DMA_REQ_SPI1);
+
+    DMA1_Channel2->CPAR = (uint32_t)&SPI1->DR;
+    DMA1_Channel3->CPAR = (uint32_t)&SPI1->DR;
+
+    NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+    digitalWrite(COEFF_FRAME_CS, 1);  // CS idle HIGH
+}
+
+void coeffFrameHwStart(const uint8_t *buf, uint8_t *rx, uint32_t len)
+{
+    digitalWrite(COEFF_FRAME_CS, 0);
+
+    // RX first so no received byte can overrun before its channel is armed; its
+    // transfer-complete marks the last bit clocked out. The setup below also gives
+    // the FPGA the two clk_in cycles it needs to freeze the status word.
+    DMA1_Channel2->CCR   = 0;
+    DMA1_Channel2->CMAR  = (uint32_t)rx;
+    DMA1_Channel2->CNDTR = len;
+    DMA1_Channel2->CCR   = DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_EN; // 8-bit, peripheral -> rx
+
+    DMA1_Channel3->CCR   = 0;
+    DMA1_Channel3->CMAR  = (uint32_t)buf;
+    DMA1_Channel3->CNDTR = len;
+    DMA1_Channel3->CCR   = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_EN; // 8-bit, memory -> DR
+
+    SPI1->CR2 |= SPI_CR2_RXDMAEN;
+    SPI1->CR2 |= SPI_CR2_TXDMAEN;  // Starts clocking
+}
+
+void DMA1_Channel2_IRQHandler(void)
+{
+    if (DMA1->ISR & DMA_ISR_TCIF2) {
+        DMA1->IFCR = DMA_IFCR_CTCIF2;
+
+        SPI1->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+        DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+        DMA1_Channel3->CCR &= ~DMA_CCR_EN;
+
+        while (SPI1->SR & SPI_SR_BSY);
+        digitalWrite(COEFF_FRAME_CS, 1);
+        coeffFrameOnDmaComplete();
+    }
+}
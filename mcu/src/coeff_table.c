@@ -0,0 +1,43 @@
+// coeff_table.c
+// Table-driven coefficient engine: interpolated lookup in place of the runtime RBJ design
+
+#include "coeff_table.h"
+
+// -----------------------------
+// Interpolation
+// -----------------------------
+
+static inline int16_t lerp_q14(int16_t e0, int16_t e1, int32_t frac)
+{
+    // Round to nearest; result always lies between e0 and e1 so it cannot overflow
+    int32_t delta = (int32_t)e1 - (int32_t)e0;
+    return (int16_t)(e0 + ((delta * frac + (COEFF_TABLE_STEP >> 1)) >> COEFF_TABLE_SHIFT));
+}
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+BiquadQ14 coeffTableLookup(CoeffBand band, uint16_t adc)
+{
+    if (adc > 4095) {
+        adc = 4095;
+    }
+
+    // Same unity-gain shortcut as the float path (gain within UNITY_GAIN_THRESHOLD_DB)
+    if (adc >= coeffTableUnityCode || band >= COEFF_NUM_BANDS) {
+        return simpleUnity();
+    }
+
+    const BiquadQ14 *e0 = &coeffTable[band][adc >> COEFF_TABLE_SHIFT];
+    const BiquadQ14 *e1 = e0 + 1;
+    int32_t frac = adc & (COEFF_TABLE_STEP - 1);
+
+    BiquadQ14 q;
+    q.b0 = lerp_q14(e0->b0, e1->b0, frac);
+    q.b1 = lerp_q14(e0->b1, e1->b1, frac);
+    q.b2 = lerp_q14(e0->b2, e1->b2, frac);
+    q.a1 = lerp_q14(e0->a1, e1->a1, frac);
+    q.a2 = lerp_q14(e0->a2, e1->a2, frac);
+    return q;
+}
@@ -0,0 +1,41 @@
+// coeff_table.h
+// Flash-resident Q2.14 coefficient tables indexed by smoothed ADC code
+
+#ifndef COEFF_TABLE_H
+#define COEFF_TABLE_H
+
+#include <stdint.h>
+#include "calc_coefficient.h"
+
+// -----------------------------
+// Table Geometry
+// -----------------------------
+
+#define COEFF_TABLE_SHIFT 5                                  // 32 ADC codes between entries
+#define COEFF_TABLE_STEP  (1 << COEFF_TABLE_SHIFT)
+#define COEFF_TABLE_SIZE  ((4095 >> COEFF_TABLE_SHIFT) + 2)  // +1 endpoint for interpolation
+
+// Largest difference (in Q2.14 LSBs) from calcCoeffBandFloat over all ADC codes
+#define COEFF_TABLE_MAX_LSB_ERR 1
+
+// -----------------------------
+// Generated Data (coeff_table_data.c)
+// -----------------------------
+
+// Regenerate with mcu/tools/gen_coeff_table.c whenever the filter design changes
+extern const BiquadQ14 coeffTable[COEFF_NUM_BANDS][COEFF_TABLE_SIZE];
+extern const uint16_t  coeffTableUnityCode;  // First ADC code the float path maps to unity
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Look up one band's coefficients, interpolating linearly between entries
+ * @param band Band to look up
+ * @param adc  Smoothed ADC value (0-4095)
+ * @return BiquadQ14 within COEFF_TABLE_MAX_LSB_ERR of calcCoeffBandFloat(band, adc)
+ */
+BiquadQ14 coeffTableLookup(CoeffBand band, uint16_t adc);
+
+#endif // COEFF_TABLE_H
@@ -0,0 +1,406 @@
+// coeff_table_data.c
+// GENERATED by mcu/tools/gen_coeff_table.c - do not edit by hand
+// Entry i holds the float design at ADC code i * 32 (no unity shortcut)
+
+#include "coeff_table.h"
+
+const uint16_t coeffTableUnityCode = 3812;
+
+const BiquadQ14 coeffTable[COEFF_NUM_BANDS][COEFF_TABLE_SIZE] = {
+    // ---- LOW BAND ----
+    {
+        {  15662, -29489,  13881, -29431,  13217 },  //    0
+        {  15668, -29496,  13882, -29438,  13224 },  //   32
+        {  15674, -29503,  13883, -29446,  13230 },  //   64
+        {  15680, -29510,  13885, -29454,  13237 },  //   96
+        {  15686, -29517,  13886, -29461,  13244 },  //  128
+        {  15692, -29524,  13887, -29469,  13251 },  //  160
+        {  15698, -29531,  13888, -29476,  13257 },  //  192
+        {  15704, -29538,  13890, -29483,  13264 },  //  224
+        {  15710, -29545,  13891, -29491,  13271 },  //  256
+        {  15716, -29552,  13892, -29498,  13278 },  //  288
+        {  15722, -29559,  13893, -29506,  13284 },  //  320
+        {  15728, -29566,  13895, -29513,  13291 },  //  352
+        {  15734, -29573,  13896, -29521,  13298 },  //  384
+        {  15740, -29579,  13897, -29528,  13304 },  //  416
+        {  15746, -29586,  13898, -29535,  13311 },  //  448
+        {  15752, -29593,  13899, -29543,  13317 },  //  480
+        {  15758, -29600,  13900, -29550,  13324 },  //  512
+        {  15764, -29607,  13901, -29557,  13331 },  //  544
+        {  15770, -29614,  13902, -29565,  13337 },  //  576
+        {  15776, -29620,  13904, -29572,  13344 },  //  608
+        {  15782, -29627,  13905, -29579,  13350 },  //  640
+        {  15788, -29634,  13906, -29586,  13357 },  //  672
+        {  15794, -29641,  13907, -29594,  13363 },  //  704
+        {  15800, -29647,  13908, -29601,  13370 },  //  736
+        {  15806, -29654,  13909, -29608,  13376 },  //  768
+        {  15812, -29661,  13910, -29615,  13383 },  //  800
+        {  15818, -29667,  13911, -29622,  13389 },  //  832
+        {  15824, -29674,  13912, -29630,  13396 },  //  864
+        {  15830, -29681,  13913, -29637,  13402 },  //  896
+        {  15836, -29687,  13914, -29644,  13409 },  //  928
+        {  15842, -29694,  13915, -29651,  13415 },  //  960
+        {  15848, -29700,  13916, -29658,  13422 },  //  992
+        {  15854, -29707,  13916, -29665,  13428 },  // 1024
+        {  15860, -29714,  13917, -29672,  13434 },  // 1056
+        {  15866, -29720,  13918, -29679,  13441 },  // 1088
+        {  15872, -29727,  13919, -29686,  13447 },  // 1120
+        {  15878, -29733,  13920, -29693,  13454 },  // 1152
+        {  15884, -29740,  13921, -29700,  13460 },  // 1184
+        {  15890, -29746,  13922, -29707,  13466 },  // 1216
+        {  15896, -29753,  13922, -29714,  13473 },  // 1248
+        {  15902, -29759,  13923, -29721,  13479 },  // 1280
+        {  15908, -29766,  13924, -29728,  13485 },  // 1312
+        {  15914, -29772,  13925, -29735,  13491 },  // 1344
+        {  15920, -29779,  13926, -29742,  13498 },  // 1376
+        {  15926, -29785,  13926, -29749,  13504 },  // 1408
+        {  15931, -29791,  13927, -29756,  13510 },  // 1440
+        {  15937, -29798,  13928, -29763,  13516 },  // 1472
+        {  15943, -29804,  13929, -29770,  13523 },  // 1504
+        {  15949, -29810,  13929, -29776,  13529 },  // 1536
+        {  15955, -29817,  13930, -29783,  13535 },  // 1568
+        {  15961, -29823,  13931, -29790,  13541 },  // 1600
+        {  15967, -29829,  13931, -29797,  13547 },  // 1632
+        {  15973, -29836,  13932, -29804,  13554 },  // 1664
+        {  15979, -29842,  13933, -29810,  13560 },  // 1696
+        {  15985, -29848,  13933, -29817,  13566 },  // 1728
+        {  15991, -29855,  13934, -29824,  13572 },  // 1760
+        {  15997, -29861,  13935, -29831,  13578 },  // 1792
+        {  16003, -29867,  13935, -29837,  13584 },  // 1824
+        {  16009, -29873,  13936, -29844,  13590 },  // 1856
+        {  16015, -29879,  13936, -29851,  13596 },  // 1888
+        {  16021, -29886,  13937, -29857,  13603 },  // 1920
+        {  16027, -29892,  13938, -29864,  13609 },  // 1952
+        {  16033, -29898,  13938, -29871,  13615 },  // 1984
+        {  16039, -29904,  13939, -29877,  13621 },  // 2016
+        {  16045, -29910,  13939, -29884,  13627 },  // 2048
+        {  16051, -29916,  13940, -29890,  13633 },  // 2080
+        {  16057, -29922,  13940, -29897,  13639 },  // 2112
+        {  16063, -29928,  13941, -29903,  13645 },  // 2144
+        {  16069, -29935,  13941, -29910,  13651 },  // 2176
+        {  16075, -29941,  13941, -29917,  13657 },  // 2208
+        {  16081, -29947,  13942, -29923,  13663 },  // 2240
+        {  16087, -29953,  13942, -29930,  13669 },  // 2272
+        {  16093, -29959,  13943, -29936,  13674 },  // 2304
+        {  16099, -29965,  13943, -29943,  13680 },  // 2336
+        {  16105, -29971,  13943, -29949,  13686 },  // 2368
+        {  16111, -29977,  13944, -29955,  13692 },  // 2400
+        {  16117, -29983,  13944, -29962,  13698 },  // 2432
+        {  16123, -29989,  13945, -29968,  13704 },  // 2464
+        {  16129, -29995,  13945, -29975,  13710 },  // 2496
+        {  16135, -30000,  13945, -29981,  13716 },  // 2528
+        {  16141, -30006,  13946, -29987,  13721 },  // 2560
+        {  16147, -30012,  13946, -29994,  13727 },  // 2592
+        {  16153, -30018,  13946, -30000,  13733 },  // 2624
+        {  16159, -30024,  13946, -30007,  13739 },  // 2656
+        {  16165, -30030,  13947, -30013,  13745 },  // 2688
+        {  16171, -30036,  13947, -30019,  13750 },  // 2720
+        {  16177, -30041,  13947, -30025,  13756 },  // 2752
+        {  16183, -30047,  13947, -30032,  13762 },  // 2784
+        {  16189, -30053,  13948, -30038,  13768 },  // 2816
+        {  16195, -30059,  13948, -30044,  13773 },  // 2848
+        {  16201, -30065,  13948, -30050,  13779 },  // 2880
+        {  16207, -30070,  13948, -30057,  13785 },  // 2912
+        {  16213, -30076,  13948, -30063,  13791 },  // 2944
+        {  16219, -30082,  13948, -30069,  13796 },  // 2976
+        {  16225, -30088,  13948, -30075,  13802 },  // 3008
+        {  16231, -30093,  13949, -30081,  13808 },  // 3040
+        {  16237, -30099,  13949, -30088,  13813 },  // 3072
+        {  16243, -30105,  13949, -30094,  13819 },  // 3104
+        {  16249, -30110,  13949, -30100,  13825 },  // 3136
+        {  16255, -30116,  13949, -30106,  13830 },  // 3168
+        {  16261, -30122,  13949, -30112,  13836 },  // 3200
+        {  16267, -30127,  13949, -30118,  13841 },  // 3232
+        {  16273, -30133,  13949, -30124,  13847 },  // 3264
+        {  16279, -30138,  13949, -30130,  13852 },  // 3296
+        {  16285, -30144,  13949, -30136,  13858 },  // 3328
+        {  16291, -30150,  13949, -30142,  13864 },  // 3360
+        {  16297, -30155,  13949, -30148,  13869 },  // 3392
+        {  16303, -30161,  13949, -30154,  13875 },  // 3424
+        {  16309, -30166,  13949, -30160,  13880 },  // 3456
+        {  16316, -30172,  13949, -30166,  13886 },  // 3488
+        {  16322, -30177,  13949, -30172,  13891 },  // 3520
+        {  16328, -30183,  13949, -30178,  13897 },  // 3552
+        {  16334, -30188,  13949, -30184,  13902 },  // 3584
+        {  16340, -30194,  13948, -30190,  13908 },  // 3616
+        {  16346, -30199,  13948, -30196,  13913 },  // 3648
+        {  16352, -30205,  13948, -30202,  13919 },  // 3680
+        {  16358, -30210,  13948, -30208,  13924 },  // 3712
+        {  16364, -30215,  13948, -30214,  13929 },  // 3744
+        {  16370, -30221,  13948, -30220,  13935 },  // 3776
+        {  16376, -30226,  13948, -30226,  13940 },  // 3808
+        {  16382, -30232,  13947, -30231,  13946 },  // 3840
+        {  16384, -30233,  13947, -30233,  13947 },  // 3872
+        {  16384, -30233,  13947, -30233,  13947 },  // 3904
+        {  16384, -30233,  13947, -30233,  13947 },  // 3936
+        {  16384, -30233,  13947, -30233,  13947 },  // 3968
+        {  16384, -30233,  13947, -30233,  13947 },  // 4000
+        {  16384, -30233,  13947, -30233,  13947 },  // 4032
+        {  16384, -30233,  13947, -30233,  13947 },  // 4064
+        {  16384, -30233,  13947, -30233,  13947 },  // 4095
+    },
+    // ---- MID BAND ----
+    {
+        {  13448, -23693,  10732, -23693,   7797 },  //    0
+        {  13471, -23723,  10739, -23723,   7827 },  //   32
+        {  13495, -23753,  10746, -23753,   7857 },  //   64
+        {  13518, -23782,  10753, -23782,   7887 },  //   96
+        {  13542, -23812,  10760, -23812,   7917 },  //  128
+        {  13565, -23841,  10766, -23841,   7947 },  //  160
+        {  13588, -23870,  10773, -23870,   7977 },  //  192
+        {  13612, -23900,  10779, -23900,   8007 },  //  224
+        {  13635, -23929,  10786, -23929,   8037 },  //  256
+        {  13659, -23958,  10792, -23958,   8067 },  //  288
+        {  13682, -23987,  10798, -23987,   8096 },  //  320
+        {  13706, -24016,  10804, -24016,   8126 },  //  352
+        {  13729, -24045,  10810, -24045,   8155 },  //  384
+        {  13753, -24074,  10816, -24074,   8185 },  //  416
+        {  13776, -24103,  10822, -24103,   8214 },  //  448
+        {  13800, -24131,  10828, -24131,   8243 },  //  480
+        {  13823, -24160,  10834, -24160,   8273 },  //  512
+        {  13847, -24189,  10839, -24189,   8302 },  //  544
+        {  13870, -24217,  10845, -24217,   8331 },  //  576
+        {  13894, -24246,  10850, -24246,   8360 },  //  608
+        {  13917, -24274,  10856, -24274,   8389 },  //  640
+        {  13941, -24302,  10861, -24302,   8418 },  //  672
+        {  13964, -24330,  10866, -24330,   8447 },  //  704
+        {  13988, -24359,  10871, -24359,   8475 },  //  736
+        {  14012, -24387,  10876, -24387,   8504 },  //  768
+        {  14035, -24415,  10881, -24415,   8533 },  //  800
+        {  14059, -24443,  10886, -24443,   8561 },  //  832
+        {  14083, -24471,  10891, -24471,   8590 },  //  864
+        {  14106, -24498,  10896, -24498,   8618 },  //  896
+        {  14130, -24526,  10900, -24526,   8646 },  //  928
+        {  14154, -24554,  10905, -24554,   8675 },  //  960
+        {  14177, -24581,  10909, -24581,   8703 },  //  992
+        {  14201, -24609,  10914, -24609,   8731 },  // 1024
+        {  14225, -24636,  10918, -24636,   8759 },  // 1056
+        {  14249, -24664,  10922, -24664,   8787 },  // 1088
+        {  14272, -24691,  10926, -24691,   8815 },  // 1120
+        {  14296, -24718,  10930, -24718,   8843 },  // 1152
+        {  14320, -24746,  10934, -24746,   8870 },  // 1184
+        {  14344, -24773,  10938, -24773,   8898 },  // 1216
+        {  14368, -24800,  10942, -24800,   8926 },  // 1248
+        {  14391, -24827,  10946, -24827,   8953 },  // 1280
+        {  14415, -24854,  10949, -24854,   8981 },  // 1312
+        {  14439, -24880,  10953, -24880,   9008 },  // 1344
+        {  14463, -24907,  10956, -24907,   9035 },  // 1376
+        {  14487, -24934,  10960, -24934,   9063 },  // 1408
+        {  14511, -24961,  10963, -24961,   9090 },  // 1440
+        {  14535, -24987,  10966, -24987,   9117 },  // 1472
+        {  14559, -25014,  10969, -25014,   9144 },  // 1504
+        {  14583, -25040,  10972, -25040,   9171 },  // 1536
+        {  14607, -25066,  10975, -25066,   9198 },  // 1568
+        {  14631, -25093,  10978, -25093,   9224 },  // 1600
+        {  14655, -25119,  10980, -25119,   9251 },  // 1632
+        {  14679, -25145,  10983, -25145,   9278 },  // 1664
+        {  14703, -25171,  10985, -25171,   9304 },  // 1696
+        {  14727, -25197,  10988, -25197,   9331 },  // 1728
+        {  14751, -25223,  10990, -25223,   9357 },  // 1760
+        {  14775, -25249,  10992, -25249,   9384 },  // 1792
+        {  14800, -25274,  10995, -25274,   9410 },  // 1824
+        {  14824, -25300,  10997, -25300,   9436 },  // 1856
+        {  14848, -25326,  10999, -25326,   9462 },  // 1888
+        {  14872, -25351,  11000, -25351,   9489 },  // 1920
+        {  14896, -25377,  11002, -25377,   9515 },  // 1952
+        {  14921, -25402,  11004, -25402,   9540 },  // 1984
+        {  14945, -25428,  11005, -25428,   9566 },  // 2016
+        {  14969, -25453,  11007, -25453,   9592 },  // 2048
+        {  14994, -25478,  11008, -25478,   9618 },  // 2080
+        {  15018, -25503,  11010, -25503,   9644 },  // 2112
+        {  15042, -25528,  11011, -25528,   9669 },  // 2144
+        {  15067, -25553,  11012, -25553,   9695 },  // 2176
+        {  15091, -25578,  11013, -25578,   9720 },  // 2208
+        {  15116, -25603,  11014, -25603,   9745 },  // 2240
+        {  15140, -25628,  11015, -25628,   9771 },  // 2272
+        {  15165, -25653,  11015, -25653,   9796 },  // 2304
+        {  15189, -25677,  11016, -25677,   9821 },  // 2336
+        {  15214, -25702,  11016, -25702,   9846 },  // 2368
+        {  15238, -25726,  11017, -25726,   9871 },  // 2400
+        {  15263, -25751,  11017, -25751,   9896 },  // 2432
+        {  15288, -25775,  11017, -25775,   9921 },  // 2464
+        {  15312, -25799,  11018, -25799,   9946 },  // 2496
+        {  15337, -25824,  11018, -25824,   9970 },  // 2528
+        {  15362, -25848,  11018, -25848,   9995 },  // 2560
+        {  15386, -25872,  11017, -25872,  10020 },  // 2592
+        {  15411, -25896,  11017, -25896,  10044 },  // 2624
+        {  15436, -25920,  11017, -25920,  10069 },  // 2656
+        {  15461, -25944,  11016, -25944,  10093 },  // 2688
+        {  15486, -25967,  11016, -25967,  10117 },  // 2720
+        {  15510, -25991,  11015, -25991,  10141 },  // 2752
+        {  15535, -26015,  11014, -26015,  10166 },  // 2784
+        {  15560, -26038,  11013, -26038,  10190 },  // 2816
+        {  15585, -26062,  11012, -26062,  10214 },  // 2848
+        {  15610, -26085,  11011, -26085,  10238 },  // 2880
+        {  15635, -26109,  11010, -26109,  10261 },  // 2912
+        {  15660, -26132,  11009, -26132,  10285 },  // 2944
+        {  15685, -26155,  11008, -26155,  10309 },  // 2976
+        {  15711, -26178,  11006, -26178,  10333 },  // 3008
+        {  15736, -26201,  11005, -26201,  10356 },  // 3040
+        {  15761, -26225,  11003, -26225,  10380 },  // 3072
+        {  15786, -26247,  11001, -26247,  10403 },  // 3104
+        {  15811, -26270,  10999, -26270,  10426 },  // 3136
+        {  15837, -26293,  10997, -26293,  10450 },  // 3168
+        {  15862, -26316,  10995, -26316,  10473 },  // 3200
+        {  15887, -26339,  10993, -26339,  10496 },  // 3232
+        {  15913, -26361,  10991, -26361,  10519 },  // 3264
+        {  15938, -26384,  10988, -26384,  10542 },  // 3296
+        {  15964, -26406,  10986, -26406,  10565 },  // 3328
+        {  15989, -26429,  10983, -26429,  10588 },  // 3360
+        {  16015, -26451,  10980, -26451,  10611 },  // 3392
+        {  16040, -26473,  10977, -26473,  10633 },  // 3424
+        {  16066, -26495,  10974, -26495,  10656 },  // 3456
+        {  16091, -26518,  10971, -26518,  10679 },  // 3488
+        {  16117, -26540,  10968, -26540,  10701 },  // 3520
+        {  16143, -26562,  10965, -26562,  10724 },  // 3552
+        {  16168, -26583,  10962, -26583,  10746 },  // 3584
+        {  16194, -26605,  10958, -26605,  10768 },  // 3616
+        {  16220, -26627,  10954, -26627,  10791 },  // 3648
+        {  16246, -26649,  10951, -26649,  10813 },  // 3680
+        {  16272, -26670,  10947, -26670,  10835 },  // 3712
+        {  16298, -26692,  10943, -26692,  10857 },  // 3744
+        {  16324, -26714,  10939, -26714,  10879 },  // 3776
+        {  16350, -26735,  10935, -26735,  10901 },  // 3808
+        {  16376, -26756,  10931, -26756,  10922 },  // 3840
+        {  16384, -26763,  10929, -26763,  10929 },  // 3872
+        {  16384, -26763,  10929, -26763,  10929 },  // 3904
+        {  16384, -26763,  10929, -26763,  10929 },  // 3936
+        {  16384, -26763,  10929, -26763,  10929 },  // 3968
+        {  16384, -26763,  10929, -26763,  10929 },  // 4000
+        {  16384, -26763,  10929, -26763,  10929 },  // 4032
+        {  16384, -26763,  10929, -26763,  10929 },  // 4064
+        {  16384, -26763,  10929, -26763,  10929 },  // 4095
+    },
+    // ---- HIGH BAND ----
+    {
+        {   6305,  -7221,   2067, -24079,   8847 },  //    0
+        {   6356,  -7288,   2090, -24061,   8834 },  //   32
+        {   6406,  -7357,   2112, -24043,   8821 },  //   64
+        {   6457,  -7425,   2135, -24025,   8808 },  //   96
+        {   6508,  -7495,   2158, -24007,   8794 },  //  128
+        {   6560,  -7565,   2181, -23989,   8781 },  //  160
+        {   6612,  -7635,   2204, -23971,   8768 },  //  192
+        {   6665,  -7707,   2228, -23952,   8754 },  //  224
+        {   6718,  -7779,   2252, -23934,   8741 },  //  256
+        {   6771,  -7851,   2276, -23916,   8728 },  //  288
+        {   6825,  -7925,   2300, -23898,   8714 },  //  320
+        {   6879,  -7998,   2325, -23879,   8701 },  //  352
+        {   6934,  -8073,   2350, -23861,   8687 },  //  384
+        {   6989,  -8148,   2375, -23842,   8674 },  //  416
+        {   7044,  -8224,   2400, -23824,   8661 },  //  448
+        {   7100,  -8301,   2426, -23805,   8647 },  //  480
+        {   7157,  -8378,   2452, -23787,   8634 },  //  512
+        {   7214,  -8456,   2478, -23768,   8620 },  //  544
+        {   7271,  -8535,   2504, -23750,   8607 },  //  576
+        {   7329,  -8614,   2531, -23731,   8593 },  //  608
+        {   7387,  -8694,   2558, -23712,   8580 },  //  640
+        {   7446,  -8775,   2585, -23694,   8566 },  //  672
+        {   7505,  -8856,   2613, -23675,   8553 },  //  704
+        {   7565,  -8939,   2640, -23656,   8539 },  //  736
+        {   7625,  -9022,   2668, -23638,   8526 },  //  768
+        {   7686,  -9105,   2697, -23619,   8512 },  //  800
+        {   7747,  -9190,   2725, -23600,   8498 },  //  832
+        {   7809,  -9275,   2754, -23581,   8485 },  //  864
+        {   7871,  -9361,   2783, -23562,   8471 },  //  896
+        {   7934,  -9448,   2813, -23543,   8458 },  //  928
+        {   7997,  -9535,   2843, -23524,   8444 },  //  960
+        {   8060,  -9624,   2873, -23505,   8430 },  //  992
+        {   8125,  -9713,   2903, -23486,   8417 },  // 1024
+        {   8189,  -9803,   2934, -23467,   8403 },  // 1056
+        {   8254,  -9893,   2964, -23448,   8389 },  // 1088
+        {   8320,  -9985,   2996, -23429,   8376 },  // 1120
+        {   8386, -10077,   3027, -23410,   8362 },  // 1152
+        {   8453, -10170,   3059, -23390,   8348 },  // 1184
+        {   8520, -10264,   3091, -23371,   8334 },  // 1216
+        {   8588, -10359,   3124, -23352,   8321 },  // 1248
+        {   8657, -10455,   3157, -23333,   8307 },  // 1280
+        {   8726, -10551,   3190, -23313,   8293 },  // 1312
+        {   8795, -10649,   3223, -23294,   8279 },  // 1344
+        {   8865, -10747,   3257, -23274,   8266 },  // 1376
+        {   8936, -10846,   3291, -23255,   8252 },  // 1408
+        {   9007, -10946,   3326, -23236,   8238 },  // 1440
+        {   9079, -11047,   3361, -23216,   8224 },  // 1472
+        {   9151, -11149,   3396, -23196,   8210 },  // 1504
+        {   9224, -11252,   3431, -23177,   8197 },  // 1536
+        {   9298, -11355,   3467, -23157,   8183 },  // 1568
+        {   9372, -11460,   3503, -23138,   8169 },  // 1600
+        {   9446, -11565,   3540, -23118,   8155 },  // 1632
+        {   9522, -11672,   3577, -23098,   8141 },  // 1664
+        {   9597, -11779,   3614, -23079,   8127 },  // 1696
+        {   9674, -11887,   3652, -23059,   8113 },  // 1728
+        {   9751, -11996,   3690, -23039,   8099 },  // 1760
+        {   9829, -12107,   3728, -23019,   8085 },  // 1792
+        {   9907, -12218,   3767, -22999,   8071 },  // 1824
+        {   9986, -12330,   3806, -22979,   8057 },  // 1856
+        {  10066, -12443,   3846, -22959,   8043 },  // 1888
+        {  10146, -12557,   3886, -22939,   8029 },  // 1920
+        {  10227, -12673,   3926, -22919,   8015 },  // 1952
+        {  10308, -12789,   3967, -22899,   8001 },  // 1984
+        {  10390, -12906,   4008, -22879,   7987 },  // 2016
+        {  10473, -13024,   4049, -22859,   7973 },  // 2048
+        {  10557, -13144,   4091, -22839,   7959 },  // 2080
+        {  10641, -13264,   4133, -22819,   7945 },  // 2112
+        {  10726, -13385,   4176, -22799,   7931 },  // 2144
+        {  10811, -13508,   4219, -22778,   7917 },  // 2176
+        {  10898, -13631,   4263, -22758,   7903 },  // 2208
+        {  10984, -13756,   4307, -22738,   7889 },  // 2240
+        {  11072, -13882,   4351, -22718,   7875 },  // 2272
+        {  11160, -14009,   4396, -22697,   7861 },  // 2304
+        {  11249, -14137,   4441, -22677,   7847 },  // 2336
+        {  11339, -14266,   4487, -22656,   7832 },  // 2368
+        {  11429, -14396,   4533, -22636,   7818 },  // 2400
+        {  11521, -14528,   4580, -22615,   7804 },  // 2432
+        {  11612, -14660,   4627, -22595,   7790 },  // 2464
+        {  11705, -14794,   4675, -22574,   7776 },  // 2496
+        {  11798, -14929,   4723, -22554,   7762 },  // 2528
+        {  11893, -15065,   4771, -22533,   7747 },  // 2560
+        {  11987, -15203,   4820, -22512,   7733 },  // 2592
+        {  12083, -15341,   4869, -22492,   7719 },  // 2624
+        {  12179, -15481,   4919, -22471,   7705 },  // 2656
+        {  12277, -15622,   4970, -22450,   7691 },  // 2688
+        {  12375, -15764,   5020, -22429,   7676 },  // 2720
+        {  12473, -15908,   5072, -22408,   7662 },  // 2752
+        {  12573, -16052,   5124, -22388,   7648 },  // 2784
+        {  12673, -16198,   5176, -22367,   7633 },  // 2816
+        {  12774, -16346,   5229, -22346,   7619 },  // 2848
+        {  12876, -16494,   5282, -22325,   7605 },  // 2880
+        {  12979, -16644,   5336, -22304,   7591 },  // 2912
+        {  13082, -16795,   5390, -22283,   7576 },  // 2944
+        {  13187, -16948,   5445, -22262,   7562 },  // 2976
+        {  13292, -17102,   5501, -22240,   7548 },  // 3008
+        {  13398, -17257,   5557, -22219,   7533 },  // 3040
+        {  13505, -17413,   5613, -22198,   7519 },  // 3072
+        {  13613, -17571,   5670, -22177,   7504 },  // 3104
+        {  13721, -17731,   5728, -22156,   7490 },  // 3136
+        {  13831, -17892,   5786, -22134,   7476 },  // 3168
+        {  13941, -18054,   5845, -22113,   7461 },  // 3200
+        {  14052, -18217,   5904, -22092,   7447 },  // 3232
+        {  14165, -18382,   5964, -22070,   7432 },  // 3264
+        {  14278, -18549,   6024, -22049,   7418 },  // 3296
+        {  14392, -18717,   6085, -22027,   7404 },  // 3328
+        {  14506, -18886,   6147, -22006,   7389 },  // 3360
+        {  14622, -19057,   6209, -21984,   7375 },  // 3392
+        {  14739, -19229,   6272, -21963,   7360 },  // 3424
+        {  14856, -19403,   6335, -21941,   7346 },  // 3456
+        {  14975, -19578,   6399, -21919,   7331 },  // 3488
+        {  15095, -19755,   6464, -21898,   7317 },  // 3520
+        {  15215, -19934,   6529, -21876,   7302 },  // 3552
+        {  15336, -20114,   6595, -21854,   7288 },  // 3584
+        {  15459, -20295,   6661, -21833,   7273 },  // 3616
+        {  15582, -20479,   6728, -21811,   7259 },  // 3648
+        {  15707, -20663,   6796, -21789,   7244 },  // 3680
+        {  15832, -20850,   6864, -21767,   7230 },  // 3712
+        {  15958, -21038,   6933, -21745,   7215 },  // 3744
+        {  16086, -21227,   7003, -21723,   7201 },  // 3776
+        {  16214, -21419,   7073, -21701,   7186 },  // 3808
+        {  16343, -21612,   7144, -21679,   7171 },  // 3840
+        {  16384, -21672,   7167, -21672,   7167 },  // 3872
+        {  16384, -21672,   7167, -21672,   7167 },  // 3904
+        {  16384, -21672,   7167, -21672,   7167 },  // 3936
+        {  16384, -21672,   7167, -21672,   7167 },  // 3968
+        {  16384, -21672,   7167, -21672,   7167 },  // 4000
+        {  16384, -21672,   7167, -21672,   7167 },  // 4032
+        {  16384, -21672,   7167, -21672,   7167 },  // 4064
+        {  16384, -21672,   7167, -21672,   7167 },  // 4095
+    },
+};
@@ -0,0 +1,21 @@
+// crc16.h
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection, no final XOR)
+
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRC16_INIT 0xFFFF
+
+/**
+ * @brief Continue a CRC over more bytes
+ * @param crc  CRC16_INIT for a new message, or the value returned for the previous bytes
+ * @param data Bytes to add
+ * @param len  Number of bytes
+ * @return Updated CRC ("123456789" gives 0x29B1)
+ */
+uint16_t crc16Update(uint16_t crc, const uint8_t *data, size_t len);
+
+#endif // CRC16_H
@@ -0,0 +1,82 @@
+// eq_control.c
+// Coefficient source selection for the design tick
+
+#include <stddef.h>
+#include "eq_control.h"
+
+static CmdControl control;
+static uint8_t    dirty;    // Mode or host data changed: resend every band once
+#if EQ_GAIN_INDEX
+static uint8_t    gain_index[COEFF_NUM_BANDS];
+#endif
+
+void eqControlInit(void)
+{
+    control.mode = EQ_MODE_KNOBS;
+    control.test_number = 0;
+    control.coeffs = simpleTestFilters(0);
+    dirty = 0;
+}
+
+void eqControlSet(const CmdControl *ctl)
+{
+    control = *ctl;
+    if (control.mode == EQ_MODE_TEST) {
+        control.coeffs = simpleTestFilters(control.test_number);  // Designed once, not per tick
+    }
+    dirty = 1;
+}
+
+EqMode eqControlMode(void)
+{
+    return control.mode;
+}
+
+uint8_t eqControlTestNumber(void)
+{
+    return control.test_number;
+}
+
+const uint16_t *eqControlSmoothInput(const uint16_t knobs[3])
+{
+    return control.mode == EQ_MODE_POTS ? control.pots : knobs;
+}
+
+uint8_t eqControlDesign(ThreeBandCoeffs *coeffs)
+{
+    uint8_t changed = 0;
+
+    switch (control.mode) {
+    case EQ_MODE_KNOBS:
+    case EQ_MODE_POTS:
+        // Smoothing and hysteresis apply to host pots exactly as to the knobs
+#if EQ_GAIN_INDEX
+        changed = calcCoeffGainIndexChanged(gain_index);
+#else
+        changed = calcCoeffDesignChanged(coeffs);
+#endif
+        break;
+    case EQ_MODE_COEFFS:
+    case EQ_MODE_TEST:
+        *coeffs = control.coeffs;
+        break;
+    default:
+        break;
+    }
+
+    if (dirty) {
+        changed = COEFF_BANDS_ALL;
+        dirty = 0;
+    }
+    return changed;
+}
+
+const uint8_t *eqControlGainIndex(void)
+{
+#if EQ_GAIN_INDEX
+    if (control.mode == EQ_MODE_KNOBS || control.mode == EQ_MODE_POTS) {
+        return gain_index;
+    }
+#endif
+    return NULL;
+}
@@ -0,0 +1,56 @@
+// eq_control.h
+// Chooses where the coefficients come from: knobs, host pot overrides, host coefficients or test filters
+
+#ifndef EQ_CONTROL_H
+#define EQ_CONTROL_H
+
+#include <stdint.h>
+#include "calc_coefficient.h"
+#include "cmd_server.h"
+
+// Knob and host-pot modes send gain indices (coeffFrameSendIndices) instead of
+// coefficients; the FPGA looks them up in gain_rom.sv and the design tick does
+// no float work at all (override with -DEQ_GAIN_INDEX=1)
+#ifndef EQ_GAIN_INDEX
+#define EQ_GAIN_INDEX 0
+#endif
+
+/**
+ * @brief Start in EQ_MODE_KNOBS
+ */
+void eqControlInit(void);
+
+/**
+ * @brief Switch to a complete control state (call at the design tick)
+ */
+void eqControlSet(const CmdControl *ctl);
+
+/**
+ * @brief Current mode and test number
+ */
+EqMode eqControlMode(void);
+uint8_t eqControlTestNumber(void);
+
+/**
+ * @brief ADC codes the smoothing should see
+ * @param knobs Codes read from the pots (low, mid, high)
+ * @return knobs, or the host's override in EQ_MODE_POTS
+ */
+const uint16_t *eqControlSmoothInput(const uint16_t knobs[3]);
+
+/**
+ * @brief Produce this tick's coefficients for the current mode
+ * @param coeffs Receives the coefficients for all three bands (left alone when
+ *               eqControlGainIndex is not NULL)
+ * @return Bitmask of bands that changed (all bands right after eqControlSet)
+ */
+uint8_t eqControlDesign(ThreeBandCoeffs *coeffs);
+
+/**
+ * @brief Gain indices from the last eqControlDesign
+ * @return Index per band (low, mid, high) to send with coeffFrameSendIndices,
+ *         or NULL when the current mode sends coefficients
+ */
+const uint8_t *eqControlGainIndex(void);
+
+#endif // EQ_CONTROL_H
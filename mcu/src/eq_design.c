@@ -0,0 +1,244 @@
+// eq_design.c
+// Runtime-parametric N-band EQ designer (RBJ Audio EQ Cookbook)
+// w0-dependent terms are cached per band, so a gain change costs one powf/sqrtf
+// and no trig; retuning a band or changing FS re-caches only that band.
+
+#include "eq_design.h"
+#include "calc_coefficient_config.h"
+#include <math.h>
+
+// -----------------------------
+// Configuration
+// -----------------------------
+
+#define Q14_SHIFT 14
+#define Q14_SCALE (1 << Q14_SHIFT)
+
+#define EQ_PI 3.14159265358979323846f
+
+const EqBandDesc eqThreeBandDefaults[COEFF_NUM_BANDS] = {
+    { EQ_LOW_SHELF,  LOW_SHELF_FREQ,  Q, -MAX_CUT_DB, 0.0f },
+    { EQ_PEAK,       MID_PEAK_FREQ,   Q, -MAX_CUT_DB, 0.0f },
+    { EQ_HIGH_SHELF, HIGH_SHELF_FREQ, Q, -MAX_CUT_DB, 0.0f },
+};
+
+// -----------------------------
+// Q2.14 Helpers
+// -----------------------------
+
+static inline int16_t float_to_q14(float x)
+{
+    int32_t q = (int32_t)lroundf(x * Q14_SCALE);
+
+    if (q >  32767) q =  32767;
+    if (q < -32768) q = -32768;
+
+    return (int16_t)q;
+}
+
+static BiquadQ14 normalize_q14(float b0, float b1, float b2,
+                               float a0, float a1, float a2)
+{
+    BiquadQ14 q;
+
+    // Normalize by a0
+    b0 /= a0;
+    b1 /= a0;
+    b2 /= a0;
+    a1 /= a0;
+    a2 /= a0;
+
+    q.b0 = float_to_q14(b0);
+    q.b1 = float_to_q14(b1);
+    q.b2 = float_to_q14(b2);
+    q.a1 = float_to_q14(a1);
+    q.a2 = float_to_q14(a2);
+
+    return q;
+}
+
+// -----------------------------
+// Section Design (gain-dependent part only)
+// -----------------------------
+
+static BiquadQ14 design_section(const EqBand *band)
+{
+    const float cosw0 = band->cosw0;
+    const float alpha = band->alpha;
+    const float gainDB = band->gain_db;
+    float A, t, scale;
+
+    switch (band->desc.type) {
+        case EQ_LOW_SHELF:
+            if (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) {
+                return simpleUnity();
+            }
+            A = powf(10.0f, gainDB / 40.0f);
+            t = 2*sqrtf(A)*alpha;
+            return normalize_q14(  A*((A+1) - (A-1)*cosw0 + t),
+                                 2*A*((A-1) - (A+1)*cosw0),
+                                   A*((A+1) - (A-1)*cosw0 - t),
+                                       (A+1) + (A-1)*cosw0 + t,
+                                  -2*((A-1) + (A+1)*cosw0),
+                                       (A+1) + (A-1)*cosw0 - t);
+
+        case EQ_HIGH_SHELF:
+            if (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) {
+                return simpleUnity();
+            }
+            A = powf(10.0f, gainDB / 40.0f);
+            t = 2*sqrtf(A)*alpha;
+            return normalize_q14(   A*((A+1) + (A-1)*cosw0 + t),
+                                 -2*A*((A-1) + (A+1)*cosw0),
+                                    A*((A+1) + (A-1)*cosw0 - t),
+                                        (A+1) - (A-1)*cosw0 + t,
+                                    2*((A-1) - (A+1)*cosw0),
+                                        (A+1) - (A-1)*cosw0 - t);
+
+        case EQ_PEAK:
+            if (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) {
+                return simpleUnity();
+            }
+            A = powf(10.0f, gainDB / 40.0f);
+            return normalize_q14(1 + alpha*A, -2*cosw0, 1 - alpha*A,
+                                 1 + alpha/A, -2*cosw0, 1 - alpha/A);
+
+        default:
+            break;
+    }
+
+    // Pass/stop filters: gain is a flat passband level
+    scale = (fabsf(gainDB) < UNITY_GAIN_THRESHOLD_DB) ? 1.0f : powf(10.0f, gainDB / 20.0f);
+
+    switch (band->desc.type) {
+        case EQ_HIGHPASS:
+            return normalize_q14(scale*(1 + cosw0)/2, -scale*(1 + cosw0), scale*(1 + cosw0)/2,
+                                 1 + alpha, -2*cosw0, 1 - alpha);
+
+        case EQ_LOWPASS:
+            return normalize_q14(scale*(1 - cosw0)/2, scale*(1 - cosw0), scale*(1 - cosw0)/2,
+                                 1 + alpha, -2*cosw0, 1 - alpha);
+
+        case EQ_NOTCH:
+            return normalize_q14(scale, -2*scale*cosw0, scale,
+                                 1 + alpha, -2*cosw0, 1 - alpha);
+
+        default:
+            return simpleUnity();
+    }
+}
+
+// Cache everything that depends only on frequency, Q and FS
+static void prepare_band(EqBand *band, float fs)
+{
+    float w0 = 2.0f * EQ_PI * band->desc.freq_hz / fs;
+
+    band->alpha = sinf(w0) / (2.0f * band->desc.q);
+    band->cosw0 = cosf(w0);
+}
+
+static float clamp_gain(const EqBandDesc *desc, float gain_db)
+{
+    if (gain_db < desc->min_gain_db) return desc->min_gain_db;
+    if (gain_db > desc->max_gain_db) return desc->max_gain_db;
+    return gain_db;
+}
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+void eqInit(EqDesign *eq, float fs, EqBand *bands, BiquadQ14 *sections, uint8_t num_bands)
+{
+    eq->fs        = fs;
+    eq->num_bands = num_bands;
+    eq->bands     = bands;
+    eq->sections  = sections;
+
+    for (uint8_t i = 0; i < num_bands; i++) {
+        // Flat peak at 1 kHz until configured
+        bands[i].desc.type        = EQ_PEAK;
+        bands[i].desc.freq_hz     = 1000.0f;
+        bands[i].desc.q           = 0.707f;
+        bands[i].desc.min_gain_db = 0.0f;
+        bands[i].desc.max_gain_db = 0.0f;
+        bands[i].gain_db          = 0.0f;
+        prepare_band(&bands[i], fs);
+        sections[i] = simpleUnity();
+    }
+}
+
+int eqConfigureBand(EqDesign *eq, uint8_t index, const EqBandDesc *desc)
+{
+    if (index >= eq->num_bands || desc->type >= EQ_NUM_BAND_TYPES) {
+        return -1;
+    }
+    if (desc->freq_hz <= 0.0f || desc->freq_hz >= eq->fs / 2.0f ||
+        desc->q <= 0.0f || desc->min_gain_db > desc->max_gain_db) {
+        return -1;
+    }
+
+    EqBand *band = &eq->bands[index];
+    band->desc    = *desc;
+    band->gain_db = clamp_gain(desc, 0.0f);   // Start as flat as the range allows
+    prepare_band(band, eq->fs);
+    eq->sections[index] = design_section(band);
+
+    return 0;
+}
+
+void eqSetSampleRate(EqDesign *eq, float fs)
+{
+    eq->fs = fs;
+
+    for (uint8_t i = 0; i < eq->num_bands; i++) {
+        prepare_band(&eq->bands[i], fs);
+        eq->sections[i] = design_section(&eq->bands[i]);
+    }
+}
+
+int eqSetGain(EqDesign *eq, uint8_t index, float gain_db)
+{
+    if (index >= eq->num_bands) {
+        return -1;
+    }
+
+    EqBand *band = &eq->bands[index];
+    band->gain_db = clamp_gain(&band->desc, gain_db);
+    eq->sections[index] = design_section(band);
+
+    return 0;
+}
+
+int eqSetPot(EqDesign *eq, uint8_t index, float pot)
+{
+    if (index >= eq->num_bands) {
+        return -1;
+    }
+
+    const EqBandDesc *desc = &eq->bands[index].desc;
+
+    // Written as max - span * (1 - pot) so the default bands match pot_to_gain_db exactly
+    return eqSetGain(eq, index,
+                     desc->max_gain_db - (desc->max_gain_db - desc->min_gain_db) * (1.0f - pot));
+}
+
+int eqGraphicLayout(EqDesign *eq, float f_lo, float f_hi, float range_db)
+{
+    if (eq->num_bands < 2 || f_lo <= 0.0f || f_hi <= f_lo || range_db < 0.0f) {
+        return -1;
+    }
+
+    float ratio = powf(f_hi / f_lo, 1.0f / (float)(eq->num_bands - 1));
+    EqBandDesc desc = { EQ_PEAK, f_lo, sqrtf(ratio) / (ratio - 1.0f), -range_db, range_db };
+
+    for (uint8_t i = 0; i < eq->num_bands; i++) {
+        // The last center is set exactly so rounding cannot push it past fs / 2
+        desc.freq_hz = (i == eq->num_bands - 1) ? f_hi : f_lo * powf(ratio, (float)i);
+        if (eqConfigureBand(eq, i, &desc) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
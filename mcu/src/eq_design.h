@@ -0,0 +1,113 @@
+// eq_design.h
+// Runtime-parametric N-band EQ designer: band descriptors in, BiquadQ14 sections out
+
+#ifndef EQ_DESIGN_H
+#define EQ_DESIGN_H
+
+#include <stdint.h>
+#include "calc_coefficient.h"
+
+// -----------------------------
+// Band Descriptors
+// -----------------------------
+
+typedef enum {
+    EQ_LOW_SHELF = 0,
+    EQ_HIGH_SHELF,
+    EQ_PEAK,
+    EQ_HIGHPASS,      // Gain scales the passband level
+    EQ_LOWPASS,       // Gain scales the passband level
+    EQ_NOTCH,         // Gain scales the passband level
+    EQ_NUM_BAND_TYPES
+} EqBandType;
+
+typedef struct {
+    EqBandType type;
+    float freq_hz;      // Corner / center frequency
+    float q;            // Quality factor
+    float min_gain_db;  // Gain with the pot at 0.0
+    float max_gain_db;  // Gain with the pot at 1.0
+} EqBandDesc;
+
+// One band plus its cached gain-independent terms
+typedef struct {
+    EqBandDesc desc;
+    float cosw0;        // cos(w0)
+    float alpha;        // sin(w0) / (2Q)
+    float gain_db;      // Gain of the current section
+} EqBand;
+
+typedef struct {
+    float      fs;          // Sample rate in Hz
+    uint8_t    num_bands;
+    EqBand    *bands;       // num_bands entries, owned by the caller
+    BiquadQ14 *sections;    // num_bands entries, sections[i] realizes bands[i]
+} EqDesign;
+
+// Low-shelf 400 Hz, peak 1 kHz, high-shelf 2 kHz: same sections as calcCoeffUpdate
+extern const EqBandDesc eqThreeBandDefaults[COEFF_NUM_BANDS];
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Attach caller storage; every section starts as unity (passthrough)
+ * @param eq        Design to initialize
+ * @param fs        Sample rate in Hz
+ * @param bands     Array of num_bands band slots
+ * @param sections  Array of num_bands output sections
+ * @param num_bands Number of bands / cascaded sections
+ */
+void eqInit(EqDesign *eq, float fs, EqBand *bands, BiquadQ14 *sections, uint8_t num_bands);
+
+/**
+ * @brief Retune one band: caches w0-dependent terms, then designs it at max_gain_db
+ * @param eq    Design
+ * @param index Band index (0 to num_bands - 1)
+ * @param desc  New band descriptor (copied)
+ * @return 0 on success, -1 for a bad index or descriptor
+ */
+int eqConfigureBand(EqDesign *eq, uint8_t index, const EqBandDesc *desc);
+
+/**
+ * @brief Change the sample rate and re-cache every band's invariant terms
+ * @param eq Design
+ * @param fs Sample rate in Hz
+ */
+void eqSetSampleRate(EqDesign *eq, float fs);
+
+/**
+ * @brief Redesign one band at a new gain using its cached terms (no trig)
+ * @param eq      Design
+ * @param index   Band index
+ * @param gain_db Gain in dB, clamped to the band's [min_gain_db, max_gain_db]
+ * @return 0 on success, -1 for a bad index
+ */
+int eqSetGain(EqDesign *eq, uint8_t index, float gain_db);
+
+/**
+ * @brief Redesign one band from a pot position mapped onto its gain range
+ * @param eq    Design
+ * @param index Band index
+ * @param pot   Pot position (0.0 = min_gain_db, 1.0 = max_gain_db)
+ * @return 0 on success, -1 for a bad index
+ */
+int eqSetPot(EqDesign *eq, uint8_t index, float pot);
+
+/**
+ * @brief Configure every band as a graphic EQ: peaks at log-spaced centers
+ *
+ * The centers run from f_lo to f_hi at a constant ratio r, and Q = sqrt(r) / (r - 1)
+ * makes neighbouring bands meet at their -3 dB points (octave spacing: Q = 1.41).
+ * Pair with iir_cascade_accum's N_SECTIONS and coeffFrameSendSections.
+ *
+ * @param eq       Design with at least two bands
+ * @param f_lo     Center of band 0 in Hz
+ * @param f_hi     Center of the last band in Hz, below fs / 2
+ * @param range_db Each band's gain range is -range_db to +range_db
+ * @return 0 on success, -1 for fewer than two bands or a bad frequency or range
+ */
+int eqGraphicLayout(EqDesign *eq, float f_lo, float f_hi, float range_db);
+
+#endif // EQ_DESIGN_H
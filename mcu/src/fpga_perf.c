@@ -0,0 +1,93 @@
+// fpga_perf.c
+// FPGA performance counter bank: register sweep over coeff_frame's link and decoding
+
+#include "fpga_perf.h"
+#include "coeff_frame.h"
+
+// -----------------------------
+// State
+// -----------------------------
+
+static uint32_t regs[FPGA_PERF_REGS];
+static uint8_t  next_reg;
+static uint8_t  waiting;     // A read of next_reg was started
+static uint8_t  have_snapshot;
+static FpgaPerf snapshot;
+
+// -----------------------------
+// Decoding
+// -----------------------------
+
+int fpgaPerfDecode(const uint32_t regs_in[FPGA_PERF_REGS], FpgaPerf *p)
+{
+    uint32_t id = regs_in[FPGA_REG_ID];
+    if ((id >> 16) != FPGA_PERF_MAGIC || (id & 0xFF) != FPGA_PERF_VERSION) return 0;
+
+    p->n_bands         = (uint8_t)(id >> 8);
+    p->samples         = regs_in[FPGA_REG_SAMPLES];
+    p->clips           = regs_in[FPGA_REG_CLIPS];
+    p->mac_busy_last   = (uint16_t)regs_in[FPGA_REG_MAC];
+    p->mac_busy_max    = (uint16_t)(regs_in[FPGA_REG_MAC] >> 16);
+    p->frame_clks      = (uint16_t)regs_in[FPGA_REG_RATE];
+    p->edge_clks_max   = (uint16_t)(regs_in[FPGA_REG_RATE] >> 16);
+    p->frames_ok       = regs_in[FPGA_REG_FRAMES_OK];
+    p->frames_rejected = regs_in[FPGA_REG_FRAMES_REJECTED];
+    p->commits         = regs_in[FPGA_REG_COMMITS];
+    return 1;
+}
+
+uint32_t fpgaPerfMacLoadPermille(const FpgaPerf *p)
+{
+    return (uint32_t)p->mac_busy_max * 1000u / FPGA_CLKS_PER_EDGE;
+}
+
+uint32_t fpgaPerfSampleRateHz(const FpgaPerf *p)
+{
+    if (p->frame_clks == 0) return 0;
+    return (FPGA_CLK_HZ + p->frame_clks / 2) / p->frame_clks;
+}
+
+// -----------------------------
+// Register Sweep
+// -----------------------------
+
+void fpgaPerfInit(void)
+{
+    next_reg = 0;
+    waiting = 0;
+    have_snapshot = 0;
+}
+
+int fpgaPerfService(void)
+{
+    int swept = 0;
+
+    if (waiting && !coeffFrameBusy()) {
+        uint8_t reg;
+        uint32_t value;
+        waiting = 0;
+        if (coeffFrameReadResult(&reg, &value) && reg == next_reg) {
+            regs[next_reg++] = value;
+            if (next_reg == FPGA_PERF_REGS) {
+                next_reg = 0;
+                if (fpgaPerfDecode(regs, &snapshot)) {
+                    have_snapshot = 1;
+                    swept = 1;
+                }
+            }
+        }
+        // Otherwise a frame went out after the read, or MISO gave no status: read it again
+    }
+
+    if (!waiting && coeffFrameRead(next_reg)) {
+        waiting = 1;
+    }
+    return swept;
+}
+
+int fpgaPerfGet(FpgaPerf *p)
+{
+    if (!have_snapshot) return 0;
+    *p = snapshot;
+    return 1;
+}
@@ -0,0 +1,87 @@
+// fpga_perf.h
+// Reads the FPGA's performance counter bank over the coefficient SPI link and decodes it
+
+#ifndef FPGA_PERF_H
+#define FPGA_PERF_H
+
+#include <stdint.h>
+
+// -----------------------------
+// Readback Bank (fpga/src/spi_top.sv)
+// -----------------------------
+
+// 32-bit registers, read one per SPI transaction (coeffFrameRead). Counters run
+// free from the FPGA's reset and wrap; take differences between reads.
+typedef enum {
+    FPGA_REG_ID              = 0,   // {FPGA_PERF_MAGIC, N_BANDS, FPGA_PERF_VERSION}
+    FPGA_REG_SAMPLES         = 1,   // Samples filtered, both channels
+    FPGA_REG_CLIPS           = 2,   // Section results saturated
+    FPGA_REG_MAC             = 3,   // {most, latest} MAC-busy clks of one pass
+    FPGA_REG_RATE            = 4,   // {longest l_r_clk edge, latest stereo frame} in clks
+    FPGA_REG_FRAMES_OK       = 5,   // Coefficient frames accepted
+    FPGA_REG_FRAMES_REJECTED = 6,   // Bad header or CRC, lost write, cut short
+    FPGA_REG_COMMITS         = 7,   // Staged bands made active
+    FPGA_PERF_REGS           = 8,
+    FPGA_REG_RAMP_SHIFT      = 8,   // Config register COEFF_CONFIG_RAMP_SHIFT (not swept)
+} FpgaReg;
+
+#define FPGA_PERF_MAGIC    0xE155
+#define FPGA_PERF_VERSION  1
+#define FPGA_CLK_HZ        12000000u    // HSOSC in fpga/src/top.sv
+#define FPGA_CLKS_PER_EDGE 192          // Pass budget of iir_cascade_accum
+
+typedef struct {
+    uint8_t  n_bands;
+    uint32_t samples;
+    uint32_t clips;
+    uint16_t mac_busy_last;     // Clks the MAC was busy in the latest pass
+    uint16_t mac_busy_max;
+    uint16_t edge_clks_max;     // Longest time between two samples (either channel)
+    uint16_t frame_clks;        // Latest stereo frame: one sample per channel
+    uint32_t frames_ok;
+    uint32_t frames_rejected;
+    uint32_t commits;
+} FpgaPerf;
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Decode a full read of the bank
+ * @return 1 if the ID register matches FPGA_PERF_MAGIC and FPGA_PERF_VERSION, else 0 (p untouched)
+ */
+int fpgaPerfDecode(const uint32_t regs[FPGA_PERF_REGS], FpgaPerf *p);
+
+/**
+ * @brief Worst MAC load seen, in permille of one edge's FPGA_CLKS_PER_EDGE budget
+ */
+uint32_t fpgaPerfMacLoadPermille(const FpgaPerf *p);
+
+/**
+ * @brief Per-channel sample rate measured by the FPGA, 0 before it has seen a frame
+ */
+uint32_t fpgaPerfSampleRateHz(const FpgaPerf *p);
+
+/**
+ * @brief Forget any partial read and the last snapshot
+ */
+void fpgaPerfInit(void);
+
+/**
+ * @brief Read the next register while the SPI link is idle; call periodically from main
+ *
+ * Coefficient frames take priority: a read that finds the link busy, or whose
+ * result a frame replaced, is simply tried again on a later call.
+ *
+ * @return 1 when this call completed a sweep of the bank and decoded it
+ */
+int fpgaPerfService(void);
+
+/**
+ * @brief The latest decoded sweep
+ * @return 1 if there is one, 0 if no sweep has decoded yet
+ */
+int fpgaPerfGet(FpgaPerf *p);
+
+#endif // FPGA_PERF_H
@@ -2,9 +2,93 @@
 #include <stdint.h>
 #include "STM32L432KC.h"
 #include "calc_coefficient.h"
+#include "adc_scan.h"
+#include "coeff_frame.h"
+#include "fpga_perf.h"
+#include "scheduler.h"
+#include "prof.h"
+#include "telemetry.h"
+#include "uart.h"
+#include "cmd_server.h"
+#include "eq_control.h"
+
+// -----------------------------
+// Task Rates
+// -----------------------------
+
+// Periods in 1 ms ticks. A knob move reaches the SPI frame within
+// SMOOTH_PERIOD + DESIGN_PERIOD ticks of being sampled (plus the moving average
+// settling); knob_latency_max records the worst case actually seen.
+#define SCHED_TICK_HZ       1000
+#define SAMPLE_PERIOD       1
+#define SMOOTH_PERIOD       5
+#define DESIGN_PERIOD       20
+#define SEND_PERIOD         20     // Same period and phase as design, runs right after it
+#define TELEM_PERIOD        100    // Coefficient/pot/FPGA records into the telemetry ring
+#define PERF_PERIOD         10     // One FPGA counter register per run, a sweep every 80 ms
+#define TELEM_DRAIN_BYTES   32     // Per tick, ITM port 1; decode with tools/telem_decode.c
+#define PROF_DUMP_PERIOD    5000   // Binary profile dump on ITM, decode with tools/prof_decode.c
+#define CMD_PERIOD          1      // Host commands on USART2; see tools/eq_cmd.c
+
+// HSI16 / 230400 gives BRR 69, 0.6% fast (460800 would be 2.1% off)
+#define CMD_UART_BAUD       230400
+
+// Send periods without a knob change before the FPGA status is polled (or, with
+// no status word on MISO, the frame is resent anyway)
+#define FRAME_REFRESH_SENDS 50
+
+// FPGA coefficient ramp: each change walks in over ~2^7 samples (4 ms at 31.25 kHz),
+// so frames every SEND_PERIOD glide into one another instead of stepping
+#define FPGA_RAMP_SHIFT     7
 
 int _write(int file, char *ptr, int len);
-static void print_q14(const char *name, int16_t q);
+
+static void task_sample(void);
+static void task_smooth(void);
+static void task_design(void);
+static void task_send(void);
+static void task_perf(void);
+static void task_telemetry(void);
+static void task_telem_drain(void);
+static void task_cmd(void);
+static void fill_status(CmdStatus *status);
+#if PROF_ENABLED
+static void task_prof_dump(void);
+static void itm_write(const uint8_t *data, size_t len);
+#endif
+
+// Table order is run order within a tick
+static SchedTask tasks[] = {
+    { .name = "sample", .fn = task_sample,      .period = SAMPLE_PERIOD,    .phase = 0 },
+    { .name = "smooth", .fn = task_smooth,      .period = SMOOTH_PERIOD,    .phase = 0 },
+    { .name = "design", .fn = task_design,      .period = DESIGN_PERIOD,    .phase = 1 },
+    { .name = "send",   .fn = task_send,        .period = SEND_PERIOD,      .phase = 1 },
+    { .name = "perf",   .fn = task_perf,        .period = PERF_PERIOD,      .phase = 5 },
+    { .name = "telem",  .fn = task_telemetry,   .period = TELEM_PERIOD,     .phase = 7 },
+    { .name = "drain",  .fn = task_telem_drain, .period = 1,                .phase = 0 },
+    { .name = "cmd",    .fn = task_cmd,         .period = CMD_PERIOD,       .phase = 0 },
+#if PROF_ENABLED
+    { .name = "prof",   .fn = task_prof_dump,   .period = PROF_DUMP_PERIOD, .phase = 13 },
+#endif
+};
+
+// Frame suppression counters (inspect with the debugger or calcCoeffGetStats)
+static uint32_t frames_sent;
+static uint32_t frames_suppressed;
+
+// Knob-to-frame latency in ticks: smoothing run that saw the move -> frame queued
+static uint32_t knob_latency_max;
+
+// State handed from task to task
+static ThreeBandCoeffs coeffs;
+static uint8_t  send_changed;     // Bands redesigned since the last frame
+static uint8_t  telem_changed;    // Bands redesigned since the last telemetry record
+static uint32_t smooth_tick;      // Tick of the latest smoothing run
+static uint32_t change_tick;      // smooth_tick behind the oldest unsent redesign
+static uint32_t sends_since_frame;
+static uint8_t  config_due = 1;   // FPGA config registers still to be written (after a reset too)
+static uint16_t bypass_sent;      // Bypass flags of the last v5 frame; any reported loss resends them
+static uint8_t  bypass_due;       // Resend them even if unchanged
 
 int main(void) {
     RCC->AHB2ENR |= (RCC_AHB2ENR_GPIOAEN | RCC_AHB2ENR_GPIOBEN | RCC_AHB2ENR_GPIOCEN |
@@ -17,112 +101,198 @@ int main(void) {
 
     pinMode(PA11, GPIO_OUTPUT);
     digitalWrite(PA11, 1);  // CS idle HIGH
+    coeffFrameInit();       // SPI1 DMA channels for coefficient frames
+    fpgaPerfInit();         // FPGA counters, read back on the same link
 
     configureADC();
+    adcScanInit(ADC_SCAN_RATE_HZ);  // TIM6-triggered DMA scan keeps values[] fresh
 
     calcCoeffInit();   // <-- initialize coefficient calculator
-while(1){
-    readADC();
-    //printf("%u \n", values[3]);
-
-    // ADC TABLE:
-    // values[1] is middle knob
-    // values[2] is left knob
-    // values[3] is right knob
-
-    //printf("ADC Values: "); 
-    //for(int i = 0; i < 5; i++) { 
-    // printf("%u \n", values[i]); 
-    //}
-
-    // -----------------------------
-    // Coefficient Calculation
-    // -----------------------------
-    /*ThreeBandCoeffs coeffs = calcCoeffUpdate(
-        values[2],   // low band knob
-        values[1],   // mid band knob
-        values[3]    // high band knob
-    ); */
-
-    //ThreeBandCoeffs coeffs = simpleTestFilters(0);
-    ThreeBandCoeffs coeffs = calcCoeffUpdate(values[2], values[1], values[3]);
-
-    
-    // -----------------------------
-    // SPI OUTPUT
-    // -----------------------------     
-    digitalWrite(PA11, 0);  // CS low
-    
-    spiSendReceive(0xAA);  // Sync byte 1
-    spiSendReceive(0x55);  // Sync byte 2
-    
-    // Send 5 ADC values (10 bytes total)
-    for(int i = 0; i < 5; i++) {
-        spiSendReceive(values[i] >> 8);    // MSB of ADC value
-        spiSendReceive(values[i] & 0xFF);  // LSB of ADC value
+    profInit();        // DWT cycle counter for the PROF_BEGIN/PROF_END scopes
+    telemInit(schedNow);  // Records stamped in scheduler ticks (ms)
+
+    eqControlInit();                 // Knobs drive the EQ until the host says otherwise
+    cmdServerInit(fill_status);
+    uartInit(CMD_UART_BAUD);         // ST-LINK virtual COM port
+
+    schedInit(tasks, sizeof tasks / sizeof tasks[0], SCHED_TICK_HZ);
+    schedRun();
+}
+
+// -----------------------------
+// Tasks
+// -----------------------------
+
+// ADC TABLE:
+// values[1] is middle knob
+// values[2] is left knob
+// values[3] is right knob
+
+static void task_sample(void)
+{
+    PROF_BEGIN(read, "adc_read");
+    adcScanRead(values);  // Latest complete scan, no conversion wait
+    PROF_END(read);
+}
+
+static void task_smooth(void)
+{
+    const uint16_t knobs[3] = { values[2], values[1], values[3] };
+    const uint16_t *in = eqControlSmoothInput(knobs);  // Host pot override in EQ_MODE_POTS
+
+    PROF_BEGIN(smooth, "smooth");
+    calcCoeffSmooth(in[0], in[1], in[2]);
+    PROF_END(smooth);
+    smooth_tick = schedNow();
+}
+
+static void task_design(void)
+{
+    CmdControl ctl;
+
+    // Host changes land here, whole, so a frame never mixes old and new control
+    PROF_BEGIN(design, "design");
+    if (cmdServerTakeControl(&ctl)) {
+        eqControlSet(&ctl);
     }
-    /*
-    // Send Low-pass filter coefficients (10 bytes)
-    spiSendReceive(0x40); spiSendReceive(0x00);  // LOW_B0 = 0x4000
-    spiSendReceive(0x00); spiSendReceive(0x30);  // LOW_B1 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x00);  // LOW_B2 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x01);  // LOW_A1 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x01);  // LOW_A2 = 0x0000
-    
-    // Send Mid-pass filter coefficients (10 bytes)
-    spiSendReceive(0x20); spiSendReceive(0x00);  // MID_B0 = 0x4000
-    spiSendReceive(0x00); spiSendReceive(0x01);  // MID_B1 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x01);  // MID_B2 = 0x0000
-    spiSendReceive(0xFF); spiSendReceive(0xFF);  // MID_A1 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x00);  // MID_A2 = 0x0000
-    
-    // Send High-pass filter coefficients (10 bytes)
-    spiSendReceive(0x40); spiSendReceive(0x00);  // HIGH_B0 = 0x4000
-    spiSendReceive(0x00); spiSendReceive(0x00);  // HIGH_B1 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x10);  // HIGH_B2 = 0x0000
-    spiSendReceive(0x00); spiSendReceive(0x00);  // HIGH_A1 = 0x0000
-    spiSendReceive(0xFF); spiSendReceive(0x00);  // HIGH_A2 = 0x0000
-  */
-
-    // helper macro
-#define SEND_Q14(x)          \
-    do {                     \
-        spiSendReceive(((x) >> 8) & 0xFF); \
-        spiSendReceive((x) & 0xFF);        \
-    } while(0)
-
-    // ---- LOW BAND ----
-    SEND_Q14(coeffs.low.b0);
-    SEND_Q14(coeffs.low.b1);
-    SEND_Q14(coeffs.low.b2);
-    SEND_Q14(coeffs.low.a1);
-    SEND_Q14(coeffs.low.a2);
-
-    // ---- MID BAND ----
-    SEND_Q14(coeffs.mid.b0);
-    SEND_Q14(coeffs.mid.b1);
-    SEND_Q14(coeffs.mid.b2);
-    SEND_Q14(coeffs.mid.a1);
-    SEND_Q14(coeffs.mid.a2);
-
-    // ---- HIGH BAND ----
-    SEND_Q14(coeffs.high.b0);
-    SEND_Q14(coeffs.high.b1);
-    SEND_Q14(coeffs.high.b2);
-    SEND_Q14(coeffs.high.a1);
-    SEND_Q14(coeffs.high.a2);
-    
-
-    digitalWrite(PA11, 1);  // CS high
-    for(volatile int i = 0; i < 20000; i++);  
-     
-    print_q14("LOW_B0", coeffs.low.b0);
-    print_q14("LOW_B1", coeffs.low.b1);
-    print_q14("LOW_B2", coeffs.low.b2);
-    print_q14("LOW_A1", coeffs.low.a1);
-    print_q14("LOW_A2", coeffs.low.a2);
+    uint8_t changed = eqControlDesign(&coeffs);
+    PROF_END(design);
+
+    if (changed && !send_changed) {
+        change_tick = smooth_tick;
+    }
+    send_changed  |= changed;
+    telem_changed |= changed;
 }
+
+static void task_send(void)
+{
+    // The FPGA's status word confirms each frame; one it dropped (bad CRC, cut
+    // short) or lost to a reset is resent with every band. Without a status word,
+    // refresh periodically instead so the FPGA still recovers its coefficients.
+    CoeffFrameAck ack = coeffFrameCheck();
+    uint8_t mask = send_changed;
+    if (ack == COEFF_ACK_LOST) {
+        mask = COEFF_BANDS_ALL;
+        config_due = 1;
+        bypass_due = 1;
+    } else if (++sends_since_frame >= FRAME_REFRESH_SENDS) {
+        if (ack == COEFF_ACK_UNKNOWN) {
+            mask = COEFF_BANDS_ALL;
+            bypass_due = 1;    // Nothing confirms the flags either
+        } else {
+            coeffFramePoll();  // An idle poll still catches an FPGA reset
+            sends_since_frame = 0;
+        }
+    }
+
+    // The frame below queues behind the config write
+    if (config_due && coeffFrameWriteConfig(COEFF_CONFIG_RAMP_SHIFT, FPGA_RAMP_SHIFT)) {
+        config_due = 0;
+    }
+
+    // Flat bands skip the FPGA cascade (bit-exact, crossfaded in and out). The
+    // flags go ahead of the frame so a band leaving neutral is not held in
+    // bypass behind it; gain-index frames keep every band in the cascade.
+    uint16_t bypass = eqControlGainIndex() ? 0 : coeffFrameFlatBands(&coeffs);
+    if ((bypass != bypass_sent || bypass_due) && coeffFrameSendBypass(bypass)) {
+        bypass_sent = bypass;
+        bypass_due = 0;
+    }
+
+    if (mask) {
+        // Only the redesigned bands go out; a resend or refresh carries all three
+        PROF_BEGIN(send, "frame_send");
+        const uint8_t *index = eqControlGainIndex();  // Non-NULL with EQ_GAIN_INDEX in knob modes
+        if (index) {
+            coeffFrameSendIndices(mask, index);
+        } else {
+            coeffFrameSend(mask, &coeffs);  // Queues behind a frame still on the wire
+        }
+        PROF_END(send);
+        if (send_changed) {
+            uint32_t latency = schedNow() - change_tick;
+            if (latency > knob_latency_max) knob_latency_max = latency;
+        }
+        send_changed = 0;
+        sends_since_frame = 0;
+        frames_sent++;
+    } else {
+        frames_suppressed++;
+    }
+}
+
+static void task_perf(void)
+{
+    // Frames go first: a read only starts while the link is idle
+    fpgaPerfService();
+}
+
+static void task_telemetry(void)
+{
+    const BiquadQ14 *q[COEFF_NUM_BANDS] = { &coeffs.low, &coeffs.mid, &coeffs.high };
+
+    // Record copies only; the drain task formats nothing and never waits on ITM
+    PROF_BEGIN(telem, "telem_log");
+    for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+        if (telem_changed & COEFF_BAND_MASK(b)) {
+            telemLogCoeffs((CoeffBand)b, q[b]);
+        }
+    }
+    uint16_t adc[3] = { values[2], values[1], values[3] };
+    float pots[3];
+    calcCoeffGetPotValues(&pots[0], &pots[1], &pots[2]);
+    telemLogPots(adc, pots);
+    FpgaPerf perf;
+    if (fpgaPerfGet(&perf)) {
+        telemLogFpga(&perf);
+    }
+    PROF_END(telem);
+    telem_changed = 0;
+}
+
+static void task_telem_drain(void)
+{
+    telemDrain(TELEM_DRAIN_BYTES);
+}
+
+static void task_cmd(void)
+{
+    PROF_BEGIN(cmd, "cmd_poll");
+    cmdServerPoll();
+    PROF_END(cmd);
+}
+
+static void fill_status(CmdStatus *status)
+{
+    const uint16_t knobs[3] = { values[2], values[1], values[3] };
+    const uint16_t *in = eqControlSmoothInput(knobs);
+
+    status->mode             = (uint8_t)eqControlMode();
+    status->test_number      = eqControlTestNumber();
+    status->tick             = schedNow();
+    status->frames_sent      = frames_sent;
+    status->knob_latency_max = knob_latency_max;
+    status->telem_dropped    = telemDropped();
+    for (int i = 0; i < 3; i++) {
+        status->pots[i] = in[i];
+    }
+    status->coeffs = coeffs;
+}
+
+#if PROF_ENABLED
+static void task_prof_dump(void)
+{
+    profDump(itm_write);
+}
+
+static void itm_write(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        ITM_SendChar(data[i]);
+    }
 }
+#endif
 
 // Function used by printf to send characters to the laptop (taken from E155 website)
 int _write(int file, char *ptr, int len) {
@@ -132,9 +302,3 @@ int _write(int file, char *ptr, int len) {
   }
   return len;
 }
-
-static void print_q14(const char *name, int16_t q)
-{
-    float real = (float)q / 16384.0f;   // Q14 → float
-    printf("%s: raw = %d, real = %.6f\n", name, q, real);
-}
\ No newline at end of file
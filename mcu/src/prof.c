@@ -0,0 +1,147 @@
+// prof.c
+// Per-scope cycle statistics and their binary dump
+
+#include <string.h>
+#include "prof.h"
+
+// -----------------------------
+// State
+// -----------------------------
+
+static ProfScope scopes[PROF_MAX_SCOPES];
+static uint8_t   num_scopes;
+static uint32_t  clock_hz;
+
+// -----------------------------
+// Helper Functions
+// -----------------------------
+
+static void clear_stats(ProfScope *s)
+{
+    s->count = 0;
+    s->min   = UINT32_MAX;
+    s->max   = 0;
+    s->sum   = 0;
+    for (int b = 0; b < PROF_HIST_BINS; b++) {
+        s->hist[b] = 0;
+    }
+}
+
+static int hist_bin(uint32_t cycles)
+{
+    if (cycles == 0) {
+        return 0;
+    }
+    int b = 32 - __builtin_clz(cycles);
+    return b < PROF_HIST_BINS ? b : PROF_HIST_BINS - 1;
+}
+
+static uint8_t *put_le(uint8_t *p, uint64_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+void profInit(void)
+{
+    clock_hz = profHwInit();
+    profReset();
+}
+
+int profScope(const char *name)
+{
+    for (int i = 0; i < num_scopes; i++) {
+        if (strcmp(scopes[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (num_scopes >= PROF_MAX_SCOPES) {
+        return -1;
+    }
+    scopes[num_scopes].name = name;
+    clear_stats(&scopes[num_scopes]);
+    return num_scopes++;
+}
+
+void profRecord(int id, uint32_t cycles)
+{
+    if (id < 0 || id >= num_scopes) {
+        return;
+    }
+    ProfScope *s = &scopes[id];
+    s->count++;
+    s->sum += cycles;
+    if (cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->hist[hist_bin(cycles)]++;
+}
+
+const ProfScope *profGet(int id)
+{
+    return (id >= 0 && id < num_scopes) ? &scopes[id] : NULL;
+}
+
+void profReset(void)
+{
+    for (int i = 0; i < num_scopes; i++) {
+        clear_stats(&scopes[i]);
+    }
+}
+
+size_t profSerialize(uint8_t *buf, size_t cap)
+{
+    size_t need = PROF_DUMP_HEADER + 1;
+    for (int i = 0; i < num_scopes; i++) {
+        size_t n = strlen(scopes[i].name);
+        need += PROF_DUMP_SCOPE(n > PROF_NAME_MAX ? PROF_NAME_MAX : n);
+    }
+    if (need > cap) {
+        return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = PROF_DUMP_MAGIC0;
+    *p++ = PROF_DUMP_MAGIC1;
+    *p++ = PROF_DUMP_VERSION;
+    *p++ = num_scopes;
+    p = put_le(p, clock_hz, 4);
+
+    for (int i = 0; i < num_scopes; i++) {
+        const ProfScope *s = &scopes[i];
+        size_t n = strlen(s->name);
+        if (n > PROF_NAME_MAX) n = PROF_NAME_MAX;
+
+        *p++ = (uint8_t)n;
+        memcpy(p, s->name, n);
+        p += n;
+        p = put_le(p, s->count, 4);
+        p = put_le(p, s->count ? s->min : 0, 4);
+        p = put_le(p, s->max, 4);
+        p = put_le(p, s->sum, 8);
+        for (int b = 0; b < PROF_HIST_BINS; b++) {
+            p = put_le(p, s->hist[b] > 0xFFFF ? 0xFFFF : s->hist[b], 2);
+        }
+    }
+
+    uint8_t x = 0;
+    for (uint8_t *q = buf; q < p; q++) {
+        x ^= *q;
+    }
+    *p++ = x;
+    return (size_t)(p - buf);
+}
+
+void profDump(ProfWriteFn write)
+{
+    static uint8_t buf[PROF_DUMP_MAX];
+    size_t len = profSerialize(buf, sizeof buf);
+    if (len) {
+        write(buf, len);
+    }
+}
@@ -0,0 +1,130 @@
+// prof.h
+// Named cycle-count scopes (DWT CYCCNT on target, a host clock on Linux) with a binary dump
+
+#ifndef PROF_H
+#define PROF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Build with -DPROF_ENABLED=0 to compile every PROF_* macro away
+#ifndef PROF_ENABLED
+#define PROF_ENABLED 1
+#endif
+
+// -----------------------------
+// Limits and Dump Format
+// -----------------------------
+
+#define PROF_MAX_SCOPES  12
+#define PROF_NAME_MAX    15
+#define PROF_HIST_BINS   20   // Bin b counts durations in [2^(b-1), 2^b), bin 0 is zero, last bin is open
+
+// Dump: 'P' 'F' version scopes clock_hz(u32), then per scope
+//   name_len name count(u32) min(u32) max(u32) sum(u64) hist[PROF_HIST_BINS](u16, saturating)
+// and a trailing XOR of every byte before it. Multi-byte fields are little endian.
+#define PROF_DUMP_MAGIC0   'P'
+#define PROF_DUMP_MAGIC1   'F'
+#define PROF_DUMP_VERSION  1
+#define PROF_DUMP_HEADER   8
+#define PROF_DUMP_SCOPE(n) (1 + (n) + 4 + 4 + 4 + 8 + 2 * PROF_HIST_BINS)
+#define PROF_DUMP_MAX      (PROF_DUMP_HEADER + PROF_MAX_SCOPES * PROF_DUMP_SCOPE(PROF_NAME_MAX) + 1)
+
+typedef struct {
+    const char *name;
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint64_t    sum;
+    uint32_t    hist[PROF_HIST_BINS];
+} ProfScope;
+
+typedef void (*ProfWriteFn)(const uint8_t *data, size_t len);
+
+// -----------------------------
+// Clock (prof_stm32.c on target, prof_host.c on Linux)
+// -----------------------------
+
+/**
+ * @brief Start the cycle counter
+ * @return Counter rate in Hz, reported in the dump header
+ */
+uint32_t profHwInit(void);
+
+/**
+ * @brief Free-running 32-bit counter (host builds only; the target reads CYCCNT inline)
+ */
+uint32_t profHwNow(void);
+
+#if defined(__arm__)
+#define PROF_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+static inline uint32_t profNow(void) { return PROF_DWT_CYCCNT; }
+#else
+static inline uint32_t profNow(void) { return profHwNow(); }
+#endif
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Start the clock and clear every scope (names stay registered)
+ */
+void profInit(void);
+
+/**
+ * @brief Get the id for a named scope, registering it on first use
+ * @param name Static string, at most PROF_NAME_MAX characters are dumped
+ * @return Scope id, or -1 when PROF_MAX_SCOPES are already in use
+ */
+int profScope(const char *name);
+
+/**
+ * @brief Add one measured duration to a scope
+ * @param id     Scope id from profScope (negative ids are ignored)
+ * @param cycles Duration in counter ticks
+ */
+void profRecord(int id, uint32_t cycles);
+
+/**
+ * @brief Read back a scope's statistics
+ * @return Pointer to the scope, NULL for an unknown id
+ */
+const ProfScope *profGet(int id);
+
+/**
+ * @brief Clear the statistics of every scope
+ */
+void profReset(void);
+
+/**
+ * @brief Serialize every scope in the dump format
+ * @param buf Destination
+ * @param cap Size of buf; PROF_DUMP_MAX always suffices
+ * @return Bytes written, 0 if cap is too small
+ */
+size_t profSerialize(uint8_t *buf, size_t cap);
+
+/**
+ * @brief Serialize and hand the dump to a byte sink (ITM, USART, file)
+ */
+void profDump(ProfWriteFn write);
+
+// -----------------------------
+// Instrumentation Macros
+// -----------------------------
+
+// PROF_BEGIN(tag, "name") ... PROF_END(tag) in the same block. The scope id is looked
+// up once per call site and cached in a static.
+#if PROF_ENABLED
+#define PROF_BEGIN(tag, name)                                  \
+    static int prof_id_##tag = -2;                             \
+    if (prof_id_##tag == -2) prof_id_##tag = profScope(name);  \
+    uint32_t prof_t0_##tag = profNow()
+#define PROF_END(tag) profRecord(prof_id_##tag, profNow() - prof_t0_##tag)
+#else
+#define PROF_BEGIN(tag, name) ((void)0)
+#define PROF_END(tag)         ((void)0)
+#endif
+
+#endif // PROF_H
@@ -0,0 +1,18 @@
+// prof_host.c
+// Clock for prof.c in Linux builds: CLOCK_MONOTONIC in nanoseconds
+
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "prof.h"
+
+uint32_t profHwInit(void)
+{
+    return 1000000000u;
+}
+
+uint32_t profHwNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
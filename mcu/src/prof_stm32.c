@@ -0,0 +1,18 @@
+// prof_stm32.c
+// Clock for prof.c: the Cortex-M4 DWT cycle counter
+
+#include "STM32L432KC.h"
+#include "prof.h"
+
+uint32_t profHwInit(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;  // DWT needs trace enabled
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    return SystemCoreClock;
+}
+
+uint32_t profHwNow(void)
+{
+    return DWT->CYCCNT;
+}
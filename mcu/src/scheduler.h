@@ -0,0 +1,79 @@
+// scheduler.h
+// Cooperative fixed-rate task scheduler on a timer tick, sleeping in WFI between ticks
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// -----------------------------
+// Types
+// -----------------------------
+
+typedef void (*SchedTaskFn)(void);
+
+typedef struct {
+    // Configuration (filled in by the caller, by designated initializer)
+    const char  *name;
+    SchedTaskFn  fn;
+    uint16_t     period;      // Ticks between releases
+    uint16_t     phase;       // Tick of the first release, spreads tasks sharing a period
+
+    // Runtime (maintained by the scheduler, reset by schedInit)
+    uint32_t     next_due;    // Tick of the next release
+    uint32_t     runs;
+    uint32_t     overruns;    // Releases dropped because the task started a period or more late
+    uint32_t     max_late;    // Worst ticks between release and start
+    uint32_t     max_ticks;   // Worst ticks spent inside fn (0 = finished within its tick)
+} SchedTask;
+
+// -----------------------------
+// Register Layer (scheduler_stm32.c on target, mocked in test/test_scheduler.c)
+// -----------------------------
+
+/**
+ * @brief Start the periodic tick interrupt; its handler calls schedOnTick
+ * @param tick_hz Tick rate
+ */
+void schedHwStart(uint32_t tick_hz);
+
+/**
+ * @brief Sleep until the next interrupt unless a tick arrived after seen was sampled
+ * @param seen Tick count the caller last ran tasks for
+ */
+void schedHwIdle(uint32_t seen);
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Reset task statistics and start the tick
+ * @param tasks   Task table, run in table order when several are due on the same tick
+ * @param count   Number of tasks
+ * @param tick_hz Tick rate that periods and phases count in
+ */
+void schedInit(SchedTask *tasks, uint8_t count, uint32_t tick_hz);
+
+/**
+ * @brief Run every task whose release is due, once each
+ * @return Number of tasks run
+ */
+uint8_t schedRunPending(void);
+
+/**
+ * @brief Run tasks forever, sleeping between ticks
+ */
+void schedRun(void);
+
+/**
+ * @brief Current tick count (wraps; compare with subtraction)
+ */
+uint32_t schedNow(void);
+
+/**
+ * @brief Tick interrupt entry
+ */
+void schedOnTick(void);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,28 @@
+// scheduler_stm32.c
+// Register layer for scheduler.c: TIM7 update interrupt as the tick, WFI between ticks
+
+#include "STM32L432KC.h"
+#include "scheduler.h"
+
+void schedHwStart(uint32_t tick_hz)
+{
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM7EN;
+    initTIMPeriodic(TIM7, tick_hz);
+    NVIC_EnableIRQ(TIM7_IRQn);
+}
+
+void schedHwIdle(uint32_t seen)
+{
+    // With PRIMASK set a pending tick still ends WFI, so the check and the sleep cannot race
+    __disable_irq();
+    if (schedNow() == seen) {
+        __WFI();
+    }
+    __enable_irq();
+}
+
+void TIM7_IRQHandler(void)
+{
+    TIM7->SR &= ~TIM_SR_UIF;
+    schedOnTick();
+}
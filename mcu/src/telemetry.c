@@ -0,0 +1,184 @@
+// telemetry.c
+// Telemetry ring: the producer copies a record, the drain encodes and trickles it out
+
+#include <stddef.h>
+#include "telemetry.h"
+
+// Keeps the compiler from moving record writes across the index updates.
+// Producer and drain each own one index; single core, so no hardware barrier.
+#define TELEM_BARRIER() __asm volatile("" ::: "memory")
+
+// -----------------------------
+// State
+// -----------------------------
+
+static TelemRecord       ring[TELEM_RING_SIZE];
+static volatile uint32_t head;      // Written only by the producer
+static volatile uint32_t tail;      // Written only by the drain
+static uint16_t          seq;
+static volatile uint32_t dropped;
+static TelemClockFn      clock_fn;
+
+// Record being sent, already encoded
+static uint8_t  tx[TELEM_WIRE_BYTES];
+static uint8_t  tx_pos = TELEM_WIRE_BYTES;
+
+// -----------------------------
+// Wire Format
+// -----------------------------
+
+static uint8_t *put_le(uint8_t *p, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    return p;
+}
+
+static uint32_t get_le(const uint8_t *p, int bytes)
+{
+    uint32_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+void telemEncode(const TelemRecord *rec, uint8_t out[TELEM_WIRE_BYTES])
+{
+    uint8_t *p = out;
+    *p++ = TELEM_SYNC;
+    *p++ = rec->type;
+    *p++ = rec->arg;
+    p = put_le(p, rec->seq, 2);
+    p = put_le(p, rec->time, 4);
+    for (int i = 0; i < TELEM_DATA_WORDS; i++) {
+        p = put_le(p, (uint16_t)rec->data[i], 2);
+    }
+
+    uint8_t x = 0;
+    for (int i = 1; i < TELEM_WIRE_BYTES - 1; i++) {
+        x ^= out[i];
+    }
+    *p = x;
+}
+
+int telemDecode(const uint8_t in[TELEM_WIRE_BYTES], TelemRecord *rec)
+{
+    uint8_t x = 0;
+    for (int i = 1; i < TELEM_WIRE_BYTES - 1; i++) {
+        x ^= in[i];
+    }
+    if (in[0] != TELEM_SYNC || x != in[TELEM_WIRE_BYTES - 1]) {
+        return 0;
+    }
+
+    rec->type = in[1];
+    rec->arg  = in[2];
+    rec->seq  = (uint16_t)get_le(in + 3, 2);
+    rec->time = get_le(in + 5, 4);
+    for (int i = 0; i < TELEM_DATA_WORDS; i++) {
+        rec->data[i] = (int16_t)get_le(in + 9 + 2 * i, 2);
+    }
+    return 1;
+}
+
+// -----------------------------
+// Producer
+// -----------------------------
+
+void telemInit(TelemClockFn now)
+{
+    head = 0;
+    tail = 0;
+    seq = 0;
+    dropped = 0;
+    tx_pos = TELEM_WIRE_BYTES;
+    clock_fn = now;
+}
+
+int telemLog(TelemType type, uint8_t arg, const int16_t *data, int n)
+{
+    uint16_t s = seq++;
+
+    if (head - tail >= TELEM_RING_SIZE) {
+        dropped++;
+        return 0;
+    }
+
+    TelemRecord *r = &ring[head & (TELEM_RING_SIZE - 1)];
+    r->type = (uint8_t)type;
+    r->arg  = arg;
+    r->seq  = s;
+    r->time = clock_fn != NULL ? clock_fn() : 0;
+    for (int i = 0; i < TELEM_DATA_WORDS; i++) {
+        r->data[i] = i < n ? data[i] : 0;
+    }
+
+    TELEM_BARRIER();
+    head++;
+    return 1;
+}
+
+int telemLogCoeffs(CoeffBand band, const BiquadQ14 *q)
+{
+    int16_t w[5] = { q->b0, q->b1, q->b2, q->a1, q->a2 };
+    return telemLog(TELEM_COEFFS, (uint8_t)band, w, 5);
+}
+
+int telemLogPots(const uint16_t adc[3], const float pots[3])
+{
+    int16_t w[6];
+    for (int i = 0; i < 3; i++) {
+        w[i]     = (int16_t)adc[i];
+        w[3 + i] = (int16_t)(pots[i] * 10000.0f + 0.5f);
+    }
+    return telemLog(TELEM_POTS, 0, w, 6);
+}
+
+int telemLogFpga(const FpgaPerf *p)
+{
+    int16_t w[6] = {
+        (int16_t)p->clips, (int16_t)p->mac_busy_max, (int16_t)p->frame_clks,
+        (int16_t)p->frames_rejected, (int16_t)p->commits, (int16_t)p->samples,
+    };
+    return telemLog(TELEM_FPGA, p->n_bands, w, 6);
+}
+
+// -----------------------------
+// Drain
+// -----------------------------
+
+uint32_t telemDrain(uint32_t max_bytes)
+{
+    uint32_t sent = 0;
+
+    while (sent < max_bytes) {
+        if (tx_pos == TELEM_WIRE_BYTES) {
+            if (tail == head) {
+                break;
+            }
+            TELEM_BARRIER();
+            telemEncode(&ring[tail & (TELEM_RING_SIZE - 1)], tx);
+            TELEM_BARRIER();
+            tail++;          // Slot is free as soon as it is encoded
+            tx_pos = 0;
+        }
+        if (!telemHwTryPut(tx[tx_pos])) {
+            break;
+        }
+        tx_pos++;
+        sent++;
+    }
+    return sent;
+}
+
+uint32_t telemDropped(void)
+{
+    return dropped;
+}
+
+uint32_t telemPending(void)
+{
+    return head - tail;
+}
@@ -0,0 +1,113 @@
+// telemetry.h
+// Lock-free single-producer ring of fixed-size binary telemetry records, drained byte-wise
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "calc_coefficient.h"
+#include "fpga_perf.h"
+
+// -----------------------------
+// Records
+// -----------------------------
+
+#define TELEM_RING_SIZE   64      // Records, power of two
+#define TELEM_DATA_WORDS  6
+
+typedef enum {
+    TELEM_COEFFS = 1,             // arg = band, data = b0 b1 b2 a1 a2 (Q2.14)
+    TELEM_POTS   = 2,             // data = raw ADC low/mid/high, smoothed pot low/mid/high x10000
+    TELEM_FPGA   = 3,             // arg = bands, data = clips, MAC busy max, frame clks, frames
+                                  // rejected, commits, samples (FPGA counters, low 16 bits)
+} TelemType;
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  arg;
+    uint16_t seq;                 // Counts every record offered; a gap means drops
+    uint32_t time;                // Ticks of the clock passed to telemInit
+    int16_t  data[TELEM_DATA_WORDS];
+} TelemRecord;
+
+// Wire format: sync, type, arg, seq(le16), time(le32), data(6 x le16), XOR of the 20 bytes
+#define TELEM_SYNC        0x7E
+#define TELEM_WIRE_BYTES  22
+
+typedef uint32_t (*TelemClockFn)(void);
+
+// -----------------------------
+// Register Layer (telemetry_stm32.c on target, mocked in test/test_telemetry.c)
+// -----------------------------
+
+/**
+ * @brief Offer one byte to the output channel without waiting
+ * @return 1 if the byte was taken, 0 if the channel is busy (try again later)
+ */
+int telemHwTryPut(uint8_t byte);
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Empty the ring and reset the counters
+ * @param now Timestamp source for records (NULL stamps 0)
+ */
+void telemInit(TelemClockFn now);
+
+/**
+ * @brief Copy one record into the ring; never waits
+ * @param type Record type
+ * @param arg  Type-specific argument
+ * @param data TELEM_DATA_WORDS words (missing words are zero when n is smaller)
+ * @param n    Number of words in data
+ * @return 1 if queued, 0 if the ring was full and the record was dropped
+ */
+int telemLog(TelemType type, uint8_t arg, const int16_t *data, int n);
+
+/**
+ * @brief Log one band's coefficients
+ */
+int telemLogCoeffs(CoeffBand band, const BiquadQ14 *q);
+
+/**
+ * @brief Log the raw knob codes and the smoothed pot positions (0.0 to 1.0)
+ */
+int telemLogPots(const uint16_t adc[3], const float pots[3]);
+
+/**
+ * @brief Log a snapshot of the FPGA's performance counters
+ */
+int telemLogFpga(const FpgaPerf *p);
+
+/**
+ * @brief Push queued bytes to the channel until it is busy or max_bytes have gone out
+ * @return Bytes written
+ */
+uint32_t telemDrain(uint32_t max_bytes);
+
+/**
+ * @brief Records dropped because the ring was full
+ */
+uint32_t telemDropped(void);
+
+/**
+ * @brief Records waiting in the ring (excluding one partly sent)
+ */
+uint32_t telemPending(void);
+
+/**
+ * @brief Encode one record in the wire format
+ * @param rec Record
+ * @param out Destination of TELEM_WIRE_BYTES bytes
+ */
+void telemEncode(const TelemRecord *rec, uint8_t out[TELEM_WIRE_BYTES]);
+
+/**
+ * @brief Decode one wire-format record
+ * @return 1 if sync and XOR check out, 0 otherwise
+ */
+int telemDecode(const uint8_t in[TELEM_WIRE_BYTES], TelemRecord *rec);
+
+#endif // TELEMETRY_H
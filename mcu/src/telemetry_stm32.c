@@ -0,0 +1,21 @@
+// telemetry_stm32.c
+// Register layer for telemetry.c: ITM stimulus port 1, so records never interleave with printf on port 0
+
+#include "STM32L432KC.h"
+#include "telemetry.h"
+
+#define TELEM_ITM_PORT 1
+
+int telemHwTryPut(uint8_t byte)
+{
+    // No debugger/SWO listener: discard so the ring keeps moving instead of filling up
+    if (!(ITM->TCR & ITM_TCR_ITMENA_Msk) || !(ITM->TER & (1u << TELEM_ITM_PORT))) {
+        return 1;
+    }
+    // Port FIFO full: report busy rather than spinning like ITM_SendChar
+    if (ITM->PORT[TELEM_ITM_PORT].u32 == 0) {
+        return 0;
+    }
+    ITM->PORT[TELEM_ITM_PORT].u8 = byte;
+    return 1;
+}
@@ -0,0 +1,98 @@
+// uart.c
+// RX and TX rings between main and the UART interrupt
+
+#include "uart.h"
+
+// Each index has a single writer (main or the interrupt), so no locking is needed
+#define UART_BARRIER() __asm volatile("" ::: "memory")
+
+// -----------------------------
+// State
+// -----------------------------
+
+static uint8_t           rx_ring[UART_RX_RING];
+static volatile uint32_t rx_head;      // Interrupt
+static volatile uint32_t rx_tail;      // Main
+static volatile uint32_t rx_overruns;
+
+static uint8_t           tx_ring[UART_TX_RING];
+static volatile uint32_t tx_head;      // Main
+static volatile uint32_t tx_tail;      // Interrupt
+
+// -----------------------------
+// Interrupt Side
+// -----------------------------
+
+void uartOnRxByte(uint8_t byte)
+{
+    if (rx_head - rx_tail >= UART_RX_RING) {
+        rx_overruns++;
+        return;
+    }
+    rx_ring[rx_head & (UART_RX_RING - 1)] = byte;
+    UART_BARRIER();
+    rx_head++;
+}
+
+int uartOnTxEmpty(uint8_t *byte)
+{
+    if (tx_tail == tx_head) {
+        return 0;
+    }
+    UART_BARRIER();
+    *byte = tx_ring[tx_tail & (UART_TX_RING - 1)];
+    UART_BARRIER();
+    tx_tail++;
+    return 1;
+}
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+void uartInit(uint32_t baud)
+{
+    rx_head = rx_tail = 0;
+    tx_head = tx_tail = 0;
+    rx_overruns = 0;
+    uartHwStart(baud);
+}
+
+uint32_t uartRead(uint8_t *buf, uint32_t max)
+{
+    uint32_t n = 0;
+    uint32_t head = rx_head;
+    UART_BARRIER();
+
+    while (n < max && rx_tail + n != head) {
+        buf[n] = rx_ring[(rx_tail + n) & (UART_RX_RING - 1)];
+        n++;
+    }
+    UART_BARRIER();
+    rx_tail += n;
+    return n;
+}
+
+uint32_t uartWrite(const uint8_t *buf, uint32_t len)
+{
+    if (len > uartTxFree()) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        tx_ring[(tx_head + i) & (UART_TX_RING - 1)] = buf[i];
+    }
+    UART_BARRIER();
+    tx_head += len;
+    uartHwTxKick();
+    return len;
+}
+
+uint32_t uartTxFree(void)
+{
+    return UART_TX_RING - (tx_head - tx_tail);
+}
+
+uint32_t uartRxOverruns(void)
+{
+    return rx_overruns;
+}
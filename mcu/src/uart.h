@@ -0,0 +1,85 @@
+// uart.h
+// Interrupt-driven, ring-buffered UART (USART2 / ST-LINK virtual COM port on target)
+
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+
+// -----------------------------
+// Configuration
+// -----------------------------
+
+#define UART_RX_RING  512     // Bytes, power of two
+#define UART_TX_RING  2048    // Bytes, power of two; a full profile dump reply fits
+
+// -----------------------------
+// Register Layer (uart_stm32.c on target, uart_host.c for the pty fake device, or a test mock)
+// -----------------------------
+
+/**
+ * @brief Configure the port and enable the RX interrupt
+ */
+void uartHwStart(uint32_t baud);
+
+/**
+ * @brief Make sure the TX-empty interrupt is enabled; it pulls bytes with uartOnTxEmpty
+ */
+void uartHwTxKick(void);
+
+// Host builds only (uart_host.c): a pty master or tty file descriptor plays USART2
+
+/**
+ * @brief Use fd as the port
+ */
+void uartHostAttach(int fd);
+
+/**
+ * @brief Stand-in for the interrupt: move readable bytes into RX, write out queued TX
+ * @return 0, or -1 once the descriptor reports an error
+ */
+int uartHostService(void);
+
+// -----------------------------
+// Public Functions
+// -----------------------------
+
+/**
+ * @brief Empty both rings, reset the counters and start the port
+ */
+void uartInit(uint32_t baud);
+
+/**
+ * @brief Copy out received bytes without waiting
+ * @return Bytes copied (0 if nothing arrived)
+ */
+uint32_t uartRead(uint8_t *buf, uint32_t max);
+
+/**
+ * @brief Queue bytes for transmission without waiting
+ * @return len if everything was queued, 0 if the TX ring lacks room (nothing is queued)
+ */
+uint32_t uartWrite(const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief Free space in the TX ring
+ */
+uint32_t uartTxFree(void);
+
+/**
+ * @brief Received bytes lost because the RX ring was full
+ */
+uint32_t uartRxOverruns(void);
+
+/**
+ * @brief RX interrupt: store one received byte
+ */
+void uartOnRxByte(uint8_t byte);
+
+/**
+ * @brief TX-empty interrupt: fetch the next byte to send
+ * @return 1 with *byte set, or 0 when the ring is empty (disable the TX-empty interrupt)
+ */
+int uartOnTxEmpty(uint8_t *byte);
+
+#endif // UART_H
@@ -0,0 +1,63 @@
+// uart_host.c
+// Register layer for uart.c in Linux builds: a pty master or tty file descriptor plays USART2
+
+#define _DEFAULT_SOURCE
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include "uart.h"
+
+static int port_fd = -1;
+
+void uartHostAttach(int fd)
+{
+    port_fd = fd;
+}
+
+void uartHwStart(uint32_t baud)
+{
+    (void)baud;  // The pty moves bytes as fast as both ends read them
+}
+
+void uartHwTxKick(void)
+{
+    // Nothing to arm: uartHostService flushes the TX ring
+}
+
+int uartHostService(void)
+{
+    if (port_fd < 0) {
+        return -1;
+    }
+
+    // RX: whatever is readable right now
+    struct pollfd pfd = { port_fd, POLLIN, 0 };
+    while (poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+        uint8_t buf[256];
+        ssize_t n = read(port_fd, buf, sizeof buf);
+        if (n <= 0) {
+            if (n < 0 && errno == EIO) break;  // pty slave closed: wait for the next client
+            if (n < 0 && errno != EAGAIN && errno != EINTR) return -1;
+            break;
+        }
+        for (ssize_t i = 0; i < n; i++) {
+            uartOnRxByte(buf[i]);
+        }
+    }
+
+    // TX: everything queued
+    uint8_t out[256];
+    size_t len = 0;
+    uint8_t b;
+    while (uartOnTxEmpty(&b)) {
+        out[len++] = b;
+        if (len == sizeof out) {
+            if (write(port_fd, out, len) < 0) return -1;
+            len = 0;
+        }
+    }
+    if (len && write(port_fd, out, len) < 0) {
+        return -1;
+    }
+    return 0;
+}
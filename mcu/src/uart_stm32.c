@@ -0,0 +1,39 @@
+// uart_stm32.c
+// Register layer for uart.c: USART2 (PA2 TX, PA15 RX, ST-LINK VCP) with RXNE/TXE interrupts
+
+#include "STM32L432KC.h"
+#include "uart.h"
+
+void uartHwStart(uint32_t baud)
+{
+    USART_TypeDef *u = initUSART(USART2_ID, (int)baud);
+
+    u->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NCF;
+    u->CR1 |= USART_CR1_RXNEIE;
+    NVIC_EnableIRQ(USART2_IRQn);
+}
+
+void uartHwTxKick(void)
+{
+    USART2->CR1 |= USART_CR1_TXEIE;  // Single RMW; the interrupt only ever clears this bit when idle
+}
+
+void USART2_IRQHandler(void)
+{
+    uint32_t isr = USART2->ISR;
+
+    if (isr & USART_ISR_RXNE) {
+        uartOnRxByte((uint8_t)USART2->RDR);  // Reading RDR clears RXNE
+    }
+    if (isr & (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE)) {
+        USART2->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NCF;
+    }
+    if ((USART2->CR1 & USART_CR1_TXEIE) && (isr & USART_ISR_TXE)) {
+        uint8_t b;
+        if (uartOnTxEmpty(&b)) {
+            USART2->TDR = b;
+        } else {
+            USART2->CR1 &= ~USART_CR1_TXEIE;
+        }
+    }
+}
@@ -0,0 +1,112 @@
+// test_calc_coefficient.c
+// Host test: per-band change tracking of calcCoeffDesignChanged (hysteresis window,
+// returned band masks, cached coefficients and the CoeffStats counters)
+//
+// Build and run from mcu/:
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc test/test_calc_coefficient.c src/calc_coefficient.c -lm -o test_calc_coefficient
+//   ./test_calc_coefficient
+
+#include <stdio.h>
+#include <string.h>
+#include "calc_coefficient.h"
+
+// calcCoeffSmooth calls that fill the moving average with one value
+#define SETTLE_CALLS 16
+
+#define LOW_ADC  1000
+#define MID_ADC  2000
+#define HIGH_ADC 3000
+
+static int failures;
+
+static void expect(int cond, const char *what)
+{
+    if (!cond) {
+        if (failures < 10) printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void settle(uint16_t adc_low, uint16_t adc_mid, uint16_t adc_high)
+{
+    for (int i = 0; i < SETTLE_CALLS; i++) {
+        calcCoeffSmooth(adc_low, adc_mid, adc_high);
+    }
+}
+
+static int same_biquad(BiquadQ14 a, BiquadQ14 b)
+{
+    return memcmp(&a, &b, sizeof a) == 0;
+}
+
+// Every band designed for the given smoothed codes, as the float engine designs them
+static int coeffs_match(const ThreeBandCoeffs *c, uint16_t adc_low, uint16_t adc_mid,
+                        uint16_t adc_high)
+{
+    return same_biquad(c->low,  calcCoeffBandFloat(COEFF_BAND_LOW,  adc_low)) &&
+           same_biquad(c->mid,  calcCoeffBandFloat(COEFF_BAND_MID,  adc_mid)) &&
+           same_biquad(c->high, calcCoeffBandFloat(COEFF_BAND_HIGH, adc_high));
+}
+
+static void check_change_tracking(void)
+{
+    ThreeBandCoeffs coeffs;
+    CoeffStats st;
+
+    calcCoeffInit();
+    expect(calcCoeffDesignChanged(&coeffs) == 0, "nothing designed before the first smooth");
+
+    // First design after init: every band
+    settle(LOW_ADC, MID_ADC, HIGH_ADC);
+    expect(calcCoeffDesignChanged(&coeffs) == COEFF_BANDS_ALL, "first design returns all bands");
+    expect(coeffs_match(&coeffs, LOW_ADC, MID_ADC, HIGH_ADC), "first design coefficients");
+    calcCoeffGetStats(&st);
+    expect(st.updates == 2 && st.unchanged == 1, "first design counted as changed");
+    expect(st.band_recomputes == COEFF_NUM_BANDS && st.band_skips == 0,
+           "first design runs every band");
+
+    // Settled moves of up to COEFF_HYSTERESIS codes either way: nothing redesigned
+    settle(LOW_ADC + COEFF_HYSTERESIS, MID_ADC - COEFF_HYSTERESIS, HIGH_ADC);
+    expect(calcCoeffDesignChanged(&coeffs) == 0, "moves inside the window return 0");
+    expect(coeffs_match(&coeffs, LOW_ADC, MID_ADC, HIGH_ADC), "skipped bands keep their design");
+    calcCoeffGetStats(&st);
+    expect(st.updates == 3 && st.unchanged == 2, "skip counted as unchanged");
+    expect(st.band_recomputes == COEFF_NUM_BANDS && st.band_skips == COEFF_NUM_BANDS,
+           "skip counts every band as skipped");
+
+    // One knob past the window (from the code it was designed for): only its band
+    uint16_t mid_moved = MID_ADC + COEFF_HYSTERESIS + 1;
+    settle(LOW_ADC + COEFF_HYSTERESIS, mid_moved, HIGH_ADC);
+    expect(calcCoeffDesignChanged(&coeffs) == COEFF_BAND_MASK(COEFF_BAND_MID),
+           "one moved knob returns only its band");
+    expect(coeffs_match(&coeffs, LOW_ADC, mid_moved, HIGH_ADC),
+           "moved band redesigned for the new code, others kept");
+    calcCoeffGetStats(&st);
+    expect(st.updates == 4 && st.unchanged == 2, "redesign counted as changed");
+    expect(st.band_recomputes == COEFF_NUM_BANDS + 1, "moved band recomputed once");
+    expect(st.band_skips == COEFF_NUM_BANDS + 2, "other bands skipped");
+
+    // The window follows the last design, not the first
+    settle(LOW_ADC + COEFF_HYSTERESIS, mid_moved - COEFF_HYSTERESIS, HIGH_ADC);
+    expect(calcCoeffDesignChanged(&coeffs) == 0, "window recentred on the redesign");
+
+    // Init starts over with every band
+    calcCoeffInit();
+    settle(LOW_ADC, MID_ADC, HIGH_ADC);
+    expect(calcCoeffDesignChanged(&coeffs) == COEFF_BANDS_ALL, "init forces a full design");
+    calcCoeffGetStats(&st);
+    expect(st.updates == 1 && st.band_recomputes == COEFF_NUM_BANDS && st.band_skips == 0,
+           "init clears the counters");
+}
+
+int main(void)
+{
+    check_change_tracking();
+
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
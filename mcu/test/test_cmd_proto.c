@@ -0,0 +1,316 @@
+// test_cmd_proto.c
+// Host test: command framing and resync, every command through the UART rings, staged control and modes
+//
+// Build and run from mcu/:
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc test/test_cmd_proto.c src/cmd_proto.c src/cmd_server.c src/crc16.c src/uart.c src/eq_control.c src/prof.c src/prof_host.c src/calc_coefficient.c -lm -o test_cmd_proto
+//   ./test_cmd_proto
+
+#include <stdio.h>
+#include <string.h>
+#include "cmd_proto.h"
+#include "cmd_server.h"
+#include "crc16.h"
+#include "eq_control.h"
+#include "uart.h"
+
+// -----------------------------
+// Mock Register Layer
+// -----------------------------
+
+static int tx_kicks;
+
+void uartHwStart(uint32_t baud) { (void)baud; }
+void uartHwTxKick(void) { tx_kicks++; }
+
+// -----------------------------
+// Checks
+// -----------------------------
+
+static int failures;
+
+static void expect(int cond, const char *what)
+{
+    if (!cond) {
+        if (failures < 10) printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+// -----------------------------
+// Helper Functions
+// -----------------------------
+
+static uint8_t  wire[CMD_MAX_FRAME];
+static CmdParser host;      // Host side parser for replies
+
+// Host -> board: encode and push through the RX interrupt path
+static void send_frame(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    size_t n = cmdFrameEncode(type, payload, len, wire);
+    for (size_t i = 0; i < n; i++) uartOnRxByte(wire[i]);
+}
+
+// Board -> host: drain the TX ring like the TXE interrupt; returns replies parsed
+static int drain_replies(void)
+{
+    int frames = 0;
+    uint8_t b;
+    while (uartOnTxEmpty(&b)) {
+        frames += cmdParserFeed(&host, b);
+    }
+    return frames;
+}
+
+// One request, one reply; returns the reply status code or -1
+static int transact(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    send_frame(type, payload, len);
+    cmdServerPoll();
+    if (drain_replies() != 1 || host.type != (type | CMD_REPLY) || host.len < 1) return -1;
+    return host.payload[0];
+}
+
+static uint32_t status_calls;
+
+static void fake_status(CmdStatus *s)
+{
+    status_calls++;
+    s->mode = EQ_MODE_TEST;
+    s->tick = 1234;
+    s->frames_sent = 77;
+    s->pots[0] = 1; s->pots[1] = 2; s->pots[2] = 3;
+    s->coeffs = simpleTestFilters(3);
+}
+
+static void reset(void)
+{
+    uartInit(230400);
+    cmdServerInit(fake_status);
+    cmdParserInit(&host);
+    eqControlInit();
+    calcCoeffInit();
+}
+
+// -----------------------------
+// Framing
+// -----------------------------
+
+static void check_crc(void)
+{
+    expect(crc16Update(CRC16_INIT, (const uint8_t *)"123456789", 9) == 0x29B1, "CRC-16/CCITT-FALSE check value");
+    uint16_t split = crc16Update(crc16Update(CRC16_INIT, (const uint8_t *)"1234", 4), (const uint8_t *)"56789", 5);
+    expect(split == 0x29B1, "CRC continues across calls");
+}
+
+static void check_parser(void)
+{
+    static CmdParser p;
+    uint8_t payload[300];
+    for (int i = 0; i < 300; i++) payload[i] = (uint8_t)(i * 7);
+
+    // Garbage (including stray SOF bytes), then a frame fed one byte at a time
+    cmdParserInit(&p);
+    const uint8_t junk[] = { 0x00, 0xA5, 0x13, 0xFF, 0xA5 };
+    int got = 0;
+    for (size_t i = 0; i < sizeof junk; i++) got += cmdParserFeed(&p, junk[i]);
+    size_t n = cmdFrameEncode(0x42, payload, 300, wire);
+    expect(n == CMD_HEADER_BYTES + 300 + CMD_CRC_BYTES, "frame length");
+    for (size_t i = 0; i < n; i++) got += cmdParserFeed(&p, wire[i]);
+    expect(got == 1, "frame found after garbage");
+    expect(p.type == 0x42 && p.len == 300 && !memcmp(p.payload, payload, 300), "payload intact");
+
+    // Every single-bit error is rejected. With the length intact the very next frame parses;
+    // a corrupted length can swallow it, so the parser is reset after those.
+    n = cmdFrameEncode(CMD_PING, payload, 8, wire);
+    int bad_accepted = 0, good_accepted = 0, good_expected = 0;
+    for (size_t bit = 8; bit < n * 8; bit++) {    // Skip the SOF byte: that only delays the frame
+        uint8_t bad[64];
+        memcpy(bad, wire, n);
+        bad[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+        for (size_t i = 0; i < n; i++) bad_accepted += cmdParserFeed(&p, bad[i]);
+        if (bit / 8 == 2 || bit / 8 == 3) {
+            cmdParserInit(&p);
+            continue;
+        }
+        good_expected++;
+        for (size_t i = 0; i < n; i++) good_accepted += cmdParserFeed(&p, wire[i]);
+    }
+    expect(bad_accepted == 0, "corrupt frames rejected");
+    expect(good_accepted == good_expected, "good frame right after a corrupt one");
+    expect(p.crc_errors > 0, "CRC errors counted");
+
+    // Oversize length: header dropped, resync on the next SOF
+    cmdParserInit(&p);
+    const uint8_t oversize[] = { CMD_SOF, 0x01, 0xFF, 0xFF };
+    for (size_t i = 0; i < sizeof oversize; i++) cmdParserFeed(&p, oversize[i]);
+    expect(p.length_errors == 1, "oversize length counted");
+    n = cmdFrameEncode(CMD_PING, NULL, 0, wire);
+    got = 0;
+    for (size_t i = 0; i < n; i++) got += cmdParserFeed(&p, wire[i]);
+    expect(got == 1 && p.len == 0, "empty frame after oversize header");
+}
+
+static void check_payloads(void)
+{
+    ThreeBandCoeffs c = simpleTestFilters(4), back;
+    uint8_t buf[CMD_COEFF_BYTES];
+    cmdPackCoeffs(&c, buf);
+    cmdUnpackCoeffs(buf, &back);
+    expect(!memcmp(&c, &back, sizeof c), "coefficient round trip");
+    expect(buf[0] == (uint8_t)c.low.b0 && buf[1] == (uint8_t)((uint16_t)c.low.b0 >> 8), "coefficients little endian");
+
+    CmdStatus s = { .mode = 2, .test_number = 5, .tick = 0x01020304, .commands = 9, .crc_errors = 8,
+                    .rx_overruns = 7, .frames_sent = 6, .knob_latency_max = 5, .telem_dropped = 4,
+                    .pots = { 4095, 0, 17 }, .coeffs = c }, t;
+    uint8_t sb[CMD_STATUS_BYTES];
+    cmdPackStatus(&s, sb);
+    cmdUnpackStatus(sb, &t);
+    expect(t.mode == 2 && t.test_number == 5 && t.tick == 0x01020304 && t.commands == 9 &&
+           t.crc_errors == 8 && t.rx_overruns == 7 && t.frames_sent == 6 && t.knob_latency_max == 5 &&
+           t.telem_dropped == 4 && t.pots[0] == 4095 && t.pots[2] == 17 &&
+           !memcmp(&t.coeffs, &c, sizeof c), "status round trip");
+}
+
+// -----------------------------
+// Server
+// -----------------------------
+
+static void check_commands(void)
+{
+    CmdControl ctl;
+    reset();
+
+    expect(transact(CMD_PING, NULL, 0) == CMD_OK && host.len == 2 && host.payload[1] == CMD_PROTO_VERSION, "ping");
+    expect(tx_kicks > 0, "reply kicks the TX interrupt");
+    expect(!cmdServerTakeControl(&ctl), "ping stages nothing");
+
+    // Coefficients: staged until taken, taken once
+    ThreeBandCoeffs c = simpleTestFilters(2);
+    uint8_t cb[CMD_COEFF_BYTES];
+    cmdPackCoeffs(&c, cb);
+    expect(transact(CMD_SET_COEFFS, cb, sizeof cb) == CMD_OK, "set coeffs");
+    expect(cmdServerTakeControl(&ctl) && ctl.mode == EQ_MODE_COEFFS && !memcmp(&ctl.coeffs, &c, sizeof c),
+           "coeffs staged");
+    expect(!cmdServerTakeControl(&ctl), "control taken once");
+
+    // Latest request wins when several arrive between design ticks
+    uint8_t pots[CMD_POTS_BYTES] = { 0x00, 0x01, 0x00, 0x08, 0xFF, 0x0F };
+    expect(transact(CMD_SET_POTS, pots, sizeof pots) == CMD_OK, "set pots");
+    uint8_t mode[2] = { EQ_MODE_TEST, 3 };
+    expect(transact(CMD_SET_MODE, mode, sizeof mode) == CMD_OK, "set mode");
+    expect(cmdServerTakeControl(&ctl) && ctl.mode == EQ_MODE_TEST && ctl.test_number == 3, "latest wins");
+    expect(ctl.pots[0] == 256 && ctl.pots[1] == 2048 && ctl.pots[2] == 4095, "pots kept with the control");
+
+    // Argument and length errors stage nothing
+    uint8_t bad_pots[CMD_POTS_BYTES] = { 0, 0, 0, 0x10, 0, 0 };
+    expect(transact(CMD_SET_POTS, bad_pots, sizeof bad_pots) == CMD_ERR_ARG, "pot above 4095");
+    uint8_t bad_mode[2] = { EQ_NUM_MODES, 0 };
+    expect(transact(CMD_SET_MODE, bad_mode, 2) == CMD_ERR_ARG, "unknown mode");
+    uint8_t bad_test[2] = { EQ_MODE_TEST, CMD_TEST_FILTERS };
+    expect(transact(CMD_SET_MODE, bad_test, 2) == CMD_ERR_ARG, "unknown test filter");
+    expect(transact(CMD_SET_COEFFS, cb, sizeof cb - 1) == CMD_ERR_LENGTH, "short coeffs");
+    expect(transact(CMD_GET_STATUS, cb, 1) == CMD_ERR_LENGTH, "status with payload");
+    expect(transact(0x33, NULL, 0) == CMD_ERR_UNKNOWN, "unknown command");
+    expect(!cmdServerTakeControl(&ctl), "errors stage nothing");
+
+    // Status: provider fields plus the server's counters
+    expect(transact(CMD_GET_STATUS, NULL, 0) == CMD_OK && host.len == 1 + CMD_STATUS_BYTES, "status");
+    CmdStatus s;
+    cmdUnpackStatus(host.payload + 1, &s);
+    expect(status_calls == 1 && s.mode == EQ_MODE_TEST && s.tick == 1234 && s.frames_sent == 77, "status fields");
+    expect(s.commands == cmdServerCommands() && s.commands == 11, "status command count");
+    expect(s.pots[2] == 3 && s.coeffs.mid.b0 == simpleTestFilters(3).mid.b0, "status pots and coeffs");
+
+    // Profile reply carries a profDump record
+    expect(transact(CMD_GET_PROFILE, NULL, 0) == CMD_OK && host.len > 3 &&
+           host.payload[1] == 'P' && host.payload[2] == 'F', "profile");
+
+    // A corrupted request gets no reply and is counted
+    size_t n = cmdFrameEncode(CMD_PING, NULL, 0, wire);
+    wire[n - 1] ^= 1;
+    for (size_t i = 0; i < n; i++) uartOnRxByte(wire[i]);
+    cmdServerPoll();
+    expect(drain_replies() == 0 && cmdServerCrcErrors() == 1, "bad CRC ignored");
+}
+
+static void check_back_pressure(void)
+{
+    reset();
+
+    // The host never reads: replies fill the TX ring, then get dropped instead of blocking
+    int sent = 0;
+    for (int i = 0; i < 200; i++) {
+        send_frame(CMD_GET_STATUS, NULL, 0);
+        cmdServerPoll();
+        sent++;
+    }
+    uint32_t frame_bytes = CMD_HEADER_BYTES + 1 + CMD_STATUS_BYTES + CMD_CRC_BYTES;
+    uint32_t fit = UART_TX_RING / frame_bytes;
+    expect(cmdServerCommands() == (uint32_t)sent, "every request handled");
+    expect(cmdServerReplyDrops() == (uint32_t)sent - fit, "overflowing replies dropped");
+    expect(drain_replies() == (int)fit, "queued replies intact");
+
+    // RX overrun: more bytes than the ring holds between polls
+    for (int i = 0; i < UART_RX_RING + 10; i++) uartOnRxByte(0);
+    expect(uartRxOverruns() == 10, "RX overruns counted");
+    cmdServerPoll();
+    expect(transact(CMD_PING, NULL, 0) == CMD_OK, "ping after overrun");
+}
+
+// -----------------------------
+// Coefficient Source
+// -----------------------------
+
+static void check_modes(void)
+{
+    CmdControl ctl = { 0 };
+    ThreeBandCoeffs c;
+    const uint16_t knobs[3] = { 2048, 2048, 2048 };
+    reset();
+
+    expect(eqControlMode() == EQ_MODE_KNOBS && eqControlSmoothInput(knobs) == knobs, "knobs by default");
+
+    ctl.mode = EQ_MODE_TEST;
+    ctl.test_number = 1;
+    eqControlSet(&ctl);
+    expect(eqControlDesign(&c) == COEFF_BANDS_ALL, "mode change resends every band");
+    expect(!memcmp(&c, &(ThreeBandCoeffs){ simpleTestFilters(1).low, simpleTestFilters(1).mid,
+                                           simpleTestFilters(1).high }, sizeof c), "test filters");
+    expect(eqControlDesign(&c) == 0, "test filters sent once");
+
+    ctl.mode = EQ_MODE_COEFFS;
+    ctl.coeffs = simpleTestFilters(5);
+    eqControlSet(&ctl);
+    expect(eqControlDesign(&c) == COEFF_BANDS_ALL && c.high.b0 == simpleTestFilters(5).high.b0, "host coeffs");
+
+    ctl.mode = EQ_MODE_POTS;
+    ctl.pots[0] = 0; ctl.pots[1] = 4095; ctl.pots[2] = 1000;
+    eqControlSet(&ctl);
+    const uint16_t *in = eqControlSmoothInput(knobs);
+    expect(in[0] == 0 && in[1] == 4095 && in[2] == 1000, "pots override the knobs");
+
+    // Host pots go through the same smoothing path as the knobs: settle, then compare
+    for (int i = 0; i < 200; i++) {
+        calcCoeffSmooth(in[0], in[1], in[2]);
+        eqControlDesign(&c);
+    }
+    ThreeBandCoeffs direct = calcCoeffUpdate(0, 4095, 1000);
+    expect(!memcmp(&c, &direct, sizeof c), "host pots design like knobs");
+}
+
+int main(void)
+{
+    check_crc();
+    check_parser();
+    check_payloads();
+    check_commands();
+    check_back_pressure();
+    check_modes();
+
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,155 @@
+// test_coeff_fixed.c
+// Host test: integer-only designer vs. float design path, plus ns-per-update and per-call benchmarks
+//
+// Build and run from mcu/:
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc test/test_coeff_fixed.c src/calc_coefficient.c src/coeff_fixed.c -lm -o test_coeff_fixed
+//   ./test_coeff_fixed
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "calc_coefficient.h"
+#include "coeff_fixed.h"
+
+#define BENCH_PASSES 200
+
+static const char *band_names[COEFF_NUM_BANDS] = { "low", "mid", "high" };
+
+static const int16_t *coeff_array(const BiquadQ14 *q)
+{
+    return &q->b0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Building blocks against double precision
+static int check_primitives(void)
+{
+    double max_exp = 0.0, max_trig = 0.0;
+
+    for (int i = -1000; i <= 1000; i++) {
+        double x = i / 1000.0;
+        double got = coeffFixedExpQ28((int32_t)lround(x * Q28_ONE)) / (double)Q28_ONE;
+        double err = fabs(got - exp(x));
+        if (err > max_exp) max_exp = err;
+    }
+    for (int i = 0; i <= 1000; i++) {
+        double a = 3.14159265358979 * i / 1000.0;
+        int32_t s, c;
+        coeffFixedSinCos((int32_t)lround(a * Q28_ONE), &s, &c);
+        double err_s = fabs(s / (double)Q28_ONE - sin(a));
+        double err_c = fabs(c / (double)Q28_ONE - cos(a));
+        if (err_s > max_trig) max_trig = err_s;
+        if (err_c > max_trig) max_trig = err_c;
+    }
+    printf("exp max error %.3g, sin/cos max error %.3g (Q14 LSB = %.3g)\n",
+           max_exp, max_trig, 1.0 / 16384.0);
+
+    return (max_exp > 1e-7 || max_trig > 1e-7) ? 1 : 0;
+}
+
+// Every ADC code and band must agree within COEFF_FIXED_MAX_LSB_ERR
+static int check_equivalence(void)
+{
+    int failures = 0;
+
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        int max_err = 0;
+        int exact = 0;
+
+        for (int adc = 0; adc < 4096; adc++) {
+            BiquadQ14 ref = calcCoeffBandFloat((CoeffBand)band, (uint16_t)adc);
+            BiquadQ14 fix = coeffFixedDesign((CoeffBand)band, (uint16_t)adc);
+            int worst = 0;
+
+            for (int k = 0; k < 5; k++) {
+                int err = abs(coeff_array(&ref)[k] - coeff_array(&fix)[k]);
+                if (err > worst) worst = err;
+            }
+            if (worst > max_err) max_err = worst;
+            if (worst == 0) exact++;
+
+            if (worst > COEFF_FIXED_MAX_LSB_ERR) {
+                if (failures < 10) {
+                    printf("FAIL %s adc=%d err=%d LSB\n", band_names[band], adc, worst);
+                }
+                failures++;
+            }
+        }
+        printf("%-4s band: max error %d LSB, %d/4096 codes bit-exact\n",
+               band_names[band], max_err, exact);
+    }
+    return failures;
+}
+
+static void benchmark(void)
+{
+    volatile int16_t sink = 0;
+    double t0, t1;
+    const double updates = (double)BENCH_PASSES * 4096.0;
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int adc = 0; adc < 4096; adc++) {
+            for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+                sink += calcCoeffBandFloat((CoeffBand)band, (uint16_t)adc).b1;
+            }
+        }
+    }
+    t1 = now_ns();
+    printf("float path: %8.1f ns per 3-band update\n", (t1 - t0) / updates);
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int adc = 0; adc < 4096; adc++) {
+            for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+                sink += coeffFixedDesign((CoeffBand)band, (uint16_t)adc).b1;
+            }
+        }
+    }
+    t1 = now_ns();
+    printf("fixed path: %8.1f ns per 3-band update\n", (t1 - t0) / updates);
+
+    // The unity shortcut returns early: best and worst call per band, each
+    // code timed as the fastest of a few trials so preemption drops out
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        double best = 1e30, worst = 0.0;
+        int best_adc = 0, worst_adc = 0;
+        for (int adc = 0; adc < 4096; adc++) {
+            double ns = 1e30;
+            for (int trial = 0; trial < 8; trial++) {
+                t0 = now_ns();
+                for (int pass = 0; pass < BENCH_PASSES / 8; pass++) {
+                    sink += coeffFixedDesign((CoeffBand)band, (uint16_t)adc).b1;
+                }
+                t1 = (now_ns() - t0) / (BENCH_PASSES / 8);
+                if (t1 < ns) ns = t1;
+            }
+            if (ns < best)  { best = ns;  best_adc = adc; }
+            if (ns > worst) { worst = ns; worst_adc = adc; }
+        }
+        printf("fixed %-4s: %6.1f ns best (adc %d), %6.1f ns worst (adc %d)\n",
+               band_names[band], best, best_adc, worst, worst_adc);
+    }
+    (void)sink;
+}
+
+int main(void)
+{
+    int failures = check_primitives();
+    failures += check_equivalence();
+    benchmark();
+
+    if (failures) {
+        printf("%d failures (limit %d LSB)\n", failures, COEFF_FIXED_MAX_LSB_ERR);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,727 @@
+// test_coeff_frame.c
+// Host test: v2/v3/v4/v5 frame packer/parser against a bit-serial aes_spi model, the DMA send queue
+// and frame confirmation from the status word
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc test/test_coeff_frame.c src/coeff_frame.c src/crc16.c -o test_coeff_frame
+//   ./test_coeff_frame
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "coeff_frame.h"
+#include "crc16.h"
+
+#define RANDOM_FRAMES 10000
+#define QUEUE_STEPS   100000
+#define WIDE_SECTIONS 10      // N_BANDS of the wide receiver model
+
+// -----------------------------
+// Mock Register Layer
+// -----------------------------
+
+static int hw_inits;
+static int hw_starts;
+static const uint8_t *hw_buf;                  // Buffer the DMA is reading
+static uint8_t  hw_copy[COEFF_FRAME_WIDE_MAX_BYTES]; // Its contents at start, to catch later writes
+static uint32_t hw_len;
+static uint8_t *hw_rx;
+
+void coeffFrameHwInit(void)
+{
+    hw_inits++;
+}
+
+void coeffFrameHwStart(const uint8_t *buf, uint8_t *rx, uint32_t len)
+{
+    hw_starts++;
+    hw_buf = buf;
+    hw_rx = rx;
+    hw_len = len;
+    memcpy(hw_copy, buf, len);
+}
+
+// -----------------------------
+// Checks
+// -----------------------------
+
+static int failures;
+
+static void expect(int cond, const char *what)
+{
+    if (!cond) {
+        if (failures < 10) printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static ThreeBandCoeffs random_coeffs(void)
+{
+    ThreeBandCoeffs c;
+    int16_t *w = &c.low.b0;
+    for (int k = 0; k < COEFF_FRAME_COEFF_WORDS; k++) {
+        w[k] = (int16_t)(rand() & 0xFFFF);
+    }
+    return c;
+}
+
+// Bit-serial model of aes_spi (spi.sv): shift MSB first, run the CRC per bit, decode
+// each byte as it completes and publish the staged bands only when the CRC leaves 0.
+// Returns the frame kind like coeffFrameParse, or -1 if nothing was published.
+static int fpga_receive(const uint8_t *frame, uint32_t len, int16_t slots[COEFF_FRAME_COEFF_WORDS],
+                        uint8_t index[COEFF_NUM_BANDS], uint8_t *mask, uint8_t *seq, uint8_t *channels)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t  shift = 0, hdr_mask = 0, hdr_ok = 0, hdr_kind = 0, hdr_v3 = 0, seq_stage = 0, chan_stage = 0;
+    uint32_t expected = 0, band_bytes = COEFF_FRAME_BAND_BYTES;
+    uint8_t  stage[COEFF_NUM_BANDS][COEFF_FRAME_BAND_BYTES] = { { 0 } };
+    int      slot = 0, off = 0;
+
+    for (uint32_t i = 0; i < 8 * len; i++) {
+        int sdi = (frame[i / 8] >> (7 - i % 8)) & 1;
+        crc = (uint16_t)((crc << 1) ^ ((((crc >> 15) ^ sdi) & 1) ? 0x1021 : 0));
+        shift = (uint8_t)((shift << 1) | sdi);
+        if (i % 8 != 7) continue;
+
+        uint32_t n = i / 8;
+        if (n == 0) {
+            hdr_mask = (shift >> 1) & 7;
+            hdr_ok = (shift >> 4) == 2 || (shift >> 4) == 3;
+            hdr_v3 = (shift >> 4) == 3;
+            chan_stage = 3;
+            hdr_kind = shift & 1;
+            band_bytes = hdr_kind ? 1 : COEFF_FRAME_BAND_BYTES;
+            expected = 4 + hdr_v3 + band_bytes * (uint32_t)(((hdr_mask >> 0) & 1) + ((hdr_mask >> 1) & 1) + ((hdr_mask >> 2) & 1));
+            slot = 0;
+            while (slot < 3 && !(hdr_mask & (1 << slot))) slot++;
+            off = 0;
+        } else if (n == 1) {
+            seq_stage = shift;
+        } else if (n == 2 && hdr_v3) {
+            chan_stage = shift & 3;
+            if ((shift >> 2) != 0 || chan_stage == 0) hdr_ok = 0;
+        } else if (n < expected - 2) {
+            stage[slot][off] = shift;
+            if (++off == (int)band_bytes) {
+                off = 0;
+                do slot++; while (slot < 3 && !(hdr_mask & (1 << slot)));
+            }
+        } else if (n == expected - 1) {
+            if (!hdr_ok || crc != 0) return -1;
+            for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+                if (!(hdr_mask & (1 << b))) continue;
+                if (hdr_kind) {
+                    index[b] = stage[b][0];     // control.sv looks the band up in gain_rom
+                    continue;
+                }
+                for (int k = 0; k < 5; k++) {
+                    slots[5 * b + k] = (int16_t)((stage[b][2 * k] << 8) | stage[b][2 * k + 1]);
+                }
+            }
+            *mask = hdr_mask;
+            *seq = seq_stage;
+            *channels = chan_stage;
+            return hdr_kind;
+        }
+    }
+    return -1;  // CS rose before the frame was complete
+}
+
+// Byte-level model of aes_spi with N_BANDS = n for v4 frames: the mask arrives in
+// bytes 3-4 and sets the length; a band past n or a bad header drops the frame
+static int fpga_receive_wide(const uint8_t *frame, uint32_t len, int n, BiquadQ14 *sections,
+                             uint16_t *mask, uint8_t *seq, uint8_t *channels)
+{
+    uint16_t crc = CRC16_INIT, m = 0;
+    uint32_t expected = 7;
+    int ok = 0;
+
+    for (uint32_t i = 0; i < len; i++) {
+        crc = crc16Update(crc, &frame[i], 1);
+        if (i == 0) {
+            ok = frame[0] == 0x40;
+        } else if (i == 2) {
+            if (frame[2] == 0 || (frame[2] >> 2) != 0) ok = 0;
+        } else if (i == 4) {
+            m = (uint16_t)((frame[3] << 8) | frame[4]);
+            if ((m >> n) != 0) ok = 0;
+            expected = 7;
+            for (int b = 0; b < n; b++) expected += (m >> b) & 1 ? COEFF_FRAME_BAND_BYTES : 0;
+        } else if (i > 4 && i == expected - 1) {
+            if (!ok || crc != 0) return -1;
+            const uint8_t *p = frame + 5;
+            for (int b = 0; b < n; b++) {
+                if (!((m >> b) & 1)) continue;
+                int16_t *w = &sections[b].b0;
+                for (int k = 0; k < 5; k++) w[k] = (int16_t)((p[2 * k] << 8) | p[2 * k + 1]);
+                p += COEFF_FRAME_BAND_BYTES;
+            }
+            *mask = m;
+            *seq = frame[1];
+            *channels = frame[2];
+            return COEFF_FRAME_COEFFS;
+        }
+    }
+    return -1;
+}
+
+static void random_sections(BiquadQ14 *s, int n)
+{
+    for (int i = 0; i < n; i++) {
+        int16_t *w = &s[i].b0;
+        for (int k = 0; k < 5; k++) w[k] = (int16_t)(rand() & 0xFFFF);
+    }
+}
+
+static void check_wide(void)
+{
+    uint8_t frame[COEFF_FRAME_WIDE_MAX_BYTES];
+    BiquadQ14 tx[COEFF_MAX_SECTIONS], rx[COEFF_MAX_SECTIONS], fpga[COEFF_MAX_SECTIONS];
+    uint16_t mask, fmask;
+    uint8_t seq, fseq, ch, fch;
+
+    expect(coeffFrameWideBytes(0x0002) == 17, "one wide section is 17 bytes");
+    expect(coeffFrameWideBytes(0x03FF) == 107, "ten wide sections are 107 bytes");
+    expect(COEFF_FRAME_WIDE_MAX_BYTES == 167, "sixteen wide sections are 167 bytes");
+
+    random_sections(tx, COEFF_MAX_SECTIONS);
+    uint32_t n = coeffFramePackSections(frame, COEFF_CHANNELS_BOTH, 0x0201, 9, tx);
+    expect(n == 27 && frame[0] == 0x40 && frame[1] == 9 && frame[2] == 3 && frame[3] == 0x02 &&
+           frame[4] == 0x01 && frame[5] == (uint8_t)((uint16_t)tx[0].b0 >> 8) &&
+           frame[15] == (uint8_t)((uint16_t)tx[9].b0 >> 8), "hand-checked wide frame");
+
+    // Random frames: the parser and the receiver model agree and reproduce the masked sections
+    for (int i = 0; i < RANDOM_FRAMES; i++) {
+        uint16_t m = (uint16_t)(rand() & ((1 << WIDE_SECTIONS) - 1));
+        uint8_t channels = (uint8_t)(1 + rand() % COEFF_CHANNELS_BOTH);
+        random_sections(tx, WIDE_SECTIONS);
+        memset(rx, 0, sizeof rx);
+        memset(fpga, 0, sizeof fpga);
+        n = coeffFramePackSections(frame, channels, m, (uint8_t)i, tx);
+        int kind = coeffFrameParseSections(frame, n, &mask, &seq, &ch, rx, WIDE_SECTIONS);
+        int fkind = fpga_receive_wide(frame, n, WIDE_SECTIONS, fpga, &fmask, &fseq, &fch);
+        int same = kind == COEFF_FRAME_COEFFS && fkind == kind && mask == m && fmask == m &&
+                   seq == (uint8_t)i && fseq == seq && ch == channels && fch == ch &&
+                   !memcmp(rx, fpga, sizeof rx);
+        for (int b = 0; b < WIDE_SECTIONS && same; b++) {
+            if ((m >> b) & 1) same = !memcmp(&rx[b], &tx[b], sizeof tx[b]);
+        }
+        if (!same) expect(0, "random wide frame round trip");
+
+        // Any flipped bit is caught by both
+        int bit = rand() % (int)(8 * n);
+        frame[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+        if (coeffFrameParseSections(frame, n, &mask, &seq, &ch, rx, WIDE_SECTIONS) >= 0 ||
+            fpga_receive_wide(frame, n, WIDE_SECTIONS, fpga, &fmask, &fseq, &fch) >= 0) {
+            expect(0, "corrupted wide frame rejected");
+        }
+    }
+
+    // A section the build does not have, no channel, or a v4 header with mask or kind bits
+    n = coeffFramePackSections(frame, COEFF_CHANNELS_BOTH, 1u << WIDE_SECTIONS, 0, tx);
+    expect(coeffFrameParseSections(frame, n, &mask, &seq, &ch, rx, WIDE_SECTIONS) < 0 &&
+           fpga_receive_wide(frame, n, WIDE_SECTIONS, fpga, &fmask, &fseq, &fch) < 0 &&
+           coeffFrameParseSections(frame, n, &mask, &seq, &ch, rx, WIDE_SECTIONS + 1) == COEFF_FRAME_COEFFS,
+           "section past N_BANDS rejected");
+    n = coeffFramePackSections(frame, 0, 0x0001, 0, tx);
+    expect(coeffFrameParseSections(frame, n, &mask, &seq, &ch, rx, WIDE_SECTIONS) < 0, "no channel rejected");
+    n = coeffFramePackSections(frame, COEFF_CHANNEL_LEFT, 0x0001, 0, tx);
+    frame[0] |= 1;
+    uint16_t crc = crc16Update(CRC16_INIT, frame, n - 2);
+    frame[n - 2] = (uint8_t)(crc >> 8);
+    frame[n - 1] = (uint8_t)crc;
+    expect(coeffFrameParseSections(frame, n, &mask, &seq, &ch, rx, WIDE_SECTIONS) < 0 &&
+           fpga_receive_wide(frame, n, WIDE_SECTIONS, fpga, &fmask, &fseq, &fch) < 0,
+           "wide gain-index frame rejected");
+
+    // A three-band build takes wide frames for its sections 0-2
+    ThreeBandCoeffs three = random_coeffs(), got = three;
+    BiquadQ14 s3[COEFF_NUM_BANDS] = { three.low, three.mid, three.high };
+    n = coeffFramePackSections(frame, COEFF_CHANNELS_BOTH, 0x0002, 0, s3);
+    BiquadQ14 r3[COEFF_NUM_BANDS] = { got.low, got.mid, got.high };
+    expect(coeffFrameParseSections(frame, n, &mask, &seq, NULL, r3, COEFF_NUM_BANDS) == COEFF_FRAME_COEFFS &&
+           !memcmp(&r3[1], &three.mid, sizeof three.mid), "wide frame to a three-band build");
+    uint8_t mask3;
+    expect(coeffFrameParse(frame, n, &mask3, &seq, NULL, &got, NULL) < 0,
+           "v2 parser leaves wide frames alone");
+
+    printf("wide frames: %d random frames checked\n", RANDOM_FRAMES);
+}
+
+static void check_layout(void)
+{
+    uint8_t frame[COEFF_FRAME_MAX_BYTES];
+
+    expect(coeffFrameBytes(COEFF_BAND_MASK(COEFF_BAND_MID), COEFF_FRAME_COEFFS) == 14, "one band is 14 bytes");
+    expect(coeffFrameBytes(COEFF_BANDS_ALL, COEFF_FRAME_COEFFS) == 34 &&
+           COEFF_FRAME_MAX_BYTES == 35, "full refresh is 34 bytes, 35 for one channel");
+    expect(coeffFrameBytes(COEFF_BAND_MASK(COEFF_BAND_MID), COEFF_FRAME_INDICES) == 5 &&
+           coeffFrameBytes(COEFF_BANDS_ALL, COEFF_FRAME_INDICES) == 7, "gain-index frames are 4 + 1 per band");
+
+    // Hand-checked frame: mid band only, seq 0x5A
+    ThreeBandCoeffs c = random_coeffs();
+    uint32_t n = coeffFramePack(frame, COEFF_BAND_MASK(COEFF_BAND_MID), 0x5A, &c);
+    expect(n == 14 && frame[0] == 0x24 && frame[1] == 0x5A, "header byte and sequence");
+    expect(frame[2] == (uint8_t)((uint16_t)c.mid.b0 >> 8) && frame[3] == (uint8_t)c.mid.b0 &&
+           frame[10] == (uint8_t)((uint16_t)c.mid.a2 >> 8) && frame[11] == (uint8_t)c.mid.a2,
+           "mid b0..a2 big-endian after the header");
+    uint16_t crc = crc16Update(CRC16_INIT, frame, 12);
+    expect(frame[12] == crc >> 8 && frame[13] == (crc & 0xFF), "CRC big-endian at the end");
+
+    for (int f = 0; f < RANDOM_FRAMES; f++) {
+        uint8_t mask = (uint8_t)(rand() & COEFF_BANDS_ALL), seq = (uint8_t)rand();
+        ThreeBandCoeffs sent = random_coeffs(), got = random_coeffs(), before = got;
+        n = coeffFramePack(frame, mask, seq, &sent);
+        if (n != coeffFrameBytes(mask, COEFF_FRAME_COEFFS)) expect(0, "packed length");
+
+        uint8_t m, s;
+        if (coeffFrameParse(frame, n, &m, &s, NULL, &got, NULL) != COEFF_FRAME_COEFFS || m != mask || s != seq) {
+            expect(0, "parser accepts packed frames");
+            continue;
+        }
+
+        // Bands in the mask come across, the rest keep their old values
+        const BiquadQ14 *sb[3] = { &sent.low, &sent.mid, &sent.high };
+        const BiquadQ14 *gb[3] = { &got.low, &got.mid, &got.high };
+        const BiquadQ14 *bb[3] = { &before.low, &before.mid, &before.high };
+        for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+            const BiquadQ14 *want = (mask & COEFF_BAND_MASK(b)) ? sb[b] : bb[b];
+            if (memcmp(gb[b], want, sizeof *want) != 0) expect(0, "band update follows the mask");
+        }
+
+        // The RTL model agrees with the parser on good frames...
+        int16_t slots[COEFF_FRAME_COEFF_WORDS];
+        memcpy(slots, &before, sizeof slots);
+        uint8_t fm, fs, fc, fi[COEFF_NUM_BANDS];
+        if (fpga_receive(frame, n, slots, fi, &fm, &fs, &fc) != COEFF_FRAME_COEFFS || fm != mask || fs != seq ||
+            memcmp(slots, &got, sizeof slots) != 0) {
+            expect(0, "aes_spi model decodes like the parser");
+        }
+
+        // ...on trailing bytes after the CRC (ignored)...
+        frame[n] = (uint8_t)rand();
+        if (coeffFrameParse(frame, n + 1, &m, &s, NULL, &got, NULL) < 0 ||
+            fpga_receive(frame, n + 1, slots, fi, &fm, &fs, &fc) < 0) {
+            expect(0, "bytes after the CRC ignored");
+        }
+
+        // ...and both drop any single-bit error, a truncated frame and a wrong version
+        uint32_t bit = (uint32_t)rand() % (8 * n);
+        frame[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+        if (coeffFrameParse(frame, n, &m, &s, NULL, &got, NULL) >= 0 || fpga_receive(frame, n, slots, fi, &fm, &fs, &fc) >= 0) {
+            expect(0, "single-bit error rejected");
+        }
+        frame[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+        if (coeffFrameParse(frame, n - 1, &m, &s, NULL, &got, NULL) >= 0 ||
+            fpga_receive(frame, n - 1, slots, fi, &fm, &fs, &fc) >= 0) {
+            expect(0, "short frame rejected");
+        }
+    }
+
+    // Gain-index frames: one byte per band, through the same CRC and band mask
+    for (int f = 0; f < RANDOM_FRAMES; f++) {
+        uint8_t mask = (uint8_t)(rand() & COEFF_BANDS_ALL), seq = (uint8_t)rand();
+        uint8_t sent[COEFF_NUM_BANDS], got[COEFF_NUM_BANDS], fi[COEFF_NUM_BANDS], fc;
+        for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+            sent[b] = (uint8_t)rand();
+            got[b] = fi[b] = (uint8_t)~sent[b];
+        }
+        n = coeffFramePackIndices(frame, mask, seq, sent);
+        if (n != coeffFrameBytes(mask, COEFF_FRAME_INDICES)) expect(0, "index frame length");
+
+        ThreeBandCoeffs before = random_coeffs(), after = before;
+        int16_t slots[COEFF_FRAME_COEFF_WORDS];
+        memcpy(slots, &before, sizeof slots);
+        uint8_t m, s, fm, fs;
+        if (coeffFrameParse(frame, n, &m, &s, NULL, &after, got) != COEFF_FRAME_INDICES || m != mask || s != seq ||
+            fpga_receive(frame, n, slots, fi, &fm, &fs, &fc) != COEFF_FRAME_INDICES || fm != mask || fs != seq) {
+            expect(0, "index frames accepted by the parser and the aes_spi model");
+            continue;
+        }
+        for (int b = 0; b < COEFF_NUM_BANDS; b++) {
+            uint8_t want = (mask & COEFF_BAND_MASK(b)) ? sent[b] : (uint8_t)~sent[b];
+            if (got[b] != want || fi[b] != want) expect(0, "index update follows the mask");
+        }
+        if (memcmp(&after, &before, sizeof after) != 0 || memcmp(slots, &before, sizeof slots) != 0) {
+            expect(0, "index frames leave the coefficients alone");
+        }
+
+        uint32_t bit = (uint32_t)rand() % (8 * n);
+        frame[bit / 8] ^= (uint8_t)(0x80 >> (bit % 8));
+        if (coeffFrameParse(frame, n, &m, &s, NULL, &after, got) >= 0 || fpga_receive(frame, n, slots, fi, &fm, &fs, &fc) >= 0) {
+            expect(0, "single-bit error in an index frame rejected");
+        }
+    }
+
+    // Channel frames (v3): the channel byte after the sequence number, same payload
+    n = coeffFramePackChannels(frame, COEFF_CHANNEL_RIGHT, COEFF_FRAME_COEFFS, COEFF_BAND_MASK(COEFF_BAND_MID),
+                               0x5A, &c, NULL);
+    expect(n == 15 && frame[0] == 0x34 && frame[1] == 0x5A && frame[2] == COEFF_CHANNEL_RIGHT &&
+           frame[3] == (uint8_t)((uint16_t)c.mid.b0 >> 8), "v3 header, sequence and channel byte");
+    for (int f = 0; f < RANDOM_FRAMES; f++) {
+        uint8_t mask = (uint8_t)(rand() & COEFF_BANDS_ALL), seq = (uint8_t)rand();
+        uint8_t channels = (uint8_t)(1 + rand() % 3);
+        CoeffFrameKind kind = (CoeffFrameKind)(rand() & 1);
+        ThreeBandCoeffs sent = random_coeffs(), got = random_coeffs();
+        uint8_t idx[COEFF_NUM_BANDS] = { (uint8_t)rand(), (uint8_t)rand(), (uint8_t)rand() };
+        uint8_t got_idx[COEFF_NUM_BANDS], fi[COEFF_NUM_BANDS];
+        n = coeffFramePackChannels(frame, channels, kind, mask, seq, &sent, idx);
+        if (n != coeffFrameBytes(mask, kind) + (channels == COEFF_CHANNELS_BOTH ? 0 : COEFF_FRAME_CHANNEL_BYTES)) {
+            expect(0, "channel frame length");
+        }
+
+        int16_t slots[COEFF_FRAME_COEFF_WORDS];
+        memcpy(slots, &got, sizeof slots);
+        uint8_t m, s, ch, fm, fs, fc;
+        if (coeffFrameParse(frame, n, &m, &s, &ch, &got, got_idx) != (int)kind || ch != channels ||
+            fpga_receive(frame, n, slots, fi, &fm, &fs, &fc) != (int)kind || fc != channels ||
+            memcmp(slots, &got, sizeof slots) != 0) {
+            expect(0, "channel frames decode the same in the parser and the aes_spi model");
+            continue;
+        }
+        if (channels == COEFF_CHANNELS_BOTH && (frame[0] >> 4) != COEFF_FRAME_VERSION) {
+            expect(0, "both channels go out as a v2 frame");
+        }
+
+        // A v3 frame for no channel (or with unknown bits) is dropped even with a good CRC
+        if (channels == COEFF_CHANNELS_BOTH) continue;
+        frame[2] = (rand() & 1) ? 0 : (uint8_t)(channels | 0x04);
+        uint16_t fix = crc16Update(CRC16_INIT, frame, n - 2);
+        frame[n - 2] = (uint8_t)(fix >> 8);
+        frame[n - 1] = (uint8_t)fix;
+        if (coeffFrameParse(frame, n, &m, &s, &ch, &got, got_idx) >= 0 ||
+            fpga_receive(frame, n, slots, fi, &fm, &fs, &fc) >= 0) {
+            expect(0, "bad channel byte rejected");
+        }
+    }
+
+    n = coeffFramePack(frame, COEFF_BANDS_ALL, 1, &c);
+    frame[0] = (uint8_t)((frame[0] & 0x0F) | 0x10);
+    crc = crc16Update(CRC16_INIT, frame, n - 2);
+    frame[n - 2] = (uint8_t)(crc >> 8);
+    frame[n - 1] = (uint8_t)crc;
+    uint8_t m, s;
+    expect(coeffFrameParse(frame, n, &m, &s, NULL, &c, NULL) < 0, "version 1 header rejected");
+}
+
+// Parse the frame the mock DMA is sending; 1 for a coefficient frame
+static int wire_frame(uint8_t *mask, uint8_t *seq, ThreeBandCoeffs *c)
+{
+    return coeffFrameParse(hw_copy, hw_len, mask, seq, NULL, c, NULL) == COEFF_FRAME_COEFFS;
+}
+
+static void check_queue(void)
+{
+    uint8_t mask, seq;
+    ThreeBandCoeffs got;
+
+    coeffFrameInit();
+    expect(hw_inits == 1 && !coeffFrameBusy(), "init leaves the queue idle");
+
+    ThreeBandCoeffs a = random_coeffs(), b = random_coeffs(), c = random_coeffs();
+
+    expect(coeffFrameSend(COEFF_BANDS_ALL, &a) == 1 && hw_starts == 1, "idle send starts at once");
+    expect(wire_frame(&mask, &seq, &got) && mask == COEFF_BANDS_ALL && seq == 0 &&
+           !memcmp(&got, &a, sizeof a), "first frame contents");
+
+    const uint8_t *first = hw_buf;
+    uint8_t first_copy[COEFF_FRAME_WIDE_MAX_BYTES];
+    memcpy(first_copy, hw_copy, sizeof first_copy);
+    expect(coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_LOW), &b) == 0 && hw_starts == 1, "busy send is queued");
+    expect(coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_HIGH), &c) == 0 && hw_starts == 1,
+           "second busy send is queued");
+    expect(memcmp(first, first_copy, hw_len) == 0, "queued frames leave the wire buffer alone");
+
+    coeffFrameOnDmaComplete();
+    expect(hw_starts == 2 && wire_frame(&mask, &seq, &got) && seq == 1 &&
+           mask == (COEFF_BAND_MASK(COEFF_BAND_LOW) | COEFF_BAND_MASK(COEFF_BAND_HIGH)) &&
+           !memcmp(&got.low, &c.low, sizeof c.low) && !memcmp(&got.high, &c.high, sizeof c.high),
+           "completion chains the newest frame with the replaced frame's bands and sequence");
+    coeffFrameOnDmaComplete();
+    expect(!coeffFrameBusy() && hw_starts == 2 && coeffFrameCompleted() == 2, "queue drains to idle");
+
+    // Random sends and completions, checked against a receiver that applies every frame
+    // put on the wire: sequence numbers never skip, the wire buffer never changes
+    // mid-transfer, and once the queue drains the receiver holds the latest coefficients
+    ThreeBandCoeffs rx = c, latest = c;
+    uint8_t expect_seq = 2;
+    int on_wire = 0, queued = 0;
+    const uint8_t *wire_buf = NULL;
+    for (int s = 0; s < QUEUE_STEPS; s++) {
+        if (on_wire && memcmp(wire_buf, hw_copy, hw_len) != 0) {
+            expect(0, "wire buffer modified during a transfer");
+        }
+        int before = hw_starts;
+        if (rand() & 1) {
+            ThreeBandCoeffs next = latest;
+            uint8_t changed = (uint8_t)(1 + rand() % COEFF_BANDS_ALL);
+            ThreeBandCoeffs r = random_coeffs();
+            if (changed & 1) next.low = r.low;
+            if (changed & 2) next.mid = r.mid;
+            if (changed & 4) next.high = r.high;
+            latest = next;
+            int started_now = coeffFrameSend(changed, &latest);
+            if (started_now != !on_wire || hw_starts != before + started_now) {
+                expect(0, "send starts exactly when idle");
+            }
+            if (!started_now) queued = 1;
+        } else if (on_wire) {
+            coeffFrameOnDmaComplete();
+            if (queued != (hw_starts == before + 1)) expect(0, "completion chains only a queued frame");
+            queued = 0;
+            if (hw_starts == before) on_wire = 0;
+        }
+        if (hw_starts != before) {
+            on_wire = 1;
+            wire_buf = hw_buf;
+            if (!wire_frame(&mask, &seq, &rx) || seq != expect_seq) expect(0, "sequence numbers contiguous");
+            expect_seq++;
+        }
+        if (!on_wire && memcmp(&rx, &latest, sizeof rx) != 0) {
+            expect(0, "receiver holds the latest coefficients once idle");
+        }
+    }
+
+    // A waiting frame replaced by one of the other kind cannot merge band by band:
+    // the replacement carries every band and keeps the sequence number
+    while (coeffFrameBusy()) coeffFrameOnDmaComplete();
+    uint8_t idx[COEFF_NUM_BANDS] = { 10, 20, 30 }, got_idx[COEFF_NUM_BANDS] = { 0, 0, 0 };
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_LOW), &a);
+    expect(coeffFrameSendIndices(COEFF_BAND_MASK(COEFF_BAND_MID), idx) == 0, "index frame queued");
+    expect(coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_HIGH), &b) == 0, "coefficient frame replaces it");
+    uint8_t queued_seq = coeffFrameSequence();
+    coeffFrameOnDmaComplete();
+    expect(wire_frame(&mask, &seq, &got) && mask == COEFF_BANDS_ALL && seq == queued_seq &&
+           !memcmp(&got, &b, sizeof b), "kind change sends every band");
+    expect(coeffFrameSendIndices(COEFF_BAND_MASK(COEFF_BAND_MID), idx) == 0, "index frame behind a busy link");
+    coeffFrameOnDmaComplete();
+    expect(coeffFrameParse(hw_copy, hw_len, &mask, &seq, NULL, &got, got_idx) == COEFF_FRAME_INDICES &&
+           mask == COEFF_BAND_MASK(COEFF_BAND_MID) && got_idx[1] == 20 && got_idx[0] == 0,
+           "queued index frame chains like a coefficient frame");
+    coeffFrameOnDmaComplete();
+
+    // Wide frames queue and merge the same way; a v2 frame they replace becomes every section
+    BiquadQ14 sec[WIDE_SECTIONS], wire_sec[WIDE_SECTIONS];
+    uint16_t wmask;
+    random_sections(sec, WIDE_SECTIONS);
+    expect(coeffFrameSendSections(0x0001, sec, WIDE_SECTIONS) == 1, "idle wide send starts at once");
+    expect(coeffFrameParseSections(hw_copy, hw_len, &wmask, &seq, NULL, wire_sec, WIDE_SECTIONS) == 0 &&
+           wmask == 0x0001, "wide frame on the wire");
+    expect(coeffFrameSendSections(0x0100, sec, WIDE_SECTIONS) == 0 &&
+           coeffFrameSendSections(0x0200, sec, WIDE_SECTIONS) == 0, "busy wide sends are queued");
+    coeffFrameOnDmaComplete();
+    expect(coeffFrameParseSections(hw_copy, hw_len, &wmask, &seq, NULL, wire_sec, WIDE_SECTIONS) == 0 &&
+           wmask == 0x0300 && !memcmp(&wire_sec[9], &sec[9], sizeof sec[9]), "wide sends merge their masks");
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_LOW), &a);
+    expect(coeffFrameSendSections(0x0010, sec, WIDE_SECTIONS) == 0, "wide frame replaces a v2 frame");
+    coeffFrameOnDmaComplete();
+    expect(coeffFrameParseSections(hw_copy, hw_len, &wmask, &seq, NULL, wire_sec, WIDE_SECTIONS) == 0 &&
+           wmask == 0x03FF, "kind change sends every section");
+    coeffFrameOnDmaComplete();
+
+    printf("queue: %d transfers started, %u completed\n", hw_starts, coeffFrameCompleted());
+}
+
+// spi_top's status word: sampled at CS low, counts the transaction once CS rises
+typedef struct {
+    int     present;
+    uint8_t busy;
+    uint8_t committed_seq;
+    uint8_t transactions;
+    uint8_t rejected;
+} FpgaStatus;
+
+// Finish the transfer on the mock wire: shift the status out, then let the FPGA
+// commit the frame (keep) or reject it
+static void fpga_complete(FpgaStatus *f, int keep)
+{
+    if (f->present) {
+        hw_rx[0] = (uint8_t)(COEFF_FRAME_STATUS_TAG | f->busy);
+        hw_rx[1] = f->committed_seq;
+        hw_rx[2] = f->transactions;
+        hw_rx[3] = f->rejected;
+    } else {
+        memset(hw_rx, 0, hw_len);
+    }
+    if (hw_copy[0] != 0x00 && hw_copy[0] != COEFF_FRAME_CONFIG_HEADER) {
+        if (keep) {
+            f->committed_seq = hw_copy[1];
+        } else {
+            f->rejected++;
+        }
+    }
+    f->transactions++;
+    coeffFrameOnDmaComplete();
+}
+
+static int poll_on_wire(void)
+{
+    static const uint8_t zeros[COEFF_FRAME_STATUS_BYTES];
+    return coeffFrameBusy() && hw_len == COEFF_FRAME_STATUS_BYTES && !memcmp(hw_copy, zeros, hw_len);
+}
+
+static void check_ack(void)
+{
+    FpgaStatus f = { 0 };
+    CoeffFrameStatus st;
+    ThreeBandCoeffs a = random_coeffs(), b = random_coeffs();
+
+    // No status word on MISO: nothing can be confirmed, and no polls go out
+    coeffFrameInit();
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE, "nothing sent, nothing to confirm");
+    coeffFrameSend(COEFF_BANDS_ALL, &a);
+    expect(coeffFrameCheck() == COEFF_ACK_WAIT, "unconfirmed while on the wire");
+    fpga_complete(&f, 1);
+    int starts = hw_starts;
+    expect(coeffFrameCheck() == COEFF_ACK_UNKNOWN && hw_starts == starts && !coeffFrameStatus(&st),
+           "no status tag: unknown, no poll");
+
+    // The FPGA has been up a while: its count starts elsewhere and seq 0xFF is live
+    f = (FpgaStatus){ 1, 0, 0xFF, 37, 2 };
+    coeffFrameInit();
+    coeffFrameSend(COEFF_BANDS_ALL, &a);
+    uint8_t seq = coeffFrameSequence();
+    f.busy = 1;
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_WAIT && poll_on_wire(), "the frame's own status word is too early");
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_WAIT && poll_on_wire(), "busy FPGA: poll again");
+    f.busy = 0;
+    fpga_complete(&f, 1);
+    starts = hw_starts;
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE && hw_starts == starts, "committed frame confirmed");
+    expect(coeffFrameStatus(&st) && st.committed_seq == seq && st.transactions == 39 && st.rejected == 2 &&
+           !st.busy, "status word decoded");
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE && hw_starts == starts, "confirmation is kept");
+
+    // A rejected frame is reported lost once; the resend is confirmed
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_MID), &b);
+    fpga_complete(&f, 0);
+    expect(coeffFrameCheck() == COEFF_ACK_WAIT, "rejected frame not known yet");
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_LOST && coeffFrameLosses() == 1, "rejected frame lost");
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE, "loss reported once");
+    coeffFrameSend(COEFF_BANDS_ALL, &b);
+    fpga_complete(&f, 1);
+    coeffFrameCheck();
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE && f.committed_seq == coeffFrameSequence(), "resend confirmed");
+
+    // Of two chained frames only the newer one counts
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_LOW), &a);
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_HIGH), &b);
+    fpga_complete(&f, 1);
+    fpga_complete(&f, 0);
+    coeffFrameCheck();
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_LOST && coeffFrameLosses() == 2, "newest chained frame lost");
+
+    // Earlier frame rejected, later frame committed: the low band never landed
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_LOW), &a);
+    coeffFrameSend(COEFF_BAND_MASK(COEFF_BAND_MID), &b);
+    fpga_complete(&f, 0);
+    fpga_complete(&f, 1);
+    expect(f.committed_seq == coeffFrameSequence(), "later frame committed");
+    expect(coeffFrameCheck() == COEFF_ACK_LOST && coeffFrameLosses() == 3, "earlier rejected frame lost");
+    expect(coeffFramePoll() == 1, "idle poll after the loss");
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE, "rejection reported once");
+
+    // FPGA reset while idle: the count stays off, is relearned, and everything is resent
+    f.transactions = 0;
+    f.committed_seq = 0xFF;
+    expect(coeffFramePoll() == 1 && poll_on_wire(), "idle poll");
+    expect(coeffFramePoll() == 0, "one poll at a time");
+    fpga_complete(&f, 1);
+    int polls = 1;
+    CoeffFrameAck ack;
+    while ((ack = coeffFrameCheck()) == COEFF_ACK_WAIT && polls < 10) {
+        fpga_complete(&f, 1);
+        polls++;
+    }
+    expect(ack == COEFF_ACK_LOST && polls == COEFF_FRAME_RESYNC_POLLS, "reset detected after the resync polls");
+    coeffFrameSend(COEFF_BANDS_ALL, &b);
+    fpga_complete(&f, 1);
+    coeffFrameCheck();
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE, "confirmed against the relearned count");
+
+    // A config write is one more transaction: a frame chained behind it is still confirmed
+    expect(coeffFrameWriteConfig(COEFF_CONFIG_RAMP_SHIFT, 7) == 1 && hw_len == COEFF_FRAME_CONFIG_BYTES &&
+           hw_copy[0] == COEFF_FRAME_CONFIG_HEADER && hw_copy[1] == COEFF_CONFIG_RAMP_SHIFT &&
+           hw_copy[2] == 7 && hw_copy[3] == 0xF8, "config write {0x01, reg, value, ~value}");
+    expect(coeffFrameWriteConfig(COEFF_CONFIG_RAMP_SHIFT, 7) == 0, "one config write at a time");
+    coeffFrameSend(COEFF_BANDS_ALL, &a);
+    fpga_complete(&f, 1);
+    fpga_complete(&f, 1);
+    coeffFrameCheck();
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE && f.committed_seq == coeffFrameSequence(),
+           "frame after a config write confirmed");
+
+    printf("ack: %u frames lost and resent\n", coeffFrameLosses());
+}
+
+static void check_bypass(void)
+{
+    static const BiquadQ14 flat = { 0x4000, 0, 0, 0, 0 };
+    FpgaStatus f = { 1, 0, 0xFF, 0, 0 };
+    ThreeBandCoeffs c = random_coeffs();
+    uint8_t buf[COEFF_FRAME_BYPASS_BYTES];
+
+    expect(coeffFramePackBypass(buf, COEFF_CHANNELS_BOTH, 0x8005, 0x42) == COEFF_FRAME_BYPASS_BYTES &&
+           buf[0] == 0x50 && buf[1] == 0x42 && buf[2] == COEFF_CHANNELS_BOTH && buf[3] == 0x80 &&
+           buf[4] == 0x05 && crc16Update(CRC16_INIT, buf, COEFF_FRAME_BYPASS_BYTES) == 0, "v5 layout");
+
+    c.low.b0 = 0x4000;      // Not flat: the others are random
+    c.mid = flat;
+    expect(coeffFrameFlatBands(&c) == COEFF_BAND_MASK(COEFF_BAND_MID), "one flat band");
+    c.low = flat;
+    c.high = flat;
+    expect(coeffFrameFlatBands(&c) == (COEFF_BANDS_ALL | COEFF_BYPASS_ALL), "all flat: global bypass");
+
+    // Only starts on an idle link; a frame after it queues behind and is the one confirmed
+    coeffFrameInit();
+    expect(coeffFrameSendBypass(COEFF_BYPASS_ALL) == 1 && hw_len == COEFF_FRAME_BYPASS_BYTES &&
+           hw_copy[0] == 0x50, "bypass frame on the wire");
+    expect(coeffFrameSendBypass(0) == 0, "not while busy");
+    coeffFrameSend(COEFF_BANDS_ALL, &c);
+    fpga_complete(&f, 1);
+    fpga_complete(&f, 1);
+    coeffFrameCheck();
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE && f.committed_seq == coeffFrameSequence() &&
+           coeffFrameSequence() == 1, "frame behind the bypass frame confirmed");
+
+    // A bypass frame on its own is confirmed like any other
+    expect(coeffFrameSendBypass(0) == 1, "bypass frame alone");
+    fpga_complete(&f, 1);
+    coeffFrameCheck();
+    fpga_complete(&f, 1);
+    expect(coeffFrameCheck() == COEFF_ACK_IDLE && f.committed_seq == coeffFrameSequence(), "bypass frame confirmed");
+
+    // Bypass frame rejected, the frame behind it committed: still a loss, so the flags go again
+    coeffFrameSendBypass(COEFF_BYPASS_ALL);
+    coeffFrameSend(COEFF_BANDS_ALL, &c);
+    fpga_complete(&f, 0);
+    fpga_complete(&f, 1);
+    expect(f.committed_seq == coeffFrameSequence(), "frame behind the bypass frame committed");
+    expect(coeffFrameCheck() == COEFF_ACK_LOST, "rejected bypass frame lost");
+}
+
+int main(void)
+{
+    srand(1);
+    check_layout();
+    check_wide();
+    check_queue();
+    check_ack();
+    check_bypass();
+
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
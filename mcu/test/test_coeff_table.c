@@ -0,0 +1,181 @@
+// test_coeff_table.c
+// Host test: table engine vs. float design path, gain-index mapping and FPGA ROM image,
+// plus ns-per-update benchmark
+//
+// Build and run from mcu/ (reads ../fpga/src/gain_rom.mem):
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc test/test_coeff_table.c src/calc_coefficient.c src/coeff_table.c src/coeff_table_data.c -lm -o test_coeff_table
+//   ./test_coeff_table
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "calc_coefficient.h"
+#include "coeff_table.h"
+
+#define BENCH_PASSES 200
+#define GAIN_ROM_PATH "../fpga/src/gain_rom.mem"
+
+static const char *band_names[COEFF_NUM_BANDS] = { "low", "mid", "high" };
+
+static const int16_t *coeff_array(const BiquadQ14 *q)
+{
+    return &q->b0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Every ADC code and band must agree within COEFF_TABLE_MAX_LSB_ERR, and exactly on grid points
+static int check_equivalence(void)
+{
+    int failures = 0;
+
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        int max_err = 0;
+        int exact = 0;
+
+        for (int adc = 0; adc < 4096; adc++) {
+            BiquadQ14 ref = calcCoeffBandFloat((CoeffBand)band, (uint16_t)adc);
+            BiquadQ14 tab = coeffTableLookup((CoeffBand)band, (uint16_t)adc);
+            int on_grid = (adc % COEFF_TABLE_STEP) == 0;
+            int worst = 0;
+
+            for (int k = 0; k < 5; k++) {
+                int err = abs(coeff_array(&ref)[k] - coeff_array(&tab)[k]);
+                if (err > worst) worst = err;
+            }
+            if (worst > max_err) max_err = worst;
+            if (worst == 0) exact++;
+
+            if (worst > COEFF_TABLE_MAX_LSB_ERR || (on_grid && worst != 0)) {
+                if (failures < 10) {
+                    printf("FAIL %s adc=%d err=%d LSB%s\n", band_names[band], adc, worst,
+                           on_grid ? " (grid point, table out of date?)" : "");
+                }
+                failures++;
+            }
+        }
+        printf("%-4s band: max error %d LSB, %d/4096 codes bit-exact\n",
+               band_names[band], max_err, exact);
+    }
+    return failures;
+}
+
+// The index mapping is monotonic and spans the table; the ROM image matches the design
+// code and index changes obey the hysteresis
+static int check_gain_index(void)
+{
+    int failures = 0;
+
+    uint8_t prev = 0;
+    for (int adc = 0; adc < 4096; adc++) {
+        uint8_t idx = calcCoeffGainIndex((uint16_t)adc);
+        if (idx < prev || idx >= COEFF_GAIN_STEPS) failures++;
+        prev = idx;
+    }
+    if (calcCoeffGainIndex(0) != 0 || calcCoeffGainIndex(4095) != COEFF_GAIN_STEPS - 1) failures++;
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        BiquadQ14 top = calcCoeffGainIndexDesign((CoeffBand)band, COEFF_GAIN_STEPS - 1);
+        BiquadQ14 unity = simpleUnity();
+        if (memcmp(&top, &unity, sizeof top) != 0) failures++;
+    }
+    if (failures) printf("FAIL gain index mapping\n");
+
+    // gain_rom.mem: one hex word per coefficient, // comments
+    FILE *f = fopen(GAIN_ROM_PATH, "r");
+    if (!f) {
+        printf("FAIL cannot open %s\n", GAIN_ROM_PATH);
+        return failures + 1;
+    }
+    int words = 0, rom_errors = 0;
+    char line[256];
+    while (fgets(line, sizeof line, f)) {
+        char *p = line, *end;
+        for (;;) {
+            while (*p == ' ' || *p == '\t') p++;
+            if (*p == '\0' || *p == '\n' || (p[0] == '/' && p[1] == '/')) break;
+            long v = strtol(p, &end, 16);
+            if (end == p) break;
+            p = end;
+
+            int entry = words / 5, k = words % 5;
+            int band = entry / COEFF_GAIN_STEPS, idx = entry % COEFF_GAIN_STEPS;
+            if (band < COEFF_NUM_BANDS) {
+                BiquadQ14 q = calcCoeffGainIndexDesign((CoeffBand)band, (uint8_t)idx);
+                if ((uint16_t)coeff_array(&q)[k] != (uint16_t)v) rom_errors++;
+            }
+            words++;
+        }
+    }
+    fclose(f);
+    if (words != COEFF_NUM_BANDS * COEFF_GAIN_STEPS * 5 || rom_errors) {
+        printf("FAIL %s: %d words, %d differ from the design (rerun tools/gen_gain_rom)\n",
+               GAIN_ROM_PATH, words, rom_errors);
+        failures++;
+    }
+
+    // Nothing before the first smoothing run, every band on the first, then only real moves
+    uint8_t index[COEFF_NUM_BANDS];
+    calcCoeffInit();
+    if (calcCoeffGainIndexChanged(index) != 0) failures++;
+    for (int i = 0; i < 64; i++) calcCoeffSmooth(1000, 2000, 3000);
+    if (calcCoeffGainIndexChanged(index) != COEFF_BANDS_ALL || index[0] != calcCoeffGainIndex(1000)) failures++;
+    for (int i = 0; i < 64; i++) calcCoeffSmooth(1002, 2000, 3000);
+    if (calcCoeffGainIndexChanged(index) != 0) failures++;
+    for (int i = 0; i < 64; i++) calcCoeffSmooth(1002, 2500, 3000);
+    if (calcCoeffGainIndexChanged(index) != COEFF_BAND_MASK(COEFF_BAND_MID) ||
+        index[1] != calcCoeffGainIndex(2500)) {
+        failures++;
+    }
+    printf("gain index: %d steps, ROM image %d words\n", COEFF_GAIN_STEPS, words);
+    return failures;
+}
+
+static void benchmark(void)
+{
+    volatile int16_t sink = 0;
+    double t0, t1;
+    const double updates = (double)BENCH_PASSES * 4096.0;
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int adc = 0; adc < 4096; adc++) {
+            for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+                sink += calcCoeffBandFloat((CoeffBand)band, (uint16_t)adc).b1;
+            }
+        }
+    }
+    t1 = now_ns();
+    printf("float path: %8.1f ns per 3-band update\n", (t1 - t0) / updates);
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (int adc = 0; adc < 4096; adc++) {
+            for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+                sink += coeffTableLookup((CoeffBand)band, (uint16_t)adc).b1;
+            }
+        }
+    }
+    t1 = now_ns();
+    printf("table path: %8.1f ns per 3-band update\n", (t1 - t0) / updates);
+    (void)sink;
+}
+
+int main(void)
+{
+    int failures = check_equivalence();
+    failures += check_gain_index();
+    benchmark();
+
+    if (failures) {
+        printf("%d failures (table mismatches beyond %d LSB)\n", failures, COEFF_TABLE_MAX_LSB_ERR);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
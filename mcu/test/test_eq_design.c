@@ -0,0 +1,177 @@
+// test_eq_design.c
+// Host test: N-band designer vs. the fixed three-band float path, plus filter-type sanity
+//
+// Build and run from mcu/:
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc test/test_eq_design.c src/eq_design.c src/calc_coefficient.c -lm -o test_eq_design
+//   ./test_eq_design
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+#include "calc_coefficient.h"
+#include "calc_coefficient_config.h"
+#include "eq_design.h"
+
+// Designer checks run at a rate with room for a 16 kHz band; the defaults use the board's FS
+#define FS_HZ 63000.0f
+
+// |H(e^jw)| of a quantized section at frequency f and sample rate fs
+static double section_mag_fs(BiquadQ14 q, double f, double fs)
+{
+    double complex z1 = cexp(-I * 2.0 * M_PI * f / fs);
+    double complex z2 = z1 * z1;
+    double complex num = q.b0 + q.b1 * z1 + q.b2 * z2;
+    double complex den = 16384.0 + q.a1 * z1 + q.a2 * z2;
+    return cabs(num / den);
+}
+
+static double section_mag(BiquadQ14 q, double f)
+{
+    return section_mag_fs(q, f, FS_HZ);
+}
+
+static int section_stable(BiquadQ14 q)
+{
+    double a1 = q.a1 / 16384.0, a2 = q.a2 / 16384.0;
+    return fabs(a2) < 1.0 && fabs(a1) < 1.0 + a2;
+}
+
+// The default descriptors must reproduce calcCoeffBandFloat bit for bit
+static int check_defaults(void)
+{
+    EqBand bands[COEFF_NUM_BANDS];
+    BiquadQ14 sections[COEFF_NUM_BANDS];
+    EqDesign eq;
+    int failures = 0;
+
+    eqInit(&eq, FS, bands, sections, COEFF_NUM_BANDS);
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        eqConfigureBand(&eq, (uint8_t)band, &eqThreeBandDefaults[band]);
+    }
+
+    for (int adc = 0; adc < 4096; adc++) {
+        for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+            BiquadQ14 ref = calcCoeffBandFloat((CoeffBand)band, (uint16_t)adc);
+            eqSetGain(&eq, (uint8_t)band, calcCoeffAdcToGainDb((uint16_t)adc));
+            if (memcmp(&ref, &sections[band], sizeof ref) != 0) {
+                if (failures < 10) {
+                    printf("FAIL default band %d adc=%d\n", band, adc);
+                }
+                failures++;
+            }
+        }
+    }
+    printf("default three-band descriptors: %d mismatches over 4096 codes\n", failures);
+    return failures;
+}
+
+// A 10-band graphic EQ plus pass/stop types: correct responses and stable poles.
+// Centers start at 250 Hz: below that, Q14 coefficients at 63 kHz cannot place
+// a peak's poles close enough to the unit circle to reach the requested gain.
+static int check_types(void)
+{
+    static const float centers[10] = { 250.0f, 400.0f, 630.0f, 1000.0f, 1600.0f,
+                                       2500.0f, 4000.0f, 6300.0f, 10000.0f, 16000.0f };
+    EqBand bands[10];
+    BiquadQ14 sections[10];
+    EqDesign eq;
+    int failures = 0;
+
+    eqInit(&eq, FS_HZ, bands, sections, 10);
+    for (uint8_t i = 0; i < 10; i++) {
+        EqBandDesc d = { EQ_PEAK, centers[i], 1.4f, -12.0f, 6.0f };
+        if (eqConfigureBand(&eq, i, &d) != 0 || eqSetGain(&eq, i, -6.0f) != 0) failures++;
+        double g = 20.0 * log10(section_mag(sections[i], centers[i]));
+        if (fabs(g + 6.0) > 0.5 || !section_stable(sections[i])) {
+            printf("FAIL graphic band %u: %.2f dB at center\n", i, g);
+            failures++;
+        }
+    }
+
+    EqBandDesc lp = { EQ_LOWPASS,  5000.0f, 0.707f, -6.0f, 0.0f };
+    EqBandDesc hp = { EQ_HIGHPASS, 1000.0f, 0.707f, -6.0f, 0.0f };
+    EqBandDesc nt = { EQ_NOTCH,    3000.0f, 2.0f,    0.0f, 0.0f };
+    eqConfigureBand(&eq, 0, &lp);
+    eqConfigureBand(&eq, 1, &hp);
+    eqConfigureBand(&eq, 2, &nt);
+    eqSetPot(&eq, 1, 0.5f);   // -3 dB passband
+
+    if (fabs(section_mag(sections[0], 0.0) - 1.0) > 0.01 || section_mag(sections[0], 31000.0) > 0.01) {
+        printf("FAIL lowpass response\n");
+        failures++;
+    }
+    if (section_mag(sections[1], 0.0) > 0.01 ||
+        fabs(20.0 * log10(section_mag(sections[1], 31000.0)) + 3.0) > 0.1) {
+        printf("FAIL highpass response\n");
+        failures++;
+    }
+    if (section_mag(sections[2], 3000.0) > 0.01 || fabs(section_mag(sections[2], 0.0) - 1.0) > 0.01) {
+        printf("FAIL notch response\n");
+        failures++;
+    }
+
+    EqBandDesc bad = { EQ_PEAK, 40000.0f, 1.0f, 0.0f, 0.0f };
+    if (eqConfigureBand(&eq, 0, &bad) == 0 || eqSetGain(&eq, 10, 0.0f) == 0) {
+        printf("FAIL invalid descriptor accepted\n");
+        failures++;
+    }
+
+    printf("graphic EQ / pass / stop checks: %d failures\n", failures);
+    return failures;
+}
+
+// eqGraphicLayout at the board's FS: 10 log-spaced peaks for a 10-section cascade.
+// 125 Hz at 31.25 kHz is the same w0 as 250 Hz at 63 kHz (see check_types).
+static int check_graphic_layout(void)
+{
+    EqBand bands[10];
+    BiquadQ14 sections[10];
+    EqDesign eq;
+    int failures = 0;
+
+    eqInit(&eq, FS, bands, sections, 10);
+    if (eqGraphicLayout(&eq, 125.0f, 12000.0f, 12.0f) != 0) {
+        printf("FAIL graphic layout rejected\n");
+        return 1;
+    }
+    for (uint8_t i = 0; i < 10; i++) {
+        float f = bands[i].desc.freq_hz;
+        if (memcmp(&sections[i], &(BiquadQ14){ 16384, 0, 0, 0, 0 }, sizeof sections[i]) != 0 ||
+            (i > 0 && f <= bands[i - 1].desc.freq_hz) || bands[i].desc.q < 1.0f || bands[i].desc.q > 2.0f) {
+            printf("FAIL layout band %u: %.1f Hz Q %.2f\n", i, f, bands[i].desc.q);
+            failures++;
+        }
+        eqSetPot(&eq, i, 0.25f);   // -6 dB
+        double g = 20.0 * log10(section_mag_fs(sections[i], f, FS));
+        if (fabs(g + 6.0) > 0.5 || !section_stable(sections[i])) {
+            printf("FAIL layout band %u: %.2f dB at %.1f Hz\n", i, g, f);
+            failures++;
+        }
+    }
+    if (fabsf(bands[9].desc.freq_hz - 12000.0f) > 0.01f) {
+        printf("FAIL last center %.2f Hz\n", bands[9].desc.freq_hz);
+        failures++;
+    }
+
+    EqDesign one;
+    eqInit(&one, FS, bands, sections, 1);
+    if (eqGraphicLayout(&eq, 125.0f, FS, 12.0f) == 0 || eqGraphicLayout(&one, 125.0f, 12000.0f, 12.0f) == 0) {
+        printf("FAIL bad graphic layout accepted\n");
+        failures++;
+    }
+
+    printf("graphic layout: %d failures\n", failures);
+    return failures;
+}
+
+int main(void)
+{
+    int failures = check_defaults() + check_types() + check_graphic_layout();
+
+    if (failures) {
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
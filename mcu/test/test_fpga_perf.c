@@ -0,0 +1,163 @@
+// test_fpga_perf.c
+// Host test: FPGA counter bank decoding and the register sweep against a mock aes_spi readback
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc test/test_fpga_perf.c src/fpga_perf.c src/coeff_frame.c src/crc16.c -o test_fpga_perf
+//   ./test_fpga_perf
+
+#include <stdio.h>
+#include <string.h>
+#include "fpga_perf.h"
+#include "coeff_frame.h"
+
+#define SWEEP_CALLS 1000
+
+// -----------------------------
+// Mock Register Layer
+// -----------------------------
+
+// The FPGA side: the bank spi_top would shift out, and whether MISO is wired at all
+static uint32_t bank[FPGA_PERF_REGS];
+static int      fpga_present;
+static int      hw_reads;
+static const uint8_t *hw_tx;
+static uint8_t *hw_rx;
+static uint32_t hw_len;
+
+void coeffFrameHwInit(void) {}
+
+void coeffFrameHwStart(const uint8_t *buf, uint8_t *rx, uint32_t len)
+{
+    hw_tx = buf;
+    hw_rx = rx;
+    hw_len = len;
+    if (buf[0] == 0x00 && len == COEFF_FRAME_READ_BYTES) hw_reads++;
+}
+
+// CS rises: fill in what MISO carried and run the completion interrupt
+static void hw_complete(void)
+{
+    memset(hw_rx, 0, hw_len);
+    if (fpga_present) {
+        hw_rx[0] = COEFF_FRAME_STATUS_TAG;
+        if (hw_tx[0] == 0x00 && hw_len >= COEFF_FRAME_READ_BYTES) {
+            uint32_t v = hw_tx[1] < FPGA_PERF_REGS ? bank[hw_tx[1]] : 0;
+            for (int i = 0; i < 4; i++) hw_rx[4 + i] = (uint8_t)(v >> (24 - 8 * i));
+        }
+    }
+    coeffFrameOnDmaComplete();
+}
+
+// -----------------------------
+// Checks
+// -----------------------------
+
+static int failures;
+
+static void expect(int cond, const char *what)
+{
+    if (!cond) {
+        if (failures < 10) printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static void fill_bank(void)
+{
+    bank[FPGA_REG_ID]              = (FPGA_PERF_MAGIC << 16) | (3 << 8) | FPGA_PERF_VERSION;
+    bank[FPGA_REG_SAMPLES]         = 0x89ABCDEF;
+    bank[FPGA_REG_CLIPS]           = 17;
+    bank[FPGA_REG_MAC]             = (45u << 16) | 43;
+    bank[FPGA_REG_RATE]            = (193u << 16) | 384;
+    bank[FPGA_REG_FRAMES_OK]       = 1000;
+    bank[FPGA_REG_FRAMES_REJECTED] = 3;
+    bank[FPGA_REG_COMMITS]         = 998;
+}
+
+static void check_decode(void)
+{
+    FpgaPerf p;
+    uint32_t regs[FPGA_PERF_REGS];
+
+    fill_bank();
+    memcpy(regs, bank, sizeof regs);
+    expect(fpgaPerfDecode(regs, &p), "bank decodes");
+    expect(p.n_bands == 3 && p.samples == 0x89ABCDEF && p.clips == 17 && p.mac_busy_last == 43 &&
+           p.mac_busy_max == 45 && p.frame_clks == 384 && p.edge_clks_max == 193 &&
+           p.frames_ok == 1000 && p.frames_rejected == 3 && p.commits == 998, "fields");
+    expect(fpgaPerfSampleRateHz(&p) == 31250, "384 clks per frame is 31.25 kHz");
+    expect(fpgaPerfMacLoadPermille(&p) == 234, "45 of 192 clks is 23.4%");
+
+    regs[FPGA_REG_ID] ^= 0x10000;
+    expect(!fpgaPerfDecode(regs, &p), "wrong magic rejected");
+    regs[FPGA_REG_ID] = (FPGA_PERF_MAGIC << 16) | (3 << 8) | (FPGA_PERF_VERSION + 1);
+    expect(!fpgaPerfDecode(regs, &p), "other bank layout rejected");
+
+    p.frame_clks = 0;
+    expect(fpgaPerfSampleRateHz(&p) == 0, "no frame measured yet");
+}
+
+static void check_sweep(void)
+{
+    FpgaPerf p;
+    ThreeBandCoeffs c;
+    memset(&c, 0, sizeof c);
+
+    // No status word on MISO: reads keep going out, nothing decodes
+    fpga_present = 0;
+    coeffFrameInit();
+    fpgaPerfInit();
+    for (int i = 0; i < 50; i++) {
+        expect(!fpgaPerfService(), "nothing sweeps without an FPGA");
+        if (coeffFrameBusy()) hw_complete();
+    }
+    expect(!fpgaPerfGet(&p), "no snapshot without an FPGA");
+
+    // One register per completed read
+    fpga_present = 1;
+    fill_bank();
+    coeffFrameInit();
+    fpgaPerfInit();
+    hw_reads = 0;
+    int sweeps = 0, calls = 0;
+    while (!sweeps && calls < SWEEP_CALLS) {
+        sweeps += fpgaPerfService();
+        calls++;
+        if (coeffFrameBusy()) hw_complete();
+    }
+    expect(sweeps == 1 && hw_reads == FPGA_PERF_REGS + 1, "one read per register, then the next sweep starts");
+    expect(fpgaPerfGet(&p) && p.samples == bank[FPGA_REG_SAMPLES] && p.commits == 998, "sweep decoded");
+
+    // Frames take the link in between: reads wait for it, and their results
+    // outlast the frames chained behind them
+    bank[FPGA_REG_CLIPS] = 99;
+    hw_reads = 0;
+    sweeps = calls = 0;
+    while (!sweeps && calls < SWEEP_CALLS) {
+        if (calls % 3 == 1) {
+            coeffFrameSend(COEFF_BANDS_ALL, &c);   // Queues behind a read on the wire
+        }
+        sweeps += fpgaPerfService();
+        calls++;
+        if (calls % 2) {
+            while (coeffFrameBusy()) hw_complete();
+        }
+    }
+    expect(sweeps == 1 && fpgaPerfGet(&p) && p.clips == 99 && p.samples == bank[FPGA_REG_SAMPLES] &&
+           p.frames_ok == 1000, "sweep survives interleaved frames");
+    expect(hw_reads <= FPGA_PERF_REGS + 1, "no read repeated");
+    printf("sweep: %d service calls for %d registers with frames in between\n", calls, FPGA_PERF_REGS);
+}
+
+int main(void)
+{
+    check_decode();
+    check_sweep();
+
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
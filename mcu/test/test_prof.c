@@ -0,0 +1,148 @@
+// test_prof.c
+// Host test: profiling scope statistics, the dump format, and the PROF_ENABLED=0 build
+//
+// Build and run from mcu/ (both configurations):
+//   gcc -O2 -Isrc test/test_prof.c src/prof.c src/prof_host.c -o test_prof
+//   ./test_prof
+//   gcc -O2 -DPROF_ENABLED=0 -Isrc test/test_prof.c src/prof.c src/prof_host.c -o test_prof_off
+//   ./test_prof_off
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "prof.h"
+
+#define SLEEP_NS  2000000
+#define SLEEPS    5
+
+static int failures;
+
+static void expect(int cond, const char *what)
+{
+    if (!cond) {
+        if (failures < 10) printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static uint64_t get_le(const uint8_t *p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// An instrumented "hot path" that really takes SLEEP_NS
+static void timed_sleep(void)
+{
+    PROF_BEGIN(sleep, "sleep");
+    struct timespec ts = { 0, SLEEP_NS };
+    nanosleep(&ts, NULL);
+    PROF_END(sleep);
+}
+
+static void check_stats(void)
+{
+    int id = profScope("stats");
+    expect(id >= 0 && profScope("stats") == id, "scope names are deduplicated");
+
+    const uint32_t samples[] = { 0, 1, 3, 100, 1000, 1000, 70000 };
+    uint64_t sum = 0;
+    for (size_t i = 0; i < sizeof samples / sizeof samples[0]; i++) {
+        profRecord(id, samples[i]);
+        sum += samples[i];
+    }
+    profRecord(-1, 5);  // Ignored
+
+    const ProfScope *s = profGet(id);
+    expect(s->count == 7 && s->min == 0 && s->max == 70000 && s->sum == sum, "count/min/max/sum");
+    // Bins: 0 -> 0, 1 -> 1, 3 -> 2, 100 -> 7, 1000 -> 10, 70000 -> 17
+    expect(s->hist[0] == 1 && s->hist[1] == 1 && s->hist[2] == 1 && s->hist[7] == 1 &&
+           s->hist[10] == 2 && s->hist[17] == 1, "log2 histogram bins");
+    profRecord(id, 0xFFFFFFFFu);
+    expect(s->hist[PROF_HIST_BINS - 1] == 1, "last bin is open ended");
+
+    profReset();
+    expect(profGet(id)->count == 0 && profScope("stats") == id, "reset keeps names, clears stats");
+    expect(profGet(PROF_MAX_SCOPES) == NULL, "unknown id");
+}
+
+static void check_dump(void)
+{
+    uint8_t buf[PROF_DUMP_MAX];
+    int id = profScope("a_rather_long_scope_name");
+    profRecord(id, 42);
+
+    size_t len = profSerialize(buf, sizeof buf);
+    expect(len > PROF_DUMP_HEADER, "dump written");
+    expect(profSerialize(buf, len - 1) == 0, "too small a buffer is refused");
+    len = profSerialize(buf, sizeof buf);
+
+    expect(buf[0] == 'P' && buf[1] == 'F' && buf[2] == PROF_DUMP_VERSION, "dump header");
+    expect(get_le(buf + 4, 4) == 1000000000u, "host clock rate in header");
+
+    uint8_t x = 0;
+    for (size_t i = 0; i + 1 < len; i++) x ^= buf[i];
+    expect(x == buf[len - 1], "trailing XOR");
+
+    // Walk to the long-named scope and check its record
+    size_t p = PROF_DUMP_HEADER;
+    int found = 0;
+    for (int i = 0; i < buf[3]; i++) {
+        size_t n = buf[p];
+        if (n == PROF_NAME_MAX && memcmp(buf + p + 1, "a_rather_long_s", n) == 0) {
+            const uint8_t *f = buf + p + 1 + n;
+            found = get_le(f, 4) == 1 && get_le(f + 4, 4) == 42 && get_le(f + 8, 4) == 42 &&
+                    get_le(f + 12, 8) == 42 && get_le(f + 20 + 2 * 6, 2) == 1;
+        }
+        p += PROF_DUMP_SCOPE(n);
+    }
+    expect(found, "scope record fields, name truncated to PROF_NAME_MAX");
+    expect(p + 1 == len, "record sizes add up to the dump length");
+}
+
+static void check_capacity(void)
+{
+    static char names[PROF_MAX_SCOPES + 1][8];
+    int last = 0;
+    for (int i = 0; i <= PROF_MAX_SCOPES; i++) {
+        snprintf(names[i], sizeof names[i], "s%d", i);
+        last = profScope(names[i]);
+    }
+    expect(last == -1, "table full returns -1");
+}
+
+int main(void)
+{
+    profInit();
+
+    for (int i = 0; i < SLEEPS; i++) {
+        timed_sleep();
+    }
+    int sid = profScope("sleep");
+
+#if PROF_ENABLED
+    const ProfScope *s = profGet(sid);
+    double mean = (double)s->sum / s->count;
+    expect(s->count == SLEEPS, "instrumented scope counted every call");
+    expect(s->min >= SLEEP_NS && mean < 20.0 * SLEEP_NS, "host clock measures the sleep");
+    printf("sleep scope: %u calls, mean %.0f ns, max %u ns\n", s->count, mean, s->max);
+#else
+    expect(profGet(sid)->count == 0, "disabled macros record nothing");
+    printf("PROF_ENABLED=0: instrumentation compiled out\n");
+#endif
+
+    check_stats();
+    check_dump();
+    check_capacity();
+
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
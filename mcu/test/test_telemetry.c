@@ -0,0 +1,213 @@
+// test_telemetry.c
+// Host test: telemetry ring ordering, drop counting, partial drains and producer cost vs. printf
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc test/test_telemetry.c src/telemetry.c -o test_telemetry
+//   ./test_telemetry
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "telemetry.h"
+
+#define CAPTURE_BYTES (1 << 22)
+#define STRESS_STEPS  20000
+#define BENCH_RECORDS 1000000
+
+// -----------------------------
+// Mock Register Layer
+// -----------------------------
+
+static uint8_t *capture;
+static size_t   captured;
+static int      channel_budget;   // Bytes the channel takes before reporting busy, -1 = unlimited
+
+int telemHwTryPut(uint8_t byte)
+{
+    if (channel_budget == 0) {
+        return 0;
+    }
+    if (channel_budget > 0) {
+        channel_budget--;
+    }
+    capture[captured++] = byte;
+    return 1;
+}
+
+static uint32_t fake_time;
+
+static uint32_t fake_clock(void)
+{
+    return fake_time;
+}
+
+// -----------------------------
+// Checks
+// -----------------------------
+
+static int failures;
+
+static void expect(int cond, const char *what)
+{
+    if (!cond) {
+        if (failures < 10) printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void reset_all(void)
+{
+    telemInit(fake_clock);
+    captured = 0;
+    channel_budget = -1;
+    fake_time = 0;
+}
+
+// Record i carries i in its first word and time 1000 + i
+static void log_numbered(int i)
+{
+    int16_t w[1] = { (int16_t)i };
+    fake_time = 1000 + (uint32_t)i;
+    telemLog(TELEM_POTS, 0, w, 1);
+}
+
+static void check_roundtrip(void)
+{
+    reset_all();
+    BiquadQ14 q = { 16384, -32768, 32767, -1, 123 };
+    fake_time = 77;
+    expect(telemLogCoeffs(COEFF_BAND_HIGH, &q) == 1, "coeff record queued");
+    uint16_t adc[3] = { 0, 2048, 4095 };
+    float pots[3] = { 0.0f, 0.5f, 1.0f };
+    expect(telemLogPots(adc, pots) == 1, "pot record queued");
+    expect(telemPending() == 2, "two pending");
+
+    expect(telemDrain(1000) == 2 * TELEM_WIRE_BYTES, "drain sends both records");
+    expect(telemPending() == 0 && telemDrain(1000) == 0, "ring empty after drain");
+
+    TelemRecord a, b;
+    expect(telemDecode(capture, &a) && telemDecode(capture + TELEM_WIRE_BYTES, &b), "decode");
+    expect(a.type == TELEM_COEFFS && a.arg == COEFF_BAND_HIGH && a.time == 77 && a.seq == 0 &&
+           a.data[0] == 16384 && a.data[1] == -32768 && a.data[2] == 32767 &&
+           a.data[3] == -1 && a.data[4] == 123 && a.data[5] == 0, "coeff record fields");
+    expect(b.type == TELEM_POTS && b.seq == 1 && (uint16_t)b.data[2] == 4095 &&
+           b.data[3] == 0 && b.data[4] == 5000 && b.data[5] == 10000, "pot record fields");
+
+    capture[7] ^= 0x10;
+    expect(!telemDecode(capture, &a), "corrupted record fails the XOR");
+}
+
+static void check_drops(void)
+{
+    reset_all();
+    for (int i = 0; i < TELEM_RING_SIZE + 10; i++) {
+        log_numbered(i);
+    }
+    expect(telemPending() == TELEM_RING_SIZE && telemDropped() == 10, "full ring drops and counts");
+
+    // Draining frees room; the next record's seq shows the gap
+    telemDrain(5 * TELEM_WIRE_BYTES);
+    log_numbered(500);
+    telemDrain(1u << 20);
+
+    int n = (int)(captured / TELEM_WIRE_BYTES);
+    TelemRecord r;
+    expect(n == TELEM_RING_SIZE + 1, "kept records all come out");
+    expect(telemDecode(capture + (size_t)(n - 1) * TELEM_WIRE_BYTES, &r) &&
+           r.seq == TELEM_RING_SIZE + 10 && r.data[0] == 500, "seq gap marks the drops");
+}
+
+// Random producer bursts against a channel that takes random byte counts
+static void check_stress(void)
+{
+    reset_all();
+    srand(3);
+    int next = 0;
+    for (int s = 0; s < STRESS_STEPS; s++) {
+        int burst = rand() % 6;
+        for (int i = 0; i < burst; i++) {
+            log_numbered(next++ & 0x7FFF);
+        }
+        channel_budget = rand() % 50;
+        telemDrain((uint32_t)(rand() % 80));
+        if (captured > CAPTURE_BYTES - 4096) break;
+    }
+    channel_budget = -1;
+    telemDrain(1u << 30);
+
+    // Everything that was not dropped arrives whole and in order, with seq explaining gaps
+    size_t n = captured / TELEM_WIRE_BYTES;
+    uint32_t gaps = 0;
+    uint16_t expect_seq = 0;
+    int ok = captured % TELEM_WIRE_BYTES == 0;
+    for (size_t i = 0; i < n && ok; i++) {
+        TelemRecord r;
+        ok = telemDecode(capture + i * TELEM_WIRE_BYTES, &r);
+        if (!ok) break;
+        gaps += (uint16_t)(r.seq - expect_seq);
+        ok = r.data[0] == (int16_t)(r.seq & 0x7FFF) && r.time == 1000u + (r.seq & 0x7FFF);
+        expect_seq = (uint16_t)(r.seq + 1);
+    }
+    expect(ok, "stress stream decodes in order");
+    expect(gaps == telemDropped() && n + gaps == (size_t)next, "every record sent or counted");
+    printf("stress: %d offered, %zu delivered, %u dropped\n", next, n, telemDropped());
+}
+
+// The old print_q14 cost is the formatting alone here; on target ITM_SendChar adds more
+static void bench(void)
+{
+    BiquadQ14 q = { 16000, -31000, 15000, -30000, 14000 };
+    char line[64];
+    volatile size_t sink = 0;
+
+    reset_all();
+    double t0 = now_ns();
+    for (int i = 0; i < BENCH_RECORDS; i++) {
+        telemLogCoeffs(COEFF_BAND_LOW, &q);
+        if ((i & (TELEM_RING_SIZE / 2 - 1)) == 0) {
+            captured = 0;
+            telemDrain(1u << 20);   // Keep the ring from filling; cost counted too
+        }
+    }
+    double t_telem = (now_ns() - t0) / BENCH_RECORDS;
+
+    t0 = now_ns();
+    for (int i = 0; i < BENCH_RECORDS / 10; i++) {
+        const int16_t *w = &q.b0;
+        for (int k = 0; k < 5; k++) {
+            sink += (size_t)snprintf(line, sizeof line, "%s: raw = %d, real = %.6f\n",
+                                     "LOW_B0", w[k], (float)w[k] / 16384.0f);
+        }
+    }
+    double t_printf = (now_ns() - t0) / (BENCH_RECORDS / 10);
+
+    printf("per band: telemetry %.1f ns (log + drain), snprintf x5 %.1f ns (%.0fx)\n",
+           t_telem, t_printf, t_printf / t_telem);
+}
+
+int main(void)
+{
+    capture = malloc(CAPTURE_BYTES);
+
+    check_roundtrip();
+    check_drops();
+    check_stress();
+    bench();
+
+    free(capture);
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
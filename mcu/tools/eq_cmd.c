@@ -0,0 +1,249 @@
+// eq_cmd.c
+// Host tool: send commands to the board (or eq_fake_device) over the USART command channel
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc tools/eq_cmd.c src/cmd_proto.c src/crc16.c src/calc_coefficient.c src/coeff_table.c src/coeff_table_data.c -lm -o eq_cmd
+//   ./eq_cmd /dev/ttyACM0 ping
+//   ./eq_cmd /dev/ttyACM0 status
+//   ./eq_cmd /dev/ttyACM0 mode knobs|test N
+//   ./eq_cmd /dev/ttyACM0 pots LOW MID HIGH
+//   ./eq_cmd /dev/ttyACM0 coeffs W0 ... W14          (low/mid/high b0 b1 b2 a1 a2, Q2.14)
+//   ./eq_cmd /dev/ttyACM0 sweep low|mid|high FROM_DB TO_DB STEPS [HOLD_MS]
+//   ./eq_cmd /dev/ttyACM0 profile | ./prof_decode
+
+#define _DEFAULT_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "calc_coefficient.h"
+#include "cmd_proto.h"
+
+#define BAUD       B230400      // CMD_UART_BAUD in main.c
+#define TIMEOUT_MS 1000
+
+static int port = -1;
+static CmdParser parser;
+static uint8_t frame[CMD_MAX_FRAME];
+
+// -----------------------------
+// Helper Functions
+// -----------------------------
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int open_port(const char *path)
+{
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) return -1;
+
+    // A pty ignores the speed; a real VCP needs raw 8N1 at the firmware's rate
+    struct termios t;
+    if (tcgetattr(fd, &t) == 0) {
+        cfmakeraw(&t);
+        cfsetispeed(&t, BAUD);
+        cfsetospeed(&t, BAUD);
+        tcsetattr(fd, TCSANOW, &t);
+    }
+    return fd;
+}
+
+// Send one request and wait for its reply; returns the reply status code, or -1 on timeout
+static int transact(uint8_t type, const uint8_t *payload, uint16_t len)
+{
+    size_t n = cmdFrameEncode(type, payload, len, frame);
+    for (size_t off = 0; off < n; ) {
+        ssize_t w = write(port, frame + off, n - off);
+        if (w < 0 && errno != EINTR) return -1;
+        if (w > 0) off += (size_t)w;
+    }
+
+    double deadline = now_ms() + TIMEOUT_MS;
+    for (;;) {
+        int left = (int)(deadline - now_ms());
+        if (left <= 0) return -1;
+
+        struct pollfd pfd = { .fd = port, .events = POLLIN };
+        if (poll(&pfd, 1, left) <= 0) continue;
+
+        uint8_t buf[256];
+        ssize_t r = read(port, buf, sizeof buf);
+        if (r <= 0) continue;
+        for (ssize_t i = 0; i < r; i++) {
+            if (cmdParserFeed(&parser, buf[i]) && parser.type == (type | CMD_REPLY) && parser.len >= 1) {
+                return parser.payload[0];
+            }
+        }
+    }
+}
+
+static int expect_ok(const char *what, int status)
+{
+    if (status == CMD_OK) return 0;
+    if (status < 0) fprintf(stderr, "%s: no reply\n", what);
+    else fprintf(stderr, "%s: error %d\n", what, status);
+    return 1;
+}
+
+static void print_band(const char *name, const BiquadQ14 *q)
+{
+    printf("  %-4s b0 %6d  b1 %6d  b2 %6d  a1 %6d  a2 %6d\n", name, q->b0, q->b1, q->b2, q->a1, q->a2);
+}
+
+static int parse_band(const char *s)
+{
+    if (!strcmp(s, "low")) return COEFF_BAND_LOW;
+    if (!strcmp(s, "mid")) return COEFF_BAND_MID;
+    if (!strcmp(s, "high")) return COEFF_BAND_HIGH;
+    return -1;
+}
+
+static void put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+// -----------------------------
+// Commands
+// -----------------------------
+
+static int cmd_status(void)
+{
+    int st = transact(CMD_GET_STATUS, NULL, 0);
+    if (expect_ok("status", st)) return 1;
+    if (parser.len < 1 + CMD_STATUS_BYTES) {
+        fprintf(stderr, "status: short reply\n");
+        return 1;
+    }
+
+    static const char *mode_names[EQ_NUM_MODES] = { "knobs", "pots", "coeffs", "test" };
+    CmdStatus s;
+    cmdUnpackStatus(parser.payload + 1, &s);
+    printf("mode          %s", s.mode < EQ_NUM_MODES ? mode_names[s.mode] : "?");
+    if (s.mode == EQ_MODE_TEST) printf(" %u", s.test_number);
+    printf("\ntick          %u ms\n", s.tick);
+    printf("commands      %u (crc errors %u, rx overruns %u)\n", s.commands, s.crc_errors, s.rx_overruns);
+    printf("frames sent   %u\n", s.frames_sent);
+    printf("knob latency  %u ticks max\n", s.knob_latency_max);
+    printf("telem dropped %u\n", s.telem_dropped);
+    printf("pots          %u %u %u\n", s.pots[0], s.pots[1], s.pots[2]);
+    printf("coeffs\n");
+    print_band("low", &s.coeffs.low);
+    print_band("mid", &s.coeffs.mid);
+    print_band("high", &s.coeffs.high);
+    return 0;
+}
+
+static int cmd_profile(void)
+{
+    int st = transact(CMD_GET_PROFILE, NULL, 0);
+    if (expect_ok("profile", st)) return 1;
+    fwrite(parser.payload + 1, 1, parser.len - 1u, stdout);
+    return 0;
+}
+
+static int cmd_sweep(CoeffBand band, float from_db, float to_db, int steps, int hold_ms)
+{
+    ThreeBandCoeffs c;
+    c.low = c.mid = c.high = simpleUnity();
+    BiquadQ14 *target = band == COEFF_BAND_LOW ? &c.low : band == COEFF_BAND_MID ? &c.mid : &c.high;
+    uint8_t payload[CMD_COEFF_BYTES];
+
+    double start = now_ms();
+    for (int i = 0; i < steps; i++) {
+        float db = steps > 1 ? from_db + (to_db - from_db) * i / (steps - 1) : from_db;
+        *target = calcCoeffDesign(band, db);
+        cmdPackCoeffs(&c, payload);
+        if (expect_ok("sweep", transact(CMD_SET_COEFFS, payload, sizeof payload))) return 1;
+        if (hold_ms > 0) usleep((useconds_t)hold_ms * 1000);
+    }
+    double secs = (now_ms() - start) / 1e3;
+    printf("%d coefficient sets in %.3f s (%.0f sets/s)\n", steps, secs, secs > 0 ? steps / secs : 0.0);
+    return 0;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s PORT ping | status | profile | mode knobs|pots|coeffs|test N\n"
+            "       %s PORT pots LOW MID HIGH | coeffs W0..W14\n"
+            "       %s PORT sweep low|mid|high FROM_DB TO_DB STEPS [HOLD_MS]\n",
+            prog, prog, prog);
+}
+
+// -----------------------------
+// Main
+// -----------------------------
+
+int main(int argc, char **argv)
+{
+    if (argc < 3) {
+        usage(argv[0]);
+        return 2;
+    }
+    port = open_port(argv[1]);
+    if (port < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+    cmdParserInit(&parser);
+
+    const char *cmd = argv[2];
+    int nargs = argc - 3;
+    char **args = argv + 3;
+
+    if (!strcmp(cmd, "ping")) {
+        double t0 = now_ms();
+        if (expect_ok("ping", transact(CMD_PING, NULL, 0))) return 1;
+        printf("protocol %u, round trip %.2f ms\n", parser.len > 1 ? parser.payload[1] : 0, now_ms() - t0);
+        return 0;
+    }
+    if (!strcmp(cmd, "status")) return cmd_status();
+    if (!strcmp(cmd, "profile")) return cmd_profile();
+
+    if (!strcmp(cmd, "mode") && nargs >= 1) {
+        static const char *names[EQ_NUM_MODES] = { "knobs", "pots", "coeffs", "test" };
+        uint8_t payload[2] = { EQ_NUM_MODES, 0 };
+        for (int m = 0; m < EQ_NUM_MODES; m++) {
+            if (!strcmp(args[0], names[m])) payload[0] = (uint8_t)m;
+        }
+        if (payload[0] == EQ_MODE_TEST && nargs >= 2) payload[1] = (uint8_t)atoi(args[1]);
+        return expect_ok("mode", transact(CMD_SET_MODE, payload, sizeof payload));
+    }
+
+    if (!strcmp(cmd, "pots") && nargs == 3) {
+        uint8_t payload[CMD_POTS_BYTES];
+        for (int i = 0; i < 3; i++) put16(payload + 2 * i, (uint16_t)atoi(args[i]));
+        return expect_ok("pots", transact(CMD_SET_POTS, payload, sizeof payload));
+    }
+
+    if (!strcmp(cmd, "coeffs") && nargs == 5 * COEFF_NUM_BANDS) {
+        uint8_t payload[CMD_COEFF_BYTES];
+        for (int i = 0; i < nargs; i++) put16(payload + 2 * i, (uint16_t)(int16_t)atoi(args[i]));
+        return expect_ok("coeffs", transact(CMD_SET_COEFFS, payload, sizeof payload));
+    }
+
+    if (!strcmp(cmd, "sweep") && nargs >= 4) {
+        int band = parse_band(args[0]);
+        if (band < 0) {
+            usage(argv[0]);
+            return 2;
+        }
+        return cmd_sweep((CoeffBand)band, (float)atof(args[1]), (float)atof(args[2]), atoi(args[3]),
+                         nargs >= 5 ? atoi(args[4]) : 0);
+    }
+
+    usage(argv[0]);
+    return 2;
+}
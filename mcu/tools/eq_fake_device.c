@@ -0,0 +1,154 @@
+// eq_fake_device.c
+// Host tool: the firmware's command server and design tick behind a pty, in place of the board
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc tools/eq_fake_device.c src/cmd_server.c src/cmd_proto.c src/crc16.c src/uart.c src/uart_host.c src/eq_control.c src/coeff_frame.c src/prof.c src/prof_host.c src/calc_coefficient.c src/coeff_table.c src/coeff_table_data.c -lm -o eq_fake_device
+//   ./eq_fake_device --link /tmp/eq0 [--verbose]      (then point eq_cmd at /tmp/eq0)
+
+#define _XOPEN_SOURCE 700
+#define _DEFAULT_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "calc_coefficient.h"
+#include "cmd_server.h"
+#include "coeff_frame.h"
+#include "eq_control.h"
+#include "prof.h"
+#include "uart.h"
+
+// Same rates as main.c, in 1 ms ticks
+#define SMOOTH_PERIOD       5
+#define DESIGN_PERIOD       20
+#define FRAME_REFRESH_SENDS 50
+
+static uint32_t tick;
+static uint32_t frames_sent;
+static ThreeBandCoeffs last_sent;
+static const uint16_t knobs[3] = { 2048, 2048, 2048 };  // The fake's pots sit mid-travel
+
+// The frame never leaves the process; the register layer just counts it
+void coeffFrameHwInit(void) {}
+void coeffFrameHwStart(const uint8_t *buf, uint8_t *rx, uint32_t len) { (void)buf; (void)rx; (void)len; coeffFrameOnDmaComplete(); }
+
+static void fill_status(CmdStatus *s)
+{
+    const uint16_t *pots = eqControlSmoothInput(knobs);
+    s->mode = (uint8_t)eqControlMode();
+    s->test_number = eqControlTestNumber();
+    s->tick = tick;
+    s->frames_sent = frames_sent;
+    for (int i = 0; i < 3; i++) s->pots[i] = pots[i];
+    s->coeffs = last_sent;
+}
+
+static int open_pty(char *name, size_t cap, int *slave_keep)
+{
+    int m = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m < 0 || grantpt(m) || unlockpt(m)) return -1;
+    snprintf(name, cap, "%s", ptsname(m));
+
+    // Holding the slave open keeps the master readable between clients; raw so bytes pass untouched
+    int s = open(name, O_RDWR | O_NOCTTY);
+    if (s < 0) return -1;
+    struct termios t;
+    tcgetattr(s, &t);
+    cfmakeraw(&t);
+    tcsetattr(s, TCSANOW, &t);
+    *slave_keep = s;
+    return m;
+}
+
+int main(int argc, char **argv)
+{
+    const char *link_path = NULL;
+    int verbose = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--link") && i + 1 < argc) link_path = argv[++i];
+        else if (!strcmp(argv[i], "--verbose")) verbose = 1;
+        else {
+            fprintf(stderr, "usage: %s [--link PATH] [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    char name[128];
+    int slave;
+    int master = open_pty(name, sizeof name, &slave);
+    if (master < 0) {
+        perror("pty");
+        return 1;
+    }
+    if (link_path) {
+        unlink(link_path);
+        if (symlink(name, link_path)) {
+            perror(link_path);
+            return 1;
+        }
+    }
+    printf("fake EQ device on %s%s%s\n", name, link_path ? " -> " : "", link_path ? link_path : "");
+    fflush(stdout);
+
+    uartHostAttach(master);
+    uartInit(230400);
+    cmdServerInit(fill_status);
+    eqControlInit();
+    calcCoeffInit();
+    coeffFrameInit();
+    profInit();
+
+    ThreeBandCoeffs coeffs;
+    uint32_t sends_since_frame = 0;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    for (;; tick++) {
+        if (uartHostService() < 0) {
+            perror("pty");
+            return 1;
+        }
+        cmdServerPoll();
+
+        if (tick % SMOOTH_PERIOD == 0) {
+            const uint16_t *in = eqControlSmoothInput(knobs);
+            calcCoeffSmooth(in[0], in[1], in[2]);
+        }
+        if (tick % DESIGN_PERIOD == 1) {
+            CmdControl ctl;
+            if (cmdServerTakeControl(&ctl)) {
+                eqControlSet(&ctl);
+            }
+            uint8_t changed = eqControlDesign(&coeffs);
+            if (changed || ++sends_since_frame >= FRAME_REFRESH_SENDS) {
+                uint8_t mask = sends_since_frame >= FRAME_REFRESH_SENDS ? COEFF_BANDS_ALL : changed;
+                const uint8_t *index = eqControlGainIndex();
+                if (index) {
+                    coeffFrameSendIndices(mask, index);
+                } else {
+                    coeffFrameSend(mask, &coeffs);
+                }
+                last_sent = coeffs;
+                frames_sent++;
+                sends_since_frame = 0;
+                if (verbose && changed) {
+                    const int16_t *w = &coeffs.low.b0;
+                    printf("t=%u mode %d frame:", tick, eqControlMode());
+                    for (int k = 0; k < 15; k++) printf(" %d", w[k]);
+                    printf("\n");
+                    fflush(stdout);
+                }
+            }
+        }
+
+        next.tv_nsec += 1000000;
+        if (next.tv_nsec >= 1000000000) {
+            next.tv_nsec -= 1000000000;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+    }
+}
@@ -0,0 +1,56 @@
+// gen_coeff_table.c
+// Host tool: generates coeff_table_data.c from the float design in calc_coefficient.c
+//
+// Build and run from mcu/:
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc tools/gen_coeff_table.c src/calc_coefficient.c -lm -o gen_coeff_table
+//   ./gen_coeff_table > src/coeff_table_data.c
+
+#include <stdio.h>
+#include "calc_coefficient.h"
+#include "coeff_table.h"
+
+static const char *band_names[COEFF_NUM_BANDS] = { "LOW", "MID", "HIGH" };
+
+static int is_unity(BiquadQ14 q)
+{
+    return q.b0 == 0x4000 && q.b1 == 0 && q.b2 == 0 && q.a1 == 0 && q.a2 == 0;
+}
+
+int main(void)
+{
+    // The gain mapping is shared by all bands, so the low band finds the threshold
+    uint16_t unity_code = 4096;
+    for (uint16_t adc = 0; adc < 4096; adc++) {
+        if (is_unity(calcCoeffBandFloat(COEFF_BAND_LOW, adc))) {
+            unity_code = adc;
+            break;
+        }
+    }
+
+    printf("// coeff_table_data.c\n");
+    printf("// GENERATED by mcu/tools/gen_coeff_table.c - do not edit by hand\n");
+    printf("// Entry i holds the float design at ADC code i * %d (no unity shortcut)\n\n",
+           COEFF_TABLE_STEP);
+    printf("#include \"coeff_table.h\"\n\n");
+    printf("const uint16_t coeffTableUnityCode = %u;\n\n", unity_code);
+    printf("const BiquadQ14 coeffTable[COEFF_NUM_BANDS][COEFF_TABLE_SIZE] = {\n");
+
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        printf("    // ---- %s BAND ----\n", band_names[band]);
+        printf("    {\n");
+        for (int i = 0; i < COEFF_TABLE_SIZE; i++) {
+            int adc = i * COEFF_TABLE_STEP;
+            if (adc > 4095) {
+                adc = 4095;
+            }
+            BiquadQ14 q = calcCoeffDesign((CoeffBand)band,
+                                          calcCoeffAdcToGainDb((uint16_t)adc));
+            printf("        { %6d, %6d, %6d, %6d, %6d },  // %4d\n",
+                   q.b0, q.b1, q.b2, q.a1, q.a2, adc);
+        }
+        printf("    },\n");
+    }
+    printf("};\n");
+
+    return 0;
+}
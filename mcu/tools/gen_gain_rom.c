@@ -0,0 +1,33 @@
+// gen_gain_rom.c
+// Host tool: generates the FPGA coefficient ROM (fpga/src/gain_rom.mem) from calcCoeffGainIndexDesign
+//
+// Build and run from mcu/:
+//   gcc -O2 -DCOEFF_ENGINE=COEFF_ENGINE_FLOAT -Isrc tools/gen_gain_rom.c src/calc_coefficient.c -lm -o gen_gain_rom
+//   ./gen_gain_rom > ../fpga/src/gain_rom.mem
+
+#include <stdio.h>
+#include "calc_coefficient.h"
+
+static const char *band_names[COEFF_NUM_BANDS] = { "LOW", "MID", "HIGH" };
+
+int main(void)
+{
+    // $readmemh format, one gain index per line: its five 16-bit words b0 b1 b2 a1 a2, which
+    // $readmemh loads in order. Word (band * COEFF_GAIN_STEPS + index) * 5 + k holds coefficient
+    // k of that band at that gain index, as gain_rom.sv reads it.
+    printf("// gain_rom.mem\n");
+    printf("// GENERATED by mcu/tools/gen_gain_rom.c - do not edit by hand\n");
+    printf("// %d bands x %d gain indices x 5 words (b0 b1 b2 a1 a2), Q2.14\n",
+           COEFF_NUM_BANDS, COEFF_GAIN_STEPS);
+
+    for (int band = 0; band < COEFF_NUM_BANDS; band++) {
+        printf("// ---- %s BAND ----\n", band_names[band]);
+        for (int i = 0; i < COEFF_GAIN_STEPS; i++) {
+            BiquadQ14 q = calcCoeffGainIndexDesign((CoeffBand)band, (uint8_t)i);
+            printf("%04X %04X %04X %04X %04X // %2d\n",
+                   (uint16_t)q.b0, (uint16_t)q.b1, (uint16_t)q.b2, (uint16_t)q.a1, (uint16_t)q.a2, i);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+// prof_decode.c
+// Host tool: prints the profDump() records found in a captured ITM/USART byte stream
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc tools/prof_decode.c -o prof_decode
+//   ./prof_decode capture.bin        (or pipe the stream into ./prof_decode)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "prof.h"
+
+#define MAX_CAPTURE (16 * 1024 * 1024)
+
+static uint64_t get_le(const uint8_t *p, int bytes)
+{
+    uint64_t v = 0;
+    for (int i = bytes - 1; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// Print one dump at buf; returns its length, or 0 if it is not a complete, valid dump
+static size_t decode(const uint8_t *buf, size_t len)
+{
+    if (len < PROF_DUMP_HEADER + 1 || buf[0] != PROF_DUMP_MAGIC0 ||
+        buf[1] != PROF_DUMP_MAGIC1 || buf[2] != PROF_DUMP_VERSION) {
+        return 0;
+    }
+    int scopes = buf[3];
+    double hz = (double)get_le(buf + 4, 4);
+    size_t pos = PROF_DUMP_HEADER;
+
+    // Walk once to find the end and check the XOR before printing anything
+    for (int i = 0; i < scopes; i++) {
+        if (pos >= len) return 0;
+        size_t n = buf[pos];
+        if (n > PROF_NAME_MAX || pos + PROF_DUMP_SCOPE(n) > len) return 0;
+        pos += PROF_DUMP_SCOPE(n);
+    }
+    if (pos >= len) return 0;
+    uint8_t x = 0;
+    for (size_t i = 0; i < pos; i++) x ^= buf[i];
+    if (x != buf[pos]) return 0;
+
+    printf("%-16s %8s %10s %10s %10s %10s\n", "scope", "count", "min", "mean", "max", "mean_us");
+    size_t p = PROF_DUMP_HEADER;
+    for (int i = 0; i < scopes; i++) {
+        size_t n = buf[p];
+        char name[PROF_NAME_MAX + 1];
+        memcpy(name, buf + p + 1, n);
+        name[n] = '\0';
+        const uint8_t *f = buf + p + 1 + n;
+        uint32_t count = (uint32_t)get_le(f, 4);
+        uint32_t min   = (uint32_t)get_le(f + 4, 4);
+        uint32_t max   = (uint32_t)get_le(f + 8, 4);
+        uint64_t sum   = get_le(f + 12, 8);
+        double mean = count ? (double)sum / count : 0.0;
+
+        printf("%-16s %8u %10u %10.1f %10u %10.2f\n", name, count, min, mean, max,
+               hz > 0 ? mean * 1e6 / hz : 0.0);
+
+        // Histogram as "<2^b:count" pairs, empty bins skipped
+        printf("  hist");
+        for (int b = 0; b < PROF_HIST_BINS; b++) {
+            unsigned h = (unsigned)get_le(f + 20 + 2 * b, 2);
+            if (!h) continue;
+            if (b == PROF_HIST_BINS - 1) {
+                printf(" >=%u:%u", 1u << (b - 1), h);
+            } else {
+                printf(" <%u:%u", 1u << b, h);
+            }
+        }
+        printf("\n");
+        p += PROF_DUMP_SCOPE(n);
+    }
+    printf("clock %.0f Hz\n\n", hz);
+    return pos + 1;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *f = argc > 1 ? fopen(argv[1], "rb") : stdin;
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+    uint8_t *buf = malloc(MAX_CAPTURE);
+    size_t len = fread(buf, 1, MAX_CAPTURE, f);
+    if (f != stdin) fclose(f);
+
+    // Dumps may be interleaved with printf text on the same channel: resync on the magic
+    int found = 0;
+    for (size_t i = 0; i < len; ) {
+        size_t n = decode(buf + i, len - i);
+        if (n) {
+            found++;
+            i += n;
+        } else {
+            i++;
+        }
+    }
+    free(buf);
+
+    if (!found) {
+        fprintf(stderr, "no profile dump found\n");
+        return 1;
+    }
+    return 0;
+}
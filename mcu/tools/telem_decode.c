@@ -0,0 +1,89 @@
+// telem_decode.c
+// Host tool: turns a captured telemetry stream (ITM stimulus port 1) back into text
+//
+// Build and run from mcu/:
+//   gcc -O2 -Isrc tools/telem_decode.c src/telemetry.c -o telem_decode
+//   ./telem_decode port1.bin        (or pipe the stream into ./telem_decode)
+
+#include <stdio.h>
+#include "telemetry.h"
+
+static const char *band_names[COEFF_NUM_BANDS] = { "LOW", "MID", "HIGH" };
+static const char *coeff_names[5] = { "B0", "B1", "B2", "A1", "A2" };
+
+// The drain is not used here, but telemetry.c links against it
+int telemHwTryPut(uint8_t byte)
+{
+    (void)byte;
+    return 0;
+}
+
+static void print_record(const TelemRecord *r)
+{
+    switch (r->type) {
+    case TELEM_COEFFS:
+        for (int k = 0; k < 5; k++) {
+            printf("t=%u %s_%s: raw = %d, real = %.6f\n", r->time,
+                   r->arg < COEFF_NUM_BANDS ? band_names[r->arg] : "?", coeff_names[k],
+                   r->data[k], r->data[k] / 16384.0);
+        }
+        break;
+    case TELEM_POTS:
+        printf("t=%u POTS: adc = %u %u %u, pot = %.4f %.4f %.4f\n", r->time,
+               (uint16_t)r->data[0], (uint16_t)r->data[1], (uint16_t)r->data[2],
+               r->data[3] / 10000.0, r->data[4] / 10000.0, r->data[5] / 10000.0);
+        break;
+    case TELEM_FPGA:
+        printf("t=%u FPGA: %u bands, clips = %u, mac busy max = %u clks, frame = %u clks, "
+               "rejected = %u, commits = %u, samples = %u\n", r->time, r->arg,
+               (uint16_t)r->data[0], (uint16_t)r->data[1], (uint16_t)r->data[2],
+               (uint16_t)r->data[3], (uint16_t)r->data[4], (uint16_t)r->data[5]);
+        break;
+    default:
+        printf("t=%u type %u (unknown)\n", r->time, r->type);
+        break;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    FILE *f = argc > 1 ? fopen(argv[1], "rb") : stdin;
+    if (!f) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    // Sliding window over the stream; resync byte by byte after noise or a lost byte
+    uint8_t win[TELEM_WIRE_BYTES];
+    int fill = 0, have_seq = 0, c;
+    uint16_t next_seq = 0;
+    unsigned records = 0, dropped = 0, garbage = 0;
+
+    while ((c = fgetc(f)) != EOF) {
+        win[fill++] = (uint8_t)c;
+        if (fill < TELEM_WIRE_BYTES) continue;
+
+        TelemRecord r;
+        if (!telemDecode(win, &r)) {
+            for (int i = 1; i < TELEM_WIRE_BYTES; i++) win[i - 1] = win[i];
+            fill--;
+            garbage++;
+            continue;
+        }
+        fill = 0;
+
+        if (have_seq && r.seq != next_seq) {
+            uint16_t gap = (uint16_t)(r.seq - next_seq);
+            printf("-- %u records dropped --\n", gap);
+            dropped += gap;
+        }
+        next_seq = (uint16_t)(r.seq + 1);
+        have_seq = 1;
+        records++;
+        print_record(&r);
+    }
+    if (f != stdin) fclose(f);
+
+    fprintf(stderr, "%u records, %u dropped, %u bytes skipped\n", records, dropped, garbage);
+    return 0;
+}